@@ -49,6 +49,7 @@
 # Components and miscellaneous options:
 #
 #     DEAL_II_WITH_64BIT_INDICES
+#     DEAL_II_WITH_INSTRUMENTATION
 #     DEAL_II_DOXYGEN_USE_MATHJAX
 #     DEAL_II_COMPILE_EXAMPLES
 #     DEAL_II_CPACK_BUNDLE_NAME
@@ -370,6 +371,12 @@ OPTION(DEAL_II_WITH_64BIT_INDICES
   )
 LIST(APPEND DEAL_II_FEATURES 64BIT_INDICES)
 
+OPTION(DEAL_II_WITH_INSTRUMENTATION
+  "If set to ON, then timing regions are compiled into several functions of the library that report to a sink attached at run time, see the Instrumentation namespace. Without an attached sink, a region costs an atomic load and a branch. The default is ON."
+  ON
+  )
+LIST(APPEND DEAL_II_FEATURES INSTRUMENTATION)
+
 OPTION(DEAL_II_DOXYGEN_USE_MATHJAX
   "If set to ON, doxygen documentation is generated using mathjax"
   OFF
@@ -452,7 +459,7 @@ FOREACH(_var ${_res})
   #
   IF(DEAL_II_FORCE_AUTODETECTION AND _var MATCHES "^DEAL_II_WITH_"
      # Exclude FEATURES that do not represent external libraries:
-     AND NOT _var MATCHES "^DEAL_II_WITH_64BIT_INDICES" )
+     AND NOT _var MATCHES "^DEAL_II_WITH_(64BIT_INDICES|INSTRUMENTATION)" )
     UNSET(${_var} CACHE)
   ENDIF()
 ENDFOREACH()
@@ -0,0 +1,105 @@
+#!/usr/bin/python
+
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2018 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Compare the JSON results of the benchmarks in tests/performance against a
+# baseline, e.g., the results of an earlier revision on the same machine:
+#
+#   compare_benchmarks.py [--threshold=0.1] BASELINE CURRENT
+#
+# BASELINE and CURRENT are either single JSON files or directories that
+# contain them. A kernel is flagged as a regression if its minimal time
+# increased by more than the given relative threshold. The script exits with
+# a nonzero status if at least one regression was found, so that it can be
+# used in continuous integration.
+
+from __future__ import print_function
+
+import glob
+import json
+import os
+import sys
+
+
+def read_results(path):
+    """Return a dictionary that maps (benchmark, name, parameters) to the
+    result of one kernel, for all JSON files found at the given path."""
+    if os.path.isdir(path):
+        files = sorted(glob.glob(os.path.join(path, "*.json")))
+    else:
+        files = [path]
+
+    results = {}
+    for filename in files:
+        with open(filename) as f:
+            data = json.load(f)
+        for result in data["results"]:
+            parameters = ", ".join("%s=%s" % (key, value) for key, value
+                                   in sorted(result["parameters"].items()))
+            results[(data["benchmark"], result["name"], parameters)] = result
+    return results
+
+
+def main(args):
+    threshold = 0.1
+    paths = []
+    for arg in args:
+        if arg.startswith("--threshold="):
+            threshold = float(arg[len("--threshold="):])
+        else:
+            paths.append(arg)
+    if len(paths) != 2:
+        sys.exit("Usage: compare_benchmarks.py [--threshold=0.1] "
+                 "BASELINE CURRENT")
+
+    baseline = read_results(paths[0])
+    current = read_results(paths[1])
+
+    n_regressions = 0
+    print("%-60s %12s %12s %8s" % ("kernel", "baseline", "current", "ratio"))
+    for key in sorted(current):
+        label = "%s/%s (%s)" % key
+        if key not in baseline:
+            print("%-60s %12s %12.4g %8s" % (label, "-",
+                                             current[key]["time_min"], "new"))
+            continue
+
+        ratio = current[key]["time_min"] / baseline[key]["time_min"]
+        if ratio > 1 + threshold:
+            status = "  REGRESSION"
+            n_regressions += 1
+        elif ratio < 1 - threshold:
+            status = "  improved"
+        else:
+            status = ""
+        print("%-60s %12.4g %12.4g %8.3f%s" % (label,
+                                               baseline[key]["time_min"],
+                                               current[key]["time_min"],
+                                               ratio, status))
+
+    for key in sorted(set(baseline) - set(current)):
+        print("%-60s: missing in current results" % ("%s/%s (%s)" % key))
+
+    if n_regressions > 0:
+        print("\n%d kernel(s) slower by more than %g%%"
+              % (n_regressions, 100 * threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
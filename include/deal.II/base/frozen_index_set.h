@@ -0,0 +1,405 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_frozen_index_set_h
+#define dealii_frozen_index_set_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/index_set.h>
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * An immutable copy of an IndexSet that is optimized for answering many
+ * queries of the kind "is this index an element of the set" and "what is the
+ * position of this index within the set", for example when setting up the
+ * ghost exchange of a Utilities::MPI::Partitioner or when filtering
+ * constraints with AffineConstraints::add_selected_constraints().
+ *
+ * In contrast to IndexSet, which stores a sorted list of ranges and needs to
+ * be compressed before it can be queried, an object of this class is set up
+ * once from a compressed IndexSet and is never changed afterwards. All query
+ * functions are therefore free of locks and can be called from several
+ * threads concurrently.
+ *
+ * <h3>Representation</h3>
+ *
+ * The class picks one of two representations when it is created:
+ * - If the set consists of only a few contiguous ranges, as is typical for
+ *   the locally owned indices, it stores the ranges, and queries use a
+ *   binary search in them.
+ * - Otherwise, e.g., for the locally relevant indices on adaptively refined
+ *   meshes in 3d, the index space is split into chunks of $2^{16}$ indices,
+ *   and the elements of each non-empty chunk are stored in whichever of the
+ *   following containers needs the least memory: a sorted array of 16-bit
+ *   offsets for sparse chunks, a bitmap with precomputed partial counts for
+ *   dense chunks, or a list of runs for chunks that consist of a few
+ *   contiguous ranges. This is the scheme of "roaring bitmaps", see S.
+ *   Chambi, D. Lemire, O. Kaser, R. Godin: "Better bitmap performance with
+ *   Roaring bitmaps", Software: Practice and Experience 46 (2016). Querying a
+ *   bitmap chunk takes constant time, independent of how fragmented the set
+ *   is.
+ *
+ * The functions that take arrays of indices are faster than calling the
+ * functions for a single index in a loop if the indices are sorted, or at
+ * least mostly sorted, because they start the search for the next index at
+ * the position of the previous one.
+ *
+ * @ingroup data
+ */
+class FrozenIndexSet
+{
+public:
+  /**
+   * The type of the indices, the same as for IndexSet.
+   */
+  using size_type = IndexSet::size_type;
+
+  /**
+   * The possible representations of the set, see the general documentation
+   * of this class.
+   */
+  enum class Representation
+  {
+    /**
+     * A sorted list of contiguous ranges.
+     */
+    ranges,
+
+    /**
+     * A list of chunks of $2^{16}$ indices, each stored as an array, a
+     * bitmap, or a list of runs.
+     */
+    chunks
+  };
+
+  /**
+   * Default constructor. Create an empty set of size zero.
+   */
+  FrozenIndexSet();
+
+  /**
+   * Constructor. Create a copy of @p index_set, which needs to be
+   * compressed.
+   */
+  explicit FrozenIndexSet(const IndexSet &index_set);
+
+  /**
+   * Replace the stored set by a copy of @p index_set, which needs to be
+   * compressed.
+   */
+  void
+  reinit(const IndexSet &index_set);
+
+  /**
+   * Return the size of the index space of which this set is a subset.
+   */
+  size_type
+  size() const;
+
+  /**
+   * Return the number of elements of this set.
+   */
+  size_type
+  n_elements() const;
+
+  /**
+   * Return the representation that was chosen for this set.
+   */
+  Representation
+  get_representation() const;
+
+  /**
+   * Return whether @p index is an element of this set.
+   */
+  bool
+  is_element(const size_type index) const;
+
+  /**
+   * Return the position of @p global_index within this set, i.e., the
+   * number of elements of the set that are smaller than @p global_index, or
+   * numbers::invalid_dof_index if @p global_index is not an element of the
+   * set. This is the same as IndexSet::index_within_set().
+   */
+  size_type
+  index_within_set(const size_type global_index) const;
+
+  /**
+   * Return the element with the given position within the set, the inverse
+   * of index_within_set(). This is the same as IndexSet::nth_index_in_set().
+   */
+  size_type
+  nth_index_in_set(const size_type local_index) const;
+
+  /**
+   * Compute index_within_set() for all elements of @p global_indices and
+   * write the results to @p local_indices, which needs to have the same size.
+   * Indices that are not elements of the set are given the position
+   * numbers::invalid_dof_index.
+   */
+  void
+  index_within_set(const ArrayView<const size_type> &global_indices,
+                   const ArrayView<size_type> &      local_indices) const;
+
+  /**
+   * Return the number of elements of @p indices that are elements of this
+   * set.
+   */
+  size_type
+  n_elements_in_set(const ArrayView<const size_type> &indices) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The number of bits of an index that determine its position within a
+   * chunk.
+   */
+  static constexpr unsigned int chunk_bits = 16;
+
+  /**
+   * The number of 64-bit words of the bitmap of a chunk.
+   */
+  static constexpr unsigned int n_bitmap_words = (1U << chunk_bits) / 64;
+
+  /**
+   * The containers used to store the elements of a chunk.
+   */
+  enum class ContainerType : unsigned char
+  {
+    array,
+    bitmap,
+    runs
+  };
+
+  /**
+   * Description of a non-empty chunk. The elements are stored in the array
+   * of the respective container type, starting at @p offset.
+   */
+  struct Chunk
+  {
+    /**
+     * The number of elements of the set in all previous chunks.
+     */
+    size_type n_elements_before;
+
+    /**
+     * The number of elements of the set in this chunk.
+     */
+    unsigned int n_elements;
+
+    /**
+     * The first entry of this chunk in array_data (for arrays), in
+     * bitmap_words and bitmap_counts (for bitmaps), or in run_counts (for
+     * runs).
+     */
+    std::size_t offset;
+
+    /**
+     * The number of entries of this chunk in array_data or of runs in
+     * run_counts. Unused for bitmaps.
+     */
+    unsigned int n_entries;
+
+    ContainerType type;
+  };
+
+  /**
+   * Return the position of @p index within the set, or
+   * numbers::invalid_dof_index, for the ranges and the chunks
+   * representation, respectively. @p hint is the index of the range or chunk
+   * to start the search from, and is set to the range or chunk that contains
+   * @p index or next to which it lies, so that a subsequent search for a
+   * nearby index is fast.
+   */
+  size_type
+  find_in_ranges(const size_type index, unsigned int &hint) const;
+
+  size_type
+  find_in_chunks(const size_type index, unsigned int &hint) const;
+
+  /**
+   * Return the position of the element with offset @p offset within the
+   * chunk @p chunk relative to the start of the chunk, or
+   * numbers::invalid_dof_index.
+   */
+  size_type
+  find_in_chunk(const Chunk &chunk, const unsigned int offset) const;
+
+  size_type    index_space_size;
+  size_type    n_elements_in_set_data;
+  Representation representation;
+
+  /**
+   * The ranges [range_begins[i], range_ends[i]) and the number of elements
+   * before each of them, for the ranges representation.
+   */
+  std::vector<size_type> range_begins;
+  std::vector<size_type> range_ends;
+  std::vector<size_type> range_n_elements_before;
+
+  /**
+   * The index of the largest range, which is checked first.
+   */
+  unsigned int largest_range;
+
+  /**
+   * The keys (i.e., the index divided by the chunk size) of the non-empty
+   * chunks and their descriptions, for the chunks representation.
+   */
+  std::vector<size_type> chunk_keys;
+  std::vector<Chunk>     chunks;
+
+  /**
+   * The offsets within their chunk of the elements of all array chunks.
+   */
+  std::vector<std::uint16_t> array_data;
+
+  /**
+   * The bitmaps of all bitmap chunks, and for each 64-bit word of a bitmap
+   * the number of elements in the previous words of the same chunk.
+   */
+  std::vector<std::uint64_t> bitmap_words;
+  std::vector<std::uint16_t> bitmap_counts;
+
+  /**
+   * The runs [run_data[2i], run_data[2i+1]) of all run chunks relative to
+   * the start of their chunk, and the number of elements before each run
+   * within the same chunk.
+   */
+  std::vector<std::uint32_t> run_data;
+  std::vector<std::uint32_t> run_counts;
+};
+
+
+
+/* ------------------------- inline functions ------------------------- */
+
+
+inline FrozenIndexSet::size_type
+FrozenIndexSet::size() const
+{
+  return index_space_size;
+}
+
+
+
+inline FrozenIndexSet::size_type
+FrozenIndexSet::n_elements() const
+{
+  return n_elements_in_set_data;
+}
+
+
+
+inline FrozenIndexSet::Representation
+FrozenIndexSet::get_representation() const
+{
+  return representation;
+}
+
+
+
+inline bool
+FrozenIndexSet::is_element(const size_type index) const
+{
+  return index_within_set(index) != numbers::invalid_dof_index;
+}
+
+
+
+inline FrozenIndexSet::size_type
+FrozenIndexSet::index_within_set(const size_type global_index) const
+{
+  AssertIndexRange(global_index, size());
+  unsigned int hint = 0;
+  if (representation == Representation::ranges)
+    {
+      hint = largest_range;
+      return find_in_ranges(global_index, hint);
+    }
+  else
+    return find_in_chunks(global_index, hint);
+}
+
+
+
+inline FrozenIndexSet::size_type
+FrozenIndexSet::find_in_chunk(const Chunk &chunk,
+                              const unsigned int offset) const
+{
+  switch (chunk.type)
+    {
+      case ContainerType::array:
+        {
+          const std::uint16_t *begin = array_data.data() + chunk.offset;
+          const std::uint16_t *end   = begin + chunk.n_entries;
+          const std::uint16_t *p     = std::lower_bound(begin, end, offset);
+          if (p == end || *p != offset)
+            return numbers::invalid_dof_index;
+          return p - begin;
+        }
+
+      case ContainerType::bitmap:
+        {
+          const unsigned int  word_index = offset / 64;
+          const std::uint64_t word =
+            bitmap_words[chunk.offset + word_index];
+          const std::uint64_t bit = std::uint64_t(1) << (offset % 64);
+          if ((word & bit) == 0)
+            return numbers::invalid_dof_index;
+          return bitmap_counts[chunk.offset + word_index] +
+                 std::bitset<64>(word & (bit - 1)).count();
+        }
+
+      case ContainerType::runs:
+        {
+          // find the last run that starts at or before the given offset
+          const std::uint32_t *runs = run_data.data() + 2 * chunk.offset;
+          unsigned int         low = 0, high = chunk.n_entries;
+          while (high - low > 1)
+            {
+              const unsigned int mid = (low + high) / 2;
+              if (runs[2 * mid] <= offset)
+                low = mid;
+              else
+                high = mid;
+            }
+          if (offset < runs[2 * low] || offset >= runs[2 * low + 1])
+            return numbers::invalid_dof_index;
+          return run_counts[chunk.offset + low] + (offset - runs[2 * low]);
+        }
+
+      default:
+        Assert(false, ExcInternalError());
+        return numbers::invalid_dof_index;
+    }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
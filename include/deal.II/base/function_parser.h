@@ -40,6 +40,14 @@ DEAL_II_NAMESPACE_OPEN
 template <typename>
 class Vector;
 
+namespace internal
+{
+  namespace FunctionParserImplementation
+  {
+    class Bytecode;
+  }
+} // namespace internal
+
 
 /**
  * This class implements a function object that gets its value by parsing a
@@ -190,6 +198,31 @@ class Vector;
  *                        constants);
  * @endcode
  *
+ * <h3>Evaluation of many points</h3>
+ *
+ * By default, every evaluation goes through a muparser object, of which
+ * each thread keeps its own copy, and the point is passed to it by setting
+ * its variables one point at a time. This is slow if a function is
+ * evaluated at many points, as in VectorTools::interpolate_boundary_values()
+ * or when assembling with a coefficient given in an input file.
+ *
+ * After calling set_evaluation_mode() with EvaluationMode::bytecode, the
+ * class instead compiles each expression once into a simple program for a
+ * stack machine. This program does not depend on any state that changes
+ * during the evaluation, so it can be used by all threads at the same time.
+ * value_list() and vector_value_list() run it for
+ * VectorizedArray<double>::n_array_elements points at once, using the
+ * vectorized arithmetic of VectorizedArray. value(), vector_value(), and the
+ * gradients computed by finite differences also use it.
+ *
+ * The expressions are still checked by muparser, so that errors are reported
+ * in the same way in both modes, and the results agree up to round-off. The
+ * bytecode supports all operators and functions listed above except
+ * <tt>rand()</tt> and <tt>rand_seed()</tt>, whose results depend on the
+ * order of the calls. If an expression uses one of them, or syntax the
+ * compiler does not know, the class keeps using muparser for this
+ * expression; uses_bytecode() tells whether this happened.
+ *
  *
  * @ingroup functions
  * @author Luca Heltai, Timo Heister 2005, 2014
@@ -234,6 +267,25 @@ public:
    */
   using ConstMap = std::map<std::string, double>;
 
+  /**
+   * The ways in which the expressions can be evaluated, see the general
+   * documentation of this class.
+   */
+  enum class EvaluationMode
+  {
+    /**
+     * Evaluate the expressions with a muparser object for each thread, one
+     * point at a time. This is the default.
+     */
+    muparser,
+
+    /**
+     * Evaluate the expressions with a program compiled once from them, for
+     * several points at a time.
+     */
+    bytecode
+  };
+
   /**
    * Iterator for the constants map. Used by the initialize() method.
    */
@@ -300,6 +352,29 @@ public:
   static std::string
   default_variable_names();
 
+  /**
+   * Select how the expressions are evaluated. This function can be called
+   * before or after initialize(), but not while other threads evaluate the
+   * function. The expressions are compiled for EvaluationMode::bytecode only
+   * once that mode is selected, so the default mode does not pay for it.
+   */
+  void
+  set_evaluation_mode(const EvaluationMode mode);
+
+  /**
+   * Return the mode selected by set_evaluation_mode().
+   */
+  EvaluationMode
+  get_evaluation_mode() const;
+
+  /**
+   * Return whether the evaluation mode is EvaluationMode::bytecode and all
+   * expressions given to initialize() could be compiled, i.e., whether
+   * evaluations of this function do not use muparser at all.
+   */
+  bool
+  uses_bytecode() const;
+
   /**
    * Return the value of the function at the given point. Unless there is only
    * one component (i.e. the function is scalar), you should state the
@@ -318,6 +393,25 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<double> &values) const override;
 
+  /**
+   * Set <tt>values</tt> to the point values of the specified component of
+   * the function at the <tt>points</tt>. In the bytecode evaluation mode,
+   * several points are evaluated at once.
+   */
+  virtual void
+  value_list(const std::vector<Point<dim>> &points,
+             std::vector<double> &          values,
+             const unsigned int             component = 0) const override;
+
+  /**
+   * Set <tt>values</tt> to the point values of all components of the
+   * function at the <tt>points</tt>. In the bytecode evaluation mode,
+   * several points are evaluated at once.
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>> &  values) const override;
+
   /**
    * @addtogroup Exceptions
    * @{
@@ -378,6 +472,15 @@ private:
    */
   std::vector<std::string> expressions;
 
+  /**
+   * The compiled expressions (one per component), for the bytecode
+   * evaluation mode. An entry is a null pointer if the expression could not
+   * be compiled.
+   */
+  std::vector<
+    std::unique_ptr<const internal::FunctionParserImplementation::Bytecode>>
+    bytecode;
+
   /**
    * Initialize fp and vars on the current thread. This function may only be
    * called once per thread. A thread can test whether the function has
@@ -386,8 +489,21 @@ private:
    */
   void
   init_muparser() const;
+
+  /**
+   * Compile the expressions into #bytecode. This happens in initialize() or
+   * set_evaluation_mode(), whichever is called last with
+   * EvaluationMode::bytecode selected.
+   */
+  void
+  init_bytecode();
 #endif
 
+  /**
+   * The mode selected by set_evaluation_mode().
+   */
+  EvaluationMode evaluation_mode;
+
   /**
    * State of usability. This variable is checked every time the function is
    * called for evaluation. It's set to true in the initialize() methods.
@@ -405,6 +521,15 @@ private:
 };
 
 
+template <int dim>
+inline typename FunctionParser<dim>::EvaluationMode
+FunctionParser<dim>::get_evaluation_mode() const
+{
+  return evaluation_mode;
+}
+
+
+
 template <int dim>
 std::string
 FunctionParser<dim>::default_variable_names()
@@ -0,0 +1,328 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_instrumentation_h
+#define dealii_instrumentation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/thread_management.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ostream>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declaration
+class TimerOutput;
+
+/**
+ * A namespace for a lightweight layer that reports the time spent in named
+ * regions of the library, e.g., DoFHandler::distribute_dofs(),
+ * AffineConstraints::close(), MatrixFree::reinit(), the ghost exchange of
+ * Utilities::MPI::Partitioner, DataOut::build_patches(), the functions of
+ * SolutionTransfer, or the calls into p4est made by
+ * parallel::distributed::Triangulation.
+ *
+ * Regions are marked in the library with the DEAL_II_INSTRUMENT_REGION
+ * macro. Whenever a region is entered or left, the Sink object attached with
+ * attach_sink() is notified. Without an attached sink, a region costs one
+ * atomic load and a branch, so the layer can be left on in production runs.
+ * If deal.II is configured with <code>DEAL_II_WITH_INSTRUMENTATION=OFF</code>,
+ * the macro expands to nothing and all regions are compiled out.
+ *
+ * A typical use reports the regions as part of the call tree of a
+ * TimerOutput object:
+ * @code
+ *   TimerOutput timer(std::cout, TimerOutput::never, TimerOutput::wall_times);
+ *   Instrumentation::TimerOutputSink sink(timer);
+ *   Instrumentation::attach_sink(sink);
+ *
+ *   {
+ *     TimerOutput::Scope t(timer, "Setup");
+ *     dof_handler.distribute_dofs(fe);
+ *     constraints.close();
+ *   }
+ *   ...
+ *   Instrumentation::detach_sink();
+ *   timer.print_call_tree();
+ * @endcode
+ * Here, the "DoFHandler::distribute_dofs" and "AffineConstraints::close"
+ * regions are listed below the "Setup" section.
+ *
+ * @ingroup utilities
+ */
+namespace Instrumentation
+{
+  /**
+   * The interface of objects that receive the events of the instrumented
+   * regions. The functions of this class may be called concurrently from
+   * several threads, and regions entered on one thread are left on the same
+   * thread in reverse order.
+   */
+  class Sink
+  {
+  public:
+    /**
+     * Destructor.
+     */
+    virtual ~Sink() = default;
+
+    /**
+     * Called when the region @p name is entered.
+     */
+    virtual void
+    enter_region(const char *name) = 0;
+
+    /**
+     * Called when the region @p name is left, after it took a wall time of
+     * @p wall_time seconds.
+     */
+    virtual void
+    leave_region(const char *name, const double wall_time) = 0;
+  };
+
+
+
+  /**
+   * A sink that enters a thread section of a TimerOutput object for every
+   * region, using TimerOutput::enter_thread_subsection(), so that the
+   * regions appear in the call tree and in the timeline of that object.
+   */
+  class TimerOutputSink : public Sink
+  {
+  public:
+    /**
+     * Constructor. The @p timer object needs to live at least as long as
+     * this object.
+     */
+    explicit TimerOutputSink(TimerOutput &timer);
+
+    virtual void
+    enter_region(const char *name) override;
+
+    virtual void
+    leave_region(const char *name, const double wall_time) override;
+
+  private:
+    /**
+     * The timer to which the regions are reported.
+     */
+    TimerOutput &timer;
+  };
+
+
+
+  /**
+   * A sink that calls a user-provided function with the name and the wall
+   * time of every region that is left. The function may be called
+   * concurrently from several threads.
+   */
+  class CallbackSink : public Sink
+  {
+  public:
+    /**
+     * Constructor.
+     */
+    explicit CallbackSink(
+      const std::function<void(const char *name, const double wall_time)>
+        &callback);
+
+    virtual void
+    enter_region(const char *name) override;
+
+    virtual void
+    leave_region(const char *name, const double wall_time) override;
+
+  private:
+    /**
+     * The function to call.
+     */
+    const std::function<void(const char *, const double)> callback;
+  };
+
+
+
+  /**
+   * A sink that writes one line with the name and the wall time (in seconds)
+   * of every region that is left to a stream, e.g., a std::ofstream. Lines
+   * written from different threads are not interleaved.
+   */
+  class StreamSink : public Sink
+  {
+  public:
+    /**
+     * Constructor. The @p out stream needs to live at least as long as this
+     * object.
+     */
+    explicit StreamSink(std::ostream &out);
+
+    virtual void
+    enter_region(const char *name) override;
+
+    virtual void
+    leave_region(const char *name, const double wall_time) override;
+
+  private:
+    /**
+     * The stream to write to.
+     */
+    std::ostream &out;
+
+    /**
+     * A lock that serializes the output of several threads.
+     */
+    Threads::Mutex mutex;
+  };
+
+
+
+  /**
+   * Attach @p sink, replacing the sink attached previously, if any. The
+   * sink needs to live until it is detached again. This function should only
+   * be called while no instrumented region is active on any thread.
+   */
+  void
+  attach_sink(Sink &sink);
+
+  /**
+   * Detach the current sink, if any. Regions that are entered afterwards
+   * are not reported anymore.
+   */
+  void
+  detach_sink();
+
+  /**
+   * Return the currently attached sink, or a null pointer.
+   */
+  Sink *
+  get_sink();
+
+
+
+  namespace internal
+  {
+    /**
+     * The sink attached with attach_sink().
+     */
+    extern std::atomic<Sink *> current_sink;
+  } // namespace internal
+
+
+
+  /**
+   * An object that marks a region from its construction to its destruction.
+   * Instead of using this class directly, use the DEAL_II_INSTRUMENT_REGION
+   * macro, which is compiled out if deal.II is configured without
+   * instrumentation.
+   */
+  class Region
+  {
+  public:
+    /**
+     * Enter the region @p name, which needs to be a string that lives at
+     * least as long as this object, typically a string literal.
+     */
+    explicit Region(const char *name);
+
+    /**
+     * Leave the region.
+     */
+    ~Region();
+
+  private:
+    /**
+     * The name of the region.
+     */
+    const char *name;
+
+    /**
+     * The sink the region was entered on, or a null pointer if no sink was
+     * attached at construction.
+     */
+    Sink *sink;
+
+    /**
+     * The time at which the region was entered.
+     */
+    std::chrono::steady_clock::time_point start_time;
+  };
+
+
+
+  /* ------------------------- inline functions ------------------------- */
+
+
+  inline Region::Region(const char *name)
+    : name(name)
+    , sink(internal::current_sink.load(std::memory_order_acquire))
+  {
+    if (sink != nullptr)
+      {
+        sink->enter_region(name);
+        start_time = std::chrono::steady_clock::now();
+      }
+  }
+
+
+
+  inline Region::~Region()
+  {
+    if (sink != nullptr)
+      {
+        const double wall_time =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        start_time)
+            .count();
+        try
+          {
+            sink->leave_region(name, wall_time);
+          }
+        catch (...)
+          {}
+      }
+  }
+} // namespace Instrumentation
+
+DEAL_II_NAMESPACE_CLOSE
+
+
+/**
+ * Mark the rest of the enclosing block as the instrumented region @p name,
+ * see the Instrumentation namespace. If deal.II is configured without
+ * instrumentation, this macro expands to nothing.
+ *
+ * @ingroup utilities
+ */
+#ifdef DEAL_II_WITH_INSTRUMENTATION
+#  define DEAL_II_INSTRUMENT_REGION(name)                                 \
+    const dealii::Instrumentation::Region DEAL_II_INSTRUMENT_REGION_NAME( \
+      __LINE__)(name)
+#  define DEAL_II_INSTRUMENT_REGION_NAME(line) \
+    DEAL_II_INSTRUMENT_REGION_NAME_IMPL(line)
+#  define DEAL_II_INSTRUMENT_REGION_NAME_IMPL(line) \
+    dealii_instrumentation_region_##line
+#else
+#  define DEAL_II_INSTRUMENT_REGION(name) \
+    do                                    \
+      {                                   \
+      }                                   \
+    while (false)
+#endif
+
+#endif
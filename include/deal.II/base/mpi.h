@@ -433,6 +433,17 @@ namespace Utilities
     MinMaxAvg
     min_max_avg(const double my_value, const MPI_Comm &mpi_communicator);
 
+    /**
+     * Same as above, but compute sum, average, minimum, maximum, and the
+     * processor ids of minimum and maximum for each of the values in
+     * @p my_values with a single collective operation. All processors need to
+     * pass the same number of values, and the i-th entry of the result
+     * belongs to the i-th value.
+     */
+    std::vector<MinMaxAvg>
+    min_max_avg(const std::vector<double> &my_values,
+                const MPI_Comm &           mpi_communicator);
+
     /**
      * A class that is used to initialize the MPI system at the beginning of a
      * program and to shut it down again at the end. It also allows you to
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/partitioner.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
@@ -44,6 +45,8 @@ namespace Utilities
       const ArrayView<Number> &      ghost_array,
       std::vector<MPI_Request> &     requests) const
     {
+      DEAL_II_INSTRUMENT_REGION("Partitioner::export_to_ghosted_array_start");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -133,6 +136,8 @@ namespace Utilities
       const ArrayView<Number> & ghost_array,
       std::vector<MPI_Request> &requests) const
     {
+      DEAL_II_INSTRUMENT_REGION("Partitioner::export_to_ghosted_array_finish");
+
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
              ExcGhostIndexArrayHasWrongSize(ghost_array.size(),
@@ -189,6 +194,8 @@ namespace Utilities
       const ArrayView<Number> &     temporary_storage,
       std::vector<MPI_Request> &    requests) const
     {
+      DEAL_II_INSTRUMENT_REGION("Partitioner::import_from_ghosted_array_start");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -379,6 +386,9 @@ namespace Utilities
       const ArrayView<Number> &      ghost_array,
       std::vector<MPI_Request> &     requests) const
     {
+      DEAL_II_INSTRUMENT_REGION(
+        "Partitioner::import_from_ghosted_array_finish");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
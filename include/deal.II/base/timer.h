@@ -20,13 +20,17 @@
 
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
+#include <atomic>
 #include <chrono>
 #include <list>
 #include <map>
 #include <string>
+#include <tuple>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -574,6 +578,53 @@ private:
  * sure that we only generate output on a single processor. See the step-32,
  * step-40, and step-42 tutorial programs for this kind of usage of this class.
  *
+ *
+ * <h3>Nested sections and sections timed on several threads</h3>
+ *
+ * Besides the flat list of sections printed by print_summary(), this class
+ * records a call tree: a section entered while another one is active is
+ * stored as a child of the innermost active section, so the same section
+ * name can appear at several places of the tree. The tree is printed by
+ * print_call_tree() and returned by get_call_tree_data(). If the object was
+ * constructed with an MPI communicator, both functions report the minimum,
+ * average, and maximum wall time of every node of the tree over all
+ * processes, including nodes that only exist on some of the processes.
+ *
+ * enter_subsection() and leave_subsection() serialize all calls through a
+ * mutex and keep one list of active sections for all threads, so they are
+ * not suitable for timing work done in tasks, e.g., in the worker functions
+ * of WorkStream::run() or the cell loop of MatrixFree. For this purpose, use
+ * enter_thread_subsection() and leave_thread_subsection(), or the scoped
+ * variant ThreadScope:
+ * @code
+ *   TimerOutput::Scope t(timer, "Assemble");
+ *   WorkStream::run(..., [&](...) {
+ *       TimerOutput::ThreadScope t(timer, "Local integrals");
+ *       ...
+ *     }, ...);
+ * @endcode
+ * These functions accumulate into data owned by the calling thread and do not
+ * take any lock. Thread sections can be nested in each other, and the
+ * outermost one is put below the section that was most recently entered by
+ * enter_subsection() and is still active, so the "Local integrals" section
+ * above shows up as a child of "Assemble" in the call tree. Times of thread
+ * sections are wall times summed over all threads, so the time of a thread
+ * section may exceed the one of its parent. Thread sections only appear in
+ * the call tree and in timelines, not in the flat summary. All thread
+ * sections must have been left before any of the functions that report
+ * results, or reset(), is called.
+ *
+ *
+ * <h3>Timelines</h3>
+ *
+ * After a call to enable_trace_recording(), every call of a section is
+ * additionally recorded with its start time, its duration, the process, and
+ * the thread it ran on. write_chrome_trace() writes these events in the
+ * Chrome trace event format, which can be inspected as a timeline, e.g., by
+ * opening <code>chrome://tracing</code> in the Chromium browser or with the
+ * Perfetto UI. Since every call creates an event, recording should only be
+ * enabled for runs of limited length.
+ *
  * @ingroup utilities
  * @author M. Kronbichler, 2009.
  */
@@ -623,6 +674,65 @@ public:
     bool in;
   };
 
+  /**
+   * Helper class to enter/exit sections on the calling thread by constructing
+   * a scope-based object, like Scope does for enter_subsection() and
+   * leave_subsection(). See the documentation of TimerOutput for the
+   * difference between the two kinds of sections.
+   */
+  class ThreadScope
+  {
+  public:
+    /**
+     * Enter the given thread section of the timer. Exit automatically when
+     * calling stop() or when the destructor runs.
+     */
+    ThreadScope(dealii::TimerOutput &timer_, const std::string &section_name);
+
+    /**
+     * Destructor calls stop().
+     */
+    ~ThreadScope();
+
+    /**
+     * In case you want to exit the scope before the destructor is executed,
+     * call this function.
+     */
+    void
+    stop();
+
+  private:
+    /**
+     * Reference to the TimerOutput object
+     */
+    dealii::TimerOutput &timer;
+
+    /**
+     * Do we still need to exit the section we are in?
+     */
+    bool in;
+  };
+
+  /**
+   * The data collected for one node of the call tree by
+   * get_call_tree_data().
+   */
+  struct CallTreeData
+  {
+    /**
+     * The number of times the section was entered at this place of the call
+     * tree on the present process, summed over all threads.
+     */
+    unsigned int n_calls;
+
+    /**
+     * The wall time spent in the section at this place of the call tree,
+     * summed over all threads, and its minimum, average, and maximum over
+     * the processes of the MPI communicator given to the constructor.
+     */
+    Utilities::MPI::MinMaxAvg wall_time;
+  };
+
   /**
    * An enumeration data type that describes whether to generate output every
    * time we exit a section, just in the end, both, or never.
@@ -810,6 +920,21 @@ public:
   void
   exit_section(const std::string &section_name = std::string());
 
+  /**
+   * Open a section on the calling thread. In contrast to enter_subsection(),
+   * this function does not take a lock and keeps separate lists of active
+   * sections and separate timing data for each thread. See the documentation
+   * of this class for how these sections are placed in the call tree.
+   */
+  void
+  enter_thread_subsection(const std::string &section_name);
+
+  /**
+   * Leave the thread section that was entered last on the calling thread.
+   */
+  void
+  leave_thread_subsection();
+
   /**
    * Get a map with the collected data of the specified type for each subsection
    */
@@ -823,6 +948,61 @@ public:
   void
   print_summary() const;
 
+  /**
+   * Return the call tree of all sections. The key of each node is the list of
+   * section names from the outermost section to the node itself.
+   *
+   * If the object was constructed with an MPI communicator, this function
+   * needs to be called on all processes of the communicator, and the
+   * returned tree contains the nodes of all processes. Nodes that do not
+   * exist on the present process have zero calls and contribute a time of
+   * zero to the minimum and average.
+   */
+  std::map<std::vector<std::string>, CallTreeData>
+  get_call_tree_data() const;
+
+  /**
+   * Print a formatted table with the wall times of the call tree returned by
+   * get_call_tree_data(), with the sections indented according to their
+   * depth in the tree. For every node, the share of the time of its parent
+   * (or, for the outermost sections, of the total time) is listed. If the
+   * communicator given to the constructor has more than one process, the
+   * minimum, average, and maximum over all processes are printed, and the
+   * share is computed from the averages.
+   *
+   * Like get_call_tree_data(), this function needs to be called on all
+   * processes of the communicator.
+   */
+  void
+  print_call_tree() const;
+
+  /**
+   * Start recording one event for every subsequent call to a section, to be
+   * written by write_chrome_trace().
+   */
+  void
+  enable_trace_recording();
+
+  /**
+   * Stop recording events. Events recorded so far are kept.
+   */
+  void
+  disable_trace_recording();
+
+  /**
+   * Write all recorded events to @p out in the Chrome trace event (JSON)
+   * format. Each MPI process is shown as a separate process of the timeline,
+   * and its threads as threads, where thread zero collects the sections
+   * entered by enter_subsection(). Times are measured from the construction
+   * of this object or the last call to reset() on each process.
+   *
+   * If the object was constructed with an MPI communicator, this function
+   * needs to be called on all processes of the communicator, and only the
+   * first process writes to @p out.
+   */
+  void
+  write_chrome_trace(std::ostream &out) const;
+
   /**
    * By calling this function, all output can be disabled. This function
    * together with enable_output() can be useful if one wants to control the
@@ -910,7 +1090,129 @@ private:
    * A lock that makes sure that this class gives reasonable results even when
    * used with several threads.
    */
-  Threads::Mutex mutex;
+  mutable Threads::Mutex mutex;
+
+  /**
+   * An event of the timeline written by write_chrome_trace(): the index of a
+   * node (of the call tree for sections entered by enter_subsection(), or of
+   * the list of thread-local nodes otherwise), and the start and duration of
+   * the call in seconds.
+   */
+  struct TraceEvent
+  {
+    unsigned int node;
+    double       start;
+    double       duration;
+  };
+
+  /**
+   * A node of the call tree of the sections entered by enter_subsection().
+   * The node with index zero is the root of the tree with an empty path.
+   */
+  struct CallTreeNode
+  {
+    std::vector<std::string> path;
+    double                   total_wall_time;
+    unsigned int             n_calls;
+  };
+
+  /**
+   * The nodes of the call tree of the sections entered by
+   * enter_subsection(), and a map from the index of the parent and the name
+   * of a section to the index of the child node.
+   */
+  std::vector<CallTreeNode> call_tree;
+  std::map<std::pair<unsigned int, std::string>, unsigned int>
+    call_tree_children;
+
+  /**
+   * For each active section, the index of its node in the call tree and the
+   * time at which it was entered.
+   */
+  std::map<std::string,
+           std::pair<unsigned int, std::chrono::steady_clock::time_point>>
+    active_call_tree_nodes;
+
+  /**
+   * The node of the call tree of the section most recently entered by
+   * enter_subsection() that is still active, or zero. This is the parent of
+   * the outermost thread sections. It is read by enter_thread_subsection()
+   * without taking the lock.
+   */
+  std::atomic<unsigned int> innermost_active_node;
+
+  /**
+   * The events recorded for the sections entered by enter_subsection().
+   */
+  std::vector<TraceEvent> trace_events;
+
+  /**
+   * Whether to record events.
+   */
+  std::atomic<bool> trace_recording_is_enabled;
+
+  /**
+   * The time from which the start times of events are measured.
+   */
+  std::chrono::steady_clock::time_point reference_time;
+
+  /**
+   * The data of the thread sections collected on one thread. Each distinct
+   * place of a section in the call tree of the thread is a node, stored
+   * with the node of the global call tree below which the outermost
+   * section was entered, the index of its parent node (or
+   * numbers::invalid_unsigned_int for the outermost sections), and its
+   * name.
+   */
+  struct ThreadData
+  {
+    struct Node
+    {
+      unsigned int tree_parent;
+      unsigned int parent;
+      std::string  name;
+      double       total_wall_time;
+      unsigned int n_calls;
+    };
+
+    ThreadData();
+
+    unsigned int thread_index;
+
+    std::vector<Node> nodes;
+
+    std::map<std::tuple<unsigned int, unsigned int, std::string>, unsigned int>
+      node_indices;
+
+    std::vector<std::pair<unsigned int, std::chrono::steady_clock::time_point>>
+      active_nodes;
+
+    std::vector<TraceEvent> trace_events;
+  };
+
+  /**
+   * The thread section data of all threads that have entered a thread
+   * section.
+   */
+  mutable Threads::ThreadLocalStorage<ThreadData> thread_data;
+
+  /**
+   * The number of threads that have entered a thread section, used to
+   * enumerate them in the timeline.
+   */
+  std::atomic<unsigned int> n_threads;
+
+  /**
+   * Return the data of the thread sections of all threads.
+   */
+  std::vector<const ThreadData *>
+  collect_thread_data() const;
+
+  /**
+   * Reset the call tree to its root node and forget all active sections.
+   */
+  void
+  reset_call_tree();
 };
 
 
@@ -1037,6 +1339,28 @@ TimerOutput::Scope::stop()
 }
 
 
+
+inline TimerOutput::ThreadScope::ThreadScope(dealii::TimerOutput &timer_,
+                                             const std::string &section_name)
+  : timer(timer_)
+  , in(true)
+{
+  timer.enter_thread_subsection(section_name);
+}
+
+
+
+inline void
+TimerOutput::ThreadScope::stop()
+{
+  if (!in)
+    return;
+  in = false;
+
+  timer.leave_thread_subsection();
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -20,6 +20,8 @@
 
 #include <deal.II/base/exceptions.h>
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -52,6 +54,9 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declare Point
+template <int dim, typename Number>
+class Point;
 
 /**
  * A namespace for utility functions that are not particularly specific to
@@ -422,6 +427,47 @@ namespace Utilities
   std::vector<unsigned long long int>
   invert_permutation(const std::vector<unsigned long long int> &permutation);
 
+  /**
+   * Given a vector of @p dim dimensional integer coordinates with @p
+   * bits_per_dim significant bits each, return their position along the
+   * Hilbert space-filling curve in transposed form: bit $b$ of entry $d$ of
+   * the result is bit number $b\cdot\text{dim} + (\text{dim}-1-d)$ of the
+   * index along the curve. Use pack_integers() to obtain a single integer
+   * that can be used for sorting.
+   *
+   * The implementation follows J. Skilling, Programming the Hilbert curve,
+   * AIP Conf. Proc. 707, 381 (2004).
+   */
+  template <int dim>
+  std::vector<std::array<std::uint64_t, dim>>
+  inverse_Hilbert_space_filling_curve(
+    const std::vector<std::array<std::uint64_t, dim>> &integer_coords,
+    const int                                          bits_per_dim = 64);
+
+  /**
+   * Same as above, but for points in real space. The points are first scaled
+   * to integer coordinates with @p bits_per_dim bits within their bounding
+   * box.
+   */
+  template <int dim, typename Number>
+  std::vector<std::array<std::uint64_t, dim>>
+  inverse_Hilbert_space_filling_curve(
+    const std::vector<Point<dim, Number>> &points,
+    const int                              bits_per_dim = 64);
+
+  /**
+   * Pack the least significant @p bits_per_dim bits of the @p dim entries of
+   * @p index into a single integer by interleaving their bits, starting with
+   * the most significant bit of the first entry. Applied to the result of
+   * inverse_Hilbert_space_filling_curve(), this gives the index along the
+   * Hilbert curve. The product of @p dim and @p bits_per_dim must not exceed
+   * 64.
+   */
+  template <int dim>
+  std::uint64_t
+  pack_integers(const std::array<std::uint64_t, dim> &index,
+                const int                             bits_per_dim);
+
   /**
    * Given an arbitrary object of type T, use boost::serialization utilities
    * to pack the object into a vector of characters and append it to the
@@ -33,6 +33,7 @@
 #  endif
 
 #  include <functional>
+#  include <list>
 #  include <memory>
 #  include <utility>
 #  include <vector>
@@ -137,6 +138,10 @@ DEAL_II_NAMESPACE_OPEN
  * CopyData can be resized in accordance with the number of local DoFs on the
  * current cell.
  *
+ * If the same kind of loop is run many times, for example once in every time
+ * step, the WorkStream::Executor class avoids setting up the scratch and copy
+ * data objects in each call, and can also call the copier concurrently.
+ *
  * The functions in this namespace only really work in parallel when
  * multithread mode was selected during deal.II configuration. Otherwise they
  * simply work on each item sequentially.
@@ -1228,6 +1233,688 @@ namespace WorkStream
         chunk_size);
   }
 
+
+
+  /**
+   * The ways in which an Executor may call the copier function.
+   */
+  enum class CopierMode
+  {
+    /**
+     * Call the copier function on one thread at a time, in the order in which
+     * the items appear in the iterator range. This is the model of the run()
+     * functions above and gives reproducible results.
+     */
+    sequential,
+
+    /**
+     * Call the copier function right after the worker function, on the same
+     * thread and concurrently with other invocations of the copier. This
+     * removes the sequential copier as a bottleneck on machines with many
+     * cores, but requires that the copier is thread-safe, e.g., because it
+     * only writes to data that is not shared with other items, or because it
+     * uses atomic operations or locks to add into the global objects. The
+     * order of the copier calls, and hence the round-off in sums of local
+     * contributions, is not reproducible between runs.
+     */
+    concurrent
+  };
+
+
+
+  /**
+   * A class that provides the functionality of the run() functions of the
+   * WorkStream namespace for many invocations with the same type of scratch
+   * and copy data, for example the assembly of a matrix or a right hand side
+   * in every time step of a simulation.
+   *
+   * Each call to one of the WorkStream::run() functions sets up a TBB
+   * pipeline and creates the scratch and copy data objects it uses by copying
+   * the sample objects. For loops over small meshes, or with expensive
+   * scratch objects such as FEValues, this setup can take longer than the
+   * work itself. An object of this class instead keeps the pipeline, the
+   * ScratchData objects (one per thread that has worked on items, plus
+   * additional ones for nested tasks as explained for the WorkStream
+   * namespace) and the CopyData objects alive between calls of run(), so
+   * that repeated calls only copy iterators. The ScratchData and CopyData
+   * objects are consequently not reset between calls; the worker function
+   * needs to initialize everything it reads, as is already the case for the
+   * run() functions above, which reuse these objects for many items.
+   *
+   * Items are distributed to the threads in chunks by the TBB scheduler,
+   * which balances the load by work stealing. In addition to the sequential
+   * copier of the run() functions above, the run() functions of this class
+   * can call the copier concurrently, see CopierMode, and run() for colored
+   * iterators calls the copier concurrently for the items of one color since
+   * their contributions do not conflict.
+   *
+   * A typical use looks as follows:
+   * @code
+   *   WorkStream::Executor<typename DoFHandler<dim>::active_cell_iterator,
+   *                        ScratchData,
+   *                        CopyData>
+   *     executor(ScratchData(fe, quadrature), CopyData(fe.dofs_per_cell));
+   *
+   *   for (unsigned int timestep = 0; timestep < n_timesteps; ++timestep)
+   *     {
+   *       system_rhs = 0;
+   *       executor.run(dof_handler.begin_active(),
+   *                    dof_handler.end(),
+   *                    &local_assemble_rhs,
+   *                    &copy_local_to_global);
+   *       ...
+   *     }
+   * @endcode
+   *
+   * An object of this class must not be used by several threads at the same
+   * time, and its run() functions must not be called from within the worker
+   * or copier functions of the same object.
+   *
+   * @ingroup threads
+   */
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  class Executor
+  {
+  public:
+    /**
+     * Constructor. The sample objects are copied and used to create the
+     * ScratchData and CopyData objects when they are first needed. The
+     * meaning of @p queue_length and @p chunk_size is the same as for the
+     * WorkStream::run() functions.
+     */
+    Executor(const ScratchData &sample_scratch_data,
+             const CopyData &   sample_copy_data,
+             const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+             const unsigned int chunk_size   = 8);
+
+    /**
+     * Run the worker function on all elements of the iterator range from @p
+     * begin to @p end, and the copier function on the results, as described
+     * for the WorkStream::run() function with the same arguments. The
+     * copier function is called as specified by @p copier_mode.
+     */
+    template <typename Worker, typename Copier>
+    void
+    run(const Iterator &                         begin,
+        const typename identity<Iterator>::type &end,
+        Worker                                   worker,
+        Copier                                   copier,
+        const CopierMode copier_mode = CopierMode::sequential);
+
+    /**
+     * Run the worker function on all elements of @p colored_iterators, one
+     * color after the other, as described for the WorkStream::run() function
+     * with the same arguments. Since the copier functions of the items of
+     * one color do not conflict, they are called concurrently, right after
+     * the worker function on the same thread.
+     */
+    template <typename Worker, typename Copier>
+    void
+    run(const std::vector<std::vector<Iterator>> &colored_iterators,
+        Worker                                    worker,
+        Copier                                    copier);
+
+    /**
+     * The same as the first run() function, for worker and copier functions
+     * that are member functions of @p main_object.
+     */
+    template <typename MainClass>
+    void
+    run(const Iterator &                         begin,
+        const typename identity<Iterator>::type &end,
+        MainClass &                              main_object,
+        void (MainClass::*worker)(const Iterator &, ScratchData &, CopyData &),
+        void (MainClass::*copier)(const CopyData &),
+        const CopierMode copier_mode = CopierMode::sequential);
+
+    /**
+     * Return the number of ScratchData objects that have been created so far
+     * and are kept for later calls of run().
+     */
+    unsigned int
+    n_scratch_data_objects() const;
+
+    /**
+     * Delete all ScratchData and CopyData objects. They are created again
+     * from the sample objects when needed.
+     */
+    void
+    clear();
+
+  private:
+    /**
+     * A ScratchData object together with a CopyData object, which is only
+     * created if the copier is called right after the worker, and a flag
+     * that indicates whether the objects are currently used by a worker. See
+     * the documentation of the WorkStream namespace for the reason why there
+     * may be more than one of these objects for each thread.
+     */
+    struct ScratchAndCopyData
+    {
+      std::shared_ptr<ScratchData> scratch_data;
+      std::shared_ptr<CopyData>    copy_data;
+      bool                         currently_in_use;
+    };
+
+    /**
+     * Return an unused element of the list of the current thread, creating
+     * it if necessary, and mark it as used. If @p with_copy_data is true,
+     * make sure the element also holds a CopyData object.
+     */
+    ScratchAndCopyData &
+    acquire_scratch_data(const bool with_copy_data);
+
+    /**
+     * Call the worker and copier functions on all elements of @p iterators
+     * in parallel, with the copier called right after the worker on the same
+     * thread.
+     */
+    void
+    run_concurrently(const std::vector<Iterator> &iterators);
+
+    /**
+     * Call the worker and copier functions on one element of @p iterators
+     * after the other on the current thread.
+     */
+    void
+    run_serially(const std::vector<Iterator> &iterators);
+
+    /**
+     * The sample objects given to the constructor.
+     */
+    const ScratchData sample_scratch_data;
+    const CopyData    sample_copy_data;
+
+    const unsigned int queue_length;
+    const unsigned int chunk_size;
+
+    /**
+     * The worker and copier functions of the current call of run().
+     */
+    std::function<void(const Iterator &, ScratchData &, CopyData &)> worker;
+    std::function<void(const CopyData &)>                            copier;
+
+    /**
+     * The ScratchData objects of each thread.
+     */
+    mutable Threads::ThreadLocalStorage<std::list<ScratchAndCopyData>>
+      thread_local_data;
+
+    /**
+     * A buffer for the iterators of the range given to run() with the
+     * concurrent copier mode. It is kept between calls to avoid reallocation.
+     */
+    std::vector<Iterator> iterator_buffer;
+
+#  ifdef DEAL_II_WITH_THREADS
+    /**
+     * A chunk of items that is passed through the pipeline used for the
+     * sequential copier mode. Since both the first and the last stage of the
+     * pipeline run in order and the pipeline has at most queue_length items
+     * in flight, the items can be used from a ring buffer in round-robin
+     * fashion.
+     */
+    struct Item
+    {
+      std::vector<Iterator> work_items;
+      std::vector<CopyData> copy_datas;
+      unsigned int          n_items;
+    };
+
+    /**
+     * The first stage of the pipeline, which fills the next item of the ring
+     * buffer with iterators.
+     */
+    class ItemStream : public tbb::filter
+    {
+    public:
+      ItemStream(Executor &executor)
+        : tbb::filter(tbb::filter::serial_in_order)
+        , executor(executor)
+      {}
+
+      virtual void *
+      operator()(void *) override;
+
+    private:
+      Executor &executor;
+    };
+
+    /**
+     * The second stage of the pipeline, which calls the worker function on
+     * the elements of an item in parallel with other items.
+     */
+    class WorkerStage : public tbb::filter
+    {
+    public:
+      WorkerStage(Executor &executor)
+        : tbb::filter(tbb::filter::parallel)
+        , executor(executor)
+      {}
+
+      virtual void *
+      operator()(void *item) override;
+
+    private:
+      Executor &executor;
+    };
+
+    /**
+     * The last stage of the pipeline, which calls the copier function on the
+     * elements of one item after the other in the order of the iterator
+     * range.
+     */
+    class CopierStage : public tbb::filter
+    {
+    public:
+      CopierStage(Executor &executor)
+        : tbb::filter(tbb::filter::serial_in_order)
+        , executor(executor)
+      {}
+
+      virtual void *
+      operator()(void *item) override;
+
+    private:
+      Executor &executor;
+    };
+
+    /**
+     * The ring buffer of items, created at the first call of run() with the
+     * sequential copier mode.
+     */
+    std::vector<Item> items;
+
+    /**
+     * The element of the ring buffer to be used for the next item.
+     */
+    unsigned int next_item;
+
+    /**
+     * The part of the iterator range of the current call of run() for which
+     * no item has been created yet.
+     */
+    std::pair<Iterator, Iterator> *remaining_range;
+
+    ItemStream  item_stream;
+    WorkerStage worker_stage;
+    CopierStage copier_stage;
+
+    /**
+     * The pipeline made up of the three stages above. It is set up once in
+     * the constructor and run in every call of run().
+     */
+    tbb::pipeline pipeline;
+#  endif
+  };
+
+
+
+  /* ----------------------- Executor implementation ---------------------- */
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  Executor<Iterator, ScratchData, CopyData>::Executor(
+    const ScratchData &sample_scratch_data,
+    const CopyData &   sample_copy_data,
+    const unsigned int queue_length,
+    const unsigned int chunk_size)
+    : sample_scratch_data(sample_scratch_data)
+    , sample_copy_data(sample_copy_data)
+    , queue_length(queue_length)
+    , chunk_size(chunk_size)
+#  ifdef DEAL_II_WITH_THREADS
+    , next_item(0)
+    , remaining_range(nullptr)
+    , item_stream(*this)
+    , worker_stage(*this)
+    , copier_stage(*this)
+#  endif
+  {
+    Assert(queue_length > 0,
+           ExcMessage("The queue length must be at least one, and preferably "
+                      "larger than the number of processors on this system."));
+    Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
+
+#  ifdef DEAL_II_WITH_THREADS
+    pipeline.add_filter(item_stream);
+    pipeline.add_filter(worker_stage);
+    pipeline.add_filter(copier_stage);
+#  endif
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  template <typename Worker, typename Copier>
+  void
+  Executor<Iterator, ScratchData, CopyData>::run(
+    const Iterator &                         begin,
+    const typename identity<Iterator>::type &end,
+    Worker                                   worker,
+    Copier                                   copier,
+    const CopierMode                         copier_mode)
+  {
+    // if no work then skip. (only use operator!= for iterators since we may
+    // not have an equality comparison operator)
+    if (!(begin != end))
+      return;
+
+    this->worker = worker;
+    this->copier = copier;
+
+#  ifdef DEAL_II_WITH_THREADS
+    if (MultithreadInfo::n_threads() > 1)
+      {
+        if (copier_mode == CopierMode::sequential && this->copier)
+          {
+            // create the ring buffer of items at the first call. the
+            // iterators are overwritten before use, but we need some valid
+            // value to initialize them with
+            if (items.empty())
+              {
+                items.resize(queue_length);
+                for (Item &item : items)
+                  {
+                    item.work_items.resize(chunk_size, begin);
+                    item.copy_datas.resize(chunk_size, sample_copy_data);
+                    item.n_items = 0;
+                  }
+              }
+
+            std::pair<Iterator, Iterator> range(begin, end);
+            remaining_range = &range;
+            next_item       = 0;
+            pipeline.run(queue_length);
+            remaining_range = nullptr;
+          }
+        else
+          {
+            // without a sequential copier, the items are independent and we
+            // can use parallel_for on an array of the iterators
+            iterator_buffer.clear();
+            for (Iterator p = begin; p != end; ++p)
+              iterator_buffer.push_back(p);
+            run_concurrently(iterator_buffer);
+          }
+      }
+    else
+#  endif
+      {
+        // with only one thread, the copier is called sequentially anyway
+        (void)copier_mode;
+        iterator_buffer.clear();
+        for (Iterator p = begin; p != end; ++p)
+          iterator_buffer.push_back(p);
+        run_serially(iterator_buffer);
+      }
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  template <typename Worker, typename Copier>
+  void
+  Executor<Iterator, ScratchData, CopyData>::run(
+    const std::vector<std::vector<Iterator>> &colored_iterators,
+    Worker                                    worker,
+    Copier                                    copier)
+  {
+    this->worker = worker;
+    this->copier = copier;
+
+    for (unsigned int color = 0; color < colored_iterators.size(); ++color)
+      if (colored_iterators[color].size() > 0)
+        {
+#  ifdef DEAL_II_WITH_THREADS
+          if (MultithreadInfo::n_threads() > 1)
+            run_concurrently(colored_iterators[color]);
+          else
+#  endif
+            run_serially(colored_iterators[color]);
+        }
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  template <typename MainClass>
+  void
+  Executor<Iterator, ScratchData, CopyData>::run(
+    const Iterator &                         begin,
+    const typename identity<Iterator>::type &end,
+    MainClass &                              main_object,
+    void (MainClass::*worker)(const Iterator &, ScratchData &, CopyData &),
+    void (MainClass::*copier)(const CopyData &),
+    const CopierMode copier_mode)
+  {
+    // forward to the other function
+    run(begin,
+        end,
+        std::bind(worker,
+                  std::ref(main_object),
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3),
+        std::bind(copier, std::ref(main_object), std::placeholders::_1),
+        copier_mode);
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  unsigned int
+  Executor<Iterator, ScratchData, CopyData>::n_scratch_data_objects() const
+  {
+#  ifdef DEAL_II_WITH_THREADS
+    unsigned int n_objects = 0;
+    for (const auto &list : thread_local_data.get_implementation())
+      n_objects += list.size();
+    return n_objects;
+#  else
+    return thread_local_data.get_implementation().size();
+#  endif
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  void
+  Executor<Iterator, ScratchData, CopyData>::clear()
+  {
+    thread_local_data.clear();
+    iterator_buffer.clear();
+#  ifdef DEAL_II_WITH_THREADS
+    items.clear();
+#  endif
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  typename Executor<Iterator, ScratchData, CopyData>::ScratchAndCopyData &
+  Executor<Iterator, ScratchData, CopyData>::acquire_scratch_data(
+    const bool with_copy_data)
+  {
+    // there is no need to synchronize access to the list using a mutex as
+    // long as we have no yield-point in between, see the documentation of
+    // IteratorRangeToItemStream::thread_local_scratch. elements of a
+    // std::list do not move when other elements are added, so the reference
+    // we return stays valid while the worker runs
+    std::list<ScratchAndCopyData> &list = thread_local_data.get();
+
+    ScratchAndCopyData *data = nullptr;
+    for (ScratchAndCopyData &p : list)
+      if (p.currently_in_use == false)
+        {
+          data = &p;
+          break;
+        }
+
+    if (data == nullptr)
+      {
+        list.emplace_back();
+        data = &list.back();
+        data->scratch_data =
+          std::make_shared<ScratchData>(sample_scratch_data);
+      }
+    if (with_copy_data && !data->copy_data)
+      data->copy_data = std::make_shared<CopyData>(sample_copy_data);
+
+    data->currently_in_use = true;
+    return *data;
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  void
+  Executor<Iterator, ScratchData, CopyData>::run_concurrently(
+    const std::vector<Iterator> &iterators)
+  {
+#  ifdef DEAL_II_WITH_THREADS
+    tbb::parallel_for(
+      tbb::blocked_range<std::size_t>(0, iterators.size(), chunk_size),
+      [this, &iterators](const tbb::blocked_range<std::size_t> &range) {
+        ScratchAndCopyData &data = acquire_scratch_data(true);
+        for (std::size_t i = range.begin(); i < range.end(); ++i)
+          {
+            try
+              {
+                if (worker)
+                  worker(iterators[i], *data.scratch_data, *data.copy_data);
+                if (copier)
+                  copier(*data.copy_data);
+              }
+            catch (const std::exception &exc)
+              {
+                Threads::internal::handle_std_exception(exc);
+              }
+            catch (...)
+              {
+                Threads::internal::handle_unknown_exception();
+              }
+          }
+        data.currently_in_use = false;
+      },
+      tbb::auto_partitioner());
+#  else
+    run_serially(iterators);
+#  endif
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  void
+  Executor<Iterator, ScratchData, CopyData>::run_serially(
+    const std::vector<Iterator> &iterators)
+  {
+    ScratchAndCopyData &data = acquire_scratch_data(true);
+    for (const Iterator &p : iterators)
+      {
+        if (worker)
+          worker(p, *data.scratch_data, *data.copy_data);
+        if (copier)
+          copier(*data.copy_data);
+      }
+    data.currently_in_use = false;
+  }
+
+
+
+#  ifdef DEAL_II_WITH_THREADS
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  void *
+  Executor<Iterator, ScratchData, CopyData>::ItemStream::operator()(void *)
+  {
+    // the pipeline has at most queue_length items in flight and releases
+    // them in the order in which they were created here, so the next
+    // element of the ring buffer is free. there is no need for a lock since
+    // this stage runs sequentially
+    std::pair<Iterator, Iterator> &range = *executor.remaining_range;
+    Item &item                           = executor.items[executor.next_item];
+
+    item.n_items = 0;
+    while ((range.first != range.second) &&
+           (item.n_items < executor.chunk_size))
+      {
+        item.work_items[item.n_items] = range.first;
+        ++range.first;
+        ++item.n_items;
+      }
+
+    if (item.n_items == 0)
+      // there were no items left. terminate the pipeline
+      return nullptr;
+
+    executor.next_item = (executor.next_item + 1) % executor.items.size();
+    return &item;
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  void *
+  Executor<Iterator, ScratchData, CopyData>::WorkerStage::operator()(
+    void *item)
+  {
+    Item &current_item = *static_cast<Item *>(item);
+
+    ScratchAndCopyData &data = executor.acquire_scratch_data(false);
+    for (unsigned int i = 0; i < current_item.n_items; ++i)
+      {
+        try
+          {
+            if (executor.worker)
+              executor.worker(current_item.work_items[i],
+                              *data.scratch_data,
+                              current_item.copy_datas[i]);
+          }
+        catch (const std::exception &exc)
+          {
+            Threads::internal::handle_std_exception(exc);
+          }
+        catch (...)
+          {
+            Threads::internal::handle_unknown_exception();
+          }
+      }
+    data.currently_in_use = false;
+
+    return item;
+  }
+
+
+
+  template <typename Iterator, typename ScratchData, typename CopyData>
+  void *
+  Executor<Iterator, ScratchData, CopyData>::CopierStage::operator()(
+    void *item)
+  {
+    Item &current_item = *static_cast<Item *>(item);
+
+    for (unsigned int i = 0; i < current_item.n_items; ++i)
+      {
+        try
+          {
+            executor.copier(current_item.copy_datas[i]);
+          }
+        catch (const std::exception &exc)
+          {
+            Threads::internal::handle_std_exception(exc);
+          }
+        catch (...)
+          {
+            Threads::internal::handle_unknown_exception();
+          }
+      }
+
+    // this is the last stage, so the pipeline ignores the return value
+    return item;
+  }
+#  endif
+
 } // namespace WorkStream
 
 
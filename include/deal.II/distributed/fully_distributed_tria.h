@@ -0,0 +1,270 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_fully_distributed_tria_h
+#define dealii_distributed_fully_distributed_tria_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <utility>
+#include <vector>
+
+#ifdef DEAL_II_WITH_MPI
+#  include <mpi.h>
+#endif
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    /**
+     * The part of a coarse mesh that a single process needs to set up its
+     * parallel::fullydistributed::Triangulation: the cells it owns, and all
+     * cells owned by other processes that share at least a vertex with one
+     * of them (the ghost cells). Cells are described in the same way as for
+     * Triangulation::create_triangulation(), i.e., the vertex indices
+     * stored in @p cells and @p subcelldata refer to the (local) array
+     * @p vertices.
+     *
+     * In addition to the geometric description, each cell carries two
+     * pieces of information: the id of the cell in the global coarse mesh,
+     * which must be the same on all processes that store the cell, and the
+     * rank of the process that owns it.
+     *
+     * Objects of this type can be filled by hand (for example by a mesh
+     * reader that only reads the part of a mesh file that belongs to the
+     * current process), or from a serial triangulation that has been
+     * partitioned with one of the GridTools::partition_triangulation()
+     * functions, using create_construction_data().
+     */
+    template <int dim, int spacedim = dim>
+    struct ConstructionData
+    {
+      /**
+       * The vertices of the locally relevant cells.
+       */
+      std::vector<Point<spacedim>> vertices;
+
+      /**
+       * The locally relevant cells, i.e., the locally owned cells and the
+       * ghost cells.
+       */
+      std::vector<CellData<dim>> cells;
+
+      /**
+       * Boundary and manifold indicators of the faces and edges of the
+       * locally relevant cells.
+       */
+      SubCellData subcelldata;
+
+      /**
+       * For each entry of @p cells, its globally unique id in the coarse
+       * mesh. This id becomes the first component of the CellId of the cell
+       * and of all of its descendants.
+       */
+      std::vector<unsigned int> coarse_cell_ids;
+
+      /**
+       * For each entry of @p cells, the rank of the process that owns it.
+       */
+      std::vector<types::subdomain_id> subdomain_ids;
+    };
+
+
+
+    /**
+     * Extract from @p tria the description of the part of the mesh that is
+     * relevant to the process with rank @p subdomain. All active cells of
+     * @p tria need to have their subdomain id set to the rank of the
+     * process that owns them, for example by one of the
+     * GridTools::partition_triangulation() functions. The active cells of
+     * @p tria become the coarse cells of the fully distributed
+     * triangulation; their ids are their active cell indices. Consequently,
+     * @p tria may be refined, but it must not have hanging nodes.
+     *
+     * This function is meant for meshes that still fit into the memory of a
+     * single process (possibly one process per node that writes the
+     * descriptions for all others to disk), and for testing.
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data(const dealii::Triangulation<dim, spacedim> &tria,
+                             const types::subdomain_id subdomain);
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+    /**
+     * A parallel triangulation in which each processor only stores the part
+     * of the coarse mesh that it needs, i.e., the coarse cells it owns and
+     * one layer of ghost cells around them. This is in contrast to
+     * parallel::distributed::Triangulation, where every processor stores the
+     * complete coarse mesh, and parallel::shared::Triangulation, where every
+     * processor stores the complete mesh. This class is therefore the one
+     * to use if the coarse mesh is too large to be stored on each process.
+     *
+     * The triangulation is not created from a list of vertices and cells
+     * shared by all processes, but from a ConstructionData object that only
+     * describes the locally relevant part of the mesh, see
+     * create_triangulation(const ConstructionData<dim,spacedim>&). The
+     * partitioning of the mesh is given by this description and cannot be
+     * changed afterwards.
+     *
+     * Since the cells stored on different processes have different indices
+     * on each process, the coarse cells are identified by a globally unique
+     * id that is part of the description. It is used for the CellId of all
+     * cells, so that functions that communicate cells by their CellId (such
+     * as GridTools::exchange_cell_data_to_ghosts()) work as for the other
+     * parallel triangulations. The DoFHandler class enumerates the degrees
+     * of freedom on this kind of triangulation in the same way as on a
+     * parallel::distributed::Triangulation.
+     *
+     * @note This class does not support adaptive refinement or coarsening:
+     * the mesh needs to be described at the resolution at which it is going
+     * to be used. Neither does it support geometric multigrid.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public dealii::parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor. The triangulation is empty until
+       * create_triangulation(const ConstructionData<dim,spacedim>&) is
+       * called.
+       */
+      explicit Triangulation(MPI_Comm mpi_communicator);
+
+      /**
+       * Create the locally relevant part of the triangulation from the
+       * description in @p construction_data. The coarse cells are stored in
+       * the order given there. Cells owned by another process that do not
+       * share a vertex with a locally owned cell are marked as artificial.
+       *
+       * This function has to be called on all processes of the
+       * communicator at the same time.
+       */
+      void
+      create_triangulation(
+        const ConstructionData<dim, spacedim> &construction_data);
+
+      /**
+       * This function is not available for this class since the mesh
+       * partitioning can not be determined from the complete list of cells.
+       * Use create_triangulation(const ConstructionData<dim,spacedim>&)
+       * instead.
+       */
+      virtual void
+      create_triangulation(const std::vector<Point<spacedim>> &vertices,
+                           const std::vector<CellData<dim>> &  cells,
+                           const SubCellData &subcelldata) override;
+
+      /**
+       * This function is not implemented for this class.
+       */
+      virtual void
+      copy_triangulation(
+        const dealii::Triangulation<dim, spacedim> &other_tria) override;
+
+      /**
+       * This function is not implemented for this class, since adaptive
+       * refinement is not supported.
+       */
+      virtual void
+      execute_coarsening_and_refinement() override;
+
+      /**
+       * Return false, since the mesh can not be refined locally.
+       */
+      virtual bool
+      has_hanging_nodes() const override;
+
+      /**
+       * Return the globally unique id of the coarse cell with the given
+       * local index, as given in the ConstructionData object this
+       * triangulation was created from.
+       */
+      virtual unsigned int
+      coarse_cell_index_to_coarse_cell_id(
+        const unsigned int coarse_cell_index) const override;
+
+      /**
+       * Return the local index of the coarse cell with the given globally
+       * unique id. The cell needs to be stored on the current process.
+       */
+      virtual unsigned int
+      coarse_cell_id_to_coarse_cell_index(
+        const unsigned int coarse_cell_id) const override;
+
+      /**
+       * Return the local memory consumption in bytes.
+       */
+      virtual std::size_t
+      memory_consumption() const override;
+
+    private:
+      /**
+       * The globally unique id of each coarse cell, indexed by its local
+       * index.
+       */
+      std::vector<unsigned int> coarse_cell_index_to_id;
+
+      /**
+       * Pairs of globally unique id and local index of the coarse cells,
+       * sorted by the id.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>>
+        coarse_cell_id_to_index;
+    };
+
+#else
+
+    /**
+     * Dummy class the compiler chooses for fully distributed triangulations
+     * if we didn't actually configure deal.II with the MPI library. The
+     * existence of this class allows us to refer to
+     * parallel::fullydistributed::Triangulation objects throughout the
+     * library even if it is disabled.
+     *
+     * Since the constructor of this class is deleted, no such objects
+     * can actually be created as this would be pointless given that
+     * MPI is not available.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public dealii::parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor. Deleted to make sure that objects of this type cannot be
+       * constructed (see also the class documentation).
+       */
+      Triangulation() = delete;
+    };
+
+#endif
+  } // namespace fullydistributed
+} // namespace parallel
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -120,6 +120,15 @@ namespace parallel
      * soltrans.refine_interpolate(old_solution, solution);
      * @endcode
      *
+     * The values of all registered vectors on a cell are packed into one
+     * contiguous buffer per cell when
+     * Triangulation::execute_coarsening_and_refinement() is called, and
+     * interpolate() reads them directly from the buffers that the
+     * triangulation received. The old vectors are not accessed after the
+     * refinement anymore, so they can be freed, e.g. by calling
+     * <tt>reinit()</tt> on them with the new index sets, before the new
+     * vectors are set up and interpolate() is called.
+     *
      * <h3>Use for Serialization</h3>
      *
      * This class can be used to serialize and later deserialize a distributed
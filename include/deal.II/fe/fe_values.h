@@ -34,6 +34,7 @@
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_update_flags.h>
 #include <deal.II/fe/fe_values_extractors.h>
+#include <deal.II/fe/fe_values_geometry_cache.h>
 #include <deal.II/fe/mapping.h>
 
 #include <deal.II/grid/tria.h>
@@ -1900,6 +1901,17 @@ namespace internal
       Cache(const FEValuesBase<dim, spacedim> &fe_values);
     };
   } // namespace FEValuesViews
+
+  namespace FEValuesImplementation
+  {
+    /**
+     * The one-dimensional shape data of a scalar tensor product element
+     * evaluated in a tensor product quadrature formula, used by FEValues to
+     * evaluate finite element functions by sum factorization. The definition
+     * is in the source file.
+     */
+    struct TensorProductShapeData;
+  } // namespace FEValuesImplementation
 } // namespace internal
 
 
@@ -3353,6 +3365,36 @@ protected:
                                                                      spacedim>
     finite_element_output;
 
+  /**
+   * The data read by the functions of this class that return mapping
+   * related quantities other than the quadrature points, and by the ones
+   * that return shape function values and derivatives. These point to
+   * #mapping_output and #finite_element_output, unless an FEValues object
+   * attached to an FEValuesGeometryCache has found the present cell in the
+   * cache, in which case they point to the data stored there. The
+   * quadrature points are always taken from #mapping_output.
+   */
+  const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
+                                                                     spacedim>
+    *present_mapping_output;
+
+  const dealii::internal::FEValuesImplementation::
+    FiniteElementRelatedData<dim, spacedim> *present_fe_output;
+
+
+  /**
+   * If the finite element is a scalar tensor product element of high enough
+   * degree and the quadrature formula is a tensor product as well, the
+   * one-dimensional shape data used to evaluate get_function_values() and
+   * get_function_gradients() by sum factorization. This reduces the work
+   * from $\mathcal O(p^{2d})$ to $\mathcal O(d p^{d+1})$ for polynomial
+   * degree $p$ in $d$ dimensions. Empty otherwise. If this object is set
+   * and gradients are requested, the inverse Jacobians are computed as well.
+   * The full shape function tables are kept in any case.
+   */
+  std::unique_ptr<
+    const dealii::internal::FEValuesImplementation::TensorProductShapeData>
+    tensor_product_shape_data;
 
   /**
    * Original update flags handed to the constructor of FEValues.
@@ -3428,6 +3470,19 @@ private:
  * values in quadrature points of a cell are needed. For further documentation
  * see this class.
  *
+ * For scalar tensor product elements such as FE_Q and FE_DGQ of degree three
+ * or higher, combined with a tensor product quadrature formula, the scalar
+ * variants of get_function_values() and get_function_gradients() use sum
+ * factorization, which costs $\mathcal O(d p^{d+1})$ instead of $\mathcal
+ * O(p^{2d})$ operations per cell. Gradients are transformed to the real cell
+ * with the inverse Jacobians, so update_inverse_jacobians is added to the
+ * update flags whenever update_gradients is given for such an element. The
+ * mapping then computes them on every cell, even if get_function_gradients()
+ * is never called. The full tables of shape function values and gradients
+ * are still computed and stored, since shape_value(), shape_grad() and the
+ * FEValuesViews classes read them, so sum factorization does not reduce the
+ * memory consumption of an FEValues object.
+ *
  * @ingroup feaccess
  * @author Wolfgang Bangerth, 1998, Guido Kanschat, 2001
  */
@@ -3493,6 +3548,22 @@ public:
   const Quadrature<dim> &
   get_quadrature() const;
 
+  /**
+   * Let this object share the data computed in reinit() with all other
+   * FEValues objects attached to the same @p cache, for all cells that are
+   * translations of a cell seen before. See the documentation of
+   * FEValuesGeometryCache for the conditions under which the cache is used.
+   * If they are not met by the mapping and finite element of this object,
+   * this function does nothing.
+   *
+   * A typical use is to attach the scratch data objects of WorkStream::run()
+   * to a common cache, so that the threads do not repeat each other's work
+   * on structured meshes, and read the data of each translation class from
+   * the same memory. The cache needs to live longer than this object.
+   */
+  void
+  attach_geometry_cache(FEValuesGeometryCache<dim, spacedim> &cache);
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object.
@@ -3537,6 +3608,38 @@ private:
    */
   void
   do_reinit();
+
+  /**
+   * The cache attached by attach_geometry_cache(), if any.
+   */
+  SmartPointer<FEValuesGeometryCache<dim, spacedim>, FEValues<dim, spacedim>>
+    geometry_cache;
+
+  /**
+   * The index under which the configuration of this object is registered in
+   * the #geometry_cache.
+   */
+  unsigned int geometry_cache_configuration;
+
+  /**
+   * The key of the present cell in the #geometry_cache. Kept as a member to
+   * avoid allocating memory on every call to reinit().
+   */
+  std::pair<unsigned int, std::vector<double>> geometry_cache_key;
+
+  /**
+   * The table of the #geometry_cache in which this object looks up cells.
+   * Holding it keeps the entry used for the present cell alive even if the
+   * cache is cleared in the meantime.
+   */
+  std::shared_ptr<const typename FEValuesGeometryCache<dim, spacedim>::Table>
+    geometry_cache_table;
+
+  /**
+   * The generation of the #geometry_cache at the time the
+   * #geometry_cache_table was obtained.
+   */
+  unsigned int geometry_cache_generation;
 };
 
 
@@ -3903,7 +4006,7 @@ namespace FEValuesViews
     // except that here we know the component as fixed and we have
     // pre-computed and cached a bunch of information. See the comments there.
     if (shape_function_data[shape_function].is_nonzero_shape_function_component)
-      return fe_values->finite_element_output.shape_values(
+      return fe_values->present_fe_output->shape_values(
         shape_function_data[shape_function].row_index, q_point);
     else
       return 0;
@@ -3926,8 +4029,8 @@ namespace FEValuesViews
     // function except that here we know the component as fixed and we have
     // pre-computed and cached a bunch of information. See the comments there.
     if (shape_function_data[shape_function].is_nonzero_shape_function_component)
-      return fe_values->finite_element_output
-        .shape_gradients[shape_function_data[shape_function].row_index]
+      return fe_values->present_fe_output
+        ->shape_gradients[shape_function_data[shape_function].row_index]
                         [q_point];
     else
       return gradient_type();
@@ -3950,8 +4053,9 @@ namespace FEValuesViews
     // function except that here we know the component as fixed and we have
     // pre-computed and cached a bunch of information. See the comments there.
     if (shape_function_data[shape_function].is_nonzero_shape_function_component)
-      return fe_values->finite_element_output
-        .shape_hessians[shape_function_data[shape_function].row_index][q_point];
+      return fe_values->present_fe_output
+        ->shape_hessians[shape_function_data[shape_function].row_index]
+                        [q_point];
     else
       return hessian_type();
   }
@@ -3973,8 +4077,8 @@ namespace FEValuesViews
     // function except that here we know the component as fixed and we have
     // pre-computed and cached a bunch of information. See the comments there.
     if (shape_function_data[shape_function].is_nonzero_shape_function_component)
-      return fe_values->finite_element_output
-        .shape_3rd_derivatives[shape_function_data[shape_function].row_index]
+      return fe_values->present_fe_output
+        ->shape_3rd_derivatives[shape_function_data[shape_function].row_index]
                               [q_point];
     else
       return third_derivative_type();
@@ -4003,7 +4107,7 @@ namespace FEValuesViews
         value_type return_value;
         return_value[shape_function_data[shape_function]
                        .single_nonzero_component_index] =
-          fe_values->finite_element_output.shape_values(snc, q_point);
+          fe_values->present_fe_output->shape_values(snc, q_point);
         return return_value;
       }
     else
@@ -4012,7 +4116,7 @@ namespace FEValuesViews
         for (unsigned int d = 0; d < dim; ++d)
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
-            return_value[d] = fe_values->finite_element_output.shape_values(
+            return_value[d] = fe_values->present_fe_output->shape_values(
               shape_function_data[shape_function].row_index[d], q_point);
 
         return return_value;
@@ -4042,7 +4146,7 @@ namespace FEValuesViews
         gradient_type return_value;
         return_value[shape_function_data[shape_function]
                        .single_nonzero_component_index] =
-          fe_values->finite_element_output.shape_gradients[snc][q_point];
+          fe_values->present_fe_output->shape_gradients[snc][q_point];
         return return_value;
       }
     else
@@ -4052,7 +4156,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[d] =
-              fe_values->finite_element_output.shape_gradients
+              fe_values->present_fe_output->shape_gradients
                 [shape_function_data[shape_function].row_index[d]][q_point];
 
         return return_value;
@@ -4079,8 +4183,8 @@ namespace FEValuesViews
     if (snc == -2)
       return divergence_type();
     else if (snc != -1)
-      return fe_values->finite_element_output
-        .shape_gradients[snc][q_point][shape_function_data[shape_function]
+      return fe_values->present_fe_output
+        ->shape_gradients[snc][q_point][shape_function_data[shape_function]
                                          .single_nonzero_component_index];
     else
       {
@@ -4089,7 +4193,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value +=
-              fe_values->finite_element_output.shape_gradients
+              fe_values->present_fe_output->shape_gradients
                 [shape_function_data[shape_function].row_index[d]][q_point][d];
 
         return return_value;
@@ -4138,11 +4242,11 @@ namespace FEValuesViews
                   if (shape_function_data[shape_function]
                         .single_nonzero_component_index == 0)
                     return_value[0] =
-                      -1.0 * fe_values->finite_element_output
-                               .shape_gradients[snc][q_point][1];
+                      -1.0 * fe_values->present_fe_output
+                               ->shape_gradients[snc][q_point][1];
                   else
-                    return_value[0] = fe_values->finite_element_output
-                                        .shape_gradients[snc][q_point][0];
+                    return_value[0] = fe_values->present_fe_output
+                                        ->shape_gradients[snc][q_point][0];
 
                   return return_value;
                 }
@@ -4156,15 +4260,15 @@ namespace FEValuesViews
                   if (shape_function_data[shape_function]
                         .is_nonzero_shape_function_component[0])
                     return_value[0] -=
-                      fe_values->finite_element_output
-                        .shape_gradients[shape_function_data[shape_function]
+                      fe_values->present_fe_output
+                        ->shape_gradients[shape_function_data[shape_function]
                                            .row_index[0]][q_point][1];
 
                   if (shape_function_data[shape_function]
                         .is_nonzero_shape_function_component[1])
                     return_value[0] +=
-                      fe_values->finite_element_output
-                        .shape_gradients[shape_function_data[shape_function]
+                      fe_values->present_fe_output
+                        ->shape_gradients[shape_function_data[shape_function]
                                            .row_index[1]][q_point][0];
 
                   return return_value;
@@ -4183,32 +4287,35 @@ namespace FEValuesViews
                       case 0:
                         {
                           return_value[0] = 0;
-                          return_value[1] = fe_values->finite_element_output
-                                              .shape_gradients[snc][q_point][2];
+                          return_value[1] =
+                            fe_values->present_fe_output
+                              ->shape_gradients[snc][q_point][2];
                           return_value[2] =
-                            -1.0 * fe_values->finite_element_output
-                                     .shape_gradients[snc][q_point][1];
+                            -1.0 * fe_values->present_fe_output
+                                     ->shape_gradients[snc][q_point][1];
                           return return_value;
                         }
 
                       case 1:
                         {
                           return_value[0] =
-                            -1.0 * fe_values->finite_element_output
-                                     .shape_gradients[snc][q_point][2];
+                            -1.0 * fe_values->present_fe_output
+                                     ->shape_gradients[snc][q_point][2];
                           return_value[1] = 0;
-                          return_value[2] = fe_values->finite_element_output
-                                              .shape_gradients[snc][q_point][0];
+                          return_value[2] =
+                            fe_values->present_fe_output
+                              ->shape_gradients[snc][q_point][0];
                           return return_value;
                         }
 
                       default:
                         {
-                          return_value[0] = fe_values->finite_element_output
-                                              .shape_gradients[snc][q_point][1];
+                          return_value[0] =
+                            fe_values->present_fe_output
+                              ->shape_gradients[snc][q_point][1];
                           return_value[1] =
-                            -1.0 * fe_values->finite_element_output
-                                     .shape_gradients[snc][q_point][0];
+                            -1.0 * fe_values->present_fe_output
+                                     ->shape_gradients[snc][q_point][0];
                           return_value[2] = 0;
                           return return_value;
                         }
@@ -4226,12 +4333,12 @@ namespace FEValuesViews
                         .is_nonzero_shape_function_component[0])
                     {
                       return_value[1] +=
-                        fe_values->finite_element_output
-                          .shape_gradients[shape_function_data[shape_function]
+                        fe_values->present_fe_output
+                          ->shape_gradients[shape_function_data[shape_function]
                                              .row_index[0]][q_point][2];
                       return_value[2] -=
-                        fe_values->finite_element_output
-                          .shape_gradients[shape_function_data[shape_function]
+                        fe_values->present_fe_output
+                          ->shape_gradients[shape_function_data[shape_function]
                                              .row_index[0]][q_point][1];
                     }
 
@@ -4239,12 +4346,12 @@ namespace FEValuesViews
                         .is_nonzero_shape_function_component[1])
                     {
                       return_value[0] -=
-                        fe_values->finite_element_output
-                          .shape_gradients[shape_function_data[shape_function]
+                        fe_values->present_fe_output
+                          ->shape_gradients[shape_function_data[shape_function]
                                              .row_index[1]][q_point][2];
                       return_value[2] +=
-                        fe_values->finite_element_output
-                          .shape_gradients[shape_function_data[shape_function]
+                        fe_values->present_fe_output
+                          ->shape_gradients[shape_function_data[shape_function]
                                              .row_index[1]][q_point][0];
                     }
 
@@ -4252,12 +4359,12 @@ namespace FEValuesViews
                         .is_nonzero_shape_function_component[2])
                     {
                       return_value[0] +=
-                        fe_values->finite_element_output
-                          .shape_gradients[shape_function_data[shape_function]
+                        fe_values->present_fe_output
+                          ->shape_gradients[shape_function_data[shape_function]
                                              .row_index[2]][q_point][1];
                       return_value[1] -=
-                        fe_values->finite_element_output
-                          .shape_gradients[shape_function_data[shape_function]
+                        fe_values->present_fe_output
+                          ->shape_gradients[shape_function_data[shape_function]
                                              .row_index[2]][q_point][0];
                     }
 
@@ -4294,7 +4401,7 @@ namespace FEValuesViews
         hessian_type return_value;
         return_value[shape_function_data[shape_function]
                        .single_nonzero_component_index] =
-          fe_values->finite_element_output.shape_hessians[snc][q_point];
+          fe_values->present_fe_output->shape_hessians[snc][q_point];
         return return_value;
       }
     else
@@ -4304,7 +4411,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[d] =
-              fe_values->finite_element_output.shape_hessians
+              fe_values->present_fe_output->shape_hessians
                 [shape_function_data[shape_function].row_index[d]][q_point];
 
         return return_value;
@@ -4335,7 +4442,7 @@ namespace FEValuesViews
         third_derivative_type return_value;
         return_value[shape_function_data[shape_function]
                        .single_nonzero_component_index] =
-          fe_values->finite_element_output.shape_3rd_derivatives[snc][q_point];
+          fe_values->present_fe_output->shape_3rd_derivatives[snc][q_point];
         return return_value;
       }
     else
@@ -4345,7 +4452,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[d] =
-              fe_values->finite_element_output.shape_3rd_derivatives
+              fe_values->present_fe_output->shape_3rd_derivatives
                 [shape_function_data[shape_function].row_index[d]][q_point];
 
         return return_value;
@@ -4447,7 +4554,7 @@ namespace FEValuesViews
     else if (snc != -1)
       return internal::symmetrize_single_row(
         shape_function_data[shape_function].single_nonzero_component_index,
-        fe_values->finite_element_output.shape_gradients[snc][q_point]);
+        fe_values->present_fe_output->shape_gradients[snc][q_point]);
     else
       {
         gradient_type return_value;
@@ -4455,7 +4562,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[d] =
-              fe_values->finite_element_output.shape_gradients
+              fe_values->present_fe_output->shape_gradients
                 [shape_function_data[shape_function].row_index[d]][q_point];
 
         return symmetrize(return_value);
@@ -4491,7 +4598,7 @@ namespace FEValuesViews
         const unsigned int comp =
           shape_function_data[shape_function].single_nonzero_component_index;
         return_value[value_type::unrolled_to_component_indices(comp)] =
-          fe_values->finite_element_output.shape_values(snc, q_point);
+          fe_values->present_fe_output->shape_values(snc, q_point);
         return return_value;
       }
     else
@@ -4501,7 +4608,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[value_type::unrolled_to_component_indices(d)] =
-              fe_values->finite_element_output.shape_values(
+              fe_values->present_fe_output->shape_values(
                 shape_function_data[shape_function].row_index[d], q_point);
         return return_value;
       }
@@ -4569,7 +4676,7 @@ namespace FEValuesViews
         // b_jj := \dfrac{\partial phi_{ii,jj}}{\partial x_jj}.
         // again, all other entries of 'b' are zero
         const dealii::Tensor<1, spacedim> &phi_grad =
-          fe_values->finite_element_output.shape_gradients[snc][q_point];
+          fe_values->present_fe_output->shape_gradients[snc][q_point];
 
         divergence_type return_value;
         return_value[ii] = phi_grad[jj];
@@ -4618,7 +4725,7 @@ namespace FEValuesViews
         const TableIndices<2> indices =
           dealii::Tensor<2, spacedim>::unrolled_to_component_indices(comp);
         return_value[indices] =
-          fe_values->finite_element_output.shape_values(snc, q_point);
+          fe_values->present_fe_output->shape_values(snc, q_point);
         return return_value;
       }
     else
@@ -4631,7 +4738,7 @@ namespace FEValuesViews
               const TableIndices<2> indices =
                 dealii::Tensor<2, spacedim>::unrolled_to_component_indices(d);
               return_value[indices] =
-                fe_values->finite_element_output.shape_values(
+                fe_values->present_fe_output->shape_values(
                   shape_function_data[shape_function].row_index[d], q_point);
             }
         return return_value;
@@ -4679,7 +4786,7 @@ namespace FEValuesViews
         const unsigned int jj = indices[1];
 
         const dealii::Tensor<1, spacedim> &phi_grad =
-          fe_values->finite_element_output.shape_gradients[snc][q_point];
+          fe_values->present_fe_output->shape_gradients[snc][q_point];
 
         divergence_type return_value;
         // note that we contract \nabla from the right
@@ -4736,7 +4843,7 @@ namespace FEValuesViews
         const unsigned int jj = indices[1];
 
         const dealii::Tensor<1, spacedim> &phi_grad =
-          fe_values->finite_element_output.shape_gradients[snc][q_point];
+          fe_values->present_fe_output->shape_gradients[snc][q_point];
 
         gradient_type return_value;
         return_value[ii][jj] = phi_grad;
@@ -4836,7 +4943,7 @@ FEValuesBase<dim, spacedim>::shape_value(const unsigned int i,
   // if the entire FE is primitive,
   // then we can take a short-cut:
   if (fe->is_primitive())
-    return this->finite_element_output.shape_values(i, j);
+    return this->present_fe_output->shape_values(i, j);
   else
     {
       // otherwise, use the mapping
@@ -4848,10 +4955,10 @@ FEValuesBase<dim, spacedim>::shape_value(const unsigned int i,
       // so we can call
       // system_to_component_index
       const unsigned int row =
-        this->finite_element_output
-          .shape_function_to_row_table[i * fe->n_components() +
+        this->present_fe_output
+          ->shape_function_to_row_table[i * fe->n_components() +
                                        fe->system_to_component_index(i).first];
-      return this->finite_element_output.shape_values(row, j);
+      return this->present_fe_output->shape_values(row, j);
     }
 }
 
@@ -4882,9 +4989,9 @@ FEValuesBase<dim, spacedim>::shape_value_component(
   // table and take the data from
   // there
   const unsigned int row =
-    this->finite_element_output
-      .shape_function_to_row_table[i * fe->n_components() + component];
-  return this->finite_element_output.shape_values(row, j);
+    this->present_fe_output
+      ->shape_function_to_row_table[i * fe->n_components() + component];
+  return this->present_fe_output->shape_values(row, j);
 }
 
 
@@ -4903,7 +5010,7 @@ FEValuesBase<dim, spacedim>::shape_grad(const unsigned int i,
   // if the entire FE is primitive,
   // then we can take a short-cut:
   if (fe->is_primitive())
-    return this->finite_element_output.shape_gradients[i][j];
+    return this->present_fe_output->shape_gradients[i][j];
   else
     {
       // otherwise, use the mapping
@@ -4915,10 +5022,10 @@ FEValuesBase<dim, spacedim>::shape_grad(const unsigned int i,
       // so we can call
       // system_to_component_index
       const unsigned int row =
-        this->finite_element_output
-          .shape_function_to_row_table[i * fe->n_components() +
+        this->present_fe_output
+          ->shape_function_to_row_table[i * fe->n_components() +
                                        fe->system_to_component_index(i).first];
-      return this->finite_element_output.shape_gradients[row][j];
+      return this->present_fe_output->shape_gradients[row][j];
     }
 }
 
@@ -4948,9 +5055,9 @@ FEValuesBase<dim, spacedim>::shape_grad_component(
   // table and take the data from
   // there
   const unsigned int row =
-    this->finite_element_output
-      .shape_function_to_row_table[i * fe->n_components() + component];
-  return this->finite_element_output.shape_gradients[row][j];
+    this->present_fe_output
+      ->shape_function_to_row_table[i * fe->n_components() + component];
+  return this->present_fe_output->shape_gradients[row][j];
 }
 
 
@@ -4969,7 +5076,7 @@ FEValuesBase<dim, spacedim>::shape_hessian(const unsigned int i,
   // if the entire FE is primitive,
   // then we can take a short-cut:
   if (fe->is_primitive())
-    return this->finite_element_output.shape_hessians[i][j];
+    return this->present_fe_output->shape_hessians[i][j];
   else
     {
       // otherwise, use the mapping
@@ -4981,10 +5088,10 @@ FEValuesBase<dim, spacedim>::shape_hessian(const unsigned int i,
       // so we can call
       // system_to_component_index
       const unsigned int row =
-        this->finite_element_output
-          .shape_function_to_row_table[i * fe->n_components() +
+        this->present_fe_output
+          ->shape_function_to_row_table[i * fe->n_components() +
                                        fe->system_to_component_index(i).first];
-      return this->finite_element_output.shape_hessians[row][j];
+      return this->present_fe_output->shape_hessians[row][j];
     }
 }
 
@@ -5014,9 +5121,9 @@ FEValuesBase<dim, spacedim>::shape_hessian_component(
   // table and take the data from
   // there
   const unsigned int row =
-    this->finite_element_output
-      .shape_function_to_row_table[i * fe->n_components() + component];
-  return this->finite_element_output.shape_hessians[row][j];
+    this->present_fe_output
+      ->shape_function_to_row_table[i * fe->n_components() + component];
+  return this->present_fe_output->shape_hessians[row][j];
 }
 
 
@@ -5035,7 +5142,7 @@ FEValuesBase<dim, spacedim>::shape_3rd_derivative(const unsigned int i,
   // if the entire FE is primitive,
   // then we can take a short-cut:
   if (fe->is_primitive())
-    return this->finite_element_output.shape_3rd_derivatives[i][j];
+    return this->present_fe_output->shape_3rd_derivatives[i][j];
   else
     {
       // otherwise, use the mapping
@@ -5047,10 +5154,10 @@ FEValuesBase<dim, spacedim>::shape_3rd_derivative(const unsigned int i,
       // so we can call
       // system_to_component_index
       const unsigned int row =
-        this->finite_element_output
-          .shape_function_to_row_table[i * fe->n_components() +
+        this->present_fe_output
+          ->shape_function_to_row_table[i * fe->n_components() +
                                        fe->system_to_component_index(i).first];
-      return this->finite_element_output.shape_3rd_derivatives[row][j];
+      return this->present_fe_output->shape_3rd_derivatives[row][j];
     }
 }
 
@@ -5080,9 +5187,9 @@ FEValuesBase<dim, spacedim>::shape_3rd_derivative_component(
   // table and take the data from
   // there
   const unsigned int row =
-    this->finite_element_output
-      .shape_function_to_row_table[i * fe->n_components() + component];
-  return this->finite_element_output.shape_3rd_derivatives[row][j];
+    this->present_fe_output
+      ->shape_function_to_row_table[i * fe->n_components() + component];
+  return this->present_fe_output->shape_3rd_derivatives[row][j];
 }
 
 
@@ -5135,7 +5242,7 @@ FEValuesBase<dim, spacedim>::get_JxW_values() const
          ExcAccessToUninitializedField("update_JxW_values"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.JxW_values;
+  return this->present_mapping_output->JxW_values;
 }
 
 
@@ -5148,7 +5255,7 @@ FEValuesBase<dim, spacedim>::get_jacobians() const
          ExcAccessToUninitializedField("update_jacobians"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobians;
+  return this->present_mapping_output->jacobians;
 }
 
 
@@ -5161,7 +5268,7 @@ FEValuesBase<dim, spacedim>::get_jacobian_grads() const
          ExcAccessToUninitializedField("update_jacobians_grads"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_grads;
+  return this->present_mapping_output->jacobian_grads;
 }
 
 
@@ -5175,7 +5282,7 @@ FEValuesBase<dim, spacedim>::jacobian_pushed_forward_grad(
          ExcAccessToUninitializedField("update_jacobian_pushed_forward_grads"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_pushed_forward_grads[i];
+  return this->present_mapping_output->jacobian_pushed_forward_grads[i];
 }
 
 
@@ -5188,7 +5295,7 @@ FEValuesBase<dim, spacedim>::get_jacobian_pushed_forward_grads() const
          ExcAccessToUninitializedField("update_jacobian_pushed_forward_grads"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_pushed_forward_grads;
+  return this->present_mapping_output->jacobian_pushed_forward_grads;
 }
 
 
@@ -5201,7 +5308,7 @@ FEValuesBase<dim, spacedim>::jacobian_2nd_derivative(const unsigned int i) const
          ExcAccessToUninitializedField("update_jacobian_2nd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_2nd_derivatives[i];
+  return this->present_mapping_output->jacobian_2nd_derivatives[i];
 }
 
 
@@ -5214,7 +5321,7 @@ FEValuesBase<dim, spacedim>::get_jacobian_2nd_derivatives() const
          ExcAccessToUninitializedField("update_jacobian_2nd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_2nd_derivatives;
+  return this->present_mapping_output->jacobian_2nd_derivatives;
 }
 
 
@@ -5229,7 +5336,8 @@ FEValuesBase<dim, spacedim>::jacobian_pushed_forward_2nd_derivative(
            "update_jacobian_pushed_forward_2nd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_pushed_forward_2nd_derivatives[i];
+  return this->present_mapping_output
+    ->jacobian_pushed_forward_2nd_derivatives[i];
 }
 
 
@@ -5243,7 +5351,7 @@ FEValuesBase<dim, spacedim>::get_jacobian_pushed_forward_2nd_derivatives() const
            "update_jacobian_pushed_forward_2nd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_pushed_forward_2nd_derivatives;
+  return this->present_mapping_output->jacobian_pushed_forward_2nd_derivatives;
 }
 
 
@@ -5256,7 +5364,7 @@ FEValuesBase<dim, spacedim>::jacobian_3rd_derivative(const unsigned int i) const
          ExcAccessToUninitializedField("update_jacobian_3rd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_3rd_derivatives[i];
+  return this->present_mapping_output->jacobian_3rd_derivatives[i];
 }
 
 
@@ -5269,7 +5377,7 @@ FEValuesBase<dim, spacedim>::get_jacobian_3rd_derivatives() const
          ExcAccessToUninitializedField("update_jacobian_3rd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_3rd_derivatives;
+  return this->present_mapping_output->jacobian_3rd_derivatives;
 }
 
 
@@ -5284,7 +5392,8 @@ FEValuesBase<dim, spacedim>::jacobian_pushed_forward_3rd_derivative(
            "update_jacobian_pushed_forward_3rd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_pushed_forward_3rd_derivatives[i];
+  return this->present_mapping_output
+    ->jacobian_pushed_forward_3rd_derivatives[i];
 }
 
 
@@ -5298,7 +5407,7 @@ FEValuesBase<dim, spacedim>::get_jacobian_pushed_forward_3rd_derivatives() const
            "update_jacobian_pushed_forward_3rd_derivatives"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.jacobian_pushed_forward_3rd_derivatives;
+  return this->present_mapping_output->jacobian_pushed_forward_3rd_derivatives;
 }
 
 
@@ -5311,7 +5420,7 @@ FEValuesBase<dim, spacedim>::get_inverse_jacobians() const
          ExcAccessToUninitializedField("update_inverse_jacobians"));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
-  return this->mapping_output.inverse_jacobians;
+  return this->present_mapping_output->inverse_jacobians;
 }
 
 
@@ -5338,12 +5447,12 @@ FEValuesBase<dim, spacedim>::JxW(const unsigned int i) const
 {
   Assert(this->update_flags & update_JxW_values,
          ExcAccessToUninitializedField("update_JxW_values"));
-  Assert(i < this->mapping_output.JxW_values.size(),
-         ExcIndexRange(i, 0, this->mapping_output.JxW_values.size()));
+  Assert(i < this->present_mapping_output->JxW_values.size(),
+         ExcIndexRange(i, 0, this->present_mapping_output->JxW_values.size()));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
 
-  return this->mapping_output.JxW_values[i];
+  return this->present_mapping_output->JxW_values[i];
 }
 
 
@@ -5354,12 +5463,12 @@ FEValuesBase<dim, spacedim>::jacobian(const unsigned int i) const
 {
   Assert(this->update_flags & update_jacobians,
          ExcAccessToUninitializedField("update_jacobians"));
-  Assert(i < this->mapping_output.jacobians.size(),
-         ExcIndexRange(i, 0, this->mapping_output.jacobians.size()));
+  Assert(i < this->present_mapping_output->jacobians.size(),
+         ExcIndexRange(i, 0, this->present_mapping_output->jacobians.size()));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
 
-  return this->mapping_output.jacobians[i];
+  return this->present_mapping_output->jacobians[i];
 }
 
 
@@ -5370,12 +5479,14 @@ FEValuesBase<dim, spacedim>::jacobian_grad(const unsigned int i) const
 {
   Assert(this->update_flags & update_jacobian_grads,
          ExcAccessToUninitializedField("update_jacobians_grads"));
-  Assert(i < this->mapping_output.jacobian_grads.size(),
-         ExcIndexRange(i, 0, this->mapping_output.jacobian_grads.size()));
+  Assert(i < this->present_mapping_output->jacobian_grads.size(),
+         ExcIndexRange(i,
+                       0,
+                       this->present_mapping_output->jacobian_grads.size()));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
 
-  return this->mapping_output.jacobian_grads[i];
+  return this->present_mapping_output->jacobian_grads[i];
 }
 
 
@@ -5386,12 +5497,14 @@ FEValuesBase<dim, spacedim>::inverse_jacobian(const unsigned int i) const
 {
   Assert(this->update_flags & update_inverse_jacobians,
          ExcAccessToUninitializedField("update_inverse_jacobians"));
-  Assert(i < this->mapping_output.inverse_jacobians.size(),
-         ExcIndexRange(i, 0, this->mapping_output.inverse_jacobians.size()));
+  Assert(i < this->present_mapping_output->inverse_jacobians.size(),
+         ExcIndexRange(i,
+                       0,
+                       this->present_mapping_output->inverse_jacobians.size()));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
 
-  return this->mapping_output.inverse_jacobians[i];
+  return this->present_mapping_output->inverse_jacobians[i];
 }
 
 
@@ -5403,12 +5516,14 @@ FEValuesBase<dim, spacedim>::normal_vector(const unsigned int i) const
   Assert(this->update_flags & update_normal_vectors,
          (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
            "update_normal_vectors")));
-  Assert(i < this->mapping_output.normal_vectors.size(),
-         ExcIndexRange(i, 0, this->mapping_output.normal_vectors.size()));
+  Assert(i < this->present_mapping_output->normal_vectors.size(),
+         ExcIndexRange(i,
+                       0,
+                       this->present_mapping_output->normal_vectors.size()));
   Assert(present_cell.get() != nullptr,
          ExcMessage("FEValues object is not reinit'ed to any cell"));
 
-  return this->mapping_output.normal_vectors[i];
+  return this->present_mapping_output->normal_vectors[i];
 }
 
 
@@ -5477,13 +5592,15 @@ template <int dim, int spacedim>
 inline const Tensor<1, spacedim> &
 FEFaceValuesBase<dim, spacedim>::boundary_form(const unsigned int i) const
 {
-  Assert(i < this->mapping_output.boundary_forms.size(),
-         ExcIndexRange(i, 0, this->mapping_output.boundary_forms.size()));
+  Assert(i < this->present_mapping_output->boundary_forms.size(),
+         ExcIndexRange(i,
+                       0,
+                       this->present_mapping_output->boundary_forms.size()));
   Assert(this->update_flags & update_boundary_forms,
          (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
            "update_boundary_forms")));
 
-  return this->mapping_output.boundary_forms[i];
+  return this->present_mapping_output->boundary_forms[i];
 }
 
 #endif // DOXYGEN
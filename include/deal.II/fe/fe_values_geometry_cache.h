@@ -0,0 +1,360 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fe_values_geometry_cache_h
+#define dealii_fe_values_geometry_cache_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/fe/fe_update_flags.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+template <int, int>
+class FEValues;
+template <int, int>
+class FiniteElement;
+template <int, int>
+class Mapping;
+
+
+/*!@addtogroup feaccess */
+/*@{*/
+
+/**
+ * A cache of the cell-dependent data computed by FEValues, shared between
+ * all FEValues objects that are attached to it via
+ * FEValues::attach_geometry_cache().
+ *
+ * On structured meshes, many cells are translations of each other. For such
+ * cells, all data computed by FEValues::reinit() except for the location of
+ * the quadrature points is the same: the JxW values, the (inverse) Jacobians
+ * and their derivatives, and the values and derivatives of the shape
+ * functions. FEValues already exploits this for two consecutive cells via
+ * CellSimilarity, but this only helps if cells are visited in a suitable
+ * order and, since the result would otherwise depend on the order in which
+ * threads pick up cells, is switched off whenever more than one thread is
+ * used. This class instead remembers the output computed on the first cell
+ * of every translation class it sees and hands it to all FEValues objects
+ * that later encounter a cell of the same class, including the per-thread
+ * copies created by WorkStream::run().
+ *
+ * The translation class of a cell is determined from the differences between
+ * the vertex locations of the cell returned by Mapping::get_vertices() and
+ * the location of its first vertex, rounded to a relative accuracy of about
+ * $10^{-11}$. Entries are additionally keyed on the configuration of the
+ * FEValues object, i.e., its mapping, finite element, quadrature formula and
+ * update flags, so the same cache can be attached to FEValues objects with
+ * different configurations. Mappings are identified by their type and
+ * polynomial degree and finite elements by their name, rather than by their
+ * address: two FEValues objects using different but equal mapping or
+ * element objects share their entries, and a new object that happens to be
+ * created at the address of a destroyed one can not pick up entries that
+ * were computed for a different mapping or element.
+ *
+ * The cache is only used by FEValues objects for which the result on a
+ * translated cell is indeed identical:
+ * <ul>
+ * <li> The mapping needs to be either a MappingCartesian or a
+ * MappingQGeneric of polynomial degree one (including MappingQ1,
+ * MappingQ1Eulerian and MappingQCache of degree one), i.e., the location of
+ * a mapped cell must be fully described by its vertices.
+ * <li> The finite element needs to be an FE_Q, FE_DGQ or FE_DGP (or one of
+ * the classes derived from them), or an FESystem built only from such
+ * elements. The shape functions of these elements are defined on the
+ * reference cell, so they do not depend on the absolute position of the
+ * cell. Other elements are rejected: FE_DGPNonparametric and FE_Enriched
+ * define their shape functions in real space, and elements such as
+ * FE_RaviartThomas or FE_Nedelec use Piola transformations that depend on
+ * the orientation of the cell, which is not part of the key.
+ * </ul>
+ * For all other combinations, attaching a cache has no effect.
+ *
+ * An FEValues object that finds the present cell in the cache does not copy
+ * the stored data, but lets its access functions such as
+ * FEValuesBase::shape_grad() and FEValuesBase::JxW() read the shared data
+ * directly. Only the quadrature points are moved to the present cell and
+ * stored in the FEValues object.
+ *
+ * Since the stored data was computed on a different cell than the one it is
+ * used on, the results differ from the ones computed without a cache by
+ * round-off, and the precise round-off error depends on which cell of a
+ * class was seen first. In multithreaded programs, results may therefore
+ * differ between runs at the level of round-off, just as they would if
+ * CellSimilarity were used with more than one thread.
+ *
+ * All functions of this class may be called concurrently. Entries are stored
+ * in a hash table that is only ever appended to, so that looking up a cell
+ * does not take any lock: a lock is only taken to insert a new entry. To
+ * avoid filling memory on unstructured meshes where hardly any two cells are
+ * translations of each other, no more than a given number of entries is
+ * stored; cells of classes not in the cache are then computed as usual.
+ */
+template <int dim, int spacedim = dim>
+class FEValuesGeometryCache : public Subscriptor
+{
+public:
+  /**
+   * Constructor. @p max_n_entries is the maximal number of translation
+   * classes (summed over all configurations) for which data is stored.
+   */
+  explicit FEValuesGeometryCache(const unsigned int max_n_entries = 1024);
+
+  /**
+   * Return whether an FEValues object using the given @p mapping and finite
+   * element @p fe can make use of the cache, following the criteria listed
+   * in the documentation of this class.
+   */
+  static bool
+  is_supported(const Mapping<dim, spacedim> &      mapping,
+               const FiniteElement<dim, spacedim> &fe);
+
+  /**
+   * Delete all entries, e.g. after the vertices of the triangulation have
+   * been moved. FEValues objects attached to this object stay attached and
+   * refill the cache as they visit cells. The data of FEValues objects that
+   * were last reinitialized from the cache stays valid until their next
+   * call to reinit().
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of translation classes currently stored.
+   */
+  unsigned int
+  n_entries() const;
+
+  /**
+   * Return the number of calls to FEValues::reinit() that have been served
+   * from the cache since its construction or the last call to clear().
+   */
+  unsigned long long int
+  n_hits() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The key of an entry: the index of the configuration and the rounded
+   * vertex differences of the translation class.
+   */
+  using Key = std::pair<unsigned int, std::vector<double>>;
+
+  /**
+   * The data stored for one translation class: the output of the mapping
+   * and the finite element on the first cell of this class that was
+   * encountered, together with the location of its first vertex that is
+   * needed to translate the quadrature points to other cells of the class.
+   */
+  struct Entry
+  {
+    Key key;
+
+    Point<spacedim> origin;
+
+    internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+      mapping_output;
+
+    internal::FEValuesImplementation::FiniteElementRelatedData<dim, spacedim>
+      finite_element_output;
+  };
+
+  /**
+   * A hash table of entries with open addressing that can be read while
+   * another thread inserts an entry. An entry is fully constructed before
+   * its index is published in #slots with release semantics, and readers
+   * load the slots with acquire semantics. Entries are never removed, so a
+   * reader either sees a complete entry or an empty slot.
+   */
+  struct Table
+  {
+    explicit Table(const unsigned int max_n_entries);
+
+    /**
+     * The stored entries, of which the first #n_entries are valid. The
+     * vector is sized to the maximal number of entries on construction and
+     * never reallocated.
+     */
+    std::vector<std::unique_ptr<const Entry>> entries;
+
+    /**
+     * The number of entries inserted so far.
+     */
+    std::atomic<unsigned int> n_entries;
+
+    /**
+     * The slots of the hash table, holding one plus the index of an entry
+     * in #entries, or zero for an empty slot. There are at least twice as
+     * many slots as entries, so that probing always ends at an empty slot.
+     */
+    std::unique_ptr<std::atomic<unsigned int>[]> slots;
+
+    /**
+     * The number of slots, a power of two.
+     */
+    unsigned int n_slots;
+  };
+
+  /**
+   * A combination of mapping, finite element, quadrature formula and update
+   * flags of an FEValues object using the cache.
+   */
+  struct Configuration
+  {
+    std::type_index mapping_type;
+
+    unsigned int mapping_degree;
+
+    std::string fe_name;
+
+    Quadrature<dim> quadrature;
+
+    UpdateFlags update_flags;
+  };
+
+  /**
+   * Return the index of the configuration described by the arguments,
+   * adding it to the list of known configurations if necessary.
+   */
+  unsigned int
+  register_configuration(const Mapping<dim, spacedim> &      mapping,
+                         const FiniteElement<dim, spacedim> &fe,
+                         const Quadrature<dim> &             quadrature,
+                         const UpdateFlags                   update_flags);
+
+  /**
+   * Fill @p key with the translation class of @p cell as seen by @p mapping
+   * for the given configuration, and @p origin with the mapped location of
+   * the first vertex of the cell.
+   */
+  static void
+  compute_key(
+    const Mapping<dim, spacedim> &                              mapping,
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const unsigned int                                          configuration,
+    Key &                                                       key,
+    Point<spacedim> &                                           origin);
+
+  /**
+   * Return the hash of @p key.
+   */
+  static std::size_t
+  hash(const Key &key);
+
+  /**
+   * Return the table in which entries are currently stored. FEValues
+   * objects keep a reference to the table, so that the entries they use
+   * stay alive when clear() replaces it.
+   */
+  std::shared_ptr<const Table>
+  get_table() const;
+
+  /**
+   * Return the number of times clear() has been called. FEValues objects
+   * compare this number against the one at the time they obtained their
+   * table in order to find out whether they need to call get_table()
+   * again.
+   */
+  unsigned int
+  get_generation() const;
+
+  /**
+   * Return the entry stored for @p key in @p table, or a null pointer if
+   * there is none. This function does not take a lock.
+   */
+  const Entry *
+  find(const Table &table, const Key &key) const;
+
+  /**
+   * Store a copy of the given data for @p key, unless the table is full or
+   * another thread has already inserted an entry for the same key. If
+   * @p snapshot, the table in which the caller looked up @p key, is
+   * already full, the data is not even copied.
+   */
+  void
+  insert(
+    const Table &         snapshot,
+    const Key &           key,
+    const Point<spacedim> origin,
+    const internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+      &mapping_output,
+    const internal::FEValuesImplementation::
+      FiniteElementRelatedData<dim, spacedim> &finite_element_output);
+
+  /**
+   * The maximal number of entries.
+   */
+  const unsigned int max_n_entries;
+
+  /**
+   * The configurations registered so far. Entries are only appended, so the
+   * index of a configuration stays valid for the lifetime of the cache.
+   */
+  std::vector<std::unique_ptr<const Configuration>> configurations;
+
+  /**
+   * The table of entries. Replaced by a new table in clear().
+   */
+  std::shared_ptr<Table> table;
+
+  /**
+   * The number of calls to clear().
+   */
+  std::atomic<unsigned int> generation;
+
+  /**
+   * The number of reinit() calls served from the cache. Only used for
+   * statistics, so it is updated with relaxed memory ordering.
+   */
+  mutable std::atomic<unsigned long long int> hit_counter;
+
+  /**
+   * A mutex guarding #configurations and #table as well as the insertion
+   * of entries. It is not needed to look up entries.
+   */
+  mutable Threads::Mutex mutex;
+
+  // FEValues accesses the entries directly
+  friend class FEValues<dim, spacedim>;
+};
+
+/*@}*/
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
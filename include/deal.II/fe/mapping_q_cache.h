@@ -0,0 +1,238 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mapping_q_cache_h
+#define dealii_mapping_q_cache_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <memory>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mapping */
+/*@{*/
+
+/**
+ * This class implements a caching strategy for objects of the MappingQGeneric
+ * family in terms of the MappingQGeneric::compute_mapping_support_points()
+ * function, which is used in all operations of MappingQGeneric. The
+ * information of the mapping is pre-computed by the
+ * MappingQCache::initialize() function.
+ *
+ * Computing the support points of a high-order mapping on a curved geometry
+ * involves calls to Manifold::get_new_points() for all edges, faces and the
+ * interior of a cell, which can be expensive, in particular for
+ * TransfiniteInterpolationManifold. Since MappingQGeneric only remembers the
+ * support points of the cell it has seen last, these computations are
+ * repeated every time FEValues, MatrixFree, or DataOut visit a cell. This
+ * class instead computes the support points of all active cells of a
+ * triangulation once, in parallel using the available threads, and stores
+ * them contiguously in memory. Copies of an object of this class (as created
+ * by clone(), e.g. inside FEValues) share the stored support points. The
+ * support points of cells that are not active, as used by multigrid methods,
+ * are not cached but computed by MappingQGeneric every time they are needed.
+ *
+ * The cache is tied to the triangulation passed to initialize(). It is
+ * automatically invalidated whenever the triangulation signals a change,
+ * e.g. upon refinement or coarsening. Changes that the triangulation does not
+ * signal, like the movement of vertices or a change of the mapping that was
+ * used to fill the cache (e.g. the displacement vector of a
+ * MappingQEulerian), require either a new call to initialize() or an explicit
+ * call to invalidate(). Using the mapping after the cache has been
+ * invalidated and before it has been re-initialized throws an exception of
+ * type ExcNotInitialized.
+ *
+ * @ingroup mapping
+ */
+template <int dim, int spacedim = dim>
+class MappingQCache : public MappingQGeneric<dim, spacedim>
+{
+public:
+  /**
+   * Constructor. @p polynomial_degree denotes the polynomial degree of the
+   * polynomials that are used to map cells from the reference to the real
+   * cell.
+   */
+  explicit MappingQCache(const unsigned int polynomial_degree);
+
+  /**
+   * Copy constructor. The new object shares the cached support points with
+   * @p mapping.
+   */
+  MappingQCache(const MappingQCache<dim, spacedim> &mapping);
+
+  /**
+   * Destructor.
+   */
+  ~MappingQCache() override;
+
+  /**
+   * clone() functionality. For documentation, see Mapping::clone().
+   */
+  virtual std::unique_ptr<Mapping<dim, spacedim>>
+  clone() const override;
+
+  /**
+   * Returns @p false because the preservation of vertex locations depends on
+   * the mapping handed to the initialize() function.
+   */
+  virtual bool
+  preserves_vertex_locations() const override;
+
+  /**
+   * Return the mapped vertices of a cell, which are the first entries of the
+   * cached support points.
+   */
+  virtual std::array<Point<spacedim>, GeometryInfo<dim>::vertices_per_cell>
+  get_vertices(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+    const override;
+
+  /**
+   * Initialize the data cache by computing the mapping support points for
+   * all active cells of the given triangulation, using the given
+   * @p mapping. The polynomial degree of @p mapping must match the one of the
+   * present object. The computation is done in parallel using the available
+   * threads.
+   *
+   * Any previously cached data is discarded. Note that only copies of the
+   * present object made after this call see the new data.
+   */
+  void
+  initialize(const Triangulation<dim, spacedim> &  triangulation,
+             const MappingQGeneric<dim, spacedim> &mapping);
+
+  /**
+   * Discard the cached support points. This needs to be called when the
+   * geometry changes in a way that is not signaled by the triangulation,
+   * e.g. when vertices are moved, and is called automatically for any change
+   * signaled by the triangulation.
+   */
+  void
+  invalidate();
+
+  /**
+   * Return whether the cache currently holds support points, i.e., whether
+   * initialize() has been called and the cache has not been invalidated
+   * since.
+   */
+  bool
+  is_initialized() const;
+
+  /**
+   * Return a view to the cached support points of the active cell @p cell,
+   * in the order described in
+   * MappingQGeneric::compute_mapping_support_points().
+   */
+  ArrayView<const Point<spacedim>>
+  get_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
+  /**
+   * Return the memory consumption (in bytes) of the cache.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception.
+   */
+  DeclExceptionMsg(ExcNotInitialized,
+                   "The cache of MappingQCache has not been initialized, or "
+                   "it has been invalidated by a change of the "
+                   "triangulation. Call MappingQCache::initialize() first.");
+
+protected:
+  /**
+   * This is the main function overridden from the base class
+   * MappingQGeneric. It returns the support points of the given cell from
+   * the cache for active cells, and computes them for all other cells.
+   */
+  virtual std::vector<Point<spacedim>>
+  compute_mapping_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+    const override;
+
+  /**
+   * Copy the cached support points of the given cell into @p points, which
+   * does not allocate memory if @p points already has the right size.
+   */
+  virtual void
+  fill_mapping_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    std::vector<Point<spacedim>> &points) const override;
+
+private:
+  /**
+   * The data of the cache, shared between copies of the mapping.
+   */
+  struct SupportPointCache
+  {
+    /**
+     * The offset of the first support point of a cell within @p
+     * support_points, indexed by the level and index of the cell, or
+     * numbers::invalid_unsigned_int for cells that are not active.
+     */
+    std::vector<std::vector<unsigned int>> cell_offsets;
+
+    /**
+     * The support points of all active cells, one cell after the other.
+     */
+    std::vector<Point<spacedim>> support_points;
+  };
+
+  /**
+   * The cached support points.
+   */
+  std::shared_ptr<const SupportPointCache> support_point_cache;
+
+  /**
+   * The triangulation the cache has been computed for, used to connect to
+   * its signals.
+   */
+  SmartPointer<const Triangulation<dim, spacedim>, MappingQCache<dim, spacedim>>
+    triangulation;
+
+  /**
+   * The connection to Triangulation::Signals::any_change that invalidates
+   * the cache.
+   */
+  boost::signals2::connection clear_signal;
+
+  /**
+   * Connect to the signals of the triangulation the cache has been computed
+   * for.
+   */
+  void
+  connect_to_triangulation();
+};
+
+/*@}*/
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
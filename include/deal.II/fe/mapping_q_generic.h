@@ -39,6 +39,9 @@ DEAL_II_NAMESPACE_OPEN
 template <int, int>
 class MappingQ;
 
+template <int, int>
+class MappingQCache;
+
 
 /*!@addtogroup mapping */
 /*@{*/
@@ -682,6 +685,18 @@ protected:
   compute_mapping_support_points(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
 
+  /**
+   * Write the support points of the given cell into @p points. This is the
+   * function used when the mapping is evaluated on a cell, e.g. by FEValues.
+   * The default implementation assigns the result of
+   * compute_mapping_support_points(); derived classes that store the support
+   * points can override it to copy them without allocating a new vector.
+   */
+  virtual void
+  fill_mapping_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    std::vector<Point<spacedim>> &                              points) const;
+
   /**
    * Transform the point @p p on the real cell to the corresponding point on
    * the unit cell @p cell by a Newton iteration.
@@ -735,6 +750,13 @@ protected:
    */
   template <int, int>
   friend class MappingQ;
+
+  /**
+   * Make MappingQCache a friend since it needs to call the
+   * compute_mapping_support_points() function.
+   */
+  template <int, int>
+  friend class MappingQCache;
 };
 
 
@@ -0,0 +1,432 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_grid_compiled_triangulation_h
+#define dealii_grid_compiled_triangulation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <boost/signals2.hpp>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A read-only, "compiled" view of the active cells of a Triangulation.
+ *
+ * The Triangulation class stores its cells in a hierarchy of levels, with
+ * the connectivity spread over several vectors in TriaLevels and TriaObjects
+ * (vertex and face indices, neighbors, refinement cases, user data, ...).
+ * Accessing a single property of an active cell through a TriaAccessor
+ * therefore involves several indirections, which is noticeable in loops that
+ * only need a few properties of all cells, such as error estimators, output
+ * routines, point location or hand-written assembly loops.
+ *
+ * This class collects the most frequently used information about all active
+ * cells into flat, contiguous arrays in structure-of-arrays format:
+ * <ul>
+ * <li> the vertex indices of each cell,
+ * <li> the face indices of each cell,
+ * <li> the index of the neighbor behind each face within this data
+ * structure,
+ * <li> the material id of each cell and the boundary id of each face, and
+ * <li> the center of each cell.
+ * </ul>
+ * Cells are numbered by a "compiled index" running from zero to
+ * n_active_cells(). This numbering follows a Hilbert space-filling curve
+ * through the cell centers, such that consecutive cells are close in space.
+ * As a consequence, iterating over a contiguous range of compiled indices,
+ * e.g. in blocks handed out to different threads, also touches vertex and
+ * neighbor data that are close in memory and is hence cache-friendly. The
+ * compiled index of a cell is unrelated to
+ * CellAccessor::active_cell_index(); use compiled_index() and
+ * get_cell_iterator() to translate between the two.
+ *
+ * The arrays are filled in the constructor and automatically rebuilt
+ * whenever the triangulation is created, refined or coarsened, or its
+ * vertices are moved. When the triangulation is cleared, the data of this
+ * class is cleared as well.
+ *
+ * The arrays are stored with a fixed number of entries per cell. For
+ * example, the vertex indices of the cell with compiled index <code>i</code>
+ * are found at positions <code>i*GeometryInfo<dim>::vertices_per_cell</code>
+ * to <code>(i+1)*GeometryInfo<dim>::vertices_per_cell-1</code> of the array
+ * returned by get_vertex_indices(), in the usual deal.II ordering of
+ * vertices. A typical loop looks as follows:
+ * @code
+ *   const CompiledTriangulation<dim> compiled(triangulation);
+ *   const std::vector<unsigned int> &vertex_indices =
+ *     compiled.get_vertex_indices();
+ *   for (unsigned int c = 0; c < compiled.n_active_cells(); ++c)
+ *     for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+ *       {
+ *         const Point<dim> &vertex = triangulation.get_vertices()
+ *           [vertex_indices[c * GeometryInfo<dim>::vertices_per_cell + v]];
+ *         ...
+ *       }
+ * @endcode
+ *
+ * @ingroup grid
+ */
+template <int dim, int spacedim = dim>
+class CompiledTriangulation : public Subscriptor
+{
+public:
+  /**
+   * The value stored in the array returned by get_neighbor_indices() if the
+   * face of a cell is at the boundary of the domain.
+   */
+  static const unsigned int boundary_neighbor = numbers::invalid_unsigned_int;
+
+  /**
+   * The value stored in the array returned by get_neighbor_indices() if the
+   * neighbor behind a face is refined, i.e., if the face has several active
+   * neighbors. Use the iterator returned by get_cell_iterator() to access
+   * these neighbors.
+   */
+  static const unsigned int refined_neighbor =
+    numbers::invalid_unsigned_int - 1;
+
+  /**
+   * Constructor. Compiles the active cells of the given triangulation and
+   * connects to its signals in order to keep the data in sync with the
+   * triangulation.
+   */
+  CompiledTriangulation(const Triangulation<dim, spacedim> &triangulation);
+
+  /**
+   * Copy constructor. Deleted because the object is tied to the signals of
+   * the triangulation.
+   */
+  CompiledTriangulation(const CompiledTriangulation<dim, spacedim> &) = delete;
+
+  /**
+   * Destructor. Disconnects from the signals of the triangulation.
+   */
+  ~CompiledTriangulation() override;
+
+  /**
+   * Copy assignment. Deleted for the same reason as the copy constructor.
+   */
+  CompiledTriangulation<dim, spacedim> &
+  operator=(const CompiledTriangulation<dim, spacedim> &) = delete;
+
+  /**
+   * Recompute all data from the current state of the triangulation. This
+   * function is called automatically when the triangulation signals a
+   * change of its cells or vertices, so there is usually no need to call it
+   * manually.
+   */
+  void
+  rebuild();
+
+  /**
+   * Return the underlying triangulation.
+   */
+  const Triangulation<dim, spacedim> &
+  get_triangulation() const;
+
+  /**
+   * Return the number of active cells represented by this object.
+   */
+  unsigned int
+  n_active_cells() const;
+
+  /**
+   * Return an iterator to the cell with the given compiled index.
+   */
+  typename Triangulation<dim, spacedim>::active_cell_iterator
+  get_cell_iterator(const unsigned int index) const;
+
+  /**
+   * Return the compiled index of the given active cell.
+   */
+  unsigned int
+  compiled_index(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const;
+
+  /**
+   * Return the vertex indices of all cells, with
+   * GeometryInfo<dim>::vertices_per_cell entries per cell.
+   */
+  const std::vector<unsigned int> &
+  get_vertex_indices() const;
+
+  /**
+   * Return the vertex indices of the cell with the given compiled index.
+   */
+  ArrayView<const unsigned int>
+  vertex_indices(const unsigned int index) const;
+
+  /**
+   * Return the indices of the faces of all cells as given by
+   * CellAccessor::face_index(), with GeometryInfo<dim>::faces_per_cell
+   * entries per cell.
+   */
+  const std::vector<unsigned int> &
+  get_face_indices() const;
+
+  /**
+   * Return the compiled indices of the neighbors of all cells, with
+   * GeometryInfo<dim>::faces_per_cell entries per cell. The entry is
+   * boundary_neighbor for faces at the boundary and refined_neighbor if the
+   * neighbor is refined. If the neighbor is coarser than the current cell,
+   * the index of the coarser neighbor is stored.
+   */
+  const std::vector<unsigned int> &
+  get_neighbor_indices() const;
+
+  /**
+   * Return the compiled indices of the neighbors of the cell with the given
+   * compiled index.
+   */
+  ArrayView<const unsigned int>
+  neighbor_indices(const unsigned int index) const;
+
+  /**
+   * Return the material ids of all cells.
+   */
+  const std::vector<types::material_id> &
+  get_material_ids() const;
+
+  /**
+   * Return the boundary ids of the faces of all cells, with
+   * GeometryInfo<dim>::faces_per_cell entries per cell. Interior faces are
+   * marked with numbers::internal_face_boundary_id.
+   */
+  const std::vector<types::boundary_id> &
+  get_face_boundary_ids() const;
+
+  /**
+   * Return the centers of all cells as computed by TriaAccessor::center().
+   */
+  const std::vector<Point<spacedim>> &
+  get_cell_centers() const;
+
+  /**
+   * Return an estimate for the memory consumption (in bytes) of this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Delete all data, called when the triangulation is cleared.
+   */
+  void
+  clear();
+
+  /**
+   * A pointer to the underlying triangulation.
+   */
+  SmartPointer<const Triangulation<dim, spacedim>,
+               CompiledTriangulation<dim, spacedim>>
+    triangulation;
+
+  /**
+   * The level and index of each cell, used to construct iterators.
+   */
+  std::vector<std::pair<unsigned int, unsigned int>> cell_level_index;
+
+  /**
+   * The compiled index of each cell, indexed by
+   * CellAccessor::active_cell_index().
+   */
+  std::vector<unsigned int> active_to_compiled_index;
+
+  /**
+   * The vertex indices of all cells.
+   */
+  std::vector<unsigned int> vertex_index_data;
+
+  /**
+   * The face indices of all cells.
+   */
+  std::vector<unsigned int> face_index_data;
+
+  /**
+   * The compiled indices of the neighbors of all cells.
+   */
+  std::vector<unsigned int> neighbor_index_data;
+
+  /**
+   * The material ids of all cells.
+   */
+  std::vector<types::material_id> material_ids;
+
+  /**
+   * The boundary ids of the faces of all cells.
+   */
+  std::vector<types::boundary_id> face_boundary_ids;
+
+  /**
+   * The centers of all cells.
+   */
+  std::vector<Point<spacedim>> cell_centers;
+
+  /**
+   * Connections to the signals of the triangulation.
+   */
+  std::vector<boost::signals2::connection> tria_listeners;
+};
+
+
+
+/* ----------------------------- inline functions ----------------------- */
+
+#ifndef DOXYGEN
+
+template <int dim, int spacedim>
+inline const Triangulation<dim, spacedim> &
+CompiledTriangulation<dim, spacedim>::get_triangulation() const
+{
+  return *triangulation;
+}
+
+
+
+template <int dim, int spacedim>
+inline unsigned int
+CompiledTriangulation<dim, spacedim>::n_active_cells() const
+{
+  return cell_level_index.size();
+}
+
+
+
+template <int dim, int spacedim>
+inline typename Triangulation<dim, spacedim>::active_cell_iterator
+CompiledTriangulation<dim, spacedim>::get_cell_iterator(
+  const unsigned int index) const
+{
+  AssertIndexRange(index, n_active_cells());
+  return typename Triangulation<dim, spacedim>::active_cell_iterator(
+    &*triangulation,
+    cell_level_index[index].first,
+    cell_level_index[index].second);
+}
+
+
+
+template <int dim, int spacedim>
+inline unsigned int
+CompiledTriangulation<dim, spacedim>::compiled_index(
+  const typename Triangulation<dim, spacedim>::active_cell_iterator &cell) const
+{
+  Assert(&cell->get_triangulation() == &*triangulation,
+         ExcMessage("The cell does not belong to the triangulation of this "
+                    "object."));
+  AssertIndexRange(cell->active_cell_index(), active_to_compiled_index.size());
+  return active_to_compiled_index[cell->active_cell_index()];
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<unsigned int> &
+CompiledTriangulation<dim, spacedim>::get_vertex_indices() const
+{
+  return vertex_index_data;
+}
+
+
+
+template <int dim, int spacedim>
+inline ArrayView<const unsigned int>
+CompiledTriangulation<dim, spacedim>::vertex_indices(
+  const unsigned int index) const
+{
+  AssertIndexRange(index, n_active_cells());
+  return ArrayView<const unsigned int>(
+    vertex_index_data.data() + index * GeometryInfo<dim>::vertices_per_cell,
+    GeometryInfo<dim>::vertices_per_cell);
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<unsigned int> &
+CompiledTriangulation<dim, spacedim>::get_face_indices() const
+{
+  return face_index_data;
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<unsigned int> &
+CompiledTriangulation<dim, spacedim>::get_neighbor_indices() const
+{
+  return neighbor_index_data;
+}
+
+
+
+template <int dim, int spacedim>
+inline ArrayView<const unsigned int>
+CompiledTriangulation<dim, spacedim>::neighbor_indices(
+  const unsigned int index) const
+{
+  AssertIndexRange(index, n_active_cells());
+  return ArrayView<const unsigned int>(
+    neighbor_index_data.data() + index * GeometryInfo<dim>::faces_per_cell,
+    GeometryInfo<dim>::faces_per_cell);
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<types::material_id> &
+CompiledTriangulation<dim, spacedim>::get_material_ids() const
+{
+  return material_ids;
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<types::boundary_id> &
+CompiledTriangulation<dim, spacedim>::get_face_boundary_ids() const
+{
+  return face_boundary_ids;
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<Point<spacedim>> &
+CompiledTriangulation<dim, spacedim>::get_cell_centers() const
+{
+  return cell_centers;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -22,9 +22,13 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/types.h>
 
+#include <cstdint>
 #include <iostream>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -33,6 +37,7 @@ template <int dim, int space_dim>
 class Triangulation;
 template <int dim>
 struct CellData;
+struct SubCellData;
 
 /**
  * This class implements an input mechanism for grid data. It allows to read a
@@ -153,6 +158,10 @@ struct CellData;
  * The read_msh() function automatically determines whether an input file is
  * version 1 or version 2.
  *
+ * <li> <tt>Gmsh 4.1 mesh</tt> format: the current format written by @p Gmsh,
+ * both in its ASCII and its binary variant. Again, read_msh() determines the
+ * version automatically.
+ *
  * <li> <tt>Tecplot</tt> format: this format is used by @p TECPLOT and often
  * serves as a basis for data exchange between different applications. Note,
  * that currently only the ASCII format is supported, binary data cannot be
@@ -345,6 +354,31 @@ public:
   void
   attach_triangulation(Triangulation<dim, spacedim> &tria);
 
+  /**
+   * Declare that a mesh whose cells have the given @p fingerprint, as
+   * computed by GridReordering::compute_fingerprint() from the cells read
+   * from a file, is already consistently oriented. All <tt>read_*</tt>
+   * functions then pass it to the overload of GridReordering::reorder_cells()
+   * that skips the reordering for such a mesh. This is useful for large
+   * coarse meshes that are read in every run of a program: write the mesh
+   * once after it has been reordered, store the fingerprint of its cells,
+   * and set it here in later runs. If the cells of a file do not match the
+   * fingerprint, they are reordered as usual.
+   *
+   * The fingerprint to store is the one returned by get_fingerprint() after
+   * reading the reordered mesh, e.g., a file written by GridOut.
+   */
+  void
+  set_trusted_fingerprint(const std::uint64_t fingerprint);
+
+  /**
+   * Return the fingerprint, as computed by
+   * GridReordering::compute_fingerprint(), of the cells of the mesh read
+   * last, after they have been reordered. See set_trusted_fingerprint().
+   */
+  std::uint64_t
+  get_fingerprint() const;
+
   /**
    * Read from the given stream. If no format is given,
    * GridIn::Format::Default is used.
@@ -363,6 +397,11 @@ public:
   /**
    * Read grid data from an vtk file. Numerical data is ignored.
    *
+   * The file is parsed by the same hand-written tokenizer as the one used by
+   * read_msh(). Points, cells and material ids given one per line, as in the
+   * files written by deal.II, are parsed in parallel; other layouts are
+   * parsed sequentially.
+   *
    * @author Mayank Sabharwal, Andreas Putz, 2013
    */
   void
@@ -446,17 +485,60 @@ public:
   read_xda(std::istream &in);
 
   /**
-   * Read grid data from an msh file, either version 1 or version 2 of that
-   * file format. The Gmsh formats are documented at
-   * http://www.geuz.org/gmsh/.
+   * Read grid data from an msh file, in version 1, version 2 or version 4.1
+   * of that file format. Version 4.1 files may be either ASCII or binary.
+   * The Gmsh formats are documented at http://www.geuz.org/gmsh/.
+   *
+   * The file is read from the stream piece by piece and parsed by a
+   * hand-written tokenizer, independently of the locale. Large sections of
+   * nodes and elements are split at line breaks into chunks that are parsed
+   * in parallel.
    *
    * @note The input function of deal.II does not distinguish between newline
    * and other whitespace. Therefore, deal.II will be able to read files in a
-   * slightly more general format than Gmsh.
+   * slightly more general format than Gmsh. Such files are, however, parsed
+   * sequentially.
    */
   void
   read_msh(std::istream &in);
 
+  /**
+   * Read the vertices, cells and boundary information of a mesh in one of
+   * the formats understood by the function above, but return them in the
+   * output arguments instead of creating a triangulation. Together with the
+   * @p cell_range argument, this allows each process of a parallel program
+   * to read only its own part of a large coarse mesh.
+   *
+   * Only the cells whose position among all cells of the file lies in the
+   * half-open range @p cell_range are returned. Lower-dimensional elements
+   * describing boundary faces are not counted. The vertices are
+   * renumbered consecutively, and vertices not used by any returned cell are
+   * removed. Boundary information is kept for the faces whose vertices all
+   * belong to the returned cells. The default range returns all cells.
+   * If the range is restricted, the elements of the file still have to be
+   * scanned as a whole to find the cells in the range, but only the
+   * elements of the returned cells and the boundary elements are kept in
+   * memory. If the stream supports positioning, as files do, the nodes are
+   * read after the elements, and only those of the returned cells are
+   * kept. Otherwise, all nodes are read first and the others are removed
+   * afterwards.
+   *
+   * In 1d, the boundary indicators assigned to vertices are returned in
+   * @p vertex_boundary_ids, indexed by the numbers of the returned vertices.
+   * In higher dimensions, this map is left empty.
+   *
+   * The data is returned as read from the file. In particular, it has not
+   * been passed through GridReordering::reorder_cells().
+   */
+  static void
+  read_msh(std::istream &                               in,
+           std::vector<Point<spacedim>> &               vertices,
+           std::vector<CellData<dim>> &                 cells,
+           SubCellData &                                subcelldata,
+           std::map<unsigned int, types::boundary_id> & vertex_boundary_ids,
+           const std::pair<unsigned int, unsigned int> &cell_range =
+             std::make_pair(0U, numbers::invalid_unsigned_int));
+
   /**
    * Read grid data from a NetCDF file. The only data format currently
    * supported is the <tt>TAU grid format</tt>.
@@ -694,10 +776,30 @@ private:
                        bool &                     structured,
                        bool &                     blocked);
 
+  /**
+   * Call GridReordering::reorder_cells() on the cells read from a file,
+   * passing the fingerprint given to set_trusted_fingerprint() if any, and
+   * store the fingerprint of the result.
+   */
+  void
+  reorder_cells(std::vector<CellData<dim>> &cells);
+
   /**
    * Input format used by read() if no format is given.
    */
   Format default_format;
+
+  /**
+   * Whether set_trusted_fingerprint() was called, and the fingerprint it was
+   * given.
+   */
+  bool          has_trusted_fingerprint;
+  std::uint64_t trusted_fingerprint;
+
+  /**
+   * The fingerprint of the cells of the mesh read last.
+   */
+  std::uint64_t last_fingerprint;
 };
 
 /* -------------- declaration of explicit specializations ------------- */
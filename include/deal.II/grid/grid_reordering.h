@@ -21,6 +21,7 @@
 
 #include <deal.II/grid/tria.h>
 
+#include <cstdint>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -651,6 +652,39 @@ public:
   reorder_cells(std::vector<CellData<dim>> &original_cells,
                 const bool                  use_new_style_ordering = false);
 
+  /**
+   * Like the function above, but skip all work if the cells are known to
+   * be consistently oriented already. This is the case if the fingerprint
+   * of @p original_cells, as computed by compute_fingerprint(), equals
+   * @p trusted_fingerprint. Otherwise, the cells are reordered as above.
+   *
+   * This is useful for very large coarse meshes that are read again and
+   * again, for example in every run of a parallel program in which each
+   * process stores the entire coarse mesh: after the first run, one can
+   * write the reordered mesh to a file and store the fingerprint of the
+   * reordered cells along with it. Later runs then only need to compute
+   * the fingerprint, which is much cheaper than checking the orientation.
+   *
+   * @note The fingerprint is a hash value. Two different lists of cells
+   * have the same fingerprint only with a negligible probability, but the
+   * function does not otherwise verify that the cells are consistently
+   * oriented.
+   */
+  static void
+  reorder_cells(std::vector<CellData<dim>> &original_cells,
+                const bool                  use_new_style_ordering,
+                const std::uint64_t         trusted_fingerprint);
+
+  /**
+   * Compute a 64-bit hash value of the vertex indices of the given cells.
+   * The value depends on the order of the cells as well as the order of
+   * the vertices within each cell, but not on the material ids or other
+   * data attached to the cells. See the reorder_cells() function taking a
+   * fingerprint for its use.
+   */
+  static std::uint64_t
+  compute_fingerprint(const std::vector<CellData<dim>> &cells);
+
   /**
    * Grids generated by grid generators may have an orientation of cells which
    * is the inverse of the orientation required by deal.II.
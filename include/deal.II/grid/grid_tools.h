@@ -315,6 +315,50 @@ namespace GridTools
                              std::vector<unsigned int> &   considered_vertices,
                              const double                  tol = 1e-12);
 
+  /**
+   * Return the order in which a Hilbert curve through the bounding box
+   * @p bounding_box visits the given @p points, i.e., the index of the point
+   * visited first, the index of the point visited second, and so on. Points
+   * that fall into the same (very small) box of the curve keep their relative
+   * order.
+   *
+   * Sorting objects this way is a cheap way to number them such that objects
+   * close to each other in space also have close numbers. This is used, for
+   * example, by hilbert_renumbering().
+   */
+  template <int spacedim>
+  std::vector<unsigned int>
+  hilbert_order(const std::vector<Point<spacedim>> &points,
+                const BoundingBox<spacedim> &       bounding_box);
+
+  /**
+   * Renumber the coarse cells and the vertices of a triangulation such that
+   * cells and vertices that are close to each other in space also have close
+   * indices. Meshes read by GridIn or produced by an external mesh generator
+   * are numbered in the order of the input file, which is often almost
+   * random. Since all loops over cells and all per-vertex arrays follow these
+   * numbers, such meshes make poor use of caches.
+   *
+   * The cells are sorted along a Hilbert curve through their centers (see
+   * hilbert_order()), and the vertices are then numbered in the order in
+   * which the sorted cells first reference them. Vertices that are not used
+   * by any cell are removed.
+   *
+   * The triangulation is recreated from the renumbered cells, keeping the
+   * material and manifold ids of the cells, the boundary and manifold ids of
+   * all faces (and, in 3d, of all edges), and the manifold objects attached
+   * to the manifold ids in use. Since this clears the triangulation, all
+   * other information, such as user flags and periodic face pairs, is lost,
+   * and objects that depend on the triangulation, such as a DoFHandler, need
+   * to be reinitialized. It is therefore best to call this function right
+   * after the coarse mesh has been created.
+   *
+   * @note The triangulation must not be refined.
+   */
+  template <int dim, int spacedim>
+  void
+  hilbert_renumbering(Triangulation<dim, spacedim> &triangulation);
+
   /*@}*/
   /**
    * @name Rotating, stretching and otherwise transforming meshes
@@ -3130,6 +3130,28 @@ public:
   virtual types::subdomain_id
   locally_owned_subdomain() const;
 
+  /**
+   * Return the globally unique id of the cell with index
+   * @p coarse_cell_index on the coarsest level. This id is the first
+   * component of the CellId of the cell and all of its descendants.
+   *
+   * For all triangulations that store the complete coarse mesh, the id is
+   * simply the index of the cell. Triangulations that only store a part of
+   * the coarse mesh on each processor, such as
+   * parallel::fullydistributed::Triangulation, override this function to
+   * return an id that is the same on all processors.
+   */
+  virtual unsigned int
+  coarse_cell_index_to_coarse_cell_id(
+    const unsigned int coarse_cell_index) const;
+
+  /**
+   * The inverse of coarse_cell_index_to_coarse_cell_id(): return the index
+   * on the coarsest level of the cell with the given globally unique id.
+   */
+  virtual unsigned int
+  coarse_cell_id_to_coarse_cell_index(const unsigned int coarse_cell_id) const;
+
   /**
    * Return a reference to the current object.
    *
@@ -23,12 +23,14 @@
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_element_access.h>
 
 #include <boost/range/iterator_range.hpp>
 
+#include <memory>
 #include <set>
 #include <utility>
 #include <vector>
@@ -46,6 +48,23 @@ class SparseMatrix;
 template <typename number>
 class BlockSparseMatrix;
 
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    class Partitioner;
+  }
+} // namespace Utilities
+
 namespace internals
 {
   template <typename number>
@@ -1172,6 +1191,19 @@ public:
    *
    * @note If this function is called with a parallel vector @p vec, then the
    * vector must not contain ghost elements.
+   *
+   * @note For vectors of type LinearAlgebra::distributed::Vector, the
+   * translation of the global indices of the constraints into local indices
+   * of the vector as well as the set of ghost elements that need to be
+   * imported are computed on the first call for a given partitioner and
+   * stored in the current object. Subsequent calls with vectors sharing the
+   * same (or an equivalent) partitioner reuse this information and apply the
+   * constraints in parallel on the locally owned elements, using the
+   * threading capabilities of the library. Since closed constraints never
+   * refer to other constrained degrees of freedom, the individual constraint
+   * lines are independent of each other. The information is discarded
+   * whenever the constraints are changed by close(), clear(), reinit(),
+   * shift(), or copy_from().
    */
   template <class VectorType>
   void
@@ -1470,6 +1502,77 @@ private:
    */
   bool sorted;
 
+  /**
+   * A data structure that stores the constraints in terms of local indices
+   * of a LinearAlgebra::distributed::Vector with a particular parallel
+   * partitioning. It is used by distribute() to avoid the translation of
+   * global to local indices and the setup of the ghosted import vector on
+   * every call.
+   */
+  struct DistributeIndexCache
+  {
+    /**
+     * The locally owned range of the vectors the local indices below refer
+     * to.
+     */
+    IndexSet owned_elements;
+
+    /**
+     * The communicator of the vectors the local indices below refer to.
+     */
+    MPI_Comm communicator;
+
+    /**
+     * A partitioner with the locally owned range @p owned_elements, and all
+     * elements as ghosts that locally owned constraints refer to but that
+     * are owned by other processors.
+     */
+    std::shared_ptr<const Utilities::MPI::Partitioner> ghosted_partitioner;
+
+    /**
+     * The position in AffineConstraints::lines of each locally owned
+     * constrained degree of freedom. Used for access to the inhomogeneity,
+     * which may still be changed after close().
+     */
+    std::vector<size_type> line_numbers;
+
+    /**
+     * The local index of each locally owned constrained degree of freedom
+     * within the locally owned range.
+     */
+    std::vector<unsigned int> constrained_local_indices;
+
+    /**
+     * Offsets into @p entry_local_indices and @p entry_values for each of the
+     * lines, in compressed row storage format. Has one element more than
+     * there are locally owned constrained degrees of freedom.
+     */
+    std::vector<unsigned int> row_starts;
+
+    /**
+     * Indices of the entries of all lines in terms of local indices of a
+     * vector based on @p ghosted_partitioner.
+     */
+    std::vector<unsigned int> entry_local_indices;
+
+    /**
+     * Weights of the entries of all lines.
+     */
+    std::vector<number> entry_values;
+  };
+
+  /**
+   * The index translation for the partitioner of the vector last passed to
+   * distribute(). Set up lazily and reset whenever the constraints change.
+   */
+  mutable std::shared_ptr<const DistributeIndexCache> distribute_index_cache;
+
+  /**
+   * A mutex guarding access to @p distribute_index_cache when distribute()
+   * is called concurrently from several threads.
+   */
+  mutable Threads::Mutex distribute_index_cache_mutex;
+
   /**
    * Internal function to calculate the index of line @p line in the vector
    * lines_cache using local_lines.
@@ -1484,6 +1587,31 @@ private:
   static bool
   check_zero_weight(const std::pair<size_type, number> &p);
 
+  /**
+   * Implementation of distribute() for general vector types.
+   */
+  template <class VectorType>
+  void
+  do_distribute(VectorType &vec) const;
+
+  /**
+   * Implementation of distribute() for LinearAlgebra::distributed::Vector,
+   * working on local indices set up by get_distribute_index_cache().
+   */
+  template <typename VectorNumber>
+  void
+  do_distribute(LinearAlgebra::distributed::Vector<VectorNumber> &vec) const;
+
+  /**
+   * Return the translation of the locally owned constraints into local
+   * indices for the given partitioner, computing it if the partitioner
+   * differs from the one seen in the previous call.
+   */
+  std::shared_ptr<const DistributeIndexCache>
+  get_distribute_index_cache(
+    const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
+    const;
+
   /**
    * This function actually implements the local_to_global function for
    * standard (non-block) matrices.
@@ -16,7 +16,12 @@
 #ifndef dealii_affine_constraints_templates_h
 #define dealii_affine_constraints_templates_h
 
+#include <deal.II/base/frozen_index_set.h>
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/partitioner.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -44,6 +49,7 @@
 #include <deal.II/lac/trilinos_parallel_block_vector.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #include <deal.II/lac/trilinos_vector.h>
+#include <deal.II/lac/vector_memory.h>
 
 #include <boost/serialization/complex.hpp>
 #include <boost/serialization/utility.hpp>
@@ -67,6 +73,8 @@ AffineConstraints<number>::copy_from(const AffineConstraints<number> &other)
   lines_cache = other.lines_cache;
   local_lines = other.local_lines;
   sorted      = other.sorted;
+
+  distribute_index_cache.reset();
 }
 
 
@@ -299,21 +307,30 @@ AffineConstraints<number>::add_selected_constraints(
 
   Assert(filter.size() > constraints.lines.back().index,
          ExcMessage("Filter needs to be larger than constraint matrix size."));
+
+  // the filter is queried for every constrained index and every entry, so
+  // use a representation that answers these queries fast also for
+  // fragmented filters
+  const FrozenIndexSet frozen_filter(filter);
   for (typename std::vector<ConstraintLine>::const_iterator line =
          constraints.lines.begin();
        line != constraints.lines.end();
        ++line)
-    if (filter.is_element(line->index))
-      {
-        const size_type row = filter.index_within_set(line->index);
-        add_line(row);
-        set_inhomogeneity(row, line->inhomogeneity);
-        for (size_type i = 0; i < line->entries.size(); ++i)
-          if (filter.is_element(line->entries[i].first))
-            add_entry(row,
-                      filter.index_within_set(line->entries[i].first),
-                      line->entries[i].second);
-      }
+    {
+      const size_type row = frozen_filter.index_within_set(line->index);
+      if (row != numbers::invalid_dof_index)
+        {
+          add_line(row);
+          set_inhomogeneity(row, line->inhomogeneity);
+          for (size_type i = 0; i < line->entries.size(); ++i)
+            {
+              const size_type column =
+                frozen_filter.index_within_set(line->entries[i].first);
+              if (column != numbers::invalid_dof_index)
+                add_entry(row, column, line->entries[i].second);
+            }
+        }
+    }
 }
 
 
@@ -325,6 +342,10 @@ AffineConstraints<number>::close()
   if (sorted == true)
     return;
 
+  DEAL_II_INSTRUMENT_REGION("AffineConstraints::close");
+
+  distribute_index_cache.reset();
+
   // sort the lines
   std::sort(lines.begin(), lines.end());
 
@@ -808,6 +829,8 @@ AffineConstraints<number>::shift(const size_type offset)
         j->first += offset;
     }
 
+  distribute_index_cache.reset();
+
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
   // are still linked correctly
@@ -835,6 +858,8 @@ AffineConstraints<number>::clear()
   }
 
   sorted = false;
+
+  distribute_index_cache.reset();
 }
 
 
@@ -2267,6 +2292,139 @@ AffineConstraints<number>::distribute(VectorType &vec) const
 {
   Assert(sorted == true, ExcMatrixNotClosed());
 
+  do_distribute(vec);
+}
+
+
+
+template <typename number>
+std::shared_ptr<const typename AffineConstraints<number>::DistributeIndexCache>
+AffineConstraints<number>::get_distribute_index_cache(
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner) const
+{
+  Assert(partitioner.get() != nullptr, ExcNotInitialized());
+
+  Threads::Mutex::ScopedLock lock(distribute_index_cache_mutex);
+
+  // reuse the previous translation if the vector has the same locally owned
+  // range and communicator as the one it was computed for. setting up a new
+  // translation creates a new partitioner, which is a collective operation,
+  // so all processors need to come to the same decision
+  const IndexSet &owned_elements = partitioner->locally_owned_range();
+  const bool      can_reuse_cache =
+    distribute_index_cache.get() != nullptr &&
+    distribute_index_cache->communicator ==
+      partitioner->get_mpi_communicator() &&
+    distribute_index_cache->owned_elements == owned_elements;
+  if (Utilities::MPI::min(static_cast<unsigned int>(can_reuse_cache),
+                          partitioner->get_mpi_communicator()) == 1)
+    return distribute_index_cache;
+
+  std::shared_ptr<DistributeIndexCache> cache =
+    std::make_shared<DistributeIndexCache>();
+  cache->owned_elements = owned_elements;
+  cache->communicator   = partitioner->get_mpi_communicator();
+
+  const std::pair<types::global_dof_index, types::global_dof_index>
+    local_range = partitioner->local_range();
+
+  // first collect the elements we need to import from other processors
+  IndexSet ghost_elements(owned_elements.size());
+  std::size_t n_entries = 0;
+  for (const ConstraintLine &line : lines)
+    if (line.index >= local_range.first && line.index < local_range.second)
+      {
+        n_entries += line.entries.size();
+        for (const std::pair<size_type, number> &entry : line.entries)
+          if (entry.first < local_range.first ||
+              entry.first >= local_range.second)
+            ghost_elements.add_index(entry.first);
+      }
+  ghost_elements.compress();
+
+  cache->ghosted_partitioner =
+    std::make_shared<const Utilities::MPI::Partitioner>(
+      owned_elements, ghost_elements, partitioner->get_mpi_communicator());
+  const Utilities::MPI::Partitioner &ghosted_partitioner =
+    *cache->ghosted_partitioner;
+
+  // then translate the constraints into local indices with respect to the
+  // ghosted partitioner, stored contiguously in compressed row format
+  cache->entry_local_indices.reserve(n_entries);
+  cache->entry_values.reserve(n_entries);
+  cache->row_starts.push_back(0);
+  for (size_type l = 0; l < lines.size(); ++l)
+    if (lines[l].index >= local_range.first &&
+        lines[l].index < local_range.second)
+      {
+        cache->line_numbers.push_back(l);
+        cache->constrained_local_indices.push_back(
+          static_cast<unsigned int>(lines[l].index - local_range.first));
+        for (const std::pair<size_type, number> &entry : lines[l].entries)
+          {
+            cache->entry_local_indices.push_back(
+              ghosted_partitioner.global_to_local(entry.first));
+            cache->entry_values.push_back(entry.second);
+          }
+        cache->row_starts.push_back(cache->entry_local_indices.size());
+      }
+
+  distribute_index_cache = cache;
+  return distribute_index_cache;
+}
+
+
+
+template <typename number>
+template <typename VectorNumber>
+void
+AffineConstraints<number>::do_distribute(
+  LinearAlgebra::distributed::Vector<VectorNumber> &vec) const
+{
+  const std::shared_ptr<const DistributeIndexCache> cache =
+    get_distribute_index_cache(vec.get_partitioner());
+
+  // import the source elements of the locally owned constraints. the input
+  // vector is not allowed to have ghost elements set, so we need a separate
+  // vector for reading the values. take it from the vector pool, where it
+  // usually keeps the ghosted layout from the previous call
+  GrowingVectorMemory<LinearAlgebra::distributed::Vector<VectorNumber>> memory;
+  typename VectorMemory<LinearAlgebra::distributed::Vector<VectorNumber>>::
+    Pointer ghosted_vector(memory);
+  if (ghosted_vector->get_partitioner() != cache->ghosted_partitioner)
+    ghosted_vector->reinit(cache->ghosted_partitioner);
+  ghosted_vector->copy_locally_owned_data_from(vec);
+  ghosted_vector->update_ghost_values();
+
+  // the lines of closed constraints never refer to other constrained
+  // degrees of freedom, so all lines can be processed independently
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    cache->line_numbers.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          VectorNumber new_value = lines[cache->line_numbers[i]].inhomogeneity;
+          for (unsigned int j = cache->row_starts[i];
+               j < cache->row_starts[i + 1];
+               ++j)
+            new_value +=
+              ghosted_vector->local_element(cache->entry_local_indices[j]) *
+              cache->entry_values[j];
+          AssertIsFinite(new_value);
+          vec.local_element(cache->constrained_local_indices[i]) = new_value;
+        }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <class VectorType>
+void
+AffineConstraints<number>::do_distribute(VectorType &vec) const
+{
   // if the vector type supports parallel storage and if the vector actually
   // does store only part of the vector, distributing is slightly more
   // complicated. we might be able to skip the complicated part if one
@@ -20,6 +20,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/template_constraints.h>
@@ -900,6 +901,29 @@ private:
  * destination vectors are necessary for these computations and this
  * information gets only available through vmult().
  *
+ * As an alternative to the conjugate gradient method (which corresponds to a
+ * Lanczos iteration), the largest eigenvalue can also be estimated with a
+ * power iteration by setting
+ * PreconditionChebyshev::AdditionalData::eigenvalue_algorithm to
+ * AdditionalData::EigenvalueAlgorithm::power_iteration. The power iteration
+ * needs more iterations than the Lanczos iteration when started from scratch,
+ * but it does not rely on symmetry of the preconditioned matrix. Moreover, it
+ * keeps the eigenvector from its last invocation and uses it as a starting
+ * guess when the eigenvalues are estimated again, for example after a call
+ * to initialize() with a slightly modified matrix, in which case it typically
+ * converges in few iterations.
+ *
+ * The estimate of the eigenvalues can be queried with
+ * get_eigenvalue_information() or computed explicitly by
+ * estimate_eigenvalues(). This allows to store the estimate alongside the
+ * matrix and to hand it back for later computations, either through
+ * PreconditionChebyshev::AdditionalData::max_eigenvalue as described below or
+ * by setting PreconditionChebyshev::AdditionalData::reuse_eigenvalue_estimate
+ * in order to keep the estimate of the previous initialize() call for a
+ * matrix that changes only slightly, for example between time steps. A new
+ * estimate is then only computed once the user calls estimate_eigenvalues(),
+ * e.g. triggered by an error indicator.
+ *
  * The estimation of eigenvalues can also be bypassed by setting
  * PreconditionChebyshev::AdditionalData::eig_cg_n_iterations to zero and
  * providing sensible values for the largest eigenvalues in the field
@@ -972,15 +996,39 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * An enum to define the available algorithms to estimate the largest
+     * eigenvalue of the preconditioned matrix.
+     */
+    enum class EigenvalueAlgorithm
+    {
+      /**
+       * Use the conjugate gradient method, which is equivalent to a Lanczos
+       * iteration, to estimate the eigenvalues. This requires the
+       * preconditioned matrix to be symmetric and positive definite.
+       */
+      lanczos,
+
+      /**
+       * Use a power iteration to estimate the largest eigenvalue. The
+       * eigenvector of the last estimation is used as a starting guess for
+       * subsequent estimations.
+       */
+      power_iteration
+    };
+
     /**
      * Constructor.
      */
-    AdditionalData(const unsigned int degree              = 0,
-                   const double       smoothing_range     = 0.,
-                   const bool         nonzero_starting    = false,
-                   const unsigned int eig_cg_n_iterations = 8,
-                   const double       eig_cg_residual     = 1e-2,
-                   const double       max_eigenvalue      = 1);
+    AdditionalData(
+      const unsigned int        degree              = 0,
+      const double              smoothing_range     = 0.,
+      const bool                nonzero_starting    = false,
+      const unsigned int        eig_cg_n_iterations = 8,
+      const double              eig_cg_residual     = 1e-2,
+      const double              max_eigenvalue      = 1,
+      const EigenvalueAlgorithm eigenvalue_algorithm =
+        EigenvalueAlgorithm::lanczos);
 
     /**
      * This determines the degree of the Chebyshev polynomial. The degree of
@@ -1023,15 +1071,17 @@ public:
     bool nonzero_starting DEAL_II_DEPRECATED;
 
     /**
-     * Maximum number of CG iterations performed for finding the maximum
-     * eigenvalue. If set to zero, no computations are performed and the
-     * eigenvalues according to the given input are used instead.
+     * Maximum number of CG iterations (or power iterations, see @p
+     * eigenvalue_algorithm) performed for finding the maximum eigenvalue. If
+     * set to zero, no computations are performed and the eigenvalues
+     * according to the given input are used instead.
      */
     unsigned int eig_cg_n_iterations;
 
     /**
      * Tolerance for CG iterations performed for finding the maximum
-     * eigenvalue.
+     * eigenvalue. For the power iteration, this is the tolerance on the
+     * relative change of the eigenvalue estimate between two iterations.
      */
     double eig_cg_residual;
 
@@ -1042,6 +1092,26 @@ public:
      */
     double max_eigenvalue;
 
+    /**
+     * The algorithm used to estimate the largest eigenvalue. The power
+     * iteration only gives an estimate of the largest eigenvalue, so it
+     * requires @p smoothing_range to be larger than one.
+     */
+    EigenvalueAlgorithm eigenvalue_algorithm;
+
+    /**
+     * If set to true, a call to initialize() keeps the eigenvalue estimate
+     * computed for the matrix passed to the previous call of initialize(),
+     * provided the matrix size did not change, instead of computing a new
+     * estimate during the next vmult(). Only the eigenvalue bounds are kept,
+     * the temporary vectors are set up again with the layout of the first
+     * vector passed to vmult() after initialize(). This is useful for
+     * matrices that change only slightly, for example between time steps. A
+     * new estimate can be requested at any time by calling
+     * estimate_eigenvalues().
+     */
+    bool reuse_eigenvalue_estimate;
+
     /**
      * Stores the inverse of the diagonal of the underlying matrix.
      *
@@ -1056,6 +1126,45 @@ public:
   };
 
 
+  /**
+   * A struct that collects the result of the estimation of the eigenvalues
+   * of the preconditioned matrix.
+   */
+  struct EigenvalueInformation
+  {
+    /**
+     * Estimate for the smallest eigenvalue of the interval the Chebyshev
+     * polynomial acts on.
+     */
+    double min_eigenvalue_estimate;
+
+    /**
+     * Estimate for the largest eigenvalue, including the safety factor
+     * applied to the result of the eigenvalue computation. This value can
+     * be passed to AdditionalData::max_eigenvalue in order to skip the
+     * eigenvalue computation in later runs.
+     */
+    double max_eigenvalue_estimate;
+
+    /**
+     * Number of iterations performed for the eigenvalue estimate, or zero if
+     * no computation was performed.
+     */
+    unsigned int cg_iterations;
+
+    /**
+     * The degree of the Chebyshev polynomial, which is computed from the
+     * eigenvalue estimate if AdditionalData::degree is set to
+     * numbers::invalid_unsigned_int.
+     */
+    unsigned int degree;
+
+    /**
+     * Constructor initializing with invalid values.
+     */
+    EigenvalueInformation();
+  };
+
   PreconditionChebyshev();
 
   /**
@@ -1065,14 +1174,35 @@ public:
    * accessing all the elements in the diagonal. Alternatively, the diagonal
    * can be supplied with the help of the AdditionalData field.
    *
-   * This function calculates an estimate of the eigenvalue range of the
-   * matrix weighted by its diagonal using a modified CG iteration in case the
-   * given number of iterations is positive.
+   * The estimate of the eigenvalue range of the matrix weighted by its
+   * diagonal is computed during the first call to vmult() or a similar
+   * function, unless AdditionalData::reuse_eigenvalue_estimate is set and an
+   * estimate for a matrix of the same size is available.
    */
   void
   initialize(const MatrixType &    matrix,
              const AdditionalData &additional_data = AdditionalData());
 
+  /**
+   * Compute an estimate of the eigenvalues of the preconditioned matrix
+   * with the algorithm selected in AdditionalData, or take the values given
+   * in AdditionalData in case AdditionalData::eig_cg_n_iterations is zero,
+   * and set up the Chebyshev iteration accordingly. The vector @p src is only
+   * used to set up the layout of temporary vectors. In contrast to vmult(),
+   * which only computes an estimate if none is available, this function
+   * always computes a new estimate.
+   */
+  EigenvalueInformation
+  estimate_eigenvalues(const VectorType &src) const;
+
+  /**
+   * Return the information about the eigenvalue estimate currently in use.
+   * If no estimate has been computed yet, the fields of the returned object
+   * are invalid.
+   */
+  const EigenvalueInformation &
+  get_eigenvalue_information() const;
+
   /**
    * Compute the action of the preconditioner on <tt>src</tt>, storing the
    * result in <tt>dst</tt>.
@@ -1166,6 +1296,29 @@ private:
    */
   bool eigenvalues_are_initialized;
 
+  /**
+   * Stores whether the temporary vectors have been set up with the layout
+   * of the vectors passed to vmult() since the last call to initialize().
+   */
+  bool temporaries_are_initialized;
+
+  /**
+   * The result of the last eigenvalue estimate.
+   */
+  EigenvalueInformation eigenvalue_information;
+
+  /**
+   * The number of rows of the matrix for which the current eigenvalue
+   * estimate has been computed.
+   */
+  size_type eigenvalue_estimate_size;
+
+  /**
+   * The eigenvector computed by the last power iteration, used as a
+   * starting guess for subsequent power iterations.
+   */
+  mutable VectorType eigenvector_estimate;
+
   /**
    * A mutex to avoid that multiple vmult() invocations by different threads
    * overwrite the temporary vectors.
@@ -1192,10 +1345,17 @@ private:
    * Initializes the factors theta and delta based on an eigenvalue
    * computation. If the user set provided values for the largest eigenvalue
    * in AdditionalData, no computation is performed and the information given
-   * by the user is used.
+   * by the user is used. Expects the mutex to be held by the caller.
    */
   void
-  estimate_eigenvalues(const VectorType &src) const;
+  do_estimate_eigenvalues(const VectorType &src) const;
+
+  /**
+   * Sets up the layout of the temporary vectors from the vector @p src.
+   * Expects the mutex to be held by the caller.
+   */
+  void
+  initialize_temporaries(const VectorType &src) const;
 };
 
 
@@ -2033,6 +2193,63 @@ namespace internal
       vector.add(-mean_value);
     }
 
+    /**
+     * Factor by which the largest eigenvalue found by the CG or power
+     * iteration is enlarged. Both iterations will in general not be converged
+     * and approach the largest eigenvalue from below, whereas the Chebyshev
+     * iteration amplifies eigenvalues above the assumed upper bound.
+     */
+    constexpr double safety_factor = 1.2;
+
+    // reduce a decision over the processors that own parts of the given
+    // vector. vectors without a communicator are serial
+    template <typename VectorType>
+    inline auto
+    all_processors_agree(const bool        local_decision,
+                         const VectorType &vector,
+                         int) -> decltype(vector.get_mpi_communicator(), bool())
+    {
+      return Utilities::MPI::min(static_cast<unsigned int>(local_decision),
+                                 vector.get_mpi_communicator()) == 1;
+    }
+
+    template <typename VectorType>
+    inline auto
+    all_processors_agree(const bool        local_decision,
+                         const VectorType &vector,
+                         long)
+      -> decltype(vector.block(0).get_mpi_communicator(), bool())
+    {
+      if (vector.n_blocks() == 0)
+        return local_decision;
+      return Utilities::MPI::min(static_cast<unsigned int>(local_decision),
+                                 vector.block(0).get_mpi_communicator()) == 1;
+    }
+
+    template <typename VectorType>
+    inline bool
+    all_processors_agree(const bool local_decision, const VectorType &, ...)
+    {
+      return local_decision;
+    }
+
+    // return whether the eigenvector estimate of a previous call can be used
+    // as start vector for the power iteration on vectors laid out like
+    // @p src. resetting the estimate involves global reductions, so all
+    // processors need to come to the same decision
+    template <typename VectorType>
+    inline bool
+    can_reuse_eigenvector_estimate(const VectorType &estimate,
+                                   const VectorType &src)
+    {
+      if (estimate.size() != src.size())
+        return false;
+      const bool same_layout =
+        estimate.locally_owned_elements() == src.locally_owned_elements();
+      return all_processors_agree(same_layout, src, 0) &&
+             estimate.l2_norm() != 0.;
+    }
+
     struct EigenvalueTracker
     {
     public:
@@ -2044,6 +2261,49 @@ namespace internal
 
       std::vector<double> values;
     };
+
+    // Estimate the largest eigenvalue of the matrix preconditioned by
+    // preconditioner with a power iteration, starting from the vector
+    // eigenvector that is overwritten by the approximate eigenvector. The
+    // iteration stops once the relative change in the eigenvalue estimate
+    // falls below the given tolerance. The vectors tmp1 and tmp2 need to
+    // have the same layout as eigenvector.
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    double
+    power_iteration(const MatrixType &        matrix,
+                    const PreconditionerType &preconditioner,
+                    const unsigned int        max_iterations,
+                    const double              tolerance,
+                    VectorType &              eigenvector,
+                    VectorType &              tmp1,
+                    VectorType &              tmp2,
+                    unsigned int &            n_iterations)
+    {
+      double eigenvalue_estimate = 0.;
+      eigenvector /= eigenvector.l2_norm();
+      for (n_iterations = 0; n_iterations < max_iterations;)
+        {
+          matrix.vmult(tmp1, eigenvector);
+          preconditioner.vmult(tmp2, tmp1);
+          ++n_iterations;
+
+          const double new_estimate = std::abs(eigenvector * tmp2);
+          const double norm         = tmp2.l2_norm();
+          if (norm == 0.)
+            return new_estimate;
+
+          eigenvector.equ(1. / norm, tmp2);
+          const bool converged =
+            std::abs(new_estimate - eigenvalue_estimate) <=
+            tolerance * new_estimate;
+          eigenvalue_estimate = new_estimate;
+          if (converged)
+            break;
+        }
+      return eigenvalue_estimate;
+    }
   } // namespace PreconditionChebyshevImplementation
 } // namespace internal
 
@@ -2053,18 +2313,33 @@ namespace internal
 
 template <typename MatrixType, class VectorType, typename PreconditionerType>
 inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
-  AdditionalData::AdditionalData(const unsigned int degree,
-                                 const double       smoothing_range,
-                                 const bool         nonzero_starting,
-                                 const unsigned int eig_cg_n_iterations,
-                                 const double       eig_cg_residual,
-                                 const double       max_eigenvalue)
+  AdditionalData::AdditionalData(
+    const unsigned int        degree,
+    const double              smoothing_range,
+    const bool                nonzero_starting,
+    const unsigned int        eig_cg_n_iterations,
+    const double              eig_cg_residual,
+    const double              max_eigenvalue,
+    const EigenvalueAlgorithm eigenvalue_algorithm)
   : degree(degree)
   , smoothing_range(smoothing_range)
   , nonzero_starting(nonzero_starting)
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , eigenvalue_algorithm(eigenvalue_algorithm)
+  , reuse_eigenvalue_estimate(false)
+{}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  EigenvalueInformation::EigenvalueInformation()
+  : min_eigenvalue_estimate(std::numeric_limits<double>::max())
+  , max_eigenvalue_estimate(std::numeric_limits<double>::lowest())
+  , cg_iterations(0)
+  , degree(0)
 {}
 
 
@@ -2075,6 +2350,8 @@ inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   : theta(1.)
   , delta(1.)
   , eigenvalues_are_initialized(false)
+  , temporaries_are_initialized(false)
+  , eigenvalue_estimate_size(numbers::invalid_size_type)
 {
   static_assert(
     std::is_same<size_type, typename VectorType::size_type>::value,
@@ -2091,11 +2368,22 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
   const MatrixType &    matrix,
   const AdditionalData &additional_data)
 {
-  matrix_ptr = &matrix;
-  data       = additional_data;
+  matrix_ptr                  = &matrix;
+  data                        = additional_data;
+  temporaries_are_initialized = false;
   internal::PreconditionChebyshevImplementation::initialize_preconditioner(
     matrix, data.preconditioner, data.matrix_diagonal_inverse);
-  eigenvalues_are_initialized = false;
+
+  // keep the previous estimate if requested, including the degree that
+  // might have been computed from it
+  if (data.reuse_eigenvalue_estimate && eigenvalues_are_initialized &&
+      eigenvalue_estimate_size == matrix.m())
+    {
+      if (data.degree == numbers::invalid_unsigned_int)
+        data.degree = eigenvalue_information.degree;
+    }
+  else
+    eigenvalues_are_initialized = false;
 }
 
 
@@ -2105,6 +2393,9 @@ inline void
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
 {
   eigenvalues_are_initialized = false;
+  temporaries_are_initialized = false;
+  eigenvalue_information      = EigenvalueInformation();
+  eigenvalue_estimate_size    = numbers::invalid_size_type;
   theta = delta = 1.0;
   matrix_ptr    = nullptr;
   {
@@ -2113,28 +2404,91 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
     update1.reinit(empty_vector);
     update2.reinit(empty_vector);
     update3.reinit(empty_vector);
+    eigenvector_estimate.reinit(empty_vector);
   }
   data.preconditioner.reset();
 }
 
 
 
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline
+  typename PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+    EigenvalueInformation
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+      estimate_eigenvalues(const VectorType &src) const
+{
+  Threads::Mutex::ScopedLock lock(mutex);
+  do_estimate_eigenvalues(src);
+  return eigenvalue_information;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline const typename PreconditionChebyshev<MatrixType,
+                                            VectorType,
+                                            PreconditionerType>::
+  EigenvalueInformation &
+  PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+    get_eigenvalue_information() const
+{
+  return eigenvalue_information;
+}
+
+
+
 template <typename MatrixType, typename VectorType, typename PreconditionerType>
 inline void
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
-  estimate_eigenvalues(const VectorType &src) const
+  do_estimate_eigenvalues(const VectorType &src) const
 {
-  Assert(eigenvalues_are_initialized == false, ExcInternalError());
   Assert(data.preconditioner.get() != nullptr, ExcNotInitialized());
 
-  update1.reinit(src);
-  update2.reinit(src, true);
+  initialize_temporaries(src);
+
+  EigenvalueInformation info;
 
   // calculate largest eigenvalue using a hand-tuned CG iteration on the
   // matrix weighted by its diagonal. we start with a vector that consists of
   // ones only, weighted by the length.
   double max_eigenvalue, min_eigenvalue;
-  if (data.eig_cg_n_iterations > 0)
+  if (data.eig_cg_n_iterations > 0 &&
+      data.eigenvalue_algorithm ==
+        AdditionalData::EigenvalueAlgorithm::power_iteration)
+    {
+      Assert(data.smoothing_range > 1.,
+             ExcMessage("The power iteration only estimates the largest "
+                        "eigenvalue, so the smoothing range must be larger "
+                        "than one."));
+
+      // start from the eigenvector of the previous estimate if its layout
+      // matches, otherwise from the same vector as the CG iteration
+      if (!internal::PreconditionChebyshevImplementation::
+            can_reuse_eigenvector_estimate(eigenvector_estimate, src))
+        {
+          eigenvector_estimate.reinit(src, true);
+          internal::PreconditionChebyshevImplementation::set_initial_guess(
+            eigenvector_estimate);
+        }
+
+      const double eigenvalue =
+        internal::PreconditionChebyshevImplementation::power_iteration(
+          *matrix_ptr,
+          *data.preconditioner,
+          data.eig_cg_n_iterations,
+          data.eig_cg_residual,
+          eigenvector_estimate,
+          update1,
+          update2,
+          info.cg_iterations);
+
+      max_eigenvalue =
+        internal::PreconditionChebyshevImplementation::safety_factor *
+        eigenvalue;
+      min_eigenvalue = max_eigenvalue / data.smoothing_range;
+    }
+  else if (data.eig_cg_n_iterations > 0)
     {
       Assert(data.eig_cg_n_iterations > 2,
              ExcMessage(
@@ -2167,6 +2521,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
         }
       catch (SolverControl::NoConvergence &)
         {}
+      info.cg_iterations = control.last_step();
 
       // read the eigenvalues from the attached eigenvalue tracker
       if (eigenvalue_tracker.values.empty())
@@ -2175,9 +2530,9 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
         {
           min_eigenvalue = eigenvalue_tracker.values.front();
 
-          // include a safety factor since the CG method will in general not
-          // be converged
-          max_eigenvalue = 1.2 * eigenvalue_tracker.values.back();
+          max_eigenvalue =
+            internal::PreconditionChebyshevImplementation::safety_factor *
+            eigenvalue_tracker.values.back();
         }
     }
   else
@@ -2215,6 +2570,31 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
     PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
     ->theta = (max_eigenvalue + alpha) * 0.5;
 
+  info.min_eigenvalue_estimate = min_eigenvalue;
+  info.max_eigenvalue_estimate = max_eigenvalue;
+  info.degree                  = data.degree;
+
+  const_cast<
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
+    ->eigenvalue_information = info;
+  const_cast<
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
+    ->eigenvalue_estimate_size = matrix_ptr->m();
+  const_cast<
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
+    ->eigenvalues_are_initialized = true;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline void
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  initialize_temporaries(const VectorType &src) const
+{
+  update1.reinit(src);
+  update2.reinit(src, true);
+
   // We do not need the third auxiliary vector in case we have a
   // DiagonalMatrix as preconditioner and use deal.II's own vectors
   if (std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value ==
@@ -2229,7 +2609,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
 
   const_cast<
     PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
-    ->eigenvalues_are_initialized = true;
+    ->temporaries_are_initialized = true;
 }
 
 
@@ -2301,7 +2681,9 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
 {
   Threads::Mutex::ScopedLock lock(mutex);
   if (eigenvalues_are_initialized == false)
-    estimate_eigenvalues(src);
+    do_estimate_eigenvalues(src);
+  else if (temporaries_are_initialized == false)
+    initialize_temporaries(src);
 
   internal::PreconditionChebyshevImplementation::vector_updates(
     src,
@@ -2327,7 +2709,9 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::Tvmult(
 {
   Threads::Mutex::ScopedLock lock(mutex);
   if (eigenvalues_are_initialized == false)
-    estimate_eigenvalues(src);
+    do_estimate_eigenvalues(src);
+  else if (temporaries_are_initialized == false)
+    initialize_temporaries(src);
 
   internal::PreconditionChebyshevImplementation::vector_updates(
     src,
@@ -2353,7 +2737,9 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
 {
   Threads::Mutex::ScopedLock lock(mutex);
   if (eigenvalues_are_initialized == false)
-    estimate_eigenvalues(src);
+    do_estimate_eigenvalues(src);
+  else if (temporaries_are_initialized == false)
+    initialize_temporaries(src);
 
   matrix_ptr->vmult(update2, dst);
   internal::PreconditionChebyshevImplementation::vector_updates(
@@ -2380,7 +2766,9 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::Tstep(
 {
   Threads::Mutex::ScopedLock lock(mutex);
   if (eigenvalues_are_initialized == false)
-    estimate_eigenvalues(src);
+    do_estimate_eigenvalues(src);
+  else if (temporaries_are_initialized == false)
+    initialize_temporaries(src);
 
   matrix_ptr->Tvmult(update2, dst);
   internal::PreconditionChebyshevImplementation::vector_updates(
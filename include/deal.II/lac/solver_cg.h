@@ -27,12 +27,16 @@
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
 // forward declaration
 class PreconditionIdentity;
+template <typename number>
+class SparseMatrix;
 
 
 /*!@addtogroup Solvers */
@@ -89,6 +93,20 @@ class PreconditionIdentity;
  * Solver base class to determine convergence. This mechanism can also be used
  * to observe the progress of the iteration.
  *
+ * <h3>Solving for several right hand sides</h3>
+ *
+ * There is a variant of the solve() function that takes a std::vector of
+ * solution and right hand side vectors. It runs one CG iteration per right
+ * hand side in lockstep, so that the matrix-vector products of all systems
+ * can be done together. For SparseMatrix, this is done by
+ * SparseMatrix::vmult() for several vectors, which reads the matrix only
+ * once for all vectors and thus makes the cost of the memory transfer of the
+ * matrix be shared among the right hand sides. Other matrix types, including
+ * the operators based on MatrixFree, simply have their vmult() function
+ * called for each vector in turn, and so is the preconditioner. The
+ * convergence of the systems is either judged by the largest residual of
+ * all systems, or by a separate SolverControl object for each system.
+ *
  *
  * @author W. Bangerth, G. Kanschat, R. Becker and F.-T. Suttmeier
  */
@@ -137,6 +155,48 @@ public:
         const VectorType &        b,
         const PreconditionerType &preconditioner);
 
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for several right hand sides $b_i$
+   * with the same matrix and preconditioner, see the class documentation.
+   * There must be at least one system.
+   *
+   * The value passed to the SolverControl object of this solver and the
+   * other slots connected to it is the largest residual of all systems,
+   * along with the corresponding solution vector. For a tolerance given as
+   * an absolute value, the iteration therefore stops once the residual of
+   * every system is below it. A ReductionControl, on the other hand,
+   * computes its tolerance from the largest initial residual, which is not
+   * a relative criterion for systems with smaller right hand sides. Use the
+   * function below with one control object per system in that case. Systems
+   * that are converged already continue to be iterated until all are, which
+   * only further reduces their residual. The signals for the CG coefficients
+   * and the eigenvalue estimates are not triggered by this function.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &              A,
+        std::vector<VectorType> &       x,
+        const std::vector<VectorType> &b,
+        const PreconditionerType &      preconditioner);
+
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for several right hand sides $b_i$
+   * like the function above, but check the residual of system <i>i</i>
+   * against <tt>*system_controls[i]</tt> rather than the SolverControl
+   * object of this solver, which is not used. Passing a ReductionControl
+   * for each system requests a reduction of every residual relative to its
+   * own initial value. A system whose control reports success is not
+   * iterated any further. If the control of any system reports a failure,
+   * an exception of type SolverControl::NoConvergence is thrown.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &                  A,
+        std::vector<VectorType> &           x,
+        const std::vector<VectorType> &     b,
+        const PreconditionerType &          preconditioner,
+        const std::vector<SolverControl *> &system_controls);
+
   /**
    * Connect a slot to retrieve the CG coefficients. The slot will be called
    * with alpha as the first argument and with beta as the second argument,
@@ -230,6 +290,25 @@ protected:
    */
   boost::signals2::signal<void(const std::vector<double> &)>
     all_eigenvalues_signal;
+
+private:
+  /**
+   * Run the CG iterations for several right hand sides, as used by both
+   * variants of solve() for several systems. The function @p check is
+   * called with the step number, the residuals of all systems, and the
+   * flags that mark the systems still being iterated. It may clear these
+   * flags and returns the state of the iteration, along with the residual
+   * to be reported in case of a failure in its last argument.
+   */
+  template <typename MatrixType,
+            typename PreconditionerType,
+            typename CheckType>
+  void
+  solve_systems(const MatrixType &              A,
+                std::vector<VectorType> &       x,
+                const std::vector<VectorType> &b,
+                const PreconditionerType &      preconditioner,
+                const CheckType &               check);
 };
 
 /*@}*/
@@ -238,6 +317,42 @@ protected:
 
 #ifndef DOXYGEN
 
+namespace internal
+{
+  namespace SolverCGImplementation
+  {
+    /**
+     * Apply the matrix to several vectors. In general, this is done vector
+     * by vector.
+     */
+    template <typename MatrixType, typename VectorType>
+    void
+    vmult(const MatrixType &                     A,
+          std::vector<VectorType *> &            dst,
+          const std::vector<const VectorType *> &src)
+    {
+      for (unsigned int i = 0; i < dst.size(); ++i)
+        A.vmult(*dst[i], *src[i]);
+    }
+
+
+
+    /**
+     * Apply the matrix to several vectors. SparseMatrix can do this in one
+     * sweep over the matrix.
+     */
+    template <typename number, typename number2>
+    void
+    vmult(const SparseMatrix<number> &               A,
+          std::vector<Vector<number2> *> &           dst,
+          const std::vector<const Vector<number2> *> &src)
+    {
+      A.vmult(dst, src);
+    }
+  } // namespace SolverCGImplementation
+} // namespace internal
+
+
 template <typename VectorType>
 SolverCG<VectorType>::SolverCG(SolverControl &           cn,
                                VectorMemory<VectorType> &mem,
@@ -327,10 +442,11 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   LogStream::Prefix prefix("cg");
 
-  // Memory allocation
-  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory);
-  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory);
-  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory);
+  // Memory allocation. the vectors get the layout of x, but their values
+  // are not set since they'd be overwritten soon anyway.
+  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory, x);
 
   // define some aliases for simpler access
   VectorType &g = *g_pointer;
@@ -352,13 +468,6 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   typename VectorType::value_type eigen_beta_alpha = 0;
 
-  // resize the vectors, but do not set
-  // the values since they'd be overwritten
-  // soon anyway.
-  g.reinit(x, true);
-  d.reinit(x, true);
-  h.reinit(x, true);
-
   number gh, beta;
 
   // compute residual. if vector is
@@ -458,6 +567,239 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
 
 
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCG<VectorType>::solve(const MatrixType &              A,
+                            std::vector<VectorType> &       x,
+                            const std::vector<VectorType> &b,
+                            const PreconditionerType &      preconditioner)
+{
+  solve_systems(A,
+                x,
+                b,
+                preconditioner,
+                [&](const unsigned int         step,
+                    const std::vector<double> &res,
+                    std::vector<bool> &,
+                    double &value) {
+                  const unsigned int worst =
+                    std::max_element(res.begin(), res.end()) - res.begin();
+                  value = res[worst];
+                  return this->iteration_status(step, value, x[worst]);
+                });
+}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCG<VectorType>::solve(
+  const MatrixType &                  A,
+  std::vector<VectorType> &           x,
+  const std::vector<VectorType> &     b,
+  const PreconditionerType &          preconditioner,
+  const std::vector<SolverControl *> &system_controls)
+{
+  AssertDimension(system_controls.size(), x.size());
+
+  solve_systems(A,
+                x,
+                b,
+                preconditioner,
+                [&](const unsigned int         step,
+                    const std::vector<double> &res,
+                    std::vector<bool> &        active,
+                    double &                   value) {
+                  SolverControl::State state = SolverControl::success;
+                  for (unsigned int i = 0; i < res.size(); ++i)
+                    if (active[i])
+                      {
+                        const SolverControl::State system_state =
+                          system_controls[i]->check(step, res[i]);
+                        if (system_state == SolverControl::failure)
+                          {
+                            value = res[i];
+                            return system_state;
+                          }
+                        else if (system_state == SolverControl::success)
+                          active[i] = false;
+                        else
+                          state = SolverControl::iterate;
+                      }
+                  return state;
+                });
+}
+
+
+
+template <typename VectorType>
+template <typename MatrixType,
+          typename PreconditionerType,
+          typename CheckType>
+void
+SolverCG<VectorType>::solve_systems(const MatrixType &              A,
+                                    std::vector<VectorType> &       x,
+                                    const std::vector<VectorType> &b,
+                                    const PreconditionerType &preconditioner,
+                                    const CheckType &         check)
+{
+  using number = typename VectorType::value_type;
+
+  AssertDimension(x.size(), b.size());
+  const unsigned int n_vectors = x.size();
+  Assert(n_vectors > 0, ExcEmptyObject());
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("cg");
+
+  // Memory allocation. the vectors get the layout of the respective
+  // solution vector, but their values are not set since they'd be
+  // overwritten soon anyway.
+  std::vector<typename VectorMemory<VectorType>::Pointer> g_pointers,
+    d_pointers, h_pointers;
+  std::vector<VectorType *> g(n_vectors), d(n_vectors), h(n_vectors);
+  for (unsigned int i = 0; i < n_vectors; ++i)
+    {
+      g_pointers.emplace_back(this->memory, x[i]);
+      d_pointers.emplace_back(this->memory, x[i]);
+      h_pointers.emplace_back(this->memory, x[i]);
+      g[i] = g_pointers[i].get();
+      d[i] = d_pointers[i].get();
+      h[i] = h_pointers[i].get();
+    }
+
+  std::vector<double> res(n_vectors);
+  std::vector<number> gh(n_vectors);
+
+  // a system is worked on as long as this flag is set. a system whose
+  // residual is exactly zero has been solved and must not be worked on any
+  // more, since the next update would divide by zero. the check may also
+  // clear the flag of a system it considers converged
+  std::vector<bool> active(n_vectors, true);
+
+  // the arguments of the matrix-vector products, which only include the
+  // systems still being worked on
+  std::vector<VectorType *>       dst;
+  std::vector<const VectorType *> src;
+
+  int    it    = 0;
+  double value = 0;
+
+  // compute residuals. if all vectors are zero, then short-circuit the full
+  // computation
+  if (std::any_of(x.begin(), x.end(), [](const VectorType &v) {
+        return !v.all_zero();
+      }))
+    {
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        src.push_back(&x[i]);
+      internal::SolverCGImplementation::vmult(A, g, src);
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        g[i]->add(-1., b[i]);
+    }
+  else
+    for (unsigned int i = 0; i < n_vectors; ++i)
+      g[i]->equ(-1., b[i]);
+
+  for (unsigned int i = 0; i < n_vectors; ++i)
+    res[i] = g[i]->l2_norm();
+
+  conv = check(0, res, active, value);
+  if (conv != SolverControl::iterate)
+    return;
+
+  for (unsigned int i = 0; i < n_vectors; ++i)
+    {
+      if (res[i] == 0.)
+        active[i] = false;
+      if (active[i] == false)
+        continue;
+
+      if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
+          false)
+        {
+          preconditioner.vmult(*h[i], *g[i]);
+          d[i]->equ(-1., *h[i]);
+          gh[i] = *g[i] * *h[i];
+        }
+      else
+        {
+          d[i]->equ(-1., *g[i]);
+          gh[i] = res[i] * res[i];
+        }
+    }
+
+  while (conv == SolverControl::iterate)
+    {
+      it++;
+
+      dst.clear();
+      src.clear();
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        if (active[i])
+          {
+            dst.push_back(h[i]);
+            src.push_back(d[i]);
+          }
+      internal::SolverCGImplementation::vmult(A, dst, src);
+
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        if (active[i])
+          {
+            number alpha = *d[i] * *h[i];
+            Assert(std::abs(alpha) != 0., ExcDivideByZero());
+            alpha = gh[i] / alpha;
+
+            x[i].add(alpha, *d[i]);
+            res[i] =
+              std::sqrt(std::abs(g[i]->add_and_dot(alpha, *h[i], *g[i])));
+          }
+
+      const unsigned int worst =
+        std::max_element(res.begin(), res.end()) - res.begin();
+      print_vectors(it, x[worst], *g[worst], *d[worst]);
+
+      conv = check(it, res, active, value);
+      if (conv != SolverControl::iterate)
+        break;
+
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        {
+          if (res[i] == 0.)
+            active[i] = false;
+          if (active[i] == false)
+            continue;
+
+          number beta = gh[i];
+          if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
+              false)
+            {
+              preconditioner.vmult(*h[i], *g[i]);
+              Assert(std::abs(beta) != 0., ExcDivideByZero());
+              gh[i] = *g[i] * *h[i];
+              beta  = gh[i] / beta;
+              d[i]->sadd(beta, -1., *h[i]);
+            }
+          else
+            {
+              gh[i] = res[i] * res[i];
+              beta  = gh[i] / beta;
+              d[i]->sadd(beta, -1., *g[i]);
+            }
+        }
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, value));
+  // otherwise exit as normal
+}
+
+
+
 template <typename VectorType>
 boost::signals2::connection
 SolverCG<VectorType>::connect_coefficients_slot(
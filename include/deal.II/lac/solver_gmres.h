@@ -21,6 +21,8 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/subscriptor.h>
 
@@ -37,6 +39,15 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -149,6 +160,25 @@ namespace internal
  * off between memory consumption and convergence speed, since a longer basis
  * means minimization over a larger space.
  *
+ *
+ * <h3>Orthogonalization of the Arnoldi basis</h3>
+ *
+ * By default, each new vector is orthogonalized against the Arnoldi basis
+ * with the modified Gram-Schmidt algorithm. This algorithm computes one inner
+ * product after the other, i.e., it needs as many global reductions in
+ * parallel computations as there are vectors in the basis. As an
+ * alternative, AdditionalData::orthogonalization_strategy can select the
+ * classical Gram-Schmidt algorithm, which computes all inner products with
+ * the basis together. For the vector types Vector and
+ * LinearAlgebra::distributed::Vector, this is done in a single pass through
+ * memory and with a single global reduction, and the subtraction of the
+ * projections is likewise done in a single pass. Since classical
+ * Gram-Schmidt is less stable than the modified variant, it is followed by a
+ * second orthogonalization step whenever the norm of the vector drops below
+ * $1/\sqrt{2}$ of its original value during orthogonalization, which
+ * indicates cancellation (the criterion by Daniel, Gragg, Kaufman, and
+ * Stewart).
+ *
  * For the requirements on matrices and vectors in order to work with this
  * class, see the documentation of the Solver base class.
  *
@@ -178,6 +208,26 @@ template <class VectorType = Vector<double>>
 class SolverGMRES : public Solver<VectorType>
 {
 public:
+  /**
+   * The algorithm used to orthogonalize new vectors against the Arnoldi
+   * basis. See the section on orthogonalization in the class documentation.
+   */
+  enum class OrthogonalizationStrategy
+  {
+    /**
+     * Use the modified Gram-Schmidt algorithm, with re-orthogonalization
+     * once a loss of orthogonality has been detected.
+     */
+    modified_gram_schmidt,
+
+    /**
+     * Use the classical Gram-Schmidt algorithm, which computes all inner
+     * products with the basis at once, with a second orthogonalization
+     * step whenever cancellation is detected.
+     */
+    classical_gram_schmidt
+  };
+
   /**
    * Standardized data struct to pipe additional data to the solver.
    */
@@ -187,12 +237,16 @@ public:
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, and orthogonalization by the
+     * modified Gram-Schmidt algorithm.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int              max_n_tmp_vectors          = 30,
+      const bool                      right_preconditioning      = false,
+      const bool                      use_default_residual       = true,
+      const bool                      force_re_orthogonalization = false,
+      const OrthogonalizationStrategy orthogonalization_strategy =
+        OrthogonalizationStrategy::modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -220,9 +274,17 @@ public:
      * Flag to force re-orthogonalization of orthonormal basis in every step.
      * If set to false, the solver automatically checks for loss of
      * orthogonality every 5 iterations and enables re-orthogonalization only
-     * if necessary.
+     * if necessary. For the classical Gram-Schmidt algorithm, the check is
+     * done in every step and re-orthogonalization is only applied to the
+     * steps where it is needed.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * The algorithm used to orthogonalize new vectors against the Arnoldi
+     * basis.
+     */
+    OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -406,6 +468,28 @@ protected:
     const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
       boost::signals2::signal<void(int)>());
 
+  /**
+   * Orthogonalize the vector @p vv against the @p dim (orthogonal) vectors
+   * given by the first argument using the classical Gram-Schmidt algorithm,
+   * with the same meaning of the arguments as in modified_gram_schmidt().
+   * All inner products with the basis are computed together. If @p
+   * re_orthogonalize is true, a second orthogonalization step is always
+   * done, otherwise only if the norm of @p vv dropped below $1/\sqrt{2}$ of
+   * its initial value during orthogonalization. In the latter case, the
+   * signal re_orthogonalize_signal is called if it is connected.
+   */
+  static double
+  classical_gram_schmidt(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                                       orthogonal_vectors,
+    const unsigned int                        dim,
+    const unsigned int                        accumulated_iterations,
+    VectorType &                              vv,
+    Vector<double> &                          h,
+    const bool                                re_orthogonalize,
+    const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
+      boost::signals2::signal<void(int)>());
+
   /**
    * Estimates the eigenvalues from the Hessenberg matrix, H_orig, generated
    * during the inner iterations. Uses these estimate to compute the condition
@@ -580,6 +664,220 @@ namespace internal
 
 
 
+    // Number of vector entries combined with all basis vectors at once in
+    // the classical Gram-Schmidt kernels below, such that the chunk of the
+    // new vector stays in cache, and number of entries handed to a single
+    // thread.
+    constexpr std::size_t gram_schmidt_chunk_size = 512;
+    constexpr std::size_t gram_schmidt_block_size =
+      64 * gram_schmidt_chunk_size;
+
+
+
+    // Compute the inner products of the locally owned part of @p vv, of which
+    // there are @p local_size elements, with the first @p dim vectors in
+    // @p orthogonal_vectors as well as with itself, and store them in the
+    // first @p dim+1 entries of @p local_sums. The blocks of the vectors are
+    // processed in parallel and their contributions are added in a fixed
+    // order, so the result does not depend on the number of threads.
+    template <typename VectorType>
+    void
+    local_inner_products(const TmpVectors<VectorType> &orthogonal_vectors,
+                         const unsigned int            dim,
+                         const VectorType &            vv,
+                         const std::size_t             local_size,
+                         std::vector<double> &         local_sums)
+    {
+      using Number = typename VectorType::value_type;
+
+      const Number *    vv_ptr = vv.begin();
+      const std::size_t n_blocks =
+        (local_size + gram_schmidt_block_size - 1) / gram_schmidt_block_size;
+      std::vector<double> block_sums(n_blocks * (dim + 1));
+
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n_blocks,
+        [&](const std::size_t first_block, const std::size_t end_block) {
+          for (std::size_t block = first_block; block < end_block; ++block)
+            {
+              double *          sums = block_sums.data() + block * (dim + 1);
+              const std::size_t block_end =
+                std::min(local_size, (block + 1) * gram_schmidt_block_size);
+              for (std::size_t start = block * gram_schmidt_block_size;
+                   start < block_end;
+                   start += gram_schmidt_chunk_size)
+                {
+                  const std::size_t end =
+                    std::min(block_end, start + gram_schmidt_chunk_size);
+                  for (unsigned int j = 0; j < dim; ++j)
+                    {
+                      const Number *basis_ptr = orthogonal_vectors[j].begin();
+                      double        sum       = 0.;
+                      for (std::size_t i = start; i < end; ++i)
+                        sum += basis_ptr[i] * vv_ptr[i];
+                      sums[j] += sum;
+                    }
+                  double sum = 0.;
+                  for (std::size_t i = start; i < end; ++i)
+                    sum += vv_ptr[i] * vv_ptr[i];
+                  sums[dim] += sum;
+                }
+            }
+        },
+        1);
+
+      std::fill(local_sums.begin(), local_sums.begin() + dim + 1, 0.);
+      for (std::size_t block = 0; block < n_blocks; ++block)
+        for (unsigned int j = 0; j <= dim; ++j)
+          local_sums[j] += block_sums[block * (dim + 1) + j];
+    }
+
+
+
+    // Subtract the linear combination of the first @p dim vectors in
+    // @p orthogonal_vectors with coefficients @p h from the locally owned
+    // part of @p vv, working on the same chunks and blocks as
+    // local_inner_products().
+    template <typename VectorType>
+    void
+    local_subtract_projections(const TmpVectors<VectorType> &orthogonal_vectors,
+                               const unsigned int            dim,
+                               const Vector<double> &        h,
+                               const std::size_t             local_size,
+                               VectorType &                  vv)
+    {
+      using Number = typename VectorType::value_type;
+
+      Number *vv_ptr = vv.begin();
+
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        local_size,
+        [&](const std::size_t begin, const std::size_t end_range) {
+          for (std::size_t start = begin; start < end_range;
+               start += gram_schmidt_chunk_size)
+            {
+              const std::size_t end =
+                std::min(end_range, start + gram_schmidt_chunk_size);
+              for (unsigned int j = 0; j < dim; ++j)
+                {
+                  const Number *basis_ptr = orthogonal_vectors[j].begin();
+                  const Number  factor    = h(j);
+                  for (std::size_t i = start; i < end; ++i)
+                    vv_ptr[i] -= factor * basis_ptr[i];
+                }
+            }
+        },
+        gram_schmidt_block_size);
+    }
+
+
+
+    // Compute the inner products of @p vv with the first @p dim vectors in
+    // @p orthogonal_vectors, store them in @p h, and return the square of the
+    // norm of @p vv. For general vector types, this is done one inner product
+    // after the other.
+    template <typename VectorType>
+    double
+    inner_products_and_norm_sqr(const TmpVectors<VectorType> &orthogonal_vectors,
+                                const unsigned int            dim,
+                                const VectorType &            vv,
+                                Vector<double> &              h)
+    {
+      for (unsigned int j = 0; j < dim; ++j)
+        h(j) = vv * orthogonal_vectors[j];
+      return vv * vv;
+    }
+
+
+
+    // Same as above, but in a single pass through memory for Vector
+    template <typename Number>
+    double
+    inner_products_and_norm_sqr(
+      const TmpVectors<dealii::Vector<Number>> &orthogonal_vectors,
+      const unsigned int                        dim,
+      const dealii::Vector<Number> &            vv,
+      Vector<double> &                          h)
+    {
+      std::vector<double> sums(dim + 1);
+      local_inner_products(orthogonal_vectors, dim, vv, vv.size(), sums);
+      for (unsigned int j = 0; j < dim; ++j)
+        h(j) = sums[j];
+      return sums[dim];
+    }
+
+
+
+    // Same as above, but in a single pass through memory and with a single
+    // global reduction for LinearAlgebra::distributed::Vector
+    template <typename Number>
+    double
+    inner_products_and_norm_sqr(
+      const TmpVectors<LinearAlgebra::distributed::Vector<Number>>
+        &                                               orthogonal_vectors,
+      const unsigned int                                dim,
+      const LinearAlgebra::distributed::Vector<Number> &vv,
+      Vector<double> &                                  h)
+    {
+      std::vector<double> sums(dim + 1);
+      local_inner_products(orthogonal_vectors, dim, vv, vv.local_size(), sums);
+      Utilities::MPI::sum(sums, vv.get_mpi_communicator(), sums);
+      for (unsigned int j = 0; j < dim; ++j)
+        h(j) = sums[j];
+      return sums[dim];
+    }
+
+
+
+    // Subtract the linear combination of the first @p dim vectors in
+    // @p orthogonal_vectors with coefficients @p h from @p vv. For general
+    // vector types, this is done one vector after the other.
+    template <typename VectorType>
+    void
+    subtract_projections(const TmpVectors<VectorType> &orthogonal_vectors,
+                         const unsigned int            dim,
+                         const Vector<double> &        h,
+                         VectorType &                  vv)
+    {
+      for (unsigned int j = 0; j < dim; ++j)
+        vv.add(-h(j), orthogonal_vectors[j]);
+    }
+
+
+
+    // Same as above, but in a single pass through memory for Vector
+    template <typename Number>
+    void
+    subtract_projections(
+      const TmpVectors<dealii::Vector<Number>> &orthogonal_vectors,
+      const unsigned int                        dim,
+      const Vector<double> &                    h,
+      dealii::Vector<Number> &                  vv)
+    {
+      local_subtract_projections(orthogonal_vectors, dim, h, vv.size(), vv);
+    }
+
+
+
+    // Same as above, but in a single pass through memory for
+    // LinearAlgebra::distributed::Vector
+    template <typename Number>
+    void
+    subtract_projections(
+      const TmpVectors<LinearAlgebra::distributed::Vector<Number>>
+        &                                         orthogonal_vectors,
+      const unsigned int                          dim,
+      const Vector<double> &                      h,
+      LinearAlgebra::distributed::Vector<Number> &vv)
+    {
+      local_subtract_projections(
+        orthogonal_vectors, dim, h, vv.local_size(), vv);
+    }
+
+
+
     // A comparator for better printing eigenvalues
     inline bool
     complex_less_pred(const std::complex<double> &x,
@@ -595,14 +893,16 @@ namespace internal
 
 template <class VectorType>
 inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
-  const unsigned int max_n_tmp_vectors,
-  const bool         right_preconditioning,
-  const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const unsigned int              max_n_tmp_vectors,
+  const bool                      right_preconditioning,
+  const bool                      use_default_residual,
+  const bool                      force_re_orthogonalization,
+  const OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -731,6 +1031,66 @@ SolverGMRES<VectorType>::modified_gram_schmidt(
 
 
 
+template <class VectorType>
+inline double
+SolverGMRES<VectorType>::classical_gram_schmidt(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                                       orthogonal_vectors,
+  const unsigned int                        dim,
+  const unsigned int                        accumulated_iterations,
+  VectorType &                              vv,
+  Vector<double> &                          h,
+  const bool                                re_orthogonalize,
+  const boost::signals2::signal<void(int)> &re_orthogonalize_signal)
+{
+  Assert(dim > 0, ExcInternalError());
+
+  // Orthogonalization. Compute all inner products at once, together with
+  // the norm of vv before orthogonalization. The norm after orthogonalization
+  // then follows from Pythagoras' theorem without another reduction.
+  const double norm_vv_start_sqr =
+    internal::SolverGMRESImplementation::inner_products_and_norm_sqr(
+      orthogonal_vectors, dim, vv, h);
+  internal::SolverGMRESImplementation::subtract_projections(orthogonal_vectors,
+                                                            dim,
+                                                            h,
+                                                            vv);
+  double norm_vv_sqr = norm_vv_start_sqr;
+  for (unsigned int i = 0; i < dim; ++i)
+    norm_vv_sqr -= h(i) * h(i);
+
+  // Re-orthogonalization if the norm of vv was reduced by more than a factor
+  // of 1/sqrt(2) by the orthogonalization, which indicates cancellation and
+  // thus loss of orthogonality, see J. W. Daniel, W. B. Gragg, L. Kaufman,
+  // G. W. Stewart, Reorthogonalization and stable algorithms for updating
+  // the Gram-Schmidt QR factorization, Math. Comp. 30 (1976), pp. 772-795.
+  if (re_orthogonalize == false)
+    {
+      if (norm_vv_sqr > 0.5 * norm_vv_start_sqr)
+        return std::sqrt(norm_vv_sqr);
+      else if (!re_orthogonalize_signal.empty())
+        re_orthogonalize_signal(accumulated_iterations);
+    }
+
+  Vector<double> h_correction(dim);
+  norm_vv_sqr =
+    internal::SolverGMRESImplementation::inner_products_and_norm_sqr(
+      orthogonal_vectors, dim, vv, h_correction);
+  internal::SolverGMRESImplementation::subtract_projections(orthogonal_vectors,
+                                                            dim,
+                                                            h_correction,
+                                                            vv);
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      h(i) += h_correction(i);
+      norm_vv_sqr -= h_correction(i) * h_correction(i);
+    }
+
+  return std::sqrt(std::max(norm_vv_sqr, 0.));
+}
+
+
+
 template <class VectorType>
 inline void
 SolverGMRES<VectorType>::compute_eigs_and_cond(
@@ -949,13 +1309,23 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+                 OrthogonalizationStrategy::classical_gram_schmidt ?
+               classical_gram_schmidt(tmp_vectors,
+                                      dim,
+                                      accumulated_iterations,
+                                      vv,
+                                      h,
+                                      re_orthogonalize,
+                                      re_orthogonalize_signal) :
+               modified_gram_schmidt(tmp_vectors,
+                                     dim,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal));
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
@@ -131,6 +131,15 @@ public:
    * spent in the factorization, so this functionality may not always be of
    * large benefit.
    *
+   * If the matrix has the same number of rows and the same sparsity
+   * structure as the matrix passed to the previous call of this function,
+   * the symbolic analysis of UMFPACK (the fill-reducing ordering and the
+   * determination of the frontal matrices) computed for that matrix is
+   * reused and only the numerical factorization is performed. This is
+   * beneficial in nonlinear or time dependent problems where matrices with
+   * the same sparsity pattern but different entries are factorized many
+   * times.
+   *
    * In contrast to the other direct solver classes, the initialization method
    * does nothing. Therefore initialize is not automatically called by this
    * method, when the initialization step has not been performed yet.
@@ -243,6 +252,16 @@ public:
   solve(BlockVector<double> &rhs_and_solution,
         const bool           transpose = false) const;
 
+  /**
+   * Same as before, but for several right hand side vectors at once. The
+   * solutions for the individual vectors are independent of each other and
+   * are computed in parallel on the available threads, all of them using
+   * the same factorization.
+   */
+  void
+  solve(std::vector<Vector<double>> &rhs_and_solutions,
+        const bool                   transpose = false) const;
+
   /**
    * Call the two functions factorize() and solve() in that order, i.e.
    * perform the whole solution process for the given right hand side vector.
@@ -324,6 +343,9 @@ private:
    * The UMFPACK routines allocate objects in which they store information
    * about symbolic and numeric values of the decomposition. The actual data
    * type of these objects is opaque, and only passed around as void pointers.
+   *
+   * The symbolic decomposition is kept after factorize() so that it can be
+   * reused for the next matrix if that one has the same sparsity structure.
    */
   void *symbolic_decomposition;
   void *numeric_decomposition;
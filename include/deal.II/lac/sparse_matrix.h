@@ -1093,6 +1093,24 @@ public:
   void
   vmult(OutVector &dst, const InVector &src) const;
 
+  /**
+   * Matrix-vector multiplication for several vectors at once: let
+   * <i>*dst[i] = M * *src[i]</i> for all <i>i</i>. In contrast to calling the
+   * function above once per vector, the matrix entries and column indices
+   * are only read once for all vectors, which makes this function
+   * considerably faster when the speed of the matrix-vector product is
+   * limited by the memory bandwidth. This is used by the variant of
+   * SolverCG::solve() for several right hand sides.
+   *
+   * Source and destination must not be the same vectors.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <typename somenumber>
+  void
+  vmult(std::vector<Vector<somenumber> *> &      dst,
+        const std::vector<const Vector<somenumber> *> &src) const;
+
   /**
    * Matrix-vector multiplication: let <i>dst = M<sup>T</sup>*src</i> with
    * <i>M</i> being this matrix. This function does the same as vmult() but
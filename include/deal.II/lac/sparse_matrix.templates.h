@@ -33,6 +33,7 @@
 #include <deal.II/lac/vector_memory.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <iomanip>
@@ -526,6 +527,60 @@ namespace internal
             *dst_ptr++ = s;
           }
     }
+
+
+
+    /**
+     * Perform a vmult on several vectors at once, using the same sweep over
+     * the matrix for all of them. The range [begin_row, end_row) is treated
+     * as in vmult_on_subrange().
+     */
+    template <typename number, typename somenumber>
+    void
+    vmult_multiple_on_subrange(
+      const size_type                                begin_row,
+      const size_type                                end_row,
+      const number *                                 values,
+      const std::size_t *                            rowstart,
+      const size_type *                              colnums,
+      const std::vector<const Vector<somenumber> *> &src,
+      const std::vector<Vector<somenumber> *> &      dst)
+    {
+      const unsigned int n_vectors = src.size();
+
+      std::vector<const somenumber *> src_ptr(n_vectors);
+      std::vector<somenumber *>       dst_ptr(n_vectors);
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        {
+          src_ptr[v] = src[v]->begin();
+          dst_ptr[v] = dst[v]->begin();
+        }
+
+      // work on a small number of vectors at a time so that the partial sums
+      // stay in registers. the batches are processed row by row, so that the
+      // entries and column indices of a row are only read from memory once
+      // and then taken from cache for all further batches
+      constexpr unsigned int             batch_size = 8;
+      std::array<somenumber, batch_size> sums;
+      for (size_type row = begin_row; row < end_row; ++row)
+        for (unsigned int start = 0; start < n_vectors; start += batch_size)
+          {
+            const unsigned int n_batch =
+              std::min(batch_size, n_vectors - start);
+            const somenumber *const *batch_src = &src_ptr[start];
+
+            std::fill(sums.begin(), sums.end(), somenumber());
+            for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+              {
+                const somenumber value  = values[j];
+                const size_type  column = colnums[j];
+                for (unsigned int v = 0; v < n_batch; ++v)
+                  sums[v] += value * batch_src[v][column];
+              }
+            for (unsigned int v = 0; v < n_batch; ++v)
+              dst_ptr[start + v][row] = sums[v];
+          }
+    }
   } // namespace SparseMatrixImplementation
 } // namespace internal
 
@@ -792,6 +847,45 @@ SparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
 
 
 
+template <typename number>
+template <typename somenumber>
+void
+SparseMatrix<number>::vmult(
+  std::vector<Vector<somenumber> *> &            dst,
+  const std::vector<const Vector<somenumber> *> &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  AssertDimension(dst.size(), src.size());
+  for (unsigned int v = 0; v < src.size(); ++v)
+    {
+      Assert(m() == dst[v]->size(), ExcDimensionMismatch(m(), dst[v]->size()));
+      Assert(n() == src[v]->size(), ExcDimensionMismatch(n(), src[v]->size()));
+      Assert(!PointerComparison::equal(src[v], dst[v]),
+             ExcSourceEqualsDestination());
+    }
+
+  // the work per row grows with the number of vectors, so reduce the grain
+  // size accordingly
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    std::bind(&internal::SparseMatrixImplementation::
+                vmult_multiple_on_subrange<number, somenumber>,
+              std::placeholders::_1,
+              std::placeholders::_2,
+              val.get(),
+              cols->rowstart.get(),
+              cols->colnums.get(),
+              std::cref(src),
+              std::cref(dst)),
+    std::max(1U,
+             internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               std::max(1U, static_cast<unsigned int>(src.size()))));
+}
+
+
+
 template <typename number>
 template <class OutVector, class InVector>
 void
@@ -21,11 +21,14 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/vector.h>
 
+#include <atomic>
 #include <iostream>
+#include <list>
 #include <memory>
 #include <vector>
 
@@ -221,6 +224,18 @@ public:
      */
     Pointer(VectorMemory<VectorType> &mem);
 
+    /**
+     * Constructor. This constructor automatically allocates a vector from
+     * the given vector memory object @p mem and gives it the same layout as
+     * @p model, i.e., the same size or parallel partitioning. This is
+     * equivalent to allocating the vector and calling
+     * <code>reinit(model, true)</code> on it, but GrowingVectorMemory can
+     * skip the reinitialization if it finds an unused vector that already
+     * has the right layout. As after such a call to reinit(), the elements
+     * of the vector have unspecified values.
+     */
+    Pointer(VectorMemory<VectorType> &mem, const VectorType &model);
+
     /**
      * Destructor, automatically releasing the vector from the memory #pool.
      */
@@ -314,6 +329,39 @@ public:
  * of creating a new memory pool every time. A drawback of this policy is that
  * vectors once allocated are only released at the end of the program run.
  *
+ * <h3>Use from several threads</h3>
+ *
+ * Since the pool is shared, access to it needs to be synchronized by a
+ * mutex. To avoid contention when many small solvers run concurrently on
+ * different threads, for example in the blocks of a task-parallel block
+ * preconditioner, each thread additionally keeps a short list of the
+ * vectors it freed last. alloc() first takes a vector from the list of the
+ * calling thread, and free() puts the vector there unless the list is full.
+ * Both only lock a mutex of the calling thread, which other threads hardly
+ * ever take. Only if the list is empty or full, the shared pool is used.
+ *
+ * If the shared pool has no unused vector either, alloc() takes a vector
+ * from the list of another thread before it creates a new one. A vector
+ * freed by a task on one thread can therefore be reused by a solver on
+ * another thread, and the number of vectors only grows to the largest
+ * number that is in use at the same time, not to the number of threads
+ * times the length of the lists.
+ *
+ * <h3>Reuse of the vector layout</h3>
+ *
+ * Most users of this class reinitialize an allocated vector with the layout
+ * of another vector right away. The alloc_like() function and the
+ * corresponding constructor of VectorMemory::Pointer do this in one step,
+ * and prefer unused vectors that already have the requested layout, in
+ * which case the reinitialization is skipped. For Vector, the layout is
+ * given by the size, for LinearAlgebra::distributed::Vector by the
+ * Utilities::MPI::Partitioner object (which is shared between vectors
+ * initialized from each other), and for block vectors by the layouts of the
+ * blocks. Vectors of other types are always reinitialized.
+ *
+ * The numbers of allocations served by the different paths are recorded and
+ * can be queried with get_statistics().
+ *
  * @author Guido Kanschat, 1999, 2007; Wolfgang Bangerth, 2017.
  */
 template <typename VectorType = dealii::Vector<double>>
@@ -382,11 +430,83 @@ public:
   free(const VectorType *const) override;
 
   /**
-   * Release all vectors that are not currently in use.
+   * Return a pointer to a vector with the same layout as @p model, i.e., the
+   * same size or parallel partitioning. The contents of the vector are
+   * unspecified. See the general documentation of this class for when the
+   * reinitialization of the vector is skipped.
+   *
+   * As for alloc(), the vector needs to be returned with free(), and it is
+   * preferable to use the VectorMemory::Pointer class instead of calling
+   * this function directly.
+   */
+  VectorType *
+  alloc_like(const VectorType &model);
+
+  /**
+   * Release all vectors that are not currently in use. This function must
+   * not be called while other threads allocate or free vectors of the same
+   * type.
    */
   static void
   release_unused_memory();
 
+  /**
+   * Counters that describe how the allocations of vectors of the current
+   * type, by all GrowingVectorMemory objects and threads, were served.
+   */
+  struct Statistics
+  {
+    /**
+     * The number of calls to alloc() and alloc_like().
+     */
+    size_type n_allocations = 0;
+
+    /**
+     * The number of allocations served from the list of recently freed
+     * vectors of the calling thread, without taking a lock.
+     */
+    size_type n_thread_local_hits = 0;
+
+    /**
+     * The number of allocations that reused an unused vector from the
+     * shared pool.
+     */
+    size_type n_pool_hits = 0;
+
+    /**
+     * The number of allocations served from the list of recently freed
+     * vectors of another thread, because the shared pool had no unused
+     * vector.
+     */
+    size_type n_other_thread_hits = 0;
+
+    /**
+     * The number of allocations for which a new vector had to be created.
+     */
+    size_type n_new_vectors = 0;
+
+    /**
+     * The number of calls to alloc_like() that found a vector with the
+     * requested layout, so that the reinitialization was skipped.
+     */
+    size_type n_reinit_skipped = 0;
+  };
+
+  /**
+   * Return the statistics of the allocations of vectors of the current type
+   * since the start of the program or the last call to reset_statistics().
+   * This function may be called while other threads allocate vectors of the
+   * same type.
+   */
+  static Statistics
+  get_statistics();
+
+  /**
+   * Reset all counters of the statistics to zero.
+   */
+  static void
+  reset_statistics();
+
   /**
    * Memory consumed by this class and all currently allocated vectors.
    */
@@ -440,17 +560,68 @@ private:
    */
   static Pool pool;
 
+  /**
+   * The data each thread keeps: the vectors it freed last, which are still
+   * marked as used in the shared pool, and its part of the statistics. The
+   * mutex protects both against other threads that take vectors from the
+   * list or read the statistics.
+   */
+  struct ThreadData
+  {
+    std::vector<VectorType *> free_vectors;
+    Statistics                statistics;
+    Threads::Mutex            mutex;
+  };
+
+  /**
+   * The data of all threads that have used the pool. Elements are only
+   * added, while holding #mutex, so that their addresses stay valid and
+   * other threads can iterate over them while holding #mutex.
+   */
+  static std::list<ThreadData> all_thread_data;
+
+  /**
+   * A pointer to the element of #all_thread_data of each thread, or a null
+   * pointer if the thread has not used the pool yet.
+   */
+  static Threads::ThreadLocalStorage<ThreadData *> thread_data;
+
+  /**
+   * Return the data of the current thread, and create it if necessary.
+   */
+  static ThreadData &
+  get_thread_data();
+
+  /**
+   * Remove a vector from @p free_vectors and return it, preferring the one
+   * freed last unless another one has the same layout as @p model. If so,
+   * set @p has_layout to true. @p free_vectors must not be empty.
+   */
+  static VectorType *
+  take_vector(std::vector<VectorType *> &free_vectors,
+              const VectorType *         model,
+              bool &                     has_layout);
+
+  /**
+   * Return a vector from the list of the current thread or the shared pool.
+   * If @p model is not a null pointer, prefer a vector with the same layout
+   * as @p model and set @p has_layout to whether the returned vector has
+   * this layout.
+   */
+  VectorType *
+  get_vector(const VectorType *model, bool &has_layout);
+
   /**
    * Overall number of allocations. Only used for bookkeeping and to generate
    * output at the end of an object's lifetime.
    */
-  size_type total_alloc;
+  std::atomic<size_type> total_alloc;
 
   /**
    * Number of vectors currently allocated in this object; used for detecting
    * memory leaks.
    */
-  size_type current_alloc;
+  std::atomic<size_type> current_alloc;
 
   /**
    * A flag controlling the logging of statistics by the destructor.
@@ -472,7 +643,15 @@ namespace internal
   {
     void
     release_all_unused_memory();
-  }
+
+    /**
+     * Allocate a vector from @p memory with the same layout as @p model,
+     * using GrowingVectorMemory::alloc_like() if @p memory is of that type.
+     */
+    template <typename VectorType>
+    VectorType *
+    alloc_like(VectorMemory<VectorType> &memory, const VectorType &model);
+  } // namespace GrowingVectorMemoryImplementation
 } // namespace internal
 
 /*@}*/
@@ -490,6 +669,38 @@ inline VectorMemory<VectorType>::Pointer::Pointer(VectorMemory<VectorType> &mem)
 
 
 
+template <typename VectorType>
+inline VectorMemory<VectorType>::Pointer::Pointer(
+  VectorMemory<VectorType> &mem,
+  const VectorType &        model)
+  : std::unique_ptr<VectorType, std::function<void(VectorType *)>>(
+      internal::GrowingVectorMemoryImplementation::alloc_like(mem, model),
+      [&mem](VectorType *v) { mem.free(v); })
+{}
+
+
+
+namespace internal
+{
+  namespace GrowingVectorMemoryImplementation
+  {
+    template <typename VectorType>
+    inline VectorType *
+    alloc_like(VectorMemory<VectorType> &memory, const VectorType &model)
+    {
+      if (GrowingVectorMemory<VectorType> *growing_memory =
+            dynamic_cast<GrowingVectorMemory<VectorType> *>(&memory))
+        return growing_memory->alloc_like(model);
+
+      VectorType *vector = memory.alloc();
+      vector->reinit(model, true);
+      return vector;
+    }
+  } // namespace GrowingVectorMemoryImplementation
+} // namespace internal
+
+
+
 template <typename VectorType>
 VectorType *
 PrimitiveVectorMemory<VectorType>::alloc()
@@ -20,8 +20,11 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
+#include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -32,6 +35,92 @@ typename GrowingVectorMemory<VectorType>::Pool
 template <typename VectorType>
 Threads::Mutex GrowingVectorMemory<VectorType>::mutex;
 
+template <typename VectorType>
+std::list<typename GrowingVectorMemory<VectorType>::ThreadData>
+  GrowingVectorMemory<VectorType>::all_thread_data;
+
+template <typename VectorType>
+Threads::ThreadLocalStorage<
+  typename GrowingVectorMemory<VectorType>::ThreadData *>
+  GrowingVectorMemory<VectorType>::thread_data(nullptr);
+
+
+
+namespace internal
+{
+  namespace GrowingVectorMemoryImplementation
+  {
+    /**
+     * The maximal number of freed vectors each thread keeps for itself
+     * before returning them to the shared pool.
+     */
+    const unsigned int max_n_thread_local_vectors = 16;
+
+    /**
+     * Return whether @p vector has the same layout as @p model, so that
+     * <code>vector.reinit(model, true)</code> can be skipped. The overloads
+     * are selected in the order block vectors, vectors with a partitioner,
+     * serial vectors, and all other vectors, for which the function returns
+     * false.
+     */
+    template <typename VectorType>
+    bool
+    has_same_layout(const VectorType &vector, const VectorType &model);
+
+    template <typename VectorType>
+    inline auto
+    has_same_layout_dispatch(const VectorType &vector,
+                             const VectorType &model,
+                             int)
+      -> decltype(model.n_blocks(), model.block(0), bool())
+    {
+      if (vector.n_blocks() != model.n_blocks())
+        return false;
+      for (unsigned int b = 0; b < model.n_blocks(); ++b)
+        if (!has_same_layout(vector.block(b), model.block(b)))
+          return false;
+      return true;
+    }
+
+    template <typename VectorType>
+    inline auto
+    has_same_layout_dispatch(const VectorType &vector,
+                             const VectorType &model,
+                             long)
+      -> decltype(model.get_partitioner(), vector.has_ghost_elements(), bool())
+    {
+      // reinit() also resets the ghost state of the vector
+      return vector.get_partitioner().get() == model.get_partitioner().get() &&
+             !vector.has_ghost_elements();
+    }
+
+    template <typename Number>
+    inline bool
+    has_same_layout_dispatch(const dealii::Vector<Number> &vector,
+                             const dealii::Vector<Number> &model,
+                             long)
+    {
+      return vector.size() == model.size();
+    }
+
+    template <typename VectorType>
+    inline bool
+    has_same_layout_dispatch(const VectorType &, const VectorType &, ...)
+    {
+      return false;
+    }
+
+    template <typename VectorType>
+    inline bool
+    has_same_layout(const VectorType &vector, const VectorType &model)
+    {
+      return has_same_layout_dispatch(vector, model, 0);
+    }
+  } // namespace GrowingVectorMemoryImplementation
+} // namespace internal
+
+
+
 template <typename VectorType>
 inline GrowingVectorMemory<VectorType>::Pool::Pool()
   : data(nullptr)
@@ -102,40 +191,208 @@ inline GrowingVectorMemory<VectorType>::~GrowingVectorMemory()
 
 
 
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::ThreadData &
+GrowingVectorMemory<VectorType>::get_thread_data()
+{
+  ThreadData *&data = thread_data.get();
+  if (data == nullptr)
+    {
+      // register the data of this thread, so that other threads can take
+      // vectors from its list and read its statistics
+      Threads::Mutex::ScopedLock lock(mutex);
+      all_thread_data.emplace_back();
+      data = &all_thread_data.back();
+    }
+  return *data;
+}
+
+
+
 template <typename VectorType>
 inline VectorType *
-GrowingVectorMemory<VectorType>::alloc()
+GrowingVectorMemory<VectorType>::take_vector(
+  std::vector<VectorType *> &free_vectors,
+  const VectorType *         model,
+  bool &                     has_layout)
 {
-  Threads::Mutex::ScopedLock lock(mutex);
+  using internal::GrowingVectorMemoryImplementation::has_same_layout;
+
+  Assert(!free_vectors.empty(), ExcInternalError());
+  auto v = free_vectors.end() - 1;
+  if (model != nullptr)
+    for (auto p = free_vectors.rbegin(); p != free_vectors.rend(); ++p)
+      if (has_same_layout(**p, *model))
+        {
+          v          = p.base() - 1;
+          has_layout = true;
+          break;
+        }
+
+  VectorType *vector = *v;
+  free_vectors.erase(v);
+  return vector;
+}
+
+
+
+template <typename VectorType>
+inline VectorType *
+GrowingVectorMemory<VectorType>::get_vector(const VectorType *model,
+                                            bool &            has_layout)
+{
+  using internal::GrowingVectorMemoryImplementation::has_same_layout;
 
   ++total_alloc;
   ++current_alloc;
-  // see if there is a free vector
-  // available in our list
+  has_layout = false;
+
+  ThreadData &data = get_thread_data();
+
+  // first see whether the current thread has freed a vector recently. these
+  // vectors are still marked as used in the shared pool, so we only need to
+  // lock the list of this thread, which other threads only take if they run
+  // out of vectors
+  {
+    Threads::Mutex::ScopedLock thread_lock(data.mutex);
+    ++data.statistics.n_allocations;
+    if (!data.free_vectors.empty())
+      {
+        ++data.statistics.n_thread_local_hits;
+        return take_vector(data.free_vectors, model, has_layout);
+      }
+  }
+
+  Threads::Mutex::ScopedLock lock(mutex);
+
+  // see if there is a free vector available in the shared pool, preferably
+  // one with the requested layout
+  typename std::vector<entry_type>::iterator free_entry = pool.data->end();
   for (typename std::vector<entry_type>::iterator i = pool.data->begin();
        i != pool.data->end();
        ++i)
+    if (i->first == false)
+      {
+        if (model != nullptr && has_same_layout(*i->second, *model))
+          {
+            free_entry = i;
+            has_layout = true;
+            break;
+          }
+        else if (free_entry == pool.data->end())
+          {
+            free_entry = i;
+            if (model == nullptr)
+              break;
+          }
+      }
+
+  if (free_entry != pool.data->end())
     {
-      if (i->first == false)
+      free_entry->first = true;
+      Threads::Mutex::ScopedLock thread_lock(data.mutex);
+      ++data.statistics.n_pool_hits;
+      return free_entry->second.get();
+    }
+
+  // before creating a new vector, take one that another thread keeps in its
+  // list. it stays marked as used in the shared pool
+  for (ThreadData &other : all_thread_data)
+    if (&other != &data)
+      {
+        VectorType *vector = nullptr;
         {
-          i->first = true;
-          return i->second.get();
+          Threads::Mutex::ScopedLock other_lock(other.mutex);
+          if (!other.free_vectors.empty())
+            vector = take_vector(other.free_vectors, model, has_layout);
         }
-    }
+        if (vector != nullptr)
+          {
+            Threads::Mutex::ScopedLock thread_lock(data.mutex);
+            ++data.statistics.n_other_thread_hits;
+            return vector;
+          }
+      }
 
   // no free vector found, so let's just allocate a new one
   pool.data->emplace_back(
     entry_type(true, std_cxx14::make_unique<VectorType>()));
+  Threads::Mutex::ScopedLock thread_lock(data.mutex);
+  ++data.statistics.n_new_vectors;
 
   return pool.data->back().second.get();
 }
 
 
 
+template <typename VectorType>
+inline VectorType *
+GrowingVectorMemory<VectorType>::alloc()
+{
+  bool has_layout;
+  return get_vector(nullptr, has_layout);
+}
+
+
+
+template <typename VectorType>
+inline VectorType *
+GrowingVectorMemory<VectorType>::alloc_like(const VectorType &model)
+{
+  bool        has_layout;
+  VectorType *vector = get_vector(&model, has_layout);
+
+  if (has_layout)
+    {
+      ThreadData &               data = get_thread_data();
+      Threads::Mutex::ScopedLock thread_lock(data.mutex);
+      ++data.statistics.n_reinit_skipped;
+    }
+  else
+    vector->reinit(model, true);
+
+  return vector;
+}
+
+
+
 template <typename VectorType>
 inline void
 GrowingVectorMemory<VectorType>::free(const VectorType *const v)
 {
+#ifdef DEBUG
+  {
+    Threads::Mutex::ScopedLock lock(mutex);
+    bool                       found = false;
+    for (typename std::vector<entry_type>::iterator i = pool.data->begin();
+         i != pool.data->end();
+         ++i)
+      if (v == i->second.get())
+        {
+          found = i->first;
+          break;
+        }
+    Assert(found, typename VectorMemory<VectorType>::ExcNotAllocatedHere());
+  }
+#endif
+
+  --current_alloc;
+
+  // keep the vector for the current thread if it has room for it
+  {
+    ThreadData &               data = get_thread_data();
+    Threads::Mutex::ScopedLock thread_lock(data.mutex);
+    Assert(std::find(data.free_vectors.begin(), data.free_vectors.end(), v) ==
+             data.free_vectors.end(),
+           typename VectorMemory<VectorType>::ExcNotAllocatedHere());
+    if (data.free_vectors.size() <
+        internal::GrowingVectorMemoryImplementation::max_n_thread_local_vectors)
+      {
+        data.free_vectors.push_back(const_cast<VectorType *>(v));
+        return;
+      }
+  }
+
   Threads::Mutex::ScopedLock lock(mutex);
 
   for (typename std::vector<entry_type>::iterator i = pool.data->begin();
@@ -145,11 +402,9 @@ GrowingVectorMemory<VectorType>::free(const VectorType *const v)
       if (v == i->second.get())
         {
           i->first = false;
-          --current_alloc;
           return;
         }
     }
-  Assert(false, typename VectorMemory<VectorType>::ExcNotAllocatedHere());
 }
 
 
@@ -160,12 +415,56 @@ GrowingVectorMemory<VectorType>::release_unused_memory()
 {
   Threads::Mutex::ScopedLock lock(mutex);
 
+  for (ThreadData &data : all_thread_data)
+    {
+      Threads::Mutex::ScopedLock thread_lock(data.mutex);
+      data.free_vectors.clear();
+    }
+
   if (pool.data != nullptr)
     pool.data->clear();
 }
 
 
 
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::Statistics
+GrowingVectorMemory<VectorType>::get_statistics()
+{
+  // the list of threads can only grow while we hold the mutex, and the
+  // counters of each thread only change while its own mutex is held
+  Threads::Mutex::ScopedLock lock(mutex);
+
+  Statistics result;
+  for (ThreadData &data : all_thread_data)
+    {
+      Threads::Mutex::ScopedLock thread_lock(data.mutex);
+      result.n_allocations += data.statistics.n_allocations;
+      result.n_thread_local_hits += data.statistics.n_thread_local_hits;
+      result.n_pool_hits += data.statistics.n_pool_hits;
+      result.n_other_thread_hits += data.statistics.n_other_thread_hits;
+      result.n_new_vectors += data.statistics.n_new_vectors;
+      result.n_reinit_skipped += data.statistics.n_reinit_skipped;
+    }
+  return result;
+}
+
+
+
+template <typename VectorType>
+inline void
+GrowingVectorMemory<VectorType>::reset_statistics()
+{
+  Threads::Mutex::ScopedLock lock(mutex);
+  for (ThreadData &data : all_thread_data)
+    {
+      Threads::Mutex::ScopedLock thread_lock(data.mutex);
+      data.statistics = Statistics();
+    }
+}
+
+
+
 template <typename VectorType>
 inline std::size_t
 GrowingVectorMemory<VectorType>::memory_consumption() const
@@ -0,0 +1,503 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_error_estimator_h
+#define dealii_matrix_free_error_estimator_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/error_estimator.h>
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * An implementation of the error indicator of Kelly, De S. R. Gago,
+ * Zienkiewicz and Babuska for solutions stored in a
+ * LinearAlgebra::distributed::Vector and discretized with a MatrixFree
+ * object. The indicator computed is the same as the one of
+ * KellyErrorEstimator (see there for the formulas and the possible scaling
+ * strategies), but the jumps of the normal derivatives are evaluated with
+ * FEFaceEvaluation on the face batches of the MatrixFree object, i.e., with
+ * sum factorization and several faces at once in the lanes of a
+ * VectorizedArray.
+ *
+ * Every face is visited only once: the integral of the squared jump over an
+ * interior face is computed a single time and then added to the indicators
+ * of both adjacent cells, whereas KellyErrorEstimator stores it in a map
+ * from faces to integrals to avoid computing it twice. On meshes with
+ * hanging nodes, the face batches of MatrixFree contain the subfaces of the
+ * coarser cell, with the finer cell on the "interior" side, so the coarser
+ * cell receives the sum of the integrals over its subfaces just as in
+ * KellyErrorEstimator. The solution is read with
+ * FEFaceEvaluation::read_dof_values_plain(), i.e., without resolving
+ * constraints, so for continuous elements the entries of constrained
+ * degrees of freedom must be set, e.g. by AffineConstraints::distribute().
+ * The face integrals are computed in parallel on subranges of the face
+ * batches using the threads of the current program, see MultithreadInfo.
+ *
+ * <h3>Setting up the MatrixFree object</h3>
+ *
+ * The MatrixFree object passed to estimate() must have been set up with
+ * face data, i.e., the fields
+ * MatrixFree::AdditionalData::mapping_update_flags_inner_faces and
+ * MatrixFree::AdditionalData::mapping_update_flags_boundary_faces must
+ * include the flags
+ * @code
+ *   update_gradients | update_JxW_values | update_normal_vectors |
+ *   update_quadrature_points
+ * @endcode
+ * where the quadrature points are only needed if a coefficient or Neumann
+ * boundary values are given. The estimator uses the element and the
+ * quadrature formula given by the arguments @p dof_no and @p quad_no,
+ * respectively, so the quadrature formula should be exact for the squared
+ * normal derivatives, e.g. QGauss<1>(fe_degree+1) as with
+ * KellyErrorEstimator.
+ *
+ * For meshes distributed over several MPI processes, the indicators of the
+ * locally owned cells can only be complete if the faces between locally
+ * owned cells and ghost cells are available on both processes. This
+ * requires to set MatrixFree::AdditionalData::hold_all_faces_to_owned_cells
+ * to true. The indicators of all other cells are set to zero.
+ *
+ * This class only supports continuous and discontinuous elements on a
+ * DoFHandler, not an hp::DoFHandler, and the mesh must not contain
+ * periodic faces. The material id and subdomain restrictions of
+ * KellyErrorEstimator are not available: the indicators of all locally
+ * owned cells are computed.
+ *
+ * @ingroup matrixfree
+ */
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d = fe_degree + 1,
+          int n_components  = 1,
+          typename Number   = double>
+class MatrixFreeKellyErrorEstimator
+{
+public:
+  /**
+   * The same strategies as for KellyErrorEstimator.
+   */
+  using Strategy = typename KellyErrorEstimator<dim>::Strategy;
+
+  /**
+   * Compute the error indicator of @p solution on all locally owned cells of
+   * @p matrix_free. The result is stored in @p estimated_error_per_cell,
+   * which is resized to the number of active cells of the triangulation and
+   * indexed by the active cell index, like in KellyErrorEstimator. If @p
+   * solution does not have its ghost values set, this function imports them
+   * and zeros them again before returning.
+   *
+   * @p neumann_bc maps the boundary indicators of Neumann boundaries to the
+   * prescribed normal derivative, which may have @p n_components components.
+   * On all other boundaries, the jump is taken as zero. @p coefficient, if
+   * given, is a scalar function or a function with @p n_components
+   * components multiplying the normal derivatives, as in
+   * KellyErrorEstimator.
+   */
+  static void
+  estimate(const MatrixFree<dim, Number> &                   matrix_free,
+           const LinearAlgebra::distributed::Vector<Number> &solution,
+           Vector<float> &estimated_error_per_cell,
+           const std::map<types::boundary_id, const Function<dim, Number> *>
+             &                  neumann_bc  = {},
+           const Function<dim> *coefficient = nullptr,
+           const Strategy       strategy =
+             KellyErrorEstimator<dim>::cell_diameter_over_24,
+           const unsigned int dof_no  = 0,
+           const unsigned int quad_no = 0);
+
+private:
+  /**
+   * Compute the integral of the squared jump of the normal derivative over
+   * the faces of the face batches in the range [@p begin, @p end) and store
+   * it in @p face_integrals.
+   */
+  static void
+  compute_face_integrals(
+    const MatrixFree<dim, Number> &                   matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &solution,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &                                   neumann_bc,
+    const Function<dim> *                 coefficient,
+    const unsigned int                    dof_no,
+    const unsigned int                    quad_no,
+    const unsigned int                    begin,
+    const unsigned int                    end,
+    std::vector<VectorizedArray<Number>> &face_integrals);
+};
+
+
+
+/* ------------------------- inline and template functions ----------------- */
+
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace MatrixFreeKellyErrorEstimatorImplementation
+  {
+    /**
+     * Access to the components of the normal derivative returned by
+     * FEFaceEvaluation, which is a plain VectorizedArray for scalar
+     * elements and a Tensor otherwise.
+     */
+    template <typename Number>
+    inline VectorizedArray<Number> &
+    component(VectorizedArray<Number> &value, const unsigned int)
+    {
+      return value;
+    }
+
+
+
+    template <int n_components, typename Number>
+    inline VectorizedArray<Number> &
+    component(Tensor<1, n_components, VectorizedArray<Number>> &value,
+              const unsigned int                                c)
+    {
+      return value[c];
+    }
+
+
+
+    /**
+     * Multiply the components of @p normal_derivative by the values of
+     * @p coefficient at the quadrature point @p point of the faces in the
+     * first @p n_filled lanes.
+     */
+    template <int dim, typename Number, typename ValueType>
+    inline void
+    apply_coefficient(const Function<dim> &                     coefficient,
+                      const Point<dim, VectorizedArray<Number>> &point,
+                      const unsigned int                         n_filled,
+                      const unsigned int                         n_components,
+                      ValueType &normal_derivative)
+    {
+      for (unsigned int v = 0; v < n_filled; ++v)
+        {
+          Point<dim> p;
+          for (unsigned int d = 0; d < dim; ++d)
+            p[d] = point[d][v];
+          for (unsigned int c = 0; c < n_components; ++c)
+            component(normal_derivative, c)[v] *=
+              coefficient.value(p, coefficient.n_components == 1 ? 0 : c);
+        }
+    }
+  } // namespace MatrixFreeKellyErrorEstimatorImplementation
+} // namespace internal
+
+
+
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components,
+          typename Number>
+void
+MatrixFreeKellyErrorEstimator<dim,
+                              fe_degree,
+                              n_q_points_1d,
+                              n_components,
+                              Number>::
+  compute_face_integrals(
+    const MatrixFree<dim, Number> &                   matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &solution,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &                                   neumann_bc,
+    const Function<dim> *                 coefficient,
+    const unsigned int                    dof_no,
+    const unsigned int                    quad_no,
+    const unsigned int                    begin,
+    const unsigned int                    end,
+    std::vector<VectorizedArray<Number>> &face_integrals)
+{
+  using namespace internal::MatrixFreeKellyErrorEstimatorImplementation;
+
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components, Number> phi_m(
+    matrix_free, true, dof_no, quad_no);
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components, Number> phi_p(
+    matrix_free, false, dof_no, quad_no);
+
+  const unsigned int n_inner_faces = matrix_free.n_inner_face_batches();
+  const unsigned int n_boundary_end =
+    n_inner_faces + matrix_free.n_boundary_face_batches();
+
+  for (unsigned int face = begin; face < end; ++face)
+    {
+      const bool is_boundary_face =
+        (face >= n_inner_faces && face < n_boundary_end);
+      const unsigned int n_filled =
+        matrix_free.n_active_entries_per_face_batch(face);
+
+      // faces with Dirichlet boundary conditions do not contribute
+      const Function<dim, Number> *neumann_function = nullptr;
+      if (is_boundary_face)
+        {
+          const auto entry = neumann_bc.find(matrix_free.get_boundary_id(face));
+          if (entry == neumann_bc.end())
+            {
+              face_integrals[face] = VectorizedArray<Number>();
+              continue;
+            }
+          neumann_function = entry->second;
+        }
+
+      phi_m.reinit(face);
+      phi_m.read_dof_values_plain(solution);
+      phi_m.evaluate(false, true);
+      if (!is_boundary_face)
+        {
+          phi_p.reinit(face);
+          phi_p.read_dof_values_plain(solution);
+          phi_p.evaluate(false, true);
+        }
+
+      VectorizedArray<Number> integral = VectorizedArray<Number>();
+      for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+        {
+          // the normal of the exterior side is the one of the interior side,
+          // so the jump is the difference of the two normal derivatives
+          auto jump = phi_m.get_normal_derivative(q);
+          if (!is_boundary_face)
+            jump -= phi_p.get_normal_derivative(q);
+
+          if (coefficient != nullptr)
+            apply_coefficient(*coefficient,
+                              phi_m.quadrature_point(q),
+                              n_filled,
+                              n_components,
+                              jump);
+
+          if (neumann_function != nullptr)
+            {
+              const Point<dim, VectorizedArray<Number>> point =
+                phi_m.quadrature_point(q);
+              for (unsigned int v = 0; v < n_filled; ++v)
+                {
+                  Point<dim> p;
+                  for (unsigned int d = 0; d < dim; ++d)
+                    p[d] = point[d][v];
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    component(jump, c)[v] -= neumann_function->value(p, c);
+                }
+            }
+
+          VectorizedArray<Number> jump_square = VectorizedArray<Number>();
+          for (unsigned int c = 0; c < n_components; ++c)
+            jump_square += component(jump, c) * component(jump, c);
+          integral += jump_square * phi_m.JxW(q);
+        }
+      face_integrals[face] = integral;
+    }
+}
+
+
+
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components,
+          typename Number>
+void
+MatrixFreeKellyErrorEstimator<dim,
+                              fe_degree,
+                              n_q_points_1d,
+                              n_components,
+                              Number>::
+  estimate(
+    const MatrixFree<dim, Number> &                   matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &solution,
+    Vector<float> &                                   estimated_error_per_cell,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &                  neumann_bc,
+    const Function<dim> *coefficient,
+    const Strategy       strategy,
+    const unsigned int   dof_no,
+    const unsigned int   quad_no)
+{
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+
+  for (const auto &boundary : neumann_bc)
+    {
+      (void)boundary;
+      Assert(boundary.second != nullptr, ExcInternalError());
+      Assert(boundary.second->n_components == n_components,
+             ExcDimensionMismatch(boundary.second->n_components,
+                                  n_components));
+    }
+  Assert(coefficient == nullptr || coefficient->n_components == 1 ||
+           coefficient->n_components == n_components,
+         ExcDimensionMismatch(coefficient->n_components, n_components));
+
+  const unsigned int n_faces = matrix_free.n_inner_face_batches() +
+                               matrix_free.n_boundary_face_batches() +
+                               matrix_free.n_ghost_inner_face_batches();
+
+  const bool has_ghost_elements = solution.has_ghost_elements();
+  if (!has_ghost_elements)
+    solution.update_ghost_values();
+
+  // compute the integrals of the squared jumps over all face batches; every
+  // task works on a contiguous subrange and writes to distinct entries
+  std::vector<VectorizedArray<Number>> face_integrals(n_faces);
+  parallel::apply_to_subranges(
+    0U,
+    n_faces,
+    [&](const unsigned int begin, const unsigned int end) {
+      compute_face_integrals(matrix_free,
+                             solution,
+                             neumann_bc,
+                             coefficient,
+                             dof_no,
+                             quad_no,
+                             begin,
+                             end,
+                             face_integrals);
+    },
+    16);
+
+  if (!has_ghost_elements)
+    solution.zero_out_ghosts();
+
+  // add the face integrals to the indicators of the adjacent cells that are
+  // locally owned, with the scaling factors of the chosen strategy. the
+  // index of the indicator and the scaling factors only depend on the cell,
+  // so compute them once per cell rather than once per face
+  const unsigned int faces_per_cell = GeometryInfo<dim>::faces_per_cell;
+  const unsigned int max_degree =
+    matrix_free.get_dof_handler(dof_no).get_fe().degree;
+  const unsigned int n_owned_cells = matrix_free.n_macro_cells() * n_lanes;
+  const bool         use_face_diameter =
+    (strategy == KellyErrorEstimator<dim>::face_diameter_over_twice_max_degree);
+
+  std::vector<unsigned int> active_cell_indices(n_owned_cells);
+  std::vector<double>       cell_factors(n_owned_cells, 1.);
+  std::vector<double>       face_diameters(
+    use_face_diameter ? n_owned_cells * faces_per_cell : 0);
+  for (unsigned int cell = 0; cell < matrix_free.n_macro_cells(); ++cell)
+    for (unsigned int v = 0;
+         v < matrix_free.n_active_entries_per_cell_batch(cell);
+         ++v)
+      {
+        const auto cell_iterator =
+          matrix_free.get_cell_iterator(cell, v, dof_no);
+        const unsigned int index   = cell * n_lanes + v;
+        active_cell_indices[index] = cell_iterator->active_cell_index();
+        if (strategy == KellyErrorEstimator<dim>::cell_diameter_over_24)
+          cell_factors[index] = cell_iterator->diameter() / 24.;
+        else if (strategy == KellyErrorEstimator<dim>::cell_diameter)
+          cell_factors[index] = cell_iterator->diameter();
+        else if (use_face_diameter)
+          for (unsigned int f = 0; f < faces_per_cell; ++f)
+            face_diameters[index * faces_per_cell + f] =
+              cell_iterator->face(f)->diameter();
+      }
+
+  estimated_error_per_cell.reinit(
+    matrix_free.get_dof_handler(dof_no).get_triangulation().n_active_cells());
+
+  for (unsigned int face = 0; face < n_faces; ++face)
+    {
+      const internal::MatrixFreeFunctions::FaceToCellTopology<n_lanes> &info =
+        matrix_free.get_face_info(face);
+      const bool is_boundary_face =
+        (face >= matrix_free.n_inner_face_batches() &&
+         face < matrix_free.n_inner_face_batches() +
+                  matrix_free.n_boundary_face_batches());
+
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_face_batch(face);
+           ++v)
+        {
+          const unsigned int cell_m = info.cells_interior[v];
+          const unsigned int cell_p =
+            is_boundary_face ? numbers::invalid_unsigned_int :
+                               info.cells_exterior[v];
+          const bool owned_m = cell_m < n_owned_cells;
+          const bool owned_p = cell_p < n_owned_cells;
+
+          if (!owned_m && !owned_p)
+            continue;
+
+          double face_factor = 1.;
+          if (use_face_diameter)
+            {
+              // the interior side is the finer one on faces with hanging
+              // nodes, so take the diameter of its face. If only the
+              // exterior cell is owned, use its subface instead
+              double face_diameter;
+              if (owned_m)
+                face_diameter =
+                  face_diameters[cell_m * faces_per_cell +
+                                 info.interior_face_no];
+              else if (info.subface_index <
+                       GeometryInfo<dim>::max_children_per_cell)
+                face_diameter =
+                  matrix_free
+                    .get_cell_iterator(cell_p / n_lanes,
+                                       cell_p % n_lanes,
+                                       dof_no)
+                    ->face(info.exterior_face_no)
+                    ->child(info.subface_index)
+                    ->diameter();
+              else
+                face_diameter =
+                  face_diameters[cell_p * faces_per_cell +
+                                 info.exterior_face_no];
+              face_factor =
+                face_diameter / (is_boundary_face ? max_degree :
+                                                    2. * max_degree);
+            }
+
+          if (owned_m)
+            estimated_error_per_cell(active_cell_indices[cell_m]) +=
+              face_integrals[face][v] * face_factor * cell_factors[cell_m];
+          if (owned_p)
+            estimated_error_per_cell(active_cell_indices[cell_p]) +=
+              face_integrals[face][v] * face_factor * cell_factors[cell_p];
+        }
+    }
+
+  for (float &error : estimated_error_per_cell)
+    error = std::sqrt(error);
+}
+
+#endif // DOXYGEN
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -3923,7 +3923,9 @@ FEEvaluationBase<dim, n_components_, Number, is_face>::read_write_operation(
   const unsigned int *cells;
   unsigned int        n_vectorization_actual =
     dof_info->n_vectorization_lanes_filled[dof_access_index][cell];
-  bool has_constraints = false;
+  bool               has_constraints = false;
+  const unsigned int n_components_read =
+    n_fe_components > 1 ? n_components : 1;
   if (is_face)
     {
       if (dof_access_index ==
@@ -3941,15 +3943,14 @@ FEEvaluationBase<dim, n_components_, Number, is_face>::read_write_operation(
         {
           Assert(cells[v] < dof_info->row_starts.size() - 1,
                  ExcInternalError());
-          has_constraints =
-            has_constraints &&
-            dof_info
+          if (dof_info
                 ->row_starts[cells[v] * n_fe_components +
-                             first_selected_component + n_components]
+                             first_selected_component + n_components_read]
                 .second != dof_info
                              ->row_starts[cells[v] * n_fe_components +
                                           first_selected_component]
-                             .second;
+                             .second)
+            has_constraints = true;
           dof_indices[v] = dof_info->dof_indices.data() +
                            dof_info
                              ->row_starts[cells[v] * n_fe_components +
@@ -3963,8 +3964,6 @@ FEEvaluationBase<dim, n_components_, Number, is_face>::read_write_operation(
     {
       AssertIndexRange((cell + 1) * n_vectorization * n_fe_components,
                        dof_info->row_starts.size());
-      const unsigned int n_components_read =
-        n_fe_components > 1 ? n_components : 1;
       for (unsigned int v = 0; v < n_vectorization_actual; ++v)
         {
           if (dof_info
@@ -4048,55 +4047,37 @@ FEEvaluationBase<dim, n_components_, Number, is_face>::read_write_operation(
         operation.process_empty(values_dofs[comp][i]);
   for (unsigned int v = 0; v < n_vectorization_actual; ++v)
     {
-      unsigned int       index_indicators, next_index_indicators;
-      const unsigned int n_components_read =
-        n_fe_components > 1 ? n_components : 1;
-      if (is_face)
-        {
-          index_indicators = dof_info
-                               ->row_starts[cells[v] * n_fe_components +
-                                            first_selected_component]
-                               .second;
-          next_index_indicators = dof_info
-                                    ->row_starts[cells[v] * n_fe_components +
-                                                 first_selected_component + 1]
-                                    .second;
-        }
-      else
-        {
-          index_indicators =
-            dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                           first_selected_component]
-              .second;
-          next_index_indicators =
-            dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                           first_selected_component + 1]
-              .second;
-        }
+      // faces access the cells adjacent to them by the indices in cells
+      const unsigned int cell_index =
+        is_face ? cells[v] : cell * n_vectorization + v;
+      unsigned int index_indicators =
+        dof_info
+          ->row_starts[cell_index * n_fe_components + first_selected_component]
+          .second;
+      unsigned int next_index_indicators =
+        dof_info
+          ->row_starts[cell_index * n_fe_components +
+                       first_selected_component + 1]
+          .second;
 
       if (apply_constraints == false &&
           dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+              ->row_starts[cell_index * n_fe_components +
                            first_selected_component]
               .second !=
             dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+              ->row_starts[cell_index * n_fe_components +
                            first_selected_component + n_components_read]
               .second)
         {
-          Assert(
-            dof_info->row_starts_plain_indices[cell * n_vectorization + v] !=
-              numbers::invalid_unsigned_int,
-            ExcNotInitialized());
+          Assert(dof_info->row_starts_plain_indices[cell_index] !=
+                   numbers::invalid_unsigned_int,
+                 ExcNotInitialized());
           dof_indices[v] =
             dof_info->plain_dof_indices.data() +
             dof_info->component_dof_indices_offset[active_fe_index]
                                                   [first_selected_component] +
-            (is_face ?
-               dof_info->row_starts_plain_indices[cells[v]] :
-               dof_info->row_starts_plain_indices[cell * n_vectorization + v]);
+            dof_info->row_starts_plain_indices[cell_index];
           next_index_indicators = index_indicators;
         }
 
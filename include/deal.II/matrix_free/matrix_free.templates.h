@@ -17,6 +17,7 @@
 #define dealii_matrix_free_templates_h
 
 
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/polynomials_piecewise.h>
@@ -239,6 +240,8 @@ MatrixFree<dim, Number>::internal_reinit(
   const std::vector<hp::QCollection<1>> &                 quad,
   const typename MatrixFree<dim, Number>::AdditionalData &additional_data)
 {
+  DEAL_II_INSTRUMENT_REGION("MatrixFree::reinit");
+
   // Reads out the FE information and stores the shape function values,
   // gradients and Hessians for quadrature points.
   {
@@ -399,6 +402,8 @@ MatrixFree<dim, Number>::internal_reinit(
   const std::vector<hp::QCollection<1>> &                 quad,
   const typename MatrixFree<dim, Number>::AdditionalData &additional_data)
 {
+  DEAL_II_INSTRUMENT_REGION("MatrixFree::reinit");
+
   // Reads out the FE information and stores the shape function values,
   // gradients and Hessians for quadrature points.
   {
@@ -1467,13 +1472,30 @@ MatrixFree<dim, Number>::initialize_indices(
                     if (dof_info[no].dof_indices[i] > part.local_size())
                       ghost_indices.push_back(
                         part.local_to_global(dof_info[no].dof_indices[i]));
-                  for (unsigned int i =
-                         dof_info[no].row_starts_plain_indices[cell];
-                       i < dof_info[no].row_starts_plain_indices[cell + 1];
-                       ++i)
-                    if (dof_info[no].plain_dof_indices[i] > part.local_size())
-                      ghost_indices.push_back(part.local_to_global(
-                        dof_info[no].plain_dof_indices[i]));
+                  // the plain indices are only stored for cells with
+                  // constraints, and the row starts of the other cells are
+                  // invalid
+                  const unsigned int plain_start =
+                    dof_info[no].row_starts_plain_indices.empty() ?
+                      numbers::invalid_unsigned_int :
+                      dof_info[no].row_starts_plain_indices[cell];
+                  if (plain_start != numbers::invalid_unsigned_int)
+                    {
+                      const unsigned int fe_index =
+                        dof_info[no].cell_active_fe_index.empty() ?
+                          0 :
+                          dof_info[no].cell_active_fe_index
+                            [cell / VectorizedArray<Number>::n_array_elements];
+                      const unsigned int dofs_this_cell =
+                        dof_info[no].dofs_per_cell[fe_index];
+                      for (unsigned int i = plain_start;
+                           i < plain_start + dofs_this_cell;
+                           ++i)
+                        if (dof_info[no].plain_dof_indices[i] >
+                            part.local_size())
+                          ghost_indices.push_back(part.local_to_global(
+                            dof_info[no].plain_dof_indices[i]));
+                    }
                 }
             std::sort(ghost_indices.begin(), ghost_indices.end());
             ghost_indices.erase(std::unique(ghost_indices.begin(),
@@ -161,6 +161,14 @@ DEAL_II_NAMESPACE_OPEN
  * there).
  * </ul>
  *
+ * If many large vectors are to be transferred, holding the old vectors,
+ * copies of them in a <tt>std::vector</tt>, and the new vectors at the same
+ * time may need more memory than available. In that case, use
+ * pack_for_coarsening_and_refinement() and the interpolate() function that
+ * takes a vector of pointers instead: the former copies the values of each
+ * vector into a buffer owned by this object and frees the memory of the
+ * vector, and the latter writes directly into the new vectors.
+ *
  * For deleting all stored data in @p SolutionTransfer and reinitializing it
  * use the <tt>clear()</tt> function.
  *
@@ -432,6 +440,57 @@ public:
   void
   interpolate(const VectorType &in, VectorType &out) const;
 
+  /**
+   * Prepare the @p SolutionTransfer for coarsening and refinement in a way
+   * that does not require the vectors in @p all_in to be kept alive until
+   * interpolate() is called. Like prepare_for_coarsening_and_refinement(),
+   * this function stores the dof indices of each cell that will not be
+   * coarsened and the interpolated values on each cell whose children will
+   * be coarsened away. In addition, it copies the values of each of the
+   * vectors into a contiguous buffer owned by this object, one buffer per
+   * vector. If @p release_input_vectors is true, the memory of each vector
+   * in @p all_in is freed as soon as its values have been copied, so that at
+   * most one vector exists twice at any time.
+   *
+   * After the triangulation has been refined and the dofs have been
+   * distributed, the data is written into the new vectors with
+   * interpolate(const std::vector<VectorType *> &). The typical use is as
+   * follows:
+   * @code
+   * std::vector<Vector<double> *> vectors = {&solution, &old_solution};
+   *
+   * tria.prepare_coarsening_and_refinement();
+   * soltrans.pack_for_coarsening_and_refinement(vectors);
+   * tria.execute_coarsening_and_refinement();
+   * dof_handler.distribute_dofs(fe);
+   *
+   * for (Vector<double> *vector : vectors)
+   *   vector->reinit(dof_handler.n_dofs());
+   * soltrans.interpolate(vectors);
+   * @endcode
+   *
+   * Compared to prepare_for_coarsening_and_refinement() with a
+   * <tt>std::vector<VectorType></tt> of copies of the solution vectors and
+   * the corresponding call of interpolate(), this avoids holding the old
+   * vectors, their copies, and the new vectors at the same time.
+   */
+  void
+  pack_for_coarsening_and_refinement(const std::vector<VectorType *> &all_in,
+                                     const bool release_input_vectors = true);
+
+  /**
+   * Interpolate the data stored by pack_for_coarsening_and_refinement() onto
+   * the refined and/or coarsened grid and write it into the vectors in @p
+   * all_out, which must have the right size, i.e., the number of dofs on the
+   * new mesh. The number of vectors must be the same as the one passed to
+   * pack_for_coarsening_and_refinement(), and the vectors in @p all_out may
+   * be the same objects. The buffer holding the values of each vector is
+   * freed as soon as the vector has been written, and this object is cleared
+   * at the end, so this function can only be called once.
+   */
+  void
+  interpolate(const std::vector<VectorType *> &all_out);
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object.
@@ -500,7 +559,13 @@ private:
     /**
      * The SolutionTransfer is prepared for coarsening and refinement.
      */
-    coarsening_and_refinement
+    coarsening_and_refinement,
+    /**
+     * The SolutionTransfer is prepared for coarsening and refinement and
+     * holds a copy of the values of the vectors, see
+     * pack_for_coarsening_and_refinement().
+     */
+    packed_coarsening_and_refinement
   };
 
   /**
@@ -547,12 +612,28 @@ private:
       , dof_values_ptr(dof_values_ptr_in)
       , active_fe_index(active_fe_index_in)
     {}
+    Pointerstruct(const std::size_t  packed_values_offset_in,
+                  const unsigned int active_fe_index_in)
+      : indices_ptr(nullptr)
+      , dof_values_ptr(nullptr)
+      , packed_values_offset(packed_values_offset_in)
+      , active_fe_index(active_fe_index_in)
+    {}
     std::size_t
     memory_consumption() const;
 
     std::vector<types::global_dof_index> *                indices_ptr;
     std::vector<Vector<typename VectorType::value_type>> *dof_values_ptr;
-    unsigned int                                          active_fe_index;
+
+    /**
+     * For cells whose children will be coarsened away and an object that
+     * is prepared for packed_coarsening_and_refinement: the position of the
+     * interpolated values of this cell in each of the #packed_values
+     * buffers, after the values at the old dofs.
+     */
+    std::size_t packed_values_offset = 0;
+
+    unsigned int active_fe_index;
   };
 
   /**
@@ -569,6 +650,14 @@ private:
    */
   std::vector<std::vector<Vector<typename VectorType::value_type>>>
     dof_values_on_cell;
+
+  /**
+   * Is used for pack_for_coarsening_and_refinement(): for each of the packed
+   * vectors a contiguous buffer of its values at the @p n_dofs_old dofs of
+   * the old mesh, followed by the interpolated values on all cells that
+   * will be coarsened.
+   */
+  std::vector<std::vector<typename VectorType::value_type>> packed_values;
 };
 
 
@@ -599,6 +599,16 @@ namespace VectorTools
    * with the hanging nodes from space @p dof afterwards, to make the result
    * continuous again.
    *
+   * A degree of freedom shared between neighboring cells gets the average of
+   * the values computed on these cells, which makes a difference for
+   * functions that are discontinuous along faces, edges or vertices of the
+   * mesh. The result does therefore not depend on the order in which cells
+   * are visited or on the parallel partitioning. For parallel vectors, or if
+   * not all components are selected, the averaging needs two temporary
+   * vectors of the size of @p vec. For serial vectors with all components
+   * selected, the values are summed up in @p vec directly and only the
+   * number of cells sharing each degree of freedom is stored.
+   *
    * The template argument <code>DoFHandlerType</code> may either be of type
    * DoFHandler or hp::DoFHandler.
    *
@@ -815,7 +825,13 @@ namespace VectorTools
    * quadrature formula for integration of the provided function while a
    * QGauss(fe_degree+2) object is used for the mass operator. You should
    * therefore make sure that the given quadrature formula is sufficient for
-   * creating the right-hand side.
+   * creating the right-hand side. The mass matrix is inverted by a conjugate
+   * gradient method preconditioned by a Chebyshev iteration around its
+   * diagonal. For discontinuous elements of type FE_DGQ (or systems of a
+   * single such element) with degree up to three and no constraints on a
+   * mesh where all cells are affine images of the reference cell, the mass
+   * matrix is block diagonal and is instead inverted exactly cell by cell
+   * using MatrixFreeOperators::CellwiseInverseMassMatrix.
    *
    * Otherwise, only serial Triangulations are supported and the mass matrix
    * is assembled exactly using MatrixTools::create_mass_matrix and the same
@@ -269,7 +269,9 @@ namespace VectorTools
     // function such that function(cell) is of type
     // Function<spacedim, typename VectorType::value_type>*
     //
-    // A given cell is skipped if function(cell) == nullptr
+    // A given cell is skipped if function(cell) == nullptr. If
+    // unique_function is true, function(cell) returns the same object for
+    // all cells.
     template <int dim,
               int spacedim,
               typename VectorType,
@@ -280,7 +282,8 @@ namespace VectorTools
                 const DoFHandlerType<dim, spacedim> &dof_handler,
                 T &                                  function,
                 VectorType &                         vec,
-                const ComponentMask &                component_mask)
+                const ComponentMask &                component_mask,
+                const bool                           unique_function = false)
     {
       Assert(component_mask.represents_n_components(
                dof_handler.get_fe().n_components()),
@@ -346,12 +349,33 @@ namespace VectorTools
       std::vector<std::vector<Vector<number>>> fe_function_values(fe.size());
       std::vector<std::vector<number>>         fe_dof_values(fe.size());
 
-      // We will need two temporary global vectors that store the new values
-      // and weights.
-      VectorType interpolation;
-      VectorType weights;
-      interpolation.reinit(vec);
-      weights.reinit(vec);
+      // For every global dof we take the average of the values computed on
+      // the cells sharing it. In general, this needs two temporary global
+      // vectors that store the sum of the values and the weights. If the
+      // same function is interpolated on all cells, all components are
+      // selected, and the vector is a serial one whose elements can be read
+      // and written in any order, we can instead sum up the values in the
+      // output vector itself and only count on how many cells each dof has
+      // been touched. The first value for a dof is assigned rather than
+      // added to zero, so the result is the same as with the temporary
+      // vectors. Parallel vectors need the temporary vectors since the
+      // contributions of cells owned by other processors have to be
+      // communicated.
+      const bool average_in_place =
+        unique_function && dealii::is_serial_vector<VectorType>::value &&
+        component_mask.n_selected_components(fe.n_components()) ==
+          fe.n_components();
+
+      VectorType                  interpolation;
+      VectorType                  weights;
+      std::vector<unsigned short> n_touches;
+      if (average_in_place)
+        n_touches.resize(vec.size(), 0);
+      else
+        {
+          interpolation.reinit(vec);
+          weights.reinit(vec);
+        }
 
       // Store locally owned dofs, so that we can skip all non-local dofs,
       // if they do not need to be interpolated.
@@ -481,6 +505,21 @@ namespace VectorTools
                     }
 #endif
 
+                  if (average_in_place)
+                    {
+                      unsigned short &n = n_touches[dofs_on_cell[i]];
+                      Assert(n < std::numeric_limits<unsigned short>::max(),
+                             ExcInternalError());
+                      if (n == 0)
+                        ::dealii::internal::ElementAccess<VectorType>::set(
+                          dof_values[i], dofs_on_cell[i], vec);
+                      else
+                        ::dealii::internal::ElementAccess<VectorType>::add(
+                          dof_values[i], dofs_on_cell[i], vec);
+                      ++n;
+                      continue;
+                    }
+
                   // Add local values to the global vectors
                   ::dealii::internal::ElementAccess<VectorType>::add(
                     dof_values[i], dofs_on_cell[i], interpolation);
@@ -510,6 +549,19 @@ namespace VectorTools
             }
         } /* loop over dof_handler.active_cell_iterators() */
 
+      if (average_in_place)
+        {
+          for (types::global_dof_index i = 0; i < n_touches.size(); ++i)
+            if (n_touches[i] > 1)
+              ::dealii::internal::ElementAccess<VectorType>::set(
+                ::dealii::internal::ElementAccess<VectorType>::get(vec, i) /
+                  typename VectorType::value_type(n_touches[i]),
+                i,
+                vec);
+          vec.compress(VectorOperation::insert);
+          return;
+        }
+
       interpolation.compress(VectorOperation::add);
       weights.compress(VectorOperation::add);
 
@@ -557,7 +609,7 @@ namespace VectorTools
     };
 
     internal::interpolate(
-      mapping, dof_handler, function_map, vec, component_mask);
+      mapping, dof_handler, function_map, vec, component_mask, true);
   }
 
 
@@ -1098,6 +1150,94 @@ namespace VectorTools
 
 
 
+    /*
+     * Solve a linear system with the matrix-free mass operator @p mass_matrix
+     * by the conjugate gradient method, reducing the residual by 10^-12 in at
+     * most @p max_steps iterations. The preconditioner is a Chebyshev
+     * iteration of degree three around the inverse diagonal of the operator,
+     * which needs to be computed before calling this function. Since the
+     * mass matrix is spectrally equivalent to its diagonal independently of
+     * the mesh size, a few additional operator evaluations per iteration
+     * pay off through a much smaller number of iterations, and thus also of
+     * global reductions, than with point Jacobi alone.
+     */
+    template <typename MatrixType, typename Number>
+    void
+    solve_mass_matrix_free(
+      const MatrixType &                                mass_matrix,
+      LinearAlgebra::distributed::Vector<Number> &      solution,
+      const LinearAlgebra::distributed::Vector<Number> &rhs,
+      const types::global_dof_index                     max_steps)
+    {
+      using VectorType = LinearAlgebra::distributed::Vector<Number>;
+      using PreconditionerType =
+        PreconditionChebyshev<MatrixType,
+                              VectorType,
+                              DiagonalMatrix<VectorType>>;
+
+      typename PreconditionerType::AdditionalData data;
+      data.degree         = 3;
+      data.preconditioner = mass_matrix.get_matrix_diagonal_inverse();
+      PreconditionerType preconditioner;
+      preconditioner.initialize(mass_matrix, data);
+
+      ReductionControl     control(max_steps, 0., 1e-12, false, false);
+      SolverCG<VectorType> cg(control);
+      cg.solve(mass_matrix, solution, rhs, preconditioner);
+    }
+
+
+
+    /*
+     * Multiply @p rhs by the inverse of the mass matrix of a discontinuous
+     * tensor product element cell by cell and write the result into @p
+     * solution, using the quadrature formula with index one of @p
+     * matrix_free that needs to be a Gauss formula with fe_degree+1 points.
+     * The second overload is selected if the degree is only known at run
+     * time, which CellwiseInverseMassMatrix does not support.
+     */
+    template <int components, int fe_degree, int dim, typename Number>
+    void
+    apply_inverse_mass_matrix_cellwise(
+      const MatrixFree<dim, Number> &                   matrix_free,
+      LinearAlgebra::distributed::Vector<Number> &      solution,
+      const LinearAlgebra::distributed::Vector<Number> &rhs,
+      std::true_type)
+    {
+      FEEvaluation<dim, fe_degree, fe_degree + 1, components, Number> phi(
+        matrix_free, 0, 1);
+      MatrixFreeOperators::
+        CellwiseInverseMassMatrix<dim, fe_degree, components, Number>
+                                             inverse(phi);
+      AlignedVector<VectorizedArray<Number>> inverse_JxW(phi.n_q_points);
+      for (unsigned int cell = 0; cell < matrix_free.n_macro_cells(); ++cell)
+        {
+          phi.reinit(cell);
+          phi.read_dof_values(rhs);
+          inverse.fill_inverse_JxW_values(inverse_JxW);
+          inverse.apply(inverse_JxW,
+                        components,
+                        phi.begin_dof_values(),
+                        phi.begin_dof_values());
+          phi.set_dof_values(solution);
+        }
+    }
+
+
+
+    template <int components, int fe_degree, int dim, typename Number>
+    void
+    apply_inverse_mass_matrix_cellwise(
+      const MatrixFree<dim, Number> &,
+      LinearAlgebra::distributed::Vector<Number> &,
+      const LinearAlgebra::distributed::Vector<Number> &,
+      std::false_type)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+
+
     /*
      * MatrixFree implementation of project() for an arbitrary number of
      * components and arbitrary degree of the FiniteElement.
@@ -1137,19 +1277,76 @@ namespace VectorTools
       Assert(dof.get_fe(0).n_components() == components,
              ExcDimensionMismatch(components, dof.get_fe(0).n_components()));
 
+      // For discontinuous tensor product elements without constraints, the
+      // mass matrix is block diagonal. On affine cells, a Gauss formula with
+      // fe_degree+1 points integrates it exactly, and we can apply its
+      // inverse cell by cell instead of solving with CG. We therefore set up
+      // this quadrature formula in addition to the one used by the mass
+      // operator, and check the cell geometries once the MatrixFree object
+      // has computed them.
+      const FiniteElement<dim, spacedim> &fe = dof.get_fe();
+      bool use_cellwise_inverse =
+        fe_degree != -1 && fe.dofs_per_face == 0 &&
+        fe.n_base_elements() == 1 &&
+        dynamic_cast<const FE_DGQ<dim, spacedim> *>(&fe.base_element(0)) !=
+          nullptr &&
+        constraints.n_constraints() == 0;
+
       // set up mass matrix and right hand side
       typename MatrixFree<dim, Number>::AdditionalData additional_data;
       additional_data.tasks_parallel_scheme =
         MatrixFree<dim, Number>::AdditionalData::partition_color;
       additional_data.mapping_update_flags =
         (update_values | update_JxW_values);
+      std::vector<QGauss<1>> quadratures(1, QGauss<1>(fe.degree + 2));
+      if (use_cellwise_inverse)
+        quadratures.emplace_back(fe.degree + 1);
       std::shared_ptr<MatrixFree<dim, Number>> matrix_free(
         new MatrixFree<dim, Number>());
       matrix_free->reinit(mapping,
-                          dof,
-                          constraints,
-                          QGauss<1>(dof.get_fe().degree + 2),
+                          std::vector<const DoFHandler<dim, spacedim> *>(1,
+                                                                         &dof),
+                          std::vector<const AffineConstraints<Number> *>(
+                            1, &constraints),
+                          quadratures,
                           additional_data);
+
+      for (unsigned int cell = 0;
+           cell < matrix_free->n_macro_cells() && use_cellwise_inverse;
+           ++cell)
+        if (matrix_free->get_mapping_info().get_cell_type(cell) >
+            dealii::internal::MatrixFreeFunctions::affine)
+          use_cellwise_inverse = false;
+
+      // the constraints and the cell geometries are only known locally, but
+      // the two code paths below differ in their collective operations, so
+      // all processors need to take the same one
+      MPI_Comm comm = MPI_COMM_SELF;
+#ifdef DEAL_II_WITH_MPI
+      if (const parallel::Triangulation<dim, spacedim> *ptria =
+            dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+              &dof.get_triangulation()))
+        comm = ptria->get_communicator();
+#endif
+      use_cellwise_inverse =
+        Utilities::MPI::min(static_cast<unsigned int>(use_cellwise_inverse),
+                            comm) == 1;
+
+      if (use_cellwise_inverse)
+        {
+          LinearAlgebra::distributed::Vector<Number> rhs;
+          matrix_free->initialize_dof_vector(work_result);
+          matrix_free->initialize_dof_vector(rhs);
+          create_right_hand_side(
+            mapping, dof, quadrature, function, rhs, constraints);
+          apply_inverse_mass_matrix_cellwise<components, fe_degree>(
+            *matrix_free,
+            work_result,
+            rhs,
+            std::integral_constant<bool, fe_degree != -1>());
+          return;
+        }
+
       using MatrixType = MatrixFreeOperators::MassOperator<
         dim,
         fe_degree,
@@ -1194,11 +1391,7 @@ namespace VectorTools
       // steps may not be sufficient, since roundoff errors may accumulate for
       // badly conditioned matrices. This behavior can be observed, e.g. for
       // FE_Q_Hierarchical for degree higher than three.
-      ReductionControl control(6. * rhs.size(), 0., 1e-12, false, false);
-      SolverCG<LinearAlgebra::distributed::Vector<Number>> cg(control);
-      PreconditionJacobi<MatrixType>                       preconditioner;
-      preconditioner.initialize(mass_matrix, 1.);
-      cg.solve(mass_matrix, work_result, rhs, preconditioner);
+      solve_mass_matrix_free(mass_matrix, work_result, rhs, 6 * rhs.size());
       work_result += inhomogeneities;
 
       constraints.distribute(work_result);
@@ -1554,12 +1747,7 @@ namespace VectorTools
       // steps may not be sufficient, since roundoff errors may accumulate for
       // badly conditioned matrices. This behavior can be observed, e.g. for
       // FE_Q_Hierarchical for degree higher than three.
-      ReductionControl control(5. * rhs.size(), 0., 1e-12, false, false);
-      SolverCG<LinearAlgebra::distributed::Vector<Number>>    cg(control);
-      typename PreconditionJacobi<MatrixType>::AdditionalData data(0.8);
-      PreconditionJacobi<MatrixType>                          preconditioner;
-      preconditioner.initialize(mass_matrix, data);
-      cg.solve(mass_matrix, vec, rhs, preconditioner);
+      solve_mass_matrix_free(mass_matrix, vec, rhs, 5 * rhs.size());
       vec += inhomogeneities;
 
       constraints.distribute(vec);
@@ -1647,12 +1835,7 @@ namespace VectorTools
       // steps may not be sufficient, since roundoff errors may accumulate for
       // badly conditioned matrices. This behavior can be observed, e.g. for
       // FE_Q_Hierarchical for degree higher than three.
-      ReductionControl control(5. * rhs.size(), 0., 1e-12, false, false);
-      SolverCG<LinearAlgebra::distributed::Vector<Number>>    cg(control);
-      typename PreconditionJacobi<MatrixType>::AdditionalData data(0.8);
-      PreconditionJacobi<MatrixType>                          preconditioner;
-      preconditioner.initialize(mass_matrix, data);
-      cg.solve(mass_matrix, vec, rhs, preconditioner);
+      solve_mass_matrix_free(mass_matrix, vec, rhs, 5 * rhs.size());
       vec += inhomogeneities;
 
       constraints.distribute(vec);
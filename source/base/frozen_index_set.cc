@@ -0,0 +1,412 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/frozen_index_set.h>
+#include <deal.II/base/memory_consumption.h>
+
+#include <utility>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  /**
+   * Sets with at most this many ranges are stored as ranges, all others as
+   * chunks.
+   */
+  const unsigned int max_n_ranges = 64;
+} // namespace
+
+
+
+FrozenIndexSet::FrozenIndexSet()
+  : index_space_size(0)
+  , n_elements_in_set_data(0)
+  , representation(Representation::ranges)
+  , largest_range(0)
+{}
+
+
+
+FrozenIndexSet::FrozenIndexSet(const IndexSet &index_set)
+  : FrozenIndexSet()
+{
+  reinit(index_set);
+}
+
+
+
+void
+FrozenIndexSet::reinit(const IndexSet &index_set)
+{
+  index_set.compress();
+
+  index_space_size       = index_set.size();
+  n_elements_in_set_data = index_set.n_elements();
+  largest_range          = 0;
+
+  range_begins.clear();
+  range_ends.clear();
+  range_n_elements_before.clear();
+  chunk_keys.clear();
+  chunks.clear();
+  array_data.clear();
+  bitmap_words.clear();
+  bitmap_counts.clear();
+  run_data.clear();
+  run_counts.clear();
+
+  if (index_set.n_intervals() <= max_n_ranges)
+    {
+      representation = Representation::ranges;
+      for (IndexSet::IntervalIterator interval = index_set.begin_intervals();
+           interval != index_set.end_intervals();
+           ++interval)
+        {
+          const size_type end = interval->last() + 1;
+          range_n_elements_before.push_back(
+            range_begins.empty() ? 0 :
+                                   range_n_elements_before.back() +
+                                     (range_ends.back() - range_begins.back()));
+          range_begins.push_back(end - interval->n_elements());
+          range_ends.push_back(end);
+          if (range_ends.back() - range_begins.back() >
+              range_ends[largest_range] - range_begins[largest_range])
+            largest_range = range_begins.size() - 1;
+        }
+      return;
+    }
+
+  representation = Representation::chunks;
+
+  // collect the runs of one chunk after the other, and store them in the
+  // container that needs the least memory once the chunk is complete
+  const size_type chunk_mask = (size_type(1) << chunk_bits) - 1;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> runs;
+  size_type                                            current_key = 0;
+  size_type                                            n_before    = 0;
+
+  const auto finish_chunk = [&]() {
+    if (runs.empty())
+      return;
+
+    Chunk chunk;
+    chunk.n_elements_before = n_before;
+    chunk.n_elements        = 0;
+    for (const auto &run : runs)
+      chunk.n_elements += run.second - run.first;
+
+    const std::size_t array_bytes = sizeof(std::uint16_t) * chunk.n_elements;
+    const std::size_t bitmap_bytes =
+      (sizeof(std::uint64_t) + sizeof(std::uint16_t)) * n_bitmap_words;
+    const std::size_t run_bytes = 3 * sizeof(std::uint32_t) * runs.size();
+
+    if (run_bytes <= array_bytes && run_bytes <= bitmap_bytes)
+      {
+        chunk.type      = ContainerType::runs;
+        chunk.offset    = run_counts.size();
+        chunk.n_entries = runs.size();
+        std::uint32_t count = 0;
+        for (const auto &run : runs)
+          {
+            run_data.push_back(run.first);
+            run_data.push_back(run.second);
+            run_counts.push_back(count);
+            count += run.second - run.first;
+          }
+      }
+    else if (array_bytes <= bitmap_bytes)
+      {
+        chunk.type      = ContainerType::array;
+        chunk.offset    = array_data.size();
+        chunk.n_entries = chunk.n_elements;
+        for (const auto &run : runs)
+          for (std::uint32_t i = run.first; i < run.second; ++i)
+            array_data.push_back(i);
+      }
+    else
+      {
+        chunk.type      = ContainerType::bitmap;
+        chunk.offset    = bitmap_words.size();
+        chunk.n_entries = 0;
+        bitmap_words.resize(bitmap_words.size() + n_bitmap_words, 0);
+        std::uint64_t *words = bitmap_words.data() + chunk.offset;
+        for (const auto &run : runs)
+          for (std::uint32_t i = run.first; i < run.second; ++i)
+            words[i / 64] |= std::uint64_t(1) << (i % 64);
+
+        std::uint16_t count = 0;
+        for (unsigned int w = 0; w < n_bitmap_words; ++w)
+          {
+            bitmap_counts.push_back(count);
+            count += std::bitset<64>(words[w]).count();
+          }
+      }
+
+    chunk_keys.push_back(current_key);
+    chunks.push_back(chunk);
+    n_before += chunk.n_elements;
+    runs.clear();
+  };
+
+  for (IndexSet::IntervalIterator interval = index_set.begin_intervals();
+       interval != index_set.end_intervals();
+       ++interval)
+    {
+      const size_type end   = interval->last() + 1;
+      size_type       begin = end - interval->n_elements();
+
+      // split the interval at chunk boundaries
+      while (begin < end)
+        {
+          const size_type key = begin >> chunk_bits;
+          if (key != current_key)
+            {
+              finish_chunk();
+              current_key = key;
+            }
+          const size_type chunk_end =
+            std::min(end, (key + 1) << chunk_bits);
+          runs.emplace_back(begin & chunk_mask,
+                            (chunk_end - 1 - (key << chunk_bits)) + 1);
+          begin = chunk_end;
+        }
+    }
+  finish_chunk();
+
+  Assert(n_before == n_elements_in_set_data, ExcInternalError());
+}
+
+
+
+FrozenIndexSet::size_type
+FrozenIndexSet::nth_index_in_set(const size_type local_index) const
+{
+  AssertIndexRange(local_index, n_elements());
+
+  if (representation == Representation::ranges)
+    {
+      const unsigned int range =
+        std::upper_bound(range_n_elements_before.begin(),
+                         range_n_elements_before.end(),
+                         local_index) -
+        range_n_elements_before.begin() - 1;
+      return range_begins[range] +
+             (local_index - range_n_elements_before[range]);
+    }
+
+  const unsigned int c =
+    std::upper_bound(chunks.begin(),
+                     chunks.end(),
+                     local_index,
+                     [](const size_type index, const Chunk &chunk) {
+                       return index < chunk.n_elements_before;
+                     }) -
+    chunks.begin() - 1;
+  const Chunk &      chunk = chunks[c];
+  const unsigned int n     = local_index - chunk.n_elements_before;
+  const size_type    chunk_begin = chunk_keys[c] << chunk_bits;
+
+  switch (chunk.type)
+    {
+      case ContainerType::array:
+        return chunk_begin + array_data[chunk.offset + n];
+
+      case ContainerType::bitmap:
+        {
+          // find the last word whose number of previous elements is at most
+          // n. this word contains the element we are looking for
+          const std::uint16_t *counts = bitmap_counts.data() + chunk.offset;
+          const unsigned int   w =
+            std::upper_bound(counts, counts + n_bitmap_words, n) - counts - 1;
+          std::uint64_t word = bitmap_words[chunk.offset + w];
+          for (unsigned int i = counts[w]; i < n; ++i)
+            word &= word - 1;
+          unsigned int bit = 0;
+          while ((word & (std::uint64_t(1) << bit)) == 0)
+            ++bit;
+          return chunk_begin + 64 * w + bit;
+        }
+
+      case ContainerType::runs:
+        {
+          const std::uint32_t *counts = run_counts.data() + chunk.offset;
+          const unsigned int   r =
+            std::upper_bound(counts, counts + chunk.n_entries, n) - counts -
+            1;
+          return chunk_begin + run_data[2 * (chunk.offset + r)] +
+                 (n - counts[r]);
+        }
+
+      default:
+        Assert(false, ExcInternalError());
+        return numbers::invalid_dof_index;
+    }
+}
+
+
+
+void
+FrozenIndexSet::index_within_set(
+  const ArrayView<const size_type> &global_indices,
+  const ArrayView<size_type> &      local_indices) const
+{
+  AssertDimension(global_indices.size(), local_indices.size());
+
+  if (representation == Representation::ranges)
+    {
+      unsigned int hint = largest_range;
+      for (unsigned int i = 0; i < global_indices.size(); ++i)
+        {
+          AssertIndexRange(global_indices[i], size());
+          local_indices[i] = find_in_ranges(global_indices[i], hint);
+        }
+    }
+  else
+    {
+      unsigned int hint = 0;
+      for (unsigned int i = 0; i < global_indices.size(); ++i)
+        {
+          AssertIndexRange(global_indices[i], size());
+          local_indices[i] = find_in_chunks(global_indices[i], hint);
+        }
+    }
+}
+
+
+
+FrozenIndexSet::size_type
+FrozenIndexSet::n_elements_in_set(
+  const ArrayView<const size_type> &indices) const
+{
+  size_type    n_elements = 0;
+  unsigned int hint       = (representation == Representation::ranges ?
+                         largest_range :
+                         0);
+  for (const size_type index : indices)
+    {
+      AssertIndexRange(index, size());
+      if ((representation == Representation::ranges ?
+             find_in_ranges(index, hint) :
+             find_in_chunks(index, hint)) != numbers::invalid_dof_index)
+        ++n_elements;
+    }
+  return n_elements;
+}
+
+
+
+FrozenIndexSet::size_type
+FrozenIndexSet::find_in_ranges(const size_type index,
+                               unsigned int &  hint) const
+{
+  const unsigned int n_ranges = range_begins.size();
+  if (n_ranges == 0)
+    return numbers::invalid_dof_index;
+
+  // first check the range given by the hint and the one after it, which
+  // covers the common case of sorted queries. otherwise do a binary search
+  // on the side of the hint on which the index lies
+  unsigned int first = 0, last = n_ranges;
+  if (hint < n_ranges)
+    {
+      if (index >= range_begins[hint])
+        {
+          if (index < range_ends[hint])
+            return range_n_elements_before[hint] +
+                   (index - range_begins[hint]);
+          if (hint + 1 == n_ranges || index < range_begins[hint + 1])
+            return numbers::invalid_dof_index;
+          first = hint + 1;
+        }
+      else
+        last = hint;
+    }
+
+  const unsigned int range =
+    std::upper_bound(range_begins.begin() + first,
+                     range_begins.begin() + last,
+                     index) -
+    range_begins.begin();
+  if (range == 0)
+    {
+      hint = 0;
+      return numbers::invalid_dof_index;
+    }
+
+  hint = range - 1;
+  if (index < range_ends[hint])
+    return range_n_elements_before[hint] + (index - range_begins[hint]);
+  else
+    return numbers::invalid_dof_index;
+}
+
+
+
+FrozenIndexSet::size_type
+FrozenIndexSet::find_in_chunks(const size_type index,
+                               unsigned int &  hint) const
+{
+  const size_type    key      = index >> chunk_bits;
+  const unsigned int n_chunks = chunks.size();
+
+  // check the chunk given by the hint, otherwise search on the side of the
+  // hint on which the index lies
+  if (hint >= n_chunks || chunk_keys[hint] != key)
+    {
+      unsigned int first = 0, last = n_chunks;
+      if (hint < n_chunks)
+        {
+          if (chunk_keys[hint] < key)
+            first = hint + 1;
+          else
+            last = hint;
+        }
+      const unsigned int c = std::lower_bound(chunk_keys.begin() + first,
+                                              chunk_keys.begin() + last,
+                                              key) -
+                             chunk_keys.begin();
+      hint = c;
+      if (c == last || chunk_keys[c] != key)
+        return numbers::invalid_dof_index;
+    }
+
+  const Chunk &   chunk = chunks[hint];
+  const size_type position =
+    find_in_chunk(chunk, index & ((size_type(1) << chunk_bits) - 1));
+  if (position == numbers::invalid_dof_index)
+    return numbers::invalid_dof_index;
+  return chunk.n_elements_before + position;
+}
+
+
+
+std::size_t
+FrozenIndexSet::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(range_begins) +
+         MemoryConsumption::memory_consumption(range_ends) +
+         MemoryConsumption::memory_consumption(range_n_elements_before) +
+         MemoryConsumption::memory_consumption(chunk_keys) +
+         chunks.capacity() * sizeof(Chunk) +
+         MemoryConsumption::memory_consumption(array_data) +
+         MemoryConsumption::memory_consumption(bitmap_words) +
+         MemoryConsumption::memory_consumption(bitmap_counts) +
+         MemoryConsumption::memory_consumption(run_data) +
+         MemoryConsumption::memory_consumption(run_counts);
+}
+
+DEAL_II_NAMESPACE_CLOSE
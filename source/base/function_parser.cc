@@ -18,14 +18,20 @@
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/vector.h>
 
 #include <boost/math/special_functions/erf.hpp>
 #include <boost/random.hpp>
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <map>
+#include <utility>
 
 #ifdef DEAL_II_WITH_MUPARSER
 #  include <muParser.h>
@@ -49,6 +55,7 @@ FunctionParser<dim>::FunctionParser(const unsigned int n_components,
                                     const double       initial_time,
                                     const double       h)
   : AutoDerivativeFunction<dim>(h, n_components, initial_time)
+  , evaluation_mode(EvaluationMode::muparser)
   , initialized(false)
   , n_vars(0)
 {}
@@ -62,6 +69,7 @@ FunctionParser<dim>::FunctionParser(const std::string &expression,
   : AutoDerivativeFunction<dim>(
       h,
       Utilities::split_string_list(expression, ';').size())
+  , evaluation_mode(EvaluationMode::muparser)
   , initialized(false)
   , n_vars(0)
 {
@@ -89,6 +97,21 @@ template <int dim>
 FunctionParser<dim>::~FunctionParser() = default;
 
 
+
+template <int dim>
+void
+FunctionParser<dim>::set_evaluation_mode(const EvaluationMode mode)
+{
+  evaluation_mode = mode;
+
+#ifdef DEAL_II_WITH_MUPARSER
+  // the expressions are only compiled once the bytecode is needed
+  if (mode == EvaluationMode::bytecode && initialized && bytecode.empty())
+    init_bytecode();
+#endif
+}
+
+
 #ifdef DEAL_II_WITH_MUPARSER
 
 template <int dim>
@@ -139,6 +162,13 @@ FunctionParser<dim>::initialize(const std::string &             variables,
   // away
   init_muparser();
 
+  // the expressions are known to be valid now, so compile them if the
+  // bytecode evaluation mode is selected. otherwise, set_evaluation_mode()
+  // does so if it is selected later
+  bytecode.clear();
+  if (evaluation_mode == EvaluationMode::bytecode)
+    init_bytecode();
+
   // finally set the initialization bit
   initialized = true;
 }
@@ -263,6 +293,826 @@ namespace internal
     return uniform_distribution(rng);
   }
 
+
+
+  namespace FunctionParserImplementation
+  {
+    // the functions muparser defines itself, implemented in the same way as
+    // in muparser so that both evaluation modes give the same results
+    double
+    mu_sin(double value)
+    {
+      return std::sin(value);
+    }
+
+    double
+    mu_cos(double value)
+    {
+      return std::cos(value);
+    }
+
+    double
+    mu_tan(double value)
+    {
+      return std::tan(value);
+    }
+
+    double
+    mu_asin(double value)
+    {
+      return std::asin(value);
+    }
+
+    double
+    mu_acos(double value)
+    {
+      return std::acos(value);
+    }
+
+    double
+    mu_atan(double value)
+    {
+      return std::atan(value);
+    }
+
+    double
+    mu_atan2(double y, double x)
+    {
+      return std::atan2(y, x);
+    }
+
+    double
+    mu_sinh(double value)
+    {
+      return std::sinh(value);
+    }
+
+    double
+    mu_cosh(double value)
+    {
+      return std::cosh(value);
+    }
+
+    double
+    mu_tanh(double value)
+    {
+      return std::tanh(value);
+    }
+
+    double
+    mu_asinh(double value)
+    {
+      return std::log(value + std::sqrt(value * value + 1));
+    }
+
+    double
+    mu_acosh(double value)
+    {
+      return std::log(value + std::sqrt(value * value - 1));
+    }
+
+    double
+    mu_atanh(double value)
+    {
+      return 0.5 * std::log((1 + value) / (1 - value));
+    }
+
+    double
+    mu_log2(double value)
+    {
+      return std::log(value) / std::log(2.);
+    }
+
+    double
+    mu_log10(double value)
+    {
+      return std::log10(value);
+    }
+
+    double
+    mu_exp(double value)
+    {
+      return std::exp(value);
+    }
+
+    double
+    mu_sqrt(double value)
+    {
+      return std::sqrt(value);
+    }
+
+    double
+    mu_sign(double value)
+    {
+      return (value < 0) ? -1. : (value > 0) ? 1. : 0.;
+    }
+
+    double
+    mu_rint(double value)
+    {
+      return std::floor(value + 0.5);
+    }
+
+    double
+    mu_abs(double value)
+    {
+      return (value >= 0) ? value : -value;
+    }
+
+
+
+    /**
+     * The operations of the stack machine that evaluates a compiled
+     * expression. Each operation takes its arguments from the top of the
+     * stack and puts its result there.
+     */
+    enum class OpCode : unsigned char
+    {
+      constant,
+      variable,
+      negate,
+      add,
+      subtract,
+      multiply,
+      divide,
+      power,
+      less,
+      greater,
+      less_equal,
+      greater_equal,
+      equal,
+      not_equal,
+      logical_and,
+      logical_or,
+      select,
+      function_1,
+      function_2,
+      function_3,
+      sum,
+      average,
+      minimum,
+      maximum
+    };
+
+
+
+    /**
+     * One instruction of a compiled expression. Depending on the operation,
+     * @p index is the index of a variable or the number of arguments, and
+     * one of the other members holds the constant or the function to call.
+     */
+    struct Instruction
+    {
+      OpCode       opcode;
+      unsigned int index;
+      double       constant;
+      double (*function_1)(double);
+      double (*function_2)(double, double);
+      double (*function_3)(double, double, double);
+    };
+
+
+
+    /**
+     * Access the lanes of a number uniformly for double and
+     * VectorizedArray<double>.
+     */
+    inline double &
+    lane(double &value, const unsigned int)
+    {
+      return value;
+    }
+
+    inline double &
+    lane(VectorizedArray<double> &value, const unsigned int v)
+    {
+      return value[v];
+    }
+
+    template <typename Number>
+    constexpr unsigned int
+    n_lanes()
+    {
+      return sizeof(Number) / sizeof(double);
+    }
+
+
+
+    /**
+     * An expression compiled into a program for a stack machine. The nested
+     * class Compiler is a recursive descent parser for the syntax of muparser,
+     * with
+     * the same precedences of the operators (from low to high: the ternary
+     * operator <tt>?:</tt>; <tt>||</tt> and <tt>|</tt>; <tt>&&</tt> and
+     * <tt>&</tt>; comparisons; <tt>+</tt> and <tt>-</tt>; <tt>*</tt>,
+     * <tt>/</tt>, and the signs; <tt>^</tt>). Since muparser has already
+     * checked the expression, the parser does not need to produce good error
+     * messages; it throws an exception for everything it does not support.
+     */
+    class Bytecode
+    {
+    public:
+      Bytecode(const std::string &                  expression,
+               const std::vector<std::string> &     variable_names,
+               const std::map<std::string, double> &constants);
+
+      /**
+       * Evaluate the expression for the given values of the variables, for
+       * one point (double) or several points at once
+       * (VectorizedArray<double>).
+       */
+      template <typename Number>
+      Number
+      evaluate(const Number *variables) const;
+
+    private:
+      /**
+       * The maximal depth of the stack, chosen such that the stack fits
+       * into a few kilobytes for the widest VectorizedArray.
+       */
+      static const unsigned int max_stack_size = 32;
+
+      class Compiler;
+
+      std::vector<Instruction> program;
+    };
+
+
+
+    /**
+     * The parser that turns an expression into the program of a Bytecode
+     * object. An object of this class only lives while the Bytecode is
+     * constructed, so it can refer to the expression, the names of the
+     * variables and the constants without copying them.
+     */
+    class Bytecode::Compiler
+    {
+    public:
+      Compiler(const std::string &                  expression,
+               const std::vector<std::string> &     variable_names,
+               const std::map<std::string, double> &constants);
+
+      /**
+       * Parse the expression and return the program.
+       */
+      std::vector<Instruction>
+      compile();
+
+    private:
+      void
+      parse_ternary();
+
+      void
+      parse_binary(const unsigned int precedence);
+
+      void
+      parse_unary();
+
+      void
+      parse_power();
+
+      void
+      parse_primary();
+
+      void
+      parse_function(const std::string &name);
+
+      /**
+       * Skip whitespace and return whether the expression continues with
+       * @p token at the current position. If so, move past it.
+       */
+      bool
+      match(const char *token);
+
+      /**
+       * Add an instruction that takes @p n_arguments values from the stack
+       * and puts one back.
+       */
+      void
+      add(const Instruction &instruction, const unsigned int n_arguments);
+
+      const std::string &                  expression;
+      const std::vector<std::string> &     variable_names;
+      const std::map<std::string, double> &constants;
+      std::string::size_type               position;
+      unsigned int                         stack_size;
+
+      std::vector<Instruction> program;
+    };
+
+
+
+    Bytecode::Bytecode(const std::string &                  expression,
+                       const std::vector<std::string> &     variable_names,
+                       const std::map<std::string, double> &constants)
+      : program(Compiler(expression, variable_names, constants).compile())
+    {}
+
+
+
+    Bytecode::Compiler::Compiler(
+      const std::string &                  expression,
+      const std::vector<std::string> &     variable_names,
+      const std::map<std::string, double> &constants)
+      : expression(expression)
+      , variable_names(variable_names)
+      , constants(constants)
+      , position(0)
+      , stack_size(0)
+    {}
+
+
+
+    std::vector<Instruction>
+    Bytecode::Compiler::compile()
+    {
+      parse_ternary();
+      match("");
+      AssertThrow(position == expression.size(),
+                  ExcMessage("Unexpected character in expression"));
+      Assert(stack_size == 1, ExcInternalError());
+      return std::move(program);
+    }
+
+
+
+    bool
+    Bytecode::Compiler::match(const char *token)
+    {
+      while (position < expression.size() &&
+             std::isspace(static_cast<unsigned char>(expression[position])))
+        ++position;
+      const std::string::size_type length = std::strlen(token);
+      if (expression.compare(position, length, token) != 0)
+        return false;
+      position += length;
+      return true;
+    }
+
+
+
+    void
+    Bytecode::Compiler::add(const Instruction &instruction,
+                  const unsigned int n_arguments)
+    {
+      Assert(stack_size >= n_arguments, ExcInternalError());
+      stack_size = stack_size - n_arguments + 1;
+      AssertThrow(stack_size <= max_stack_size,
+                  ExcMessage("Expression too deeply nested"));
+      program.push_back(instruction);
+    }
+
+
+
+    void
+    Bytecode::Compiler::parse_ternary()
+    {
+      parse_binary(1);
+      if (match("?"))
+        {
+          parse_ternary();
+          AssertThrow(match(":"), ExcMessage("Expected ':'"));
+          parse_ternary();
+          add({OpCode::select, 0, 0., nullptr, nullptr, nullptr}, 3);
+        }
+    }
+
+
+
+    void
+    Bytecode::Compiler::parse_binary(const unsigned int precedence)
+    {
+      if (precedence == 7)
+        {
+          parse_unary();
+          return;
+        }
+
+      parse_binary(precedence + 1);
+      while (true)
+        {
+          Instruction instruction{
+            OpCode::constant, 0, 0., nullptr, nullptr, nullptr};
+
+          // check the operators that consist of two characters first, and
+          // make sure not to match the first character of '||' and '&&'
+          // for '|' and '&'
+          if (precedence == 1 && match("||"))
+            instruction.opcode = OpCode::logical_or;
+          else if (precedence == 1 && match("|"))
+            {
+              instruction.opcode     = OpCode::function_2;
+              instruction.function_2 = &internal::mu_or;
+            }
+          else if (precedence == 2 && match("&&"))
+            instruction.opcode = OpCode::logical_and;
+          else if (precedence == 2 && match("&"))
+            {
+              instruction.opcode     = OpCode::function_2;
+              instruction.function_2 = &internal::mu_and;
+            }
+          else if (precedence == 4 && match("<="))
+            instruction.opcode = OpCode::less_equal;
+          else if (precedence == 4 && match(">="))
+            instruction.opcode = OpCode::greater_equal;
+          else if (precedence == 4 && match("=="))
+            instruction.opcode = OpCode::equal;
+          else if (precedence == 4 && match("!="))
+            instruction.opcode = OpCode::not_equal;
+          else if (precedence == 4 && match("<"))
+            instruction.opcode = OpCode::less;
+          else if (precedence == 4 && match(">"))
+            instruction.opcode = OpCode::greater;
+          else if (precedence == 5 && match("+"))
+            instruction.opcode = OpCode::add;
+          else if (precedence == 5 && match("-"))
+            instruction.opcode = OpCode::subtract;
+          else if (precedence == 6 && match("*"))
+            instruction.opcode = OpCode::multiply;
+          else if (precedence == 6 && match("/"))
+            instruction.opcode = OpCode::divide;
+          else
+            return;
+
+          parse_binary(precedence + 1);
+          add(instruction, 2);
+        }
+    }
+
+
+
+    void
+    Bytecode::Compiler::parse_unary()
+    {
+      // the signs bind weaker than the power operator, i.e., -x^2 is
+      // -(x^2)
+      if (match("-"))
+        {
+          parse_unary();
+          add({OpCode::negate, 0, 0., nullptr, nullptr, nullptr}, 1);
+        }
+      else if (match("+"))
+        parse_unary();
+      else
+        parse_power();
+    }
+
+
+
+    void
+    Bytecode::Compiler::parse_power()
+    {
+      parse_primary();
+      // the power operator is right-associative, and its exponent may have
+      // a sign
+      if (match("^"))
+        {
+          parse_unary();
+          add({OpCode::power, 0, 0., nullptr, nullptr, nullptr}, 2);
+        }
+    }
+
+
+
+    void
+    Bytecode::Compiler::parse_primary()
+    {
+      if (match("("))
+        {
+          parse_ternary();
+          AssertThrow(match(")"), ExcMessage("Expected ')'"));
+          return;
+        }
+
+      AssertThrow(position < expression.size(),
+                  ExcMessage("Unexpected end of expression"));
+
+      const char c = expression[position];
+      if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+        {
+          const char *begin = expression.c_str() + position;
+          char *      end   = nullptr;
+          const double value = std::strtod(begin, &end);
+          AssertThrow(end != begin, ExcMessage("Invalid number"));
+          position += end - begin;
+          add({OpCode::constant, 0, value, nullptr, nullptr, nullptr}, 0);
+          return;
+        }
+
+      AssertThrow(std::isalpha(static_cast<unsigned char>(c)) || c == '_',
+                  ExcMessage("Unexpected character in expression"));
+      const std::string::size_type begin = position;
+      while (position < expression.size() &&
+             (std::isalnum(static_cast<unsigned char>(expression[position])) ||
+              expression[position] == '_'))
+        ++position;
+      const std::string name = expression.substr(begin, position - begin);
+
+      if (match("("))
+        {
+          parse_function(name);
+          return;
+        }
+
+      const auto variable =
+        std::find(variable_names.begin(), variable_names.end(), name);
+      if (variable != variable_names.end())
+        {
+          add({OpCode::variable,
+               static_cast<unsigned int>(variable - variable_names.begin()),
+               0.,
+               nullptr,
+               nullptr,
+               nullptr},
+              0);
+          return;
+        }
+
+      double value = 0;
+      if (constants.find(name) != constants.end())
+        value = constants.find(name)->second;
+      else if (name == "_pi")
+        value = numbers::PI;
+      else if (name == "_e")
+        value = numbers::E;
+      else
+        AssertThrow(false, ExcMessage("Unknown name <" + name + ">"));
+      add({OpCode::constant, 0, value, nullptr, nullptr, nullptr}, 0);
+    }
+
+
+
+    void
+    Bytecode::Compiler::parse_function(const std::string &name)
+    {
+      // the arguments, which are put on the stack one after the other
+      unsigned int n_arguments = 0;
+      if (!match(")"))
+        {
+          do
+            {
+              parse_ternary();
+              ++n_arguments;
+            }
+          while (match(","));
+          AssertThrow(match(")"), ExcMessage("Expected ')'"));
+        }
+
+      static const std::map<std::string, double (*)(double)> functions_1 = {
+        {"sin", &mu_sin},
+        {"cos", &mu_cos},
+        {"tan", &mu_tan},
+        {"asin", &mu_asin},
+        {"acos", &mu_acos},
+        {"atan", &mu_atan},
+        {"sinh", &mu_sinh},
+        {"cosh", &mu_cosh},
+        {"tanh", &mu_tanh},
+        {"asinh", &mu_asinh},
+        {"acosh", &mu_acosh},
+        {"atanh", &mu_atanh},
+        {"log2", &mu_log2},
+        {"log10", &mu_log10},
+        {"log", &internal::mu_log},
+        {"ln", &internal::mu_log},
+        {"exp", &mu_exp},
+        {"sqrt", &mu_sqrt},
+        {"sign", &mu_sign},
+        {"rint", &mu_rint},
+        {"abs", &mu_abs},
+        {"int", &internal::mu_int},
+        {"ceil", &internal::mu_ceil},
+        {"floor", &internal::mu_floor},
+        {"cot", &internal::mu_cot},
+        {"csc", &internal::mu_csc},
+        {"sec", &internal::mu_sec},
+        {"erfc", &internal::mu_erfc}};
+      static const std::map<std::string, double (*)(double, double)>
+        functions_2 = {{"atan2", &mu_atan2}, {"pow", &internal::mu_pow}};
+      static const std::map<std::string, OpCode> functions_n = {
+        {"sum", OpCode::sum},
+        {"avg", OpCode::average},
+        {"min", OpCode::minimum},
+        {"max", OpCode::maximum}};
+
+      Instruction instruction{
+        OpCode::constant, n_arguments, 0., nullptr, nullptr, nullptr};
+      if (functions_1.find(name) != functions_1.end() && n_arguments == 1)
+        {
+          instruction.opcode     = OpCode::function_1;
+          instruction.function_1 = functions_1.find(name)->second;
+        }
+      else if (functions_2.find(name) != functions_2.end() &&
+               n_arguments == 2)
+        {
+          instruction.opcode     = OpCode::function_2;
+          instruction.function_2 = functions_2.find(name)->second;
+        }
+      else if (name == "if" && n_arguments == 3)
+        {
+          instruction.opcode     = OpCode::function_3;
+          instruction.function_3 = &internal::mu_if;
+        }
+      else if (functions_n.find(name) != functions_n.end() && n_arguments > 0)
+        instruction.opcode = functions_n.find(name)->second;
+      else
+        // in particular rand() and rand_seed(), which have side effects
+        AssertThrow(false,
+                    ExcMessage("Unsupported function <" + name + ">"));
+
+      // add() expects the number of values taken from the stack; the
+      // functions without arguments are not supported
+      add(instruction, n_arguments);
+    }
+
+
+
+    template <typename Number>
+    Number
+    Bytecode::evaluate(const Number *variables) const
+    {
+      Number       stack[max_stack_size];
+      unsigned int top = 0;
+
+      for (const Instruction &instruction : program)
+        switch (instruction.opcode)
+          {
+            case OpCode::constant:
+              stack[top++] = instruction.constant;
+              break;
+
+            case OpCode::variable:
+              stack[top++] = variables[instruction.index];
+              break;
+
+            case OpCode::negate:
+              stack[top - 1] = -stack[top - 1];
+              break;
+
+            case OpCode::add:
+              --top;
+              stack[top - 1] += stack[top];
+              break;
+
+            case OpCode::subtract:
+              --top;
+              stack[top - 1] -= stack[top];
+              break;
+
+            case OpCode::multiply:
+              --top;
+              stack[top - 1] *= stack[top];
+              break;
+
+            case OpCode::divide:
+              --top;
+              stack[top - 1] /= stack[top];
+              break;
+
+            case OpCode::select:
+              top -= 2;
+              for (unsigned int v = 0; v < n_lanes<Number>(); ++v)
+                lane(stack[top - 1], v) = (lane(stack[top - 1], v) != 0) ?
+                                            lane(stack[top], v) :
+                                            lane(stack[top + 1], v);
+              break;
+
+            case OpCode::function_1:
+              for (unsigned int v = 0; v < n_lanes<Number>(); ++v)
+                lane(stack[top - 1], v) =
+                  instruction.function_1(lane(stack[top - 1], v));
+              break;
+
+            case OpCode::function_2:
+              --top;
+              for (unsigned int v = 0; v < n_lanes<Number>(); ++v)
+                lane(stack[top - 1], v) =
+                  instruction.function_2(lane(stack[top - 1], v),
+                                         lane(stack[top], v));
+              break;
+
+            case OpCode::function_3:
+              top -= 2;
+              for (unsigned int v = 0; v < n_lanes<Number>(); ++v)
+                lane(stack[top - 1], v) =
+                  instruction.function_3(lane(stack[top - 1], v),
+                                         lane(stack[top], v),
+                                         lane(stack[top + 1], v));
+              break;
+
+            case OpCode::sum:
+            case OpCode::average:
+              {
+                const unsigned int n = instruction.index;
+                top -= n - 1;
+                Number &result = stack[top - 1];
+                for (unsigned int i = 1; i < n; ++i)
+                  result += stack[top - 1 + i];
+                if (instruction.opcode == OpCode::average)
+                  result = result / static_cast<double>(n);
+                break;
+              }
+
+            default:
+              {
+                // the remaining operations are evaluated lane by lane
+                // since VectorizedArray has no comparison operators
+                const unsigned int n =
+                  (instruction.opcode == OpCode::minimum ||
+                   instruction.opcode == OpCode::maximum) ?
+                    instruction.index :
+                    2;
+                top -= n - 1;
+                for (unsigned int v = 0; v < n_lanes<Number>(); ++v)
+                  {
+                    double &     result = lane(stack[top - 1], v);
+                    const double b      = lane(stack[top], v);
+                    switch (instruction.opcode)
+                      {
+                        case OpCode::power:
+                          result = std::pow(result, b);
+                          break;
+                        case OpCode::less:
+                          result = result < b;
+                          break;
+                        case OpCode::greater:
+                          result = result > b;
+                          break;
+                        case OpCode::less_equal:
+                          result = result <= b;
+                          break;
+                        case OpCode::greater_equal:
+                          result = result >= b;
+                          break;
+                        case OpCode::equal:
+                          result = result == b;
+                          break;
+                        case OpCode::not_equal:
+                          result = result != b;
+                          break;
+                        case OpCode::logical_and:
+                          result = result && b;
+                          break;
+                        case OpCode::logical_or:
+                          result = result || b;
+                          break;
+                        case OpCode::minimum:
+                          for (unsigned int i = 1; i < n; ++i)
+                            result =
+                              std::min(result, lane(stack[top - 1 + i], v));
+                          break;
+                        case OpCode::maximum:
+                          for (unsigned int i = 1; i < n; ++i)
+                            result =
+                              std::max(result, lane(stack[top - 1 + i], v));
+                          break;
+                        default:
+                          Assert(false, ExcInternalError());
+                      }
+                  }
+              }
+          }
+
+      Assert(top == 1, ExcInternalError());
+      return stack[0];
+    }
+
+
+
+    /**
+     * Evaluate @p bytecode at all @p points, VectorizedArray<double>::
+     * n_array_elements points at a time, and pass the value for the point
+     * with index i to <code>store(i, value)</code>.
+     */
+    template <int dim, typename StoreFunction>
+    void
+    evaluate_list(const Bytecode &               bytecode,
+                  const std::vector<Point<dim>> &points,
+                  const unsigned int             n_variables,
+                  const double                   time,
+                  const StoreFunction &          store)
+    {
+      const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+
+      VectorizedArray<double> variables[dim + 1];
+      if (n_variables > dim)
+        variables[dim] = time;
+
+      for (unsigned int p = 0; p < points.size(); p += n_lanes)
+        {
+          // fill the unused lanes of the last batch with its last point
+          const unsigned int n_points =
+            std::min<std::size_t>(n_lanes, points.size() - p);
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            for (unsigned int d = 0; d < dim; ++d)
+              variables[d][v] = points[p + std::min(v, n_points - 1)][d];
+
+          const VectorizedArray<double> result = bytecode.evaluate(variables);
+          for (unsigned int v = 0; v < n_points; ++v)
+            store(p + v, result[v]);
+        }
+    }
+  } // namespace FunctionParserImplementation
 } // namespace internal
 
 
@@ -411,6 +1261,28 @@ FunctionParser<dim>::init_muparser() const
 
 
 
+template <int dim>
+void
+FunctionParser<dim>::init_bytecode()
+{
+  bytecode.clear();
+  for (unsigned int component = 0; component < this->n_components; ++component)
+    try
+      {
+        bytecode.emplace_back(
+          new internal::FunctionParserImplementation::Bytecode(
+            expressions[component], var_names, constants));
+      }
+    catch (const ExceptionBase &)
+      {
+        // the expression uses something the compiler does not support, so
+        // leave it to muparser
+        bytecode.emplace_back();
+      }
+}
+
+
+
 template <int dim>
 void
 FunctionParser<dim>::initialize(const std::string &                  vars,
@@ -435,6 +1307,16 @@ FunctionParser<dim>::value(const Point<dim> & p,
   Assert(component < this->n_components,
          ExcIndexRange(component, 0, this->n_components));
 
+  if (evaluation_mode == EvaluationMode::bytecode && bytecode[component])
+    {
+      double variables[dim + 1];
+      for (unsigned int i = 0; i < dim; ++i)
+        variables[i] = p(i);
+      if (dim != n_vars)
+        variables[dim] = this->get_time();
+      return bytecode[component]->evaluate(variables);
+    }
+
   // initialize the parser if that hasn't happened yet on the current thread
   if (fp.get().size() == 0)
     init_muparser();
@@ -471,6 +1353,18 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
   Assert(values.size() == this->n_components,
          ExcDimensionMismatch(values.size(), this->n_components));
 
+  if (uses_bytecode())
+    {
+      double variables[dim + 1];
+      for (unsigned int i = 0; i < dim; ++i)
+        variables[i] = p(i);
+      if (dim != n_vars)
+        variables[dim] = this->get_time();
+      for (unsigned int component = 0; component < this->n_components;
+           ++component)
+        values(component) = bytecode[component]->evaluate(variables);
+      return;
+    }
 
   // initialize the parser if that hasn't happened yet on the current thread
   if (fp.get().size() == 0)
@@ -485,6 +1379,75 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
     values(component) = fp.get()[component]->Eval();
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &points,
+                                std::vector<double> &          values,
+                                const unsigned int             component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(component < this->n_components,
+         ExcIndexRange(component, 0, this->n_components));
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  if (evaluation_mode == EvaluationMode::bytecode && bytecode[component])
+    internal::FunctionParserImplementation::evaluate_list(
+      *bytecode[component],
+      points,
+      n_vars,
+      this->get_time(),
+      [&values](const unsigned int i, const double value) {
+        values[i] = value;
+      });
+  else
+    for (unsigned int i = 0; i < points.size(); ++i)
+      values[i] = this->value(points[i], component);
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>> &  values) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  for (unsigned int component = 0; component < this->n_components; ++component)
+    if (evaluation_mode == EvaluationMode::bytecode && bytecode[component])
+      internal::FunctionParserImplementation::evaluate_list(
+        *bytecode[component],
+        points,
+        n_vars,
+        this->get_time(),
+        [&values, component](const unsigned int i, const double value) {
+          values[i](component) = value;
+        });
+    else
+      for (unsigned int i = 0; i < points.size(); ++i)
+        values[i](component) = this->value(points[i], component);
+}
+
+
+
+template <int dim>
+bool
+FunctionParser<dim>::uses_bytecode() const
+{
+  if (evaluation_mode != EvaluationMode::bytecode || initialized == false)
+    return false;
+  for (const auto &b : bytecode)
+    if (!b)
+      return false;
+  return true;
+}
+
 #else
 
 
@@ -527,6 +1490,34 @@ FunctionParser<dim>::vector_value(const Point<dim> &, Vector<double> &) const
 }
 
 
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &,
+                                std::vector<double> &,
+                                const unsigned int) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(const std::vector<Point<dim>> &,
+                                       std::vector<Vector<double>> &) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+bool
+FunctionParser<dim>::uses_bytecode() const
+{
+  return false;
+}
+
+
 #endif
 
 // Explicit Instantiations.
@@ -0,0 +1,118 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/instrumentation.h>
+#include <deal.II/base/timer.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Instrumentation
+{
+  namespace internal
+  {
+    std::atomic<Sink *> current_sink(nullptr);
+  }
+
+
+
+  TimerOutputSink::TimerOutputSink(TimerOutput &timer)
+    : timer(timer)
+  {}
+
+
+
+  void
+  TimerOutputSink::enter_region(const char *name)
+  {
+    timer.enter_thread_subsection(name);
+  }
+
+
+
+  void
+  TimerOutputSink::leave_region(const char *, const double)
+  {
+    timer.leave_thread_subsection();
+  }
+
+
+
+  CallbackSink::CallbackSink(
+    const std::function<void(const char *name, const double wall_time)>
+      &callback)
+    : callback(callback)
+  {}
+
+
+
+  void
+  CallbackSink::enter_region(const char *)
+  {}
+
+
+
+  void
+  CallbackSink::leave_region(const char *name, const double wall_time)
+  {
+    callback(name, wall_time);
+  }
+
+
+
+  StreamSink::StreamSink(std::ostream &out)
+    : out(out)
+  {}
+
+
+
+  void
+  StreamSink::enter_region(const char *)
+  {}
+
+
+
+  void
+  StreamSink::leave_region(const char *name, const double wall_time)
+  {
+    Threads::Mutex::ScopedLock lock(mutex);
+    out << name << ' ' << wall_time << '\n';
+  }
+
+
+
+  void
+  attach_sink(Sink &sink)
+  {
+    internal::current_sink.store(&sink, std::memory_order_release);
+  }
+
+
+
+  void
+  detach_sink()
+  {
+    internal::current_sink.store(nullptr, std::memory_order_release);
+  }
+
+
+
+  Sink *
+  get_sink()
+  {
+    return internal::current_sink.load(std::memory_order_acquire);
+  }
+} // namespace Instrumentation
+
+DEAL_II_NAMESPACE_CLOSE
@@ -302,35 +302,41 @@ namespace Utilities
                  int *       len,
                  MPI_Datatype *)
       {
-        (void)len;
-        const MinMaxAvg *in_lhs    = static_cast<const MinMaxAvg *>(in_lhs_);
-        MinMaxAvg *      inout_rhs = static_cast<MinMaxAvg *>(inout_rhs_);
+        const MinMaxAvg *in_lhs_array =
+          static_cast<const MinMaxAvg *>(in_lhs_);
+        MinMaxAvg *inout_rhs_array = static_cast<MinMaxAvg *>(inout_rhs_);
 
-        Assert(*len == 1, ExcInternalError());
-
-        inout_rhs->sum += in_lhs->sum;
-        if (inout_rhs->min > in_lhs->min)
-          {
-            inout_rhs->min       = in_lhs->min;
-            inout_rhs->min_index = in_lhs->min_index;
-          }
-        else if (inout_rhs->min == in_lhs->min)
+        for (int i = 0; i < *len; ++i)
           {
-            // choose lower cpu index when tied to make operator commutative
-            if (inout_rhs->min_index > in_lhs->min_index)
-              inout_rhs->min_index = in_lhs->min_index;
-          }
+            const MinMaxAvg *in_lhs    = in_lhs_array + i;
+            MinMaxAvg *      inout_rhs = inout_rhs_array + i;
 
-        if (inout_rhs->max < in_lhs->max)
-          {
-            inout_rhs->max       = in_lhs->max;
-            inout_rhs->max_index = in_lhs->max_index;
-          }
-        else if (inout_rhs->max == in_lhs->max)
-          {
-            // choose lower cpu index when tied to make operator commutative
-            if (inout_rhs->max_index > in_lhs->max_index)
-              inout_rhs->max_index = in_lhs->max_index;
+            inout_rhs->sum += in_lhs->sum;
+            if (inout_rhs->min > in_lhs->min)
+              {
+                inout_rhs->min       = in_lhs->min;
+                inout_rhs->min_index = in_lhs->min_index;
+              }
+            else if (inout_rhs->min == in_lhs->min)
+              {
+                // choose lower cpu index when tied to make operator
+                // commutative
+                if (inout_rhs->min_index > in_lhs->min_index)
+                  inout_rhs->min_index = in_lhs->min_index;
+              }
+
+            if (inout_rhs->max < in_lhs->max)
+              {
+                inout_rhs->max       = in_lhs->max;
+                inout_rhs->max_index = in_lhs->max_index;
+              }
+            else if (inout_rhs->max == in_lhs->max)
+              {
+                // choose lower cpu index when tied to make operator
+                // commutative
+                if (inout_rhs->max_index > in_lhs->max_index)
+                  inout_rhs->max_index = in_lhs->max_index;
+              }
           }
       }
     } // namespace
@@ -340,29 +346,47 @@ namespace Utilities
     MinMaxAvg
     min_max_avg(const double my_value, const MPI_Comm &mpi_communicator)
     {
+      return min_max_avg(std::vector<double>(1, my_value), mpi_communicator)
+        .front();
+    }
+
+
+
+    std::vector<MinMaxAvg>
+    min_max_avg(const std::vector<double> &my_values,
+                const MPI_Comm &           mpi_communicator)
+    {
+      std::vector<MinMaxAvg> results(my_values.size());
+
       // If MPI was not started, we have a serial computation and cannot run
       // the other MPI commands
       if (job_supports_mpi() == false)
         {
-          MinMaxAvg result;
-          result.sum       = my_value;
-          result.avg       = my_value;
-          result.min       = my_value;
-          result.max       = my_value;
-          result.min_index = 0;
-          result.max_index = 0;
-
-          return result;
+          for (unsigned int i = 0; i < my_values.size(); ++i)
+            {
+              results[i].sum       = my_values[i];
+              results[i].avg       = my_values[i];
+              results[i].min       = my_values[i];
+              results[i].max       = my_values[i];
+              results[i].min_index = 0;
+              results[i].max_index = 0;
+            }
+
+          return results;
         }
 
+      if (my_values.empty())
+        return results;
+
       // To avoid uninitialized values on some MPI implementations, provide
       // result with a default value already...
-      MinMaxAvg result = {0.,
-                          std::numeric_limits<double>::max(),
-                          -std::numeric_limits<double>::max(),
-                          0,
-                          0,
-                          0.};
+      for (MinMaxAvg &result : results)
+        result = {0.,
+                  std::numeric_limits<double>::max(),
+                  -std::numeric_limits<double>::max(),
+                  0,
+                  0,
+                  0.};
 
       const unsigned int my_id =
         dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
@@ -373,9 +397,12 @@ namespace Utilities
       int    ierr = MPI_Op_create((MPI_User_function *)&max_reduce, true, &op);
       AssertThrowMPI(ierr);
 
-      MinMaxAvg in;
-      in.sum = in.min = in.max = my_value;
-      in.min_index = in.max_index = my_id;
+      std::vector<MinMaxAvg> in(my_values.size());
+      for (unsigned int i = 0; i < my_values.size(); ++i)
+        {
+          in[i].sum = in[i].min = in[i].max = my_values[i];
+          in[i].min_index = in[i].max_index = my_id;
+        }
 
       MPI_Datatype type;
       int          lengths[]       = {3, 2};
@@ -385,9 +412,24 @@ namespace Utilities
       ierr = MPI_Type_struct(2, lengths, displacements, types, &type);
       AssertThrowMPI(ierr);
 
-      ierr = MPI_Type_commit(&type);
+      // the struct type has a trailing member that is not communicated, so
+      // set its extent to the size of the struct for arrays to be laid out
+      // correctly
+      MPI_Datatype resized_type;
+      ierr = MPI_Type_create_resized(type, 0, sizeof(MinMaxAvg), &resized_type);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_Type_commit(&resized_type);
       AssertThrowMPI(ierr);
-      ierr = MPI_Allreduce(&in, &result, 1, type, op, mpi_communicator);
+      ierr = MPI_Allreduce(in.data(),
+                           results.data(),
+                           in.size(),
+                           resized_type,
+                           op,
+                           mpi_communicator);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_Type_free(&resized_type);
       AssertThrowMPI(ierr);
 
       ierr = MPI_Type_free(&type);
@@ -396,9 +438,10 @@ namespace Utilities
       ierr = MPI_Op_free(&op);
       AssertThrowMPI(ierr);
 
-      result.avg = result.sum / numproc;
+      for (MinMaxAvg &result : results)
+        result.avg = result.sum / numproc;
 
-      return result;
+      return results;
     }
 
 #else
@@ -441,6 +484,19 @@ namespace Utilities
       return result;
     }
 
+
+
+    std::vector<MinMaxAvg>
+    min_max_avg(const std::vector<double> &my_values,
+                const MPI_Comm &           mpi_communicator)
+    {
+      std::vector<MinMaxAvg> results(my_values.size());
+      for (unsigned int i = 0; i < my_values.size(); ++i)
+        results[i] = min_max_avg(my_values[i], mpi_communicator);
+
+      return results;
+    }
+
 #endif
 
 
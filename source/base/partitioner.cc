@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/frozen_index_set.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/partitioner.templates.h>
 
@@ -429,16 +430,23 @@ namespace Utilities
 
           n_ghost_indices_in_larger_set = larger_ghost_index_set.n_elements();
 
-          std::vector<unsigned int> expanded_numbering;
-          for (IndexSet::ElementIterator it = ghost_indices_data.begin();
-               it != ghost_indices_data.end();
-               ++it)
+          // look up the positions of all ghost indices in the larger set at
+          // once. the ghost indices are sorted, which the bulk query of
+          // FrozenIndexSet exploits
+          std::vector<types::global_dof_index> ghost_indices;
+          ghost_indices_data.fill_index_vector(ghost_indices);
+          std::vector<types::global_dof_index> positions(ghost_indices.size());
+          FrozenIndexSet(larger_ghost_index_set)
+            .index_within_set(make_array_view(ghost_indices),
+                              make_array_view(positions));
+
+          std::vector<unsigned int> expanded_numbering(positions.size());
+          for (unsigned int i = 0; i < positions.size(); ++i)
             {
-              Assert(larger_ghost_index_set.is_element(*it),
+              Assert(positions[i] != numbers::invalid_dof_index,
                      ExcMessage("The given larger ghost index set must contain"
                                 "all indices in the actual index set."));
-              expanded_numbering.push_back(
-                larger_ghost_index_set.index_within_set(*it));
+              expanded_numbering[i] = positions[i];
             }
 
           std::vector<std::pair<unsigned int, unsigned int>>
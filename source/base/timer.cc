@@ -20,11 +20,14 @@
 #include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 
+#include <boost/serialization/string.hpp>
+
 #include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -100,6 +103,24 @@ namespace internal
         data.min_index = numbers::invalid_unsigned_int;
         data.max_index = numbers::invalid_unsigned_int;
       }
+
+      /**
+       * Return @p name with quotes and backslashes escaped and control
+       * characters replaced by spaces, for use in a JSON string.
+       */
+      std::string
+      escape_json_string(const std::string &name)
+      {
+        std::string escaped;
+        for (const char c : name)
+          if (c == '"' || c == '\\')
+            escaped += std::string("\\") + c;
+          else if (static_cast<unsigned char>(c) < 0x20)
+            escaped += ' ';
+          else
+            escaped += c;
+        return escaped;
+      }
     } // namespace
   }   // namespace TimerImplementation
 } // namespace internal
@@ -321,7 +342,13 @@ TimerOutput::TimerOutput(std::ostream &        stream,
   , out_stream(stream, true)
   , output_is_enabled(true)
   , mpi_communicator(MPI_COMM_SELF)
-{}
+  , innermost_active_node(0)
+  , trace_recording_is_enabled(false)
+  , reference_time(std::chrono::steady_clock::now())
+  , n_threads(0)
+{
+  reset_call_tree();
+}
 
 
 
@@ -333,7 +360,13 @@ TimerOutput::TimerOutput(ConditionalOStream &  stream,
   , out_stream(stream)
   , output_is_enabled(true)
   , mpi_communicator(MPI_COMM_SELF)
-{}
+  , innermost_active_node(0)
+  , trace_recording_is_enabled(false)
+  , reference_time(std::chrono::steady_clock::now())
+  , n_threads(0)
+{
+  reset_call_tree();
+}
 
 
 
@@ -346,7 +379,13 @@ TimerOutput::TimerOutput(MPI_Comm              mpi_communicator,
   , out_stream(stream, true)
   , output_is_enabled(true)
   , mpi_communicator(mpi_communicator)
-{}
+  , innermost_active_node(0)
+  , trace_recording_is_enabled(false)
+  , reference_time(std::chrono::steady_clock::now())
+  , n_threads(0)
+{
+  reset_call_tree();
+}
 
 
 
@@ -359,7 +398,13 @@ TimerOutput::TimerOutput(MPI_Comm              mpi_communicator,
   , out_stream(stream)
   , output_is_enabled(true)
   , mpi_communicator(mpi_communicator)
-{}
+  , innermost_active_node(0)
+  , trace_recording_is_enabled(false)
+  , reference_time(std::chrono::steady_clock::now())
+  , n_threads(0)
+{
+  reset_call_tree();
+}
 
 
 
@@ -442,10 +487,35 @@ TimerOutput::enter_subsection(const std::string &section_name)
       sections[section_name].n_calls         = 0;
     }
 
+  // find the node of the call tree below the innermost active section
+  const unsigned int parent =
+    (active_sections.empty() ?
+       0 :
+       active_call_tree_nodes[active_sections.back()].first);
+  auto child = call_tree_children.find(std::make_pair(parent, section_name));
+  if (child == call_tree_children.end())
+    {
+      CallTreeNode node;
+      node.path = call_tree[parent].path;
+      node.path.push_back(section_name);
+      node.total_wall_time = 0;
+      node.n_calls         = 0;
+      call_tree.push_back(std::move(node));
+      child = call_tree_children
+                .insert(std::make_pair(std::make_pair(parent, section_name),
+                                       call_tree.size() - 1))
+                .first;
+    }
+  ++call_tree[child->second].n_calls;
+
   sections[section_name].timer.reset();
   sections[section_name].timer.start();
   sections[section_name].n_calls++;
 
+  active_call_tree_nodes[section_name] =
+    std::make_pair(child->second, std::chrono::steady_clock::now());
+  innermost_active_node = child->second;
+
   active_sections.push_back(section_name);
 }
 
@@ -485,6 +555,19 @@ TimerOutput::leave_subsection(const std::string &section_name)
   const double cpu_time = sections[actual_section_name].timer.last_cpu_time();
   sections[actual_section_name].total_cpu_time += cpu_time;
 
+  const auto active_node = active_call_tree_nodes.find(actual_section_name);
+  Assert(active_node != active_call_tree_nodes.end(), ExcInternalError());
+  call_tree[active_node->second.first].total_wall_time +=
+    sections[actual_section_name].timer.last_wall_time();
+  if (trace_recording_is_enabled)
+    trace_events.push_back(
+      TraceEvent{active_node->second.first,
+                 std::chrono::duration<double>(active_node->second.second -
+                                               reference_time)
+                   .count(),
+                 sections[actual_section_name].timer.last_wall_time()});
+  active_call_tree_nodes.erase(active_node);
+
   // in case we have to print out something, do that here...
   if ((output_frequency == every_call ||
        output_frequency == every_call_and_summary) &&
@@ -511,6 +594,80 @@ TimerOutput::leave_subsection(const std::string &section_name)
   active_sections.erase(std::find(active_sections.begin(),
                                   active_sections.end(),
                                   actual_section_name));
+  innermost_active_node =
+    (active_sections.empty() ?
+       0 :
+       active_call_tree_nodes[active_sections.back()].first);
+}
+
+
+
+TimerOutput::ThreadData::ThreadData()
+  : thread_index(numbers::invalid_unsigned_int)
+{}
+
+
+
+void
+TimerOutput::enter_thread_subsection(const std::string &section_name)
+{
+  Assert(section_name.empty() == false, ExcMessage("Section string is empty."));
+
+  ThreadData &data = thread_data.get();
+  if (data.thread_index == numbers::invalid_unsigned_int)
+    data.thread_index = ++n_threads;
+
+  // the outermost thread section is attached to the call tree below the
+  // innermost section entered by enter_subsection(), nested ones below the
+  // enclosing thread section
+  const std::tuple<unsigned int, unsigned int, std::string> key =
+    (data.active_nodes.empty() ?
+       std::make_tuple(innermost_active_node.load(),
+                       numbers::invalid_unsigned_int,
+                       section_name) :
+       std::make_tuple(numbers::invalid_unsigned_int,
+                       data.active_nodes.back().first,
+                       section_name));
+
+  auto node = data.node_indices.find(key);
+  if (node == data.node_indices.end())
+    {
+      data.nodes.push_back(ThreadData::Node{
+        std::get<0>(key), std::get<1>(key), section_name, 0., 0});
+      node =
+        data.node_indices.insert(std::make_pair(key, data.nodes.size() - 1))
+          .first;
+    }
+
+  data.active_nodes.emplace_back(node->second,
+                                 std::chrono::steady_clock::now());
+}
+
+
+
+void
+TimerOutput::leave_thread_subsection()
+{
+  const auto  now  = std::chrono::steady_clock::now();
+  ThreadData &data = thread_data.get();
+  Assert(!data.active_nodes.empty(),
+         ExcMessage("Cannot exit any thread section because none has been "
+                    "entered on this thread!"));
+
+  const unsigned int node = data.active_nodes.back().first;
+  const auto         start_time = data.active_nodes.back().second;
+  const double       duration =
+    std::chrono::duration<double>(now - start_time).count();
+
+  data.nodes[node].total_wall_time += duration;
+  ++data.nodes[node].n_calls;
+  if (trace_recording_is_enabled)
+    data.trace_events.push_back(TraceEvent{
+      node,
+      std::chrono::duration<double>(start_time - reference_time).count(),
+      duration});
+
+  data.active_nodes.pop_back();
 }
 
 
@@ -541,6 +698,281 @@ TimerOutput::get_summary_data(const OutputData kind) const
 
 
 
+std::vector<const TimerOutput::ThreadData *>
+TimerOutput::collect_thread_data() const
+{
+  std::vector<const ThreadData *> all_data;
+#ifdef DEAL_II_WITH_THREADS
+  for (const ThreadData &data : thread_data.get_implementation())
+    if (data.thread_index != numbers::invalid_unsigned_int)
+      all_data.push_back(&data);
+#else
+  if (thread_data.get_implementation().thread_index !=
+      numbers::invalid_unsigned_int)
+    all_data.push_back(&thread_data.get_implementation());
+#endif
+
+  std::sort(all_data.begin(),
+            all_data.end(),
+            [](const ThreadData *a, const ThreadData *b) {
+              return a->thread_index < b->thread_index;
+            });
+  for (const ThreadData *data : all_data)
+    {
+      (void)data;
+      Assert(data->active_nodes.empty(),
+             ExcMessage("Thread sections must be left before the timing data "
+                        "is collected."));
+    }
+  return all_data;
+}
+
+
+
+std::map<std::vector<std::string>, TimerOutput::CallTreeData>
+TimerOutput::get_call_tree_data() const
+{
+  // accumulate the number of calls and the wall time of the sections entered
+  // by enter_subsection() and of the thread sections of all threads by path
+  std::map<std::vector<std::string>, std::pair<unsigned int, double>>
+    local_data;
+  {
+    Threads::Mutex::ScopedLock lock(mutex);
+    for (unsigned int i = 1; i < call_tree.size(); ++i)
+      {
+        std::pair<unsigned int, double> &entry = local_data[call_tree[i].path];
+        entry.first += call_tree[i].n_calls;
+        entry.second += call_tree[i].total_wall_time;
+      }
+
+    for (const ThreadData *data : collect_thread_data())
+      {
+        // parents are created before their children, so the path of the
+        // parent is always known
+        std::vector<std::vector<std::string>> paths(data->nodes.size());
+        for (unsigned int i = 0; i < data->nodes.size(); ++i)
+          {
+            const ThreadData::Node &node = data->nodes[i];
+            paths[i] = (node.parent == numbers::invalid_unsigned_int ?
+                          call_tree[node.tree_parent].path :
+                          paths[node.parent]);
+            paths[i].push_back(node.name);
+
+            std::pair<unsigned int, double> &entry = local_data[paths[i]];
+            entry.first += node.n_calls;
+            entry.second += node.total_wall_time;
+          }
+      }
+  }
+
+  const bool is_parallel =
+    (Utilities::MPI::job_supports_mpi() &&
+     Utilities::MPI::n_mpi_processes(mpi_communicator) > 1);
+
+  // in parallel, the tree is the union of the trees of all processes
+  std::vector<std::vector<std::string>> paths;
+  for (const auto &entry : local_data)
+    paths.push_back(entry.first);
+  if (is_parallel)
+    {
+      std::set<std::vector<std::string>> all_paths;
+      for (const auto &paths_on_process :
+           Utilities::MPI::all_gather(mpi_communicator, paths))
+        all_paths.insert(paths_on_process.begin(), paths_on_process.end());
+      paths.assign(all_paths.begin(), all_paths.end());
+    }
+
+  // all processes now know the same paths in the same order, so the wall
+  // times of all nodes can be combined with a single collective operation
+  std::vector<double> wall_times(paths.size(), 0.);
+  for (unsigned int i = 0; i < paths.size(); ++i)
+    {
+      const auto entry = local_data.find(paths[i]);
+      if (entry != local_data.end())
+        wall_times[i] = entry->second.second;
+    }
+  const std::vector<Utilities::MPI::MinMaxAvg> wall_time_statistics =
+    Utilities::MPI::min_max_avg(wall_times, mpi_communicator);
+
+  std::map<std::vector<std::string>, CallTreeData> call_tree_data;
+  for (unsigned int i = 0; i < paths.size(); ++i)
+    {
+      const auto    entry = local_data.find(paths[i]);
+      CallTreeData &data  = call_tree_data[paths[i]];
+      data.n_calls   = (entry != local_data.end() ? entry->second.first : 0);
+      data.wall_time = wall_time_statistics[i];
+    }
+
+  return call_tree_data;
+}
+
+
+
+void
+TimerOutput::print_call_tree() const
+{
+  const std::map<std::vector<std::string>, CallTreeData> call_tree_data =
+    get_call_tree_data();
+
+  const bool is_parallel =
+    (Utilities::MPI::job_supports_mpi() &&
+     Utilities::MPI::n_mpi_processes(mpi_communicator) > 1);
+  const double total_wall_time =
+    (is_parallel ?
+       Utilities::MPI::min_max_avg(timer_all.wall_time(), mpi_communicator)
+         .avg :
+       timer_all.wall_time());
+
+  // store the format of the stream to restore it later on
+  const std::istream::fmtflags old_flags = out_stream.get_stream().flags();
+  const std::streamsize old_precision    = out_stream.get_stream().precision();
+  const std::streamsize old_width        = out_stream.get_stream().width();
+
+  // every level of the tree is indented by two spaces
+  unsigned int max_width = 32;
+  for (const auto &node : call_tree_data)
+    max_width = std::max<unsigned int>(max_width,
+                                       2 * (node.first.size() - 1) +
+                                         node.first.back().length() + 1);
+
+  std::string separator = "+" + std::string(max_width + 1, '-') + "+" +
+                          std::string(11, '-') + "+";
+  for (unsigned int i = 0; i < (is_parallel ? 3 : 1); ++i)
+    separator += std::string(12, '-') + "+";
+  separator += std::string(13, '-') + "+";
+
+  std::string header = "Section (call tree)";
+  header.resize(max_width, ' ');
+  out_stream << "\n\n"
+             << separator << "\n"
+             << "| " << header << "| no. calls |"
+             << (is_parallel ? "   min time |   avg time |   max time |" :
+                               "  wall time |")
+             << " % of parent |\n"
+             << separator << "\n";
+
+  for (const auto &node : call_tree_data)
+    {
+      std::string name_out =
+        std::string(2 * (node.first.size() - 1), ' ') + node.first.back();
+      name_out.resize(max_width, ' ');
+      out_stream << "| " << name_out << "| " << std::setw(9)
+                 << node.second.n_calls << " |";
+
+      out_stream << std::setprecision(3) << std::right;
+      if (is_parallel)
+        out_stream << std::setw(10) << node.second.wall_time.min << "s |"
+                   << std::setw(10) << node.second.wall_time.avg << "s |"
+                   << std::setw(10) << node.second.wall_time.max << "s |";
+      else
+        out_stream << std::setw(10) << node.second.wall_time.avg << "s |";
+
+      const std::vector<std::string> parent_path(node.first.begin(),
+                                                 node.first.end() - 1);
+      const double                   parent_wall_time =
+        (parent_path.empty() ? total_wall_time :
+                               call_tree_data.find(parent_path)
+                                 ->second.wall_time.avg);
+
+      // as in print_summary(), print a zero instead of tiny fractions
+      const double fraction =
+        (parent_wall_time != 0 ?
+           node.second.wall_time.avg / parent_wall_time :
+           0.);
+      out_stream << std::setw(11);
+      if (fraction > 0.001)
+        out_stream << std::setprecision(2) << fraction * 100;
+      else
+        out_stream << 0.0;
+      out_stream << "% |\n";
+    }
+  out_stream << separator << "\n" << std::endl;
+
+  out_stream.get_stream().precision(old_precision);
+  out_stream.get_stream().width(old_width);
+  out_stream.get_stream().flags(old_flags);
+}
+
+
+
+void
+TimerOutput::enable_trace_recording()
+{
+  trace_recording_is_enabled = true;
+}
+
+
+
+void
+TimerOutput::disable_trace_recording()
+{
+  trace_recording_is_enabled = false;
+}
+
+
+
+void
+TimerOutput::write_chrome_trace(std::ostream &out) const
+{
+  const bool is_parallel =
+    (Utilities::MPI::job_supports_mpi() &&
+     Utilities::MPI::n_mpi_processes(mpi_communicator) > 1);
+  const unsigned int my_rank =
+    (is_parallel ? Utilities::MPI::this_mpi_process(mpi_communicator) : 0);
+
+  // write the events of this process, with times in microseconds
+  std::ostringstream events;
+  events << std::fixed << std::setprecision(3);
+  events << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << my_rank
+         << ",\"args\":{\"name\":\"MPI process " << my_rank << "\"}}";
+
+  const auto write_event = [&](const std::string &name,
+                               const unsigned int thread,
+                               const TraceEvent & event) {
+    events << ",\n{\"name\":\""
+           << internal::TimerImplementation::escape_json_string(name)
+           << "\",\"cat\":\"TimerOutput\",\"ph\":\"X\",\"pid\":"
+           << my_rank << ",\"tid\":" << thread
+           << ",\"ts\":" << event.start * 1e6
+           << ",\"dur\":" << event.duration * 1e6 << "}";
+  };
+
+  {
+    Threads::Mutex::ScopedLock lock(mutex);
+    for (const TraceEvent &event : trace_events)
+      write_event(call_tree[event.node].path.back(), 0, event);
+    for (const ThreadData *data : collect_thread_data())
+      for (const TraceEvent &event : data->trace_events)
+        write_event(data->nodes[event.node].name, data->thread_index, event);
+  }
+
+  std::vector<std::string> all_events(1, events.str());
+  if (is_parallel)
+    all_events = Utilities::MPI::gather(mpi_communicator, events.str());
+
+  if (my_rank == 0)
+    {
+      out << "{\"traceEvents\":[\n";
+      for (unsigned int i = 0; i < all_events.size(); ++i)
+        out << (i > 0 ? ",\n" : "") << all_events[i];
+      out << "\n],\n\"displayTimeUnit\":\"ms\"}" << std::endl;
+    }
+}
+
+
+
+void
+TimerOutput::reset_call_tree()
+{
+  call_tree.clear();
+  call_tree.push_back(CallTreeNode{std::vector<std::string>(), 0., 0});
+  call_tree_children.clear();
+  active_call_tree_nodes.clear();
+  innermost_active_node = 0;
+}
+
+
+
 void
 TimerOutput::print_summary() const
 {
@@ -876,9 +1308,26 @@ TimerOutput::reset()
   Threads::Mutex::ScopedLock lock(mutex);
   sections.clear();
   active_sections.clear();
+  reset_call_tree();
+  trace_events.clear();
+  thread_data.clear();
+  n_threads      = 0;
+  reference_time = std::chrono::steady_clock::now();
   timer_all.restart();
 }
 
+
+
+TimerOutput::ThreadScope::~ThreadScope()
+{
+  try
+    {
+      stop();
+    }
+  catch (...)
+    {}
+}
+
 TimerOutput::Scope::~Scope()
 {
   try
@@ -24,6 +24,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/utilities.h>
 
@@ -558,6 +559,110 @@ namespace Utilities
   }
 
 
+  template <int dim>
+  std::vector<std::array<std::uint64_t, dim>>
+  inverse_Hilbert_space_filling_curve(
+    const std::vector<std::array<std::uint64_t, dim>> &integer_coords,
+    const int                                          bits_per_dim)
+  {
+    Assert(bits_per_dim > 0 && bits_per_dim <= 64,
+           ExcIndexRange(bits_per_dim, 1, 65));
+
+    std::vector<std::array<std::uint64_t, dim>> result(integer_coords);
+    const std::uint64_t M = std::uint64_t(1) << (bits_per_dim - 1);
+    for (std::array<std::uint64_t, dim> &X : result)
+      {
+        // inverse undo excess work
+        for (std::uint64_t Q = M; Q > 1; Q >>= 1)
+          {
+            const std::uint64_t P = Q - 1;
+            for (unsigned int i = 0; i < dim; ++i)
+              if (X[i] & Q)
+                // invert
+                X[0] ^= P;
+              else
+                {
+                  // exchange
+                  const std::uint64_t t = (X[0] ^ X[i]) & P;
+                  X[0] ^= t;
+                  X[i] ^= t;
+                }
+          }
+
+        // Gray encode
+        for (unsigned int i = 1; i < dim; ++i)
+          X[i] ^= X[i - 1];
+        std::uint64_t t = 0;
+        for (std::uint64_t Q = M; Q > 1; Q >>= 1)
+          if (X[dim - 1] & Q)
+            t ^= Q - 1;
+        for (unsigned int i = 0; i < dim; ++i)
+          X[i] ^= t;
+      }
+
+    return result;
+  }
+
+
+
+  template <int dim, typename Number>
+  std::vector<std::array<std::uint64_t, dim>>
+  inverse_Hilbert_space_filling_curve(
+    const std::vector<Point<dim, Number>> &points,
+    const int                              bits_per_dim)
+  {
+    Assert(bits_per_dim > 0 && bits_per_dim <= 64,
+           ExcIndexRange(bits_per_dim, 1, 65));
+    if (points.empty())
+      return std::vector<std::array<std::uint64_t, dim>>();
+
+    // scale the points to the integer range given by the number of bits
+    // within their bounding box, using the same scaling in all directions
+    Point<dim, Number> lower = points[0], upper = points[0];
+    for (const Point<dim, Number> &p : points)
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          lower[d] = std::min(lower[d], p[d]);
+          upper[d] = std::max(upper[d], p[d]);
+        }
+    double extent = 0;
+    for (unsigned int d = 0; d < dim; ++d)
+      extent = std::max(extent, static_cast<double>(upper[d] - lower[d]));
+
+    const double max_int    = std::ldexp(1., bits_per_dim) - 1.;
+    const double safe_limit = std::nextafter(std::ldexp(1., bits_per_dim), 0.);
+    std::vector<std::array<std::uint64_t, dim>> integer_coords(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      for (unsigned int d = 0; d < dim; ++d)
+        integer_coords[i][d] =
+          extent > 0 ? static_cast<std::uint64_t>(std::min(
+                         static_cast<double>(points[i][d] - lower[d]) /
+                           extent * max_int,
+                         safe_limit)) :
+                       0;
+
+    return inverse_Hilbert_space_filling_curve<dim>(integer_coords,
+                                                    bits_per_dim);
+  }
+
+
+
+  template <int dim>
+  std::uint64_t
+  pack_integers(const std::array<std::uint64_t, dim> &index,
+                const int                             bits_per_dim)
+  {
+    Assert(bits_per_dim * dim <= 64, ExcIndexRange(bits_per_dim * dim, 1, 65));
+
+    std::uint64_t packed = 0;
+    for (int b = bits_per_dim - 1; b >= 0; --b)
+      for (unsigned int d = 0; d < dim; ++d)
+        packed = (packed << 1) | ((index[d] >> b) & 1);
+    return packed;
+  }
+
+
+
   template <typename Integer>
   std::vector<Integer>
   reverse_permutation(const std::vector<Integer> &permutation)
@@ -901,6 +1006,37 @@ namespace Utilities
   template std::string
   to_string<long double>(long double, unsigned int);
 
+  template std::vector<std::array<std::uint64_t, 1>>
+  inverse_Hilbert_space_filling_curve<1>(
+    const std::vector<std::array<std::uint64_t, 1>> &,
+    const int);
+  template std::vector<std::array<std::uint64_t, 2>>
+  inverse_Hilbert_space_filling_curve<2>(
+    const std::vector<std::array<std::uint64_t, 2>> &,
+    const int);
+  template std::vector<std::array<std::uint64_t, 3>>
+  inverse_Hilbert_space_filling_curve<3>(
+    const std::vector<std::array<std::uint64_t, 3>> &,
+    const int);
+  template std::vector<std::array<std::uint64_t, 1>>
+  inverse_Hilbert_space_filling_curve<1, double>(
+    const std::vector<Point<1, double>> &,
+    const int);
+  template std::vector<std::array<std::uint64_t, 2>>
+  inverse_Hilbert_space_filling_curve<2, double>(
+    const std::vector<Point<2, double>> &,
+    const int);
+  template std::vector<std::array<std::uint64_t, 3>>
+  inverse_Hilbert_space_filling_curve<3, double>(
+    const std::vector<Point<3, double>> &,
+    const int);
+  template std::uint64_t
+  pack_integers<1>(const std::array<std::uint64_t, 1> &, const int);
+  template std::uint64_t
+  pack_integers<2>(const std::array<std::uint64_t, 2> &, const int);
+  template std::uint64_t
+  pack_integers<3>(const std::array<std::uint64_t, 3> &, const int);
+
 } // namespace Utilities
 
 DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,388 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    namespace
+    {
+      /**
+       * Copy the boundary and manifold indicators of the boundary faces of
+       * @p cell into @p subcelldata, using the new vertex numbers in
+       * @p new_vertex_index. Only faces with non-default indicators are
+       * stored.
+       */
+      template <int spacedim>
+      void
+      add_boundary_faces(const TriaActiveIterator<CellAccessor<1, spacedim>> &,
+                         const std::vector<unsigned int> &,
+                         SubCellData &)
+      {
+        // in 1d, the boundary indicators are stored with the vertices and
+        // can not be described by a SubCellData object
+      }
+
+
+
+      template <int spacedim>
+      void
+      add_boundary_faces(
+        const TriaActiveIterator<CellAccessor<2, spacedim>> &cell,
+        const std::vector<unsigned int> &new_vertex_index,
+        SubCellData &                                        subcelldata)
+      {
+        for (unsigned int f = 0; f < GeometryInfo<2>::faces_per_cell; ++f)
+          if (cell->at_boundary(f) &&
+              (cell->face(f)->boundary_id() != 0 ||
+               cell->face(f)->manifold_id() != numbers::flat_manifold_id))
+            {
+              CellData<1> line;
+              for (unsigned int v = 0; v < GeometryInfo<1>::vertices_per_cell;
+                   ++v)
+                line.vertices[v] =
+                  new_vertex_index[cell->face(f)->vertex_index(v)];
+              line.boundary_id = cell->face(f)->boundary_id();
+              line.manifold_id = cell->face(f)->manifold_id();
+              subcelldata.boundary_lines.push_back(line);
+            }
+      }
+
+
+
+      template <int spacedim>
+      void
+      add_boundary_faces(
+        const TriaActiveIterator<CellAccessor<3, spacedim>> &cell,
+        const std::vector<unsigned int> &new_vertex_index,
+        SubCellData &                                        subcelldata)
+      {
+        for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+          if (cell->at_boundary(f))
+            {
+              const auto face = cell->face(f);
+              if (face->boundary_id() != 0 ||
+                  face->manifold_id() != numbers::flat_manifold_id)
+                {
+                  CellData<2> quad;
+                  for (unsigned int v = 0;
+                       v < GeometryInfo<2>::vertices_per_cell;
+                       ++v)
+                    quad.vertices[v] = new_vertex_index[face->vertex_index(v)];
+                  quad.boundary_id = face->boundary_id();
+                  quad.manifold_id = face->manifold_id();
+                  subcelldata.boundary_quads.push_back(quad);
+                }
+
+              // the indicators of the lines of the face are independent of
+              // the ones of the face itself. lines shared by several faces
+              // are stored more than once, which is allowed
+              for (unsigned int l = 0; l < GeometryInfo<2>::lines_per_cell;
+                   ++l)
+                {
+                  const auto line = face->line(l);
+                  if (line->boundary_id() != 0 ||
+                      line->manifold_id() != numbers::flat_manifold_id)
+                    {
+                      CellData<1> line_data;
+                      for (unsigned int v = 0;
+                           v < GeometryInfo<1>::vertices_per_cell;
+                           ++v)
+                        line_data.vertices[v] =
+                          new_vertex_index[line->vertex_index(v)];
+                      line_data.boundary_id = line->boundary_id();
+                      line_data.manifold_id = line->manifold_id();
+                      subcelldata.boundary_lines.push_back(line_data);
+                    }
+                }
+            }
+      }
+    } // namespace
+
+
+
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data(const dealii::Triangulation<dim, spacedim> &tria,
+                             const types::subdomain_id subdomain)
+    {
+      AssertThrow(tria.has_hanging_nodes() == false,
+                  ExcMessage("The active cells of the triangulation become "
+                             "the coarse cells of the fully distributed "
+                             "triangulation, so the triangulation must not "
+                             "have hanging nodes."));
+
+      // mark the vertices of the locally owned cells. all cells that touch
+      // one of them are locally relevant
+      std::vector<bool> vertex_is_owned(tria.n_vertices(), false);
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->subdomain_id() == subdomain)
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            vertex_is_owned[cell->vertex_index(v)] = true;
+
+      std::vector<bool> vertex_is_relevant(tria.n_vertices(), false);
+      std::vector<typename dealii::Triangulation<dim, spacedim>::
+                    active_cell_iterator>
+        relevant_cells;
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          bool is_relevant = false;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            if (vertex_is_owned[cell->vertex_index(v)])
+              {
+                is_relevant = true;
+                break;
+              }
+          if (is_relevant)
+            {
+              relevant_cells.push_back(cell);
+              for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                   ++v)
+                vertex_is_relevant[cell->vertex_index(v)] = true;
+            }
+        }
+
+      // number the relevant vertices in the order of their global index
+      ConstructionData<dim, spacedim> construction_data;
+      std::vector<unsigned int>       new_vertex_index(
+        tria.n_vertices(), numbers::invalid_unsigned_int);
+      for (unsigned int v = 0; v < tria.n_vertices(); ++v)
+        if (vertex_is_relevant[v])
+          {
+            new_vertex_index[v] = construction_data.vertices.size();
+            construction_data.vertices.push_back(tria.get_vertices()[v]);
+          }
+
+      construction_data.cells.reserve(relevant_cells.size());
+      construction_data.coarse_cell_ids.reserve(relevant_cells.size());
+      construction_data.subdomain_ids.reserve(relevant_cells.size());
+      for (const auto &cell : relevant_cells)
+        {
+          CellData<dim> cell_data;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            cell_data.vertices[v] = new_vertex_index[cell->vertex_index(v)];
+          cell_data.material_id = cell->material_id();
+          cell_data.manifold_id = cell->manifold_id();
+          construction_data.cells.push_back(cell_data);
+          construction_data.coarse_cell_ids.push_back(
+            cell->active_cell_index());
+          construction_data.subdomain_ids.push_back(cell->subdomain_id());
+
+          add_boundary_faces(cell,
+                             new_vertex_index,
+                             construction_data.subcelldata);
+        }
+
+      return construction_data;
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+    template <int dim, int spacedim>
+    Triangulation<dim, spacedim>::Triangulation(MPI_Comm mpi_communicator)
+      : dealii::parallel::Triangulation<dim, spacedim>(mpi_communicator,
+                                                       dealii::Triangulation<
+                                                         dim,
+                                                         spacedim>::none,
+                                                       false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const ConstructionData<dim, spacedim> &construction_data)
+    {
+      AssertDimension(construction_data.coarse_cell_ids.size(),
+                      construction_data.cells.size());
+      AssertDimension(construction_data.subdomain_ids.size(),
+                      construction_data.cells.size());
+
+      // set up the map between the local indices and the global ids of the
+      // coarse cells first, since the signals triggered at the end of
+      // creating the triangulation may already query the CellId of cells
+      coarse_cell_index_to_id = construction_data.coarse_cell_ids;
+      coarse_cell_id_to_index.resize(coarse_cell_index_to_id.size());
+      for (unsigned int i = 0; i < coarse_cell_index_to_id.size(); ++i)
+        coarse_cell_id_to_index[i] =
+          std::make_pair(coarse_cell_index_to_id[i], i);
+      std::sort(coarse_cell_id_to_index.begin(), coarse_cell_id_to_index.end());
+      Assert(std::adjacent_find(
+               coarse_cell_id_to_index.begin(),
+               coarse_cell_id_to_index.end(),
+               [](const std::pair<unsigned int, unsigned int> &a,
+                  const std::pair<unsigned int, unsigned int> &b) {
+                 return a.first == b.first;
+               }) == coarse_cell_id_to_index.end(),
+             ExcMessage("The ids of the coarse cells must be unique."));
+
+      try
+        {
+          dealii::Triangulation<dim, spacedim>::create_triangulation(
+            construction_data.vertices,
+            construction_data.cells,
+            construction_data.subcelldata);
+        }
+      catch (
+        const typename dealii::Triangulation<dim, spacedim>::DistortedCellList
+          &)
+        {
+          // the underlying triangulation should not be checking for distorted
+          // cells
+          Assert(false, ExcInternalError());
+        }
+
+      // the coarse cells are created in the order in which they were given,
+      // so we can just copy the owners. cells that are owned by another
+      // process and do not share a vertex with one of ours are artificial
+      std::vector<bool> vertex_is_owned(this->n_vertices(), false);
+      for (const auto &cell : this->active_cell_iterators())
+        if (construction_data.subdomain_ids[cell->index()] ==
+            this->my_subdomain)
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            vertex_is_owned[cell->vertex_index(v)] = true;
+
+      for (const auto &cell : this->active_cell_iterators())
+        {
+          const types::subdomain_id owner =
+            construction_data.subdomain_ids[cell->index()];
+          bool is_relevant = (owner == this->my_subdomain);
+          for (unsigned int v = 0;
+               v < GeometryInfo<dim>::vertices_per_cell && !is_relevant;
+               ++v)
+            is_relevant = vertex_is_owned[cell->vertex_index(v)];
+          cell->set_subdomain_id(
+            is_relevant ? owner : numbers::artificial_subdomain_id);
+        }
+
+      this->update_number_cache();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const std::vector<Point<spacedim>> &,
+      const std::vector<CellData<dim>> &,
+      const SubCellData &)
+    {
+      AssertThrow(false,
+                  ExcMessage(
+                    "A parallel::fullydistributed::Triangulation can only be "
+                    "created from a ConstructionData object that describes "
+                    "the locally relevant part of the mesh."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::copy_triangulation(
+      const dealii::Triangulation<dim, spacedim> &)
+    {
+      AssertThrow(false, ExcNotImplemented());
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
+    {
+      AssertThrow(false, ExcNotImplemented());
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    Triangulation<dim, spacedim>::has_hanging_nodes() const
+    {
+      return false;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+      const unsigned int coarse_cell_index) const
+    {
+      AssertIndexRange(coarse_cell_index, coarse_cell_index_to_id.size());
+      return coarse_cell_index_to_id[coarse_cell_index];
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+      const unsigned int coarse_cell_id) const
+    {
+      const auto entry = std::lower_bound(
+        coarse_cell_id_to_index.begin(),
+        coarse_cell_id_to_index.end(),
+        std::make_pair(coarse_cell_id, 0U));
+      Assert(entry != coarse_cell_id_to_index.end() &&
+               entry->first == coarse_cell_id,
+             ExcMessage("The coarse cell with id " +
+                        Utilities::to_string(coarse_cell_id) +
+                        " is not stored on this process."));
+      return entry->second;
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    Triangulation<dim, spacedim>::memory_consumption() const
+    {
+      return (dealii::parallel::Triangulation<dim, spacedim>::
+                memory_consumption() +
+              MemoryConsumption::memory_consumption(coarse_cell_index_to_id) +
+              MemoryConsumption::memory_consumption(coarse_cell_id_to_index));
+    }
+
+#endif
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+/*-------------- Explicit Instantiations -------------------------------*/
+#include "fully_distributed_tria.inst"
+
+DEAL_II_NAMESPACE_CLOSE
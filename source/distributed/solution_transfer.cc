@@ -18,6 +18,8 @@
 
 #ifdef DEAL_II_WITH_P4EST
 
+#  include <deal.II/base/instrumentation.h>
+
 #  include <deal.II/distributed/solution_transfer.h>
 #  include <deal.II/distributed/tria.h>
 
@@ -36,6 +38,7 @@
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
 
+#  include <cstring>
 #  include <functional>
 
 DEAL_II_NAMESPACE_OPEN
@@ -158,6 +161,9 @@ namespace parallel
     SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate(
       std::vector<VectorType *> &all_out)
     {
+      DEAL_II_INSTRUMENT_REGION(
+        "parallel::distributed::SolutionTransfer::interpolate");
+
       Assert(input_vectors.size() == all_out.size(),
              ExcDimensionMismatch(input_vectors.size(), all_out.size()));
 
@@ -212,21 +218,28 @@ namespace parallel
     {
       typename DoFHandlerType::cell_iterator cell(*cell_, dof_handler);
 
-      // create buffer for each individual object
-      std::vector<::dealii::Vector<typename VectorType::value_type>> dofvalues(
-        input_vectors.size());
-
-      auto cit_input = input_vectors.cbegin();
-      auto it_output = dofvalues.begin();
-      for (; cit_input != input_vectors.cend(); ++cit_input, ++it_output)
+      // write the values of all registered vectors on this cell into one
+      // contiguous buffer, one vector after the other. there is no need for a
+      // serialization of the data: the number of values per vector follows
+      // from the element on the cell, and since all cells carry the same
+      // number of values, the data has a fixed size as requested in
+      // register_data_attach()
+      using value_type                 = typename VectorType::value_type;
+      const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
+
+      std::vector<char> buffer(input_vectors.size() * dofs_per_cell *
+                               sizeof(value_type));
+      ::dealii::Vector<value_type> dof_values(dofs_per_cell);
+      for (unsigned int j = 0; j < input_vectors.size(); ++j)
         {
-          it_output->reinit(cell->get_fe().dofs_per_cell);
-          cell->get_interpolated_dof_values(*(*cit_input), *it_output);
+          cell->get_interpolated_dof_values(*input_vectors[j], dof_values);
+          if (dofs_per_cell > 0)
+            std::memcpy(buffer.data() + j * dofs_per_cell * sizeof(value_type),
+                        dof_values.begin(),
+                        dofs_per_cell * sizeof(value_type));
         }
 
-      // to get consistent data sizes on each cell for the fixed size transfer,
-      // we won't allow compression
-      return Utilities::pack(dofvalues, /*allow_compression=*/false);
+      return buffer;
     }
 
 
@@ -244,30 +257,30 @@ namespace parallel
     {
       typename DoFHandlerType::cell_iterator cell(*cell_, dof_handler);
 
-      const std::vector<::dealii::Vector<typename VectorType::value_type>>
-        dofvalues = Utilities::unpack<
-          std::vector<::dealii::Vector<typename VectorType::value_type>>>(
-          data_range.begin(), data_range.end(), /*allow_compression=*/false);
-
-      // check if sizes match
-      Assert(dofvalues.size() == all_out.size(), ExcInternalError());
+      using value_type                 = typename VectorType::value_type;
+      const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
 
       // check if we have enough dofs provided by the FE object
       // to interpolate the transferred data correctly
-      for (auto it_dofvalues = dofvalues.begin();
-           it_dofvalues != dofvalues.end();
-           ++it_dofvalues)
-        Assert(
-          cell->get_fe().dofs_per_cell == it_dofvalues->size(),
-          ExcMessage(
-            "The transferred data was packed with a different number of dofs than the"
-            "currently registered FE object assigned to the DoFHandler has."));
-
-      // distribute data for each registered vector on mesh
-      auto it_input  = dofvalues.cbegin();
-      auto it_output = all_out.begin();
-      for (; it_input != dofvalues.cend(); ++it_input, ++it_output)
-        cell->set_dof_values_by_interpolation(*it_input, *(*it_output));
+      Assert(
+        static_cast<std::size_t>(data_range.end() - data_range.begin()) ==
+          all_out.size() * dofs_per_cell * sizeof(value_type),
+        ExcMessage(
+          "The transferred data was packed with a different number of dofs than the "
+          "currently registered FE object assigned to the DoFHandler has."));
+
+      // distribute data for each registered vector on mesh, reading the
+      // values directly from the buffer
+      ::dealii::Vector<value_type> dof_values(dofs_per_cell);
+      for (unsigned int j = 0; j < all_out.size(); ++j)
+        {
+          if (dofs_per_cell > 0)
+            std::memcpy(dof_values.begin(),
+                        &*data_range.begin() +
+                          j * dofs_per_cell * sizeof(value_type),
+                        dofs_per_cell * sizeof(value_type));
+          cell->set_dof_values_by_interpolation(dof_values, *all_out[j]);
+        }
     }
 
 
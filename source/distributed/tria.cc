@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/utilities.h>
@@ -2195,6 +2196,9 @@ namespace parallel
       const std::vector<CellData<dim>> &  cells,
       const SubCellData &                 subcelldata)
     {
+      DEAL_II_INSTRUMENT_REGION(
+        "parallel::distributed::Triangulation::create_triangulation");
+
       try
         {
           dealii::Triangulation<dim, spacedim>::create_triangulation(
@@ -2688,6 +2692,8 @@ namespace parallel
     void
     Triangulation<dim, spacedim>::save(const char *filename) const
     {
+      DEAL_II_INSTRUMENT_REGION("parallel::distributed::Triangulation::save");
+
       Assert(
         cell_attached_data.n_attached_deserialize == 0,
         ExcMessage(
@@ -2765,6 +2771,8 @@ namespace parallel
     Triangulation<dim, spacedim>::load(const char *filename,
                                        const bool  autopartition)
     {
+      DEAL_II_INSTRUMENT_REGION("parallel::distributed::Triangulation::load");
+
       Assert(
         this->n_cells() > 0,
         ExcMessage(
@@ -3449,6 +3457,9 @@ namespace parallel
     void
     Triangulation<dim, spacedim>::copy_local_forest_to_triangulation()
     {
+      DEAL_II_INSTRUMENT_REGION(
+        "parallel::distributed::Triangulation::copy_local_forest_to_triangulation");
+
       // disable mesh smoothing for recreating the deal.II triangulation,
       // otherwise we might not be able to reproduce the p4est mesh
       // exactly. We restore the original smoothing at the end of this
@@ -3809,6 +3820,9 @@ namespace parallel
     void
     Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
     {
+      DEAL_II_INSTRUMENT_REGION(
+        "parallel::distributed::Triangulation::execute_coarsening_and_refinement");
+
       // do not allow anisotropic refinement
 #  ifdef DEBUG
       for (typename Triangulation<dim, spacedim>::active_cell_iterator cell =
@@ -4074,6 +4088,9 @@ namespace parallel
     void
     Triangulation<dim, spacedim>::repartition()
     {
+      DEAL_II_INSTRUMENT_REGION(
+        "parallel::distributed::Triangulation::repartition");
+
 #  ifdef DEBUG
       for (typename Triangulation<dim, spacedim>::active_cell_iterator cell =
              this->begin_active();
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
@@ -854,8 +855,7 @@ DoFHandler<dim, spacedim>::DoFHandler(const Triangulation<dim, spacedim> &tria)
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
+  else if (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
              &tria) == nullptr)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
@@ -906,8 +906,7 @@ DoFHandler<dim, spacedim>::initialize(const Triangulation<dim, spacedim> &t,
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(&t) !=
+  else if (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(&t) !=
            nullptr)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
@@ -1210,6 +1209,8 @@ DoFHandler<dim, spacedim>::distribute_dofs(
   Assert(tria->n_levels() > 0,
          ExcMessage("The Triangulation you are using is empty!"));
 
+  DEAL_II_INSTRUMENT_REGION("DoFHandler::distribute_dofs");
+
   // Only recreate the FECollection if we don't already store
   // the exact same FiniteElement object.
   if (fe_collection.size() == 0 || fe_collection[0] != ff)
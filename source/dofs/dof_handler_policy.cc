@@ -3853,6 +3853,16 @@ namespace internal
 
 
 
+      } // namespace
+
+#endif // DEAL_II_WITH_P4EST
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+      namespace
+      {
         /**
          * A function that communicates the DoF indices from that subset of
          * locally owned cells that have their user indices set to the
@@ -3874,10 +3884,7 @@ namespace internal
         template <int spacedim>
         void
         communicate_dof_indices_on_marked_cells(
-          const DoFHandler<1, spacedim> &,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const DoFHandler<1, spacedim> &)
         {
           Assert(false, ExcNotImplemented());
         }
@@ -3887,10 +3894,7 @@ namespace internal
         template <int spacedim>
         void
         communicate_dof_indices_on_marked_cells(
-          const hp::DoFHandler<1, spacedim> &,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const hp::DoFHandler<1, spacedim> &)
         {
           Assert(false, ExcNotImplemented());
         }
@@ -3900,15 +3904,8 @@ namespace internal
         template <class DoFHandlerType>
         void
         communicate_dof_indices_on_marked_cells(
-          const DoFHandlerType &dof_handler,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const DoFHandlerType &dof_handler)
         {
-#  ifndef DEAL_II_WITH_MPI
-          (void)vertices_with_ghost_neighbors;
-          Assert(false, ExcNotImplemented());
-#  else
           const unsigned int dim = DoFHandlerType::dimension;
           const unsigned int spacedim = DoFHandlerType::space_dimension;
 
@@ -3956,7 +3953,7 @@ namespace internal
                 // nothing we need to send that hasn't been sent so far.
                 // so return an empty array, but also verify that indeed
                 // the cell is complete
-#    ifdef DEBUG
+#  ifdef DEBUG
                 std::vector<types::global_dof_index> local_dof_indices(
                   cell->get_fe().dofs_per_cell);
                 cell->get_dof_indices(local_dof_indices);
@@ -3967,7 +3964,7 @@ namespace internal
                              numbers::invalid_dof_index) ==
                    local_dof_indices.end());
                 Assert(is_complete, ExcInternalError());
-#    endif
+#  endif
                 return boost::optional<std::vector<types::global_dof_index>>();
               }
           };
@@ -4051,9 +4048,9 @@ namespace internal
           // different tags for phase 1 and 2, but the cost of a
           // barrier is negligible compared to everything else we do
           // here
-          if (const auto *triangulation = dynamic_cast<
-                const parallel::distributed::Triangulation<dim, spacedim> *>(
-                &dof_handler.get_triangulation()))
+          if (const auto *triangulation =
+                dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+                  &dof_handler.get_triangulation()))
             {
               const int ierr = MPI_Barrier(triangulation->get_communicator());
               AssertThrowMPI(ierr);
@@ -4065,14 +4062,13 @@ namespace internal
                        "The function communicate_dof_indices_on_marked_cells() "
                        "only works with parallel distributed triangulations."));
             }
-#  endif
         }
 
 
 
       } // namespace
 
-#endif // DEAL_II_WITH_P4EST
+#endif // DEAL_II_WITH_MPI
 
 
 
@@ -4088,15 +4084,15 @@ namespace internal
       NumberCache
       ParallelDistributed<DoFHandlerType>::distribute_dofs() const
       {
-#ifndef DEAL_II_WITH_P4EST
+#ifndef DEAL_II_WITH_MPI
         Assert(false, ExcNotImplemented());
         return NumberCache();
 #else
         const unsigned int dim      = DoFHandlerType::dimension;
         const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-        parallel::distributed::Triangulation<dim, spacedim> *triangulation =
-          (dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+        parallel::Triangulation<dim, spacedim> *triangulation =
+          (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
             const_cast<dealii::Triangulation<dim, spacedim> *>(
               &dof_handler->get_triangulation())));
         Assert(triangulation != nullptr, ExcInternalError());
@@ -4278,17 +4274,9 @@ namespace internal
           //
           // as explained in the 'distributed' paper, this has to be
           // done twice
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
           // at this point, we must have taken care of the data transfer
           // on all cells we had previously marked. verify this
@@ -4337,7 +4325,7 @@ namespace internal
         }
 #  endif // DEBUG
         return number_cache;
-#endif   // DEAL_II_WITH_P4EST
+#endif   // DEAL_II_WITH_MPI
       }
 
 
@@ -4635,15 +4623,15 @@ namespace internal
         Assert(new_numbers.size() == dof_handler->n_locally_owned_dofs(),
                ExcInternalError());
 
-#ifndef DEAL_II_WITH_P4EST
+#ifndef DEAL_II_WITH_MPI
         Assert(false, ExcNotImplemented());
         return NumberCache();
 #else
         const unsigned int dim      = DoFHandlerType::dimension;
         const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-        parallel::distributed::Triangulation<dim, spacedim> *triangulation =
-          (dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+        parallel::Triangulation<dim, spacedim> *triangulation =
+          (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
             const_cast<dealii::Triangulation<dim, spacedim> *>(
               &dof_handler->get_triangulation())));
         Assert(triangulation != nullptr, ExcInternalError());
@@ -4728,30 +4716,15 @@ namespace internal
             if (!cell->is_artificial())
               cell->set_user_flag();
 
-          // figure out which cells are ghost cells on which we have
-          // to exchange DoF indices
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
-            vertices_with_ghost_neighbors =
-              triangulation->compute_vertices_with_ghost_neighbors();
-
-
           // Send and receive cells. After this, only the local cells
           // are marked, that received new data. This has to be
           // communicated in a second communication step.
           //
           // as explained in the 'distributed' paper, this has to be
           // done twice
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
           triangulation->load_user_flags(user_flags);
         }
@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/multithread_info.h>
@@ -20,12 +21,14 @@
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 
 #include <deal.II/differentiation/ad.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
@@ -43,6 +46,8 @@
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_element_access.h>
 
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
 #include <boost/container/small_vector.hpp>
 
 #include <iomanip>
@@ -1638,7 +1643,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -1663,7 +1668,7 @@ namespace FEValuesViews
 
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -1694,7 +1699,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<1, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       gradients);
   }
@@ -1719,7 +1724,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<1, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       gradients);
   }
@@ -1750,7 +1755,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       hessians);
   }
@@ -1775,7 +1780,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       hessians);
   }
@@ -1806,7 +1811,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       laplacians);
   }
@@ -1831,7 +1836,7 @@ namespace FEValuesViews
 
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       laplacians);
   }
@@ -1862,7 +1867,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->present_fe_output->shape_3rd_derivatives,
       shape_function_data,
       third_derivatives);
   }
@@ -1886,7 +1891,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->present_fe_output->shape_3rd_derivatives,
       shape_function_data,
       third_derivatives);
   }
@@ -1917,7 +1922,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -1942,7 +1947,7 @@ namespace FEValuesViews
 
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -1973,7 +1978,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<1, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       gradients);
   }
@@ -1998,7 +2003,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<1, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       gradients);
   }
@@ -2029,7 +2034,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_symmetric_gradients<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       symmetric_gradients);
   }
@@ -2053,7 +2058,7 @@ namespace FEValuesViews
 
     internal::do_function_symmetric_gradients<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       symmetric_gradients);
   }
@@ -2085,7 +2090,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_divergences<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       divergences);
   }
@@ -2110,7 +2115,7 @@ namespace FEValuesViews
 
     internal::do_function_divergences<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       divergences);
   }
@@ -2141,7 +2146,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_curls<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       curls);
   }
@@ -2166,7 +2171,7 @@ namespace FEValuesViews
 
     internal::do_function_curls<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       curls);
   }
@@ -2197,7 +2202,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       hessians);
   }
@@ -2222,7 +2227,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       hessians);
   }
@@ -2258,7 +2263,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       laplacians);
   }
@@ -2286,7 +2291,7 @@ namespace FEValuesViews
 
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->present_fe_output->shape_hessians,
       shape_function_data,
       laplacians);
   }
@@ -2317,7 +2322,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->present_fe_output->shape_3rd_derivatives,
       shape_function_data,
       third_derivatives);
   }
@@ -2341,7 +2346,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->present_fe_output->shape_3rd_derivatives,
       shape_function_data,
       third_derivatives);
   }
@@ -2372,7 +2377,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -2397,7 +2402,7 @@ namespace FEValuesViews
 
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -2429,7 +2434,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_divergences<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       divergences);
   }
@@ -2455,7 +2460,7 @@ namespace FEValuesViews
 
     internal::do_function_divergences<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       divergences);
   }
@@ -2486,7 +2491,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -2511,7 +2516,7 @@ namespace FEValuesViews
 
     internal::do_function_values<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_values,
+      fe_values->present_fe_output->shape_values,
       shape_function_data,
       values);
   }
@@ -2543,7 +2548,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_divergences<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       divergences);
   }
@@ -2568,7 +2573,7 @@ namespace FEValuesViews
 
     internal::do_function_divergences<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       divergences);
   }
@@ -2600,7 +2605,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_gradients<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       gradients);
   }
@@ -2625,7 +2630,7 @@ namespace FEValuesViews
 
     internal::do_function_gradients<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_gradients,
+      fe_values->present_fe_output->shape_gradients,
       shape_function_data,
       gradients);
   }
@@ -3168,6 +3173,8 @@ FEValuesBase<dim, spacedim>::FEValuesBase(
   , dofs_per_cell(dofs_per_cell)
   , mapping(&mapping, typeid(*this).name())
   , fe(&fe, typeid(*this).name())
+  , present_mapping_output(&mapping_output)
+  , present_fe_output(&finite_element_output)
   , cell_similarity(CellSimilarity::Similarity::none)
   , fe_values_views_cache(*this)
 {
@@ -3191,6 +3198,280 @@ FEValuesBase<dim, spacedim>::~FEValuesBase()
 
 namespace internal
 {
+  namespace FEValuesImplementation
+  {
+    struct TensorProductShapeData
+    {
+      /**
+       * Number of shape functions and quadrature points per direction.
+       */
+      unsigned int n_dofs_1d;
+      unsigned int n_q_points_1d;
+
+      /**
+       * Values and derivatives of the one-dimensional shape functions in the
+       * one-dimensional quadrature points, stored as
+       * <tt>n_dofs_1d * n_q_points_1d</tt> arrays with the quadrature index
+       * running fastest.
+       */
+      AlignedVector<double> shape_values;
+      AlignedVector<double> shape_gradients;
+
+      /**
+       * For each shape function in lexicographic order, the index of the
+       * shape function in the numbering of the finite element.
+       */
+      std::vector<unsigned int> lexicographic_numbering;
+    };
+
+
+
+    // the minimal polynomial degree for which the evaluation by sum
+    // factorization is used. below, the overhead of the reordering and the
+    // temporary arrays eats up the gain over the plain loops through the
+    // shape function tables
+    const unsigned int min_degree_for_sum_factorization = 3;
+
+
+
+    // set up the one-dimensional shape data for the given element and
+    // quadrature formula if both are of tensor product form. the 1D shape
+    // functions are evaluated along the line through the first support point
+    // in x direction, as done by MatrixFreeFunctions::ShapeInfo. return an
+    // empty pointer if the element or the quadrature is not supported
+    template <int dim, int spacedim>
+    std::unique_ptr<const TensorProductShapeData>
+    create_tensor_product_shape_data(const FiniteElement<dim, spacedim> &fe,
+                                     const Quadrature<dim> &quadrature)
+    {
+      const FE_Poly<TensorProductPolynomials<dim>, dim, spacedim> *fe_poly =
+        dynamic_cast<
+          const FE_Poly<TensorProductPolynomials<dim>, dim, spacedim> *>(&fe);
+      if (dim != spacedim || fe_poly == nullptr || fe.n_components() != 1 ||
+          fe.degree < min_degree_for_sum_factorization ||
+          fe.dofs_per_cell != Utilities::fixed_power<dim>(fe.degree + 1) ||
+          fe.has_support_points() == false ||
+          quadrature.is_tensor_product() == false)
+        return std::unique_ptr<const TensorProductShapeData>();
+
+      const std::array<Quadrature<1>, dim> &quadrature_1d =
+        quadrature.get_tensor_basis();
+      for (unsigned int d = 1; d < dim; ++d)
+        if (!(quadrature_1d[d] == quadrature_1d[0]))
+          return std::unique_ptr<const TensorProductShapeData>();
+
+      const std::vector<unsigned int> lexicographic =
+        fe_poly->get_poly_space_numbering_inverse();
+      const Point<dim> unit_point =
+        fe.get_unit_support_points()[lexicographic[0]];
+      if (std::abs(fe.shape_value(lexicographic[0], unit_point) - 1.) > 1e-13)
+        return std::unique_ptr<const TensorProductShapeData>();
+
+      TensorProductShapeData data;
+      data.n_dofs_1d     = fe.degree + 1;
+      data.n_q_points_1d = quadrature_1d[0].size();
+      data.shape_values.resize(data.n_dofs_1d * data.n_q_points_1d);
+      data.shape_gradients.resize(data.n_dofs_1d * data.n_q_points_1d);
+      for (unsigned int i = 0; i < data.n_dofs_1d; ++i)
+        for (unsigned int q = 0; q < data.n_q_points_1d; ++q)
+          {
+            Point<dim> point = unit_point;
+            point[0]         = quadrature_1d[0].point(q)[0];
+            data.shape_values[i * data.n_q_points_1d + q] =
+              fe.shape_value(lexicographic[i], point);
+            data.shape_gradients[i * data.n_q_points_1d + q] =
+              fe.shape_grad(lexicographic[i], point)[0];
+          }
+      data.lexicographic_numbering = lexicographic;
+
+      return std_cxx14::make_unique<const TensorProductShapeData>(
+        std::move(data));
+    }
+
+
+
+    // evaluate the values and, if requested, the gradients on the unit cell
+    // of a finite element function given by its values in the degrees of
+    // freedom by sum factorization. the unit cell gradients are stored
+    // component by component, i.e., all x derivatives first
+    template <int dim, typename Number>
+    void
+    evaluate_tensor_product(const TensorProductShapeData &data,
+                            const Number *                dof_values,
+                            Number *                      values,
+                            Number *                      unit_gradients)
+    {
+      const unsigned int n_dofs = Utilities::fixed_power<dim>(data.n_dofs_1d);
+      const unsigned int n_q_points =
+        Utilities::fixed_power<dim>(data.n_q_points_1d);
+      const unsigned int temp_size = Utilities::fixed_power<dim>(
+        std::max(data.n_dofs_1d, data.n_q_points_1d));
+
+      boost::container::small_vector<Number, 1000> lexicographic_values(
+        n_dofs);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        lexicographic_values[i] = dof_values[data.lexicographic_numbering[i]];
+
+      boost::container::small_vector<Number, 1000> temp1(temp_size),
+        temp2(temp_size);
+      const AlignedVector<double> no_hessians;
+
+      dealii::internal::
+        EvaluatorTensorProduct<dealii::internal::evaluate_general,
+                               dim,
+                               0,
+                               0,
+                               Number,
+                               double>
+          eval(data.shape_values,
+               data.shape_gradients,
+               no_hessians,
+               data.n_dofs_1d,
+               data.n_q_points_1d);
+
+      const Number *in = lexicographic_values.data();
+      switch (dim)
+        {
+          case 1:
+            if (values != nullptr)
+              eval.template values<0, true, false>(in, values);
+            if (unit_gradients != nullptr)
+              eval.template gradients<0, true, false>(in, unit_gradients);
+            break;
+
+          case 2:
+            eval.template values<0, true, false>(in, temp1.data());
+            if (values != nullptr)
+              eval.template values<1, true, false>(temp1.data(), values);
+            if (unit_gradients != nullptr)
+              {
+                eval.template gradients<1, true, false>(temp1.data(),
+                                                        unit_gradients +
+                                                          n_q_points);
+                eval.template gradients<0, true, false>(in, temp1.data());
+                eval.template values<1, true, false>(temp1.data(),
+                                                     unit_gradients);
+              }
+            break;
+
+          case 3:
+            eval.template values<0, true, false>(in, temp1.data());
+            eval.template values<1, true, false>(temp1.data(), temp2.data());
+            if (values != nullptr)
+              eval.template values<2, true, false>(temp2.data(), values);
+            if (unit_gradients != nullptr)
+              {
+                eval.template gradients<2, true, false>(temp2.data(),
+                                                        unit_gradients +
+                                                          2 * n_q_points);
+                eval.template gradients<1, true, false>(temp1.data(),
+                                                        temp2.data());
+                eval.template values<2, true, false>(temp2.data(),
+                                                     unit_gradients +
+                                                       n_q_points);
+                eval.template gradients<0, true, false>(in, temp1.data());
+                eval.template values<1, true, false>(temp1.data(),
+                                                     temp2.data());
+                eval.template values<2, true, false>(temp2.data(),
+                                                     unit_gradients);
+              }
+            break;
+
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+    }
+
+
+
+    // the sum factorization kernels are only set up for plain floating
+    // point numbers. for all other number types (complex numbers,
+    // auto-differentiable numbers), the functions below return false and
+    // the caller falls back to the loops through the shape function tables
+    template <int dim, typename Number>
+    typename std::enable_if<std::is_floating_point<Number>::value, bool>::type
+    do_function_values_tensor_product(const TensorProductShapeData *data,
+                                      const Number *        dof_values,
+                                      std::vector<Number> & values)
+    {
+      if (data == nullptr)
+        return false;
+
+      AssertDimension(values.size(),
+                      Utilities::fixed_power<dim>(data->n_q_points_1d));
+      evaluate_tensor_product<dim>(*data,
+                                   dof_values,
+                                   values.data(),
+                                   static_cast<Number *>(nullptr));
+      return true;
+    }
+
+
+
+    template <int dim, typename Number>
+    typename std::enable_if<!std::is_floating_point<Number>::value, bool>::type
+    do_function_values_tensor_product(const TensorProductShapeData *,
+                                      const Number *,
+                                      std::vector<Number> &)
+    {
+      return false;
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    typename std::enable_if<std::is_floating_point<Number>::value, bool>::type
+    do_function_gradients_tensor_product(
+      const TensorProductShapeData *                       data,
+      const Number *                                       dof_values,
+      const std::vector<DerivativeForm<1, spacedim, dim>> &inverse_jacobians,
+      std::vector<Tensor<1, spacedim, Number>> &           gradients)
+    {
+      if (data == nullptr)
+        return false;
+
+      const unsigned int n_q_points =
+        Utilities::fixed_power<dim>(data->n_q_points_1d);
+      AssertDimension(gradients.size(), n_q_points);
+      AssertDimension(inverse_jacobians.size(), n_q_points);
+
+      boost::container::small_vector<Number, 1000> unit_gradients(dim *
+                                                                  n_q_points);
+      evaluate_tensor_product<dim>(*data,
+                                   dof_values,
+                                   static_cast<Number *>(nullptr),
+                                   unit_gradients.data());
+
+      // transform to the real cell, i.e., multiply by the transpose of the
+      // inverse Jacobian
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        for (unsigned int e = 0; e < spacedim; ++e)
+          {
+            Number sum = unit_gradients[q] * inverse_jacobians[q][0][e];
+            for (unsigned int d = 1; d < dim; ++d)
+              sum += unit_gradients[d * n_q_points + q] *
+                     inverse_jacobians[q][d][e];
+            gradients[q][e] = sum;
+          }
+      return true;
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    typename std::enable_if<!std::is_floating_point<Number>::value, bool>::type
+    do_function_gradients_tensor_product(
+      const TensorProductShapeData *,
+      const Number *,
+      const std::vector<DerivativeForm<1, spacedim, dim>> &,
+      std::vector<Tensor<1, spacedim, Number>> &)
+    {
+      return false;
+    }
+  } // namespace FEValuesImplementation
+
+
+
   // put shape function part of get_function_xxx methods into separate
   // internal functions. this allows us to reuse the same code for several
   // functions (e.g. both the versions with and without indices) as well as
@@ -3669,9 +3950,11 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
-  internal::do_function_values(dof_values.begin(),
-                               this->finite_element_output.shape_values,
-                               values);
+  if (internal::FEValuesImplementation::do_function_values_tensor_product<dim>(
+        tensor_product_shape_data.get(), dof_values.begin(), values) == false)
+    internal::do_function_values(dof_values.begin(),
+                                 this->present_fe_output->shape_values,
+                                 values);
 }
 
 
@@ -3693,9 +3976,11 @@ FEValuesBase<dim, spacedim>::get_function_values(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   for (unsigned int i = 0; i < dofs_per_cell; ++i)
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
-  internal::do_function_values(dof_values.data(),
-                               this->finite_element_output.shape_values,
-                               values);
+  if (internal::FEValuesImplementation::do_function_values_tensor_product<dim>(
+        tensor_product_shape_data.get(), dof_values.data(), values) == false)
+    internal::do_function_values(dof_values.data(),
+                                 this->present_fe_output->shape_values,
+                                 values);
 }
 
 
@@ -3720,9 +4005,9 @@ FEValuesBase<dim, spacedim>::get_function_values(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_values(
     dof_values.begin(),
-    this->finite_element_output.shape_values,
+    this->present_fe_output->shape_values,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(values.begin(), values.end()));
 }
 
@@ -3749,9 +4034,9 @@ FEValuesBase<dim, spacedim>::get_function_values(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_values(
     dof_values.data(),
-    this->finite_element_output.shape_values,
+    this->present_fe_output->shape_values,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(values.begin(), values.end()),
     false,
     indices.size() / dofs_per_cell);
@@ -3783,9 +4068,9 @@ FEValuesBase<dim, spacedim>::get_function_values(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_values(
     dof_values.data(),
-    this->finite_element_output.shape_values,
+    this->present_fe_output->shape_values,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(values.begin(), values.end()),
     quadrature_points_fastest,
     indices.size() / dofs_per_cell);
@@ -3812,9 +4097,15 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
-  internal::do_function_derivatives(dof_values.begin(),
-                                    this->finite_element_output.shape_gradients,
-                                    gradients);
+  if (internal::FEValuesImplementation::do_function_gradients_tensor_product(
+        tensor_product_shape_data.get(),
+        dof_values.begin(),
+        this->present_mapping_output->inverse_jacobians,
+        gradients) == false)
+    internal::do_function_derivatives(
+      dof_values.begin(),
+      this->present_fe_output->shape_gradients,
+      gradients);
 }
 
 
@@ -3837,9 +4128,15 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   for (unsigned int i = 0; i < dofs_per_cell; ++i)
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
-  internal::do_function_derivatives(dof_values.data(),
-                                    this->finite_element_output.shape_gradients,
-                                    gradients);
+  if (internal::FEValuesImplementation::do_function_gradients_tensor_product(
+        tensor_product_shape_data.get(),
+        dof_values.data(),
+        this->present_mapping_output->inverse_jacobians,
+        gradients) == false)
+    internal::do_function_derivatives(
+      dof_values.data(),
+      this->present_fe_output->shape_gradients,
+      gradients);
 }
 
 
@@ -3865,9 +4162,9 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_gradients,
+    this->present_fe_output->shape_gradients,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(gradients.begin(), gradients.end()));
 }
 
@@ -3897,9 +4194,9 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_gradients,
+    this->present_fe_output->shape_gradients,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(gradients.begin(), gradients.end()),
     quadrature_points_fastest,
     indices.size() / dofs_per_cell);
@@ -3927,7 +4224,7 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(dof_values.begin(),
-                                    this->finite_element_output.shape_hessians,
+                                    this->present_fe_output->shape_hessians,
                                     hessians);
 }
 
@@ -3952,7 +4249,7 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
   for (unsigned int i = 0; i < dofs_per_cell; ++i)
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(dof_values.data(),
-                                    this->finite_element_output.shape_hessians,
+                                    this->present_fe_output->shape_hessians,
                                     hessians);
 }
 
@@ -3980,9 +4277,9 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_hessians,
+    this->present_fe_output->shape_hessians,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(hessians.begin(), hessians.end()),
     quadrature_points_fastest);
 }
@@ -4011,9 +4308,9 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_hessians,
+    this->present_fe_output->shape_hessians,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(hessians.begin(), hessians.end()),
     quadrature_points_fastest,
     indices.size() / dofs_per_cell);
@@ -4040,7 +4337,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_laplacians(dof_values.begin(),
-                                   this->finite_element_output.shape_hessians,
+                                   this->present_fe_output->shape_hessians,
                                    laplacians);
 }
 
@@ -4064,7 +4361,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
   for (unsigned int i = 0; i < dofs_per_cell; ++i)
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_laplacians(dof_values.data(),
-                                   this->finite_element_output.shape_hessians,
+                                   this->present_fe_output->shape_hessians,
                                    laplacians);
 }
 
@@ -4089,9 +4386,9 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_laplacians(
     dof_values.begin(),
-    this->finite_element_output.shape_hessians,
+    this->present_fe_output->shape_hessians,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     laplacians);
 }
 
@@ -4118,9 +4415,9 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_laplacians(
     dof_values.data(),
-    this->finite_element_output.shape_hessians,
+    this->present_fe_output->shape_hessians,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     laplacians,
     false,
     indices.size() / dofs_per_cell);
@@ -4148,9 +4445,9 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_laplacians(
     dof_values.data(),
-    this->finite_element_output.shape_hessians,
+    this->present_fe_output->shape_hessians,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     laplacians,
     quadrature_points_fastest,
     indices.size() / dofs_per_cell);
@@ -4179,7 +4476,7 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->present_fe_output->shape_3rd_derivatives,
     third_derivatives);
 }
 
@@ -4205,7 +4502,7 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->present_fe_output->shape_3rd_derivatives,
     third_derivatives);
 }
 
@@ -4233,9 +4530,9 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->present_fe_output->shape_3rd_derivatives,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(third_derivatives.begin(), third_derivatives.end()),
     quadrature_points_fastest);
 }
@@ -4264,9 +4561,9 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->present_fe_output->shape_3rd_derivatives,
     *fe,
-    this->finite_element_output.shape_function_to_row_table,
+    this->present_fe_output->shape_function_to_row_table,
     make_array_view(third_derivatives.begin(), third_derivatives.end()),
     quadrature_points_fastest,
     indices.size() / dofs_per_cell);
@@ -4303,7 +4600,7 @@ FEValuesBase<dim, spacedim>::get_normal_vectors() const
          (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
            "update_normal_vectors")));
 
-  return this->mapping_output.normal_vectors;
+  return this->present_mapping_output->normal_vectors;
 }
 
 
@@ -4502,6 +4799,8 @@ FEValues<dim, spacedim>::FEValues(const Mapping<dim, spacedim> &      mapping,
                                 mapping,
                                 fe)
   , quadrature(q)
+  , geometry_cache_configuration(numbers::invalid_unsigned_int)
+  , geometry_cache_generation(0)
 {
   initialize(update_flags);
 }
@@ -4518,6 +4817,8 @@ FEValues<dim, spacedim>::FEValues(const FiniteElement<dim, spacedim> &fe,
                                 StaticMappingQ1<dim, spacedim>::mapping,
                                 fe)
   , quadrature(q)
+  , geometry_cache_configuration(numbers::invalid_unsigned_int)
+  , geometry_cache_generation(0)
 {
   initialize(update_flags);
 }
@@ -4538,7 +4839,16 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
                       "triangulation it refers to is embedded in a higher "
                       "dimensional space."));
 
-  const UpdateFlags flags = this->compute_update_flags(update_flags);
+  UpdateFlags flags = this->compute_update_flags(update_flags);
+
+  // see whether we can evaluate finite element functions by sum
+  // factorization. gradients then get transformed to the real cell by the
+  // inverse Jacobians, so make sure the mapping computes them
+  this->tensor_product_shape_data =
+    internal::FEValuesImplementation::create_tensor_product_shape_data(
+      *this->fe, quadrature);
+  if (this->tensor_product_shape_data != nullptr && (flags & update_gradients))
+    flags |= update_inverse_jacobians;
 
   // initialize the base classes
   if (flags & update_mapping)
@@ -4660,10 +4970,90 @@ FEValues<dim, spacedim>::reinit(
 
 
 
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::attach_geometry_cache(
+  FEValuesGeometryCache<dim, spacedim> &cache)
+{
+  // forget about the table of a previously attached cache, and with it
+  // about the data of the present cell if it was taken from there
+  geometry_cache_table         = nullptr;
+  this->present_mapping_output = &this->mapping_output;
+  this->present_fe_output      = &this->finite_element_output;
+
+  if (FEValuesGeometryCache<dim, spacedim>::is_supported(this->get_mapping(),
+                                                         this->get_fe()))
+    {
+      geometry_cache = &cache;
+      geometry_cache_configuration =
+        cache.register_configuration(this->get_mapping(),
+                                     this->get_fe(),
+                                     quadrature,
+                                     this->update_flags);
+    }
+  else
+    geometry_cache = nullptr;
+}
+
+
+
 template <int dim, int spacedim>
 void
 FEValues<dim, spacedim>::do_reinit()
 {
+  // if the present cell is a translation of the previous one, the mapping
+  // and the finite element only need to update the few quantities that
+  // change and there is nothing to gain from the cache. otherwise, see
+  // whether some FEValues object attached to the same cache has already
+  // visited a cell of the same translation class
+  Point<spacedim> origin;
+  const bool      use_geometry_cache =
+    (geometry_cache != nullptr &&
+     this->cell_similarity != CellSimilarity::translation);
+  if (use_geometry_cache)
+    {
+      if (geometry_cache_table == nullptr ||
+          geometry_cache->get_generation() != geometry_cache_generation)
+        {
+          geometry_cache_generation = geometry_cache->get_generation();
+          geometry_cache_table      = geometry_cache->get_table();
+        }
+
+      FEValuesGeometryCache<dim, spacedim>::compute_key(
+        this->get_mapping(),
+        *this->present_cell,
+        geometry_cache_configuration,
+        geometry_cache_key,
+        origin);
+
+      const auto entry =
+        geometry_cache->find(*geometry_cache_table, geometry_cache_key);
+      if (entry != nullptr)
+        {
+          // read everything but the quadrature points directly from the
+          // stored data, and move the quadrature points to the present cell
+          this->present_mapping_output = &entry->mapping_output;
+          this->present_fe_output      = &entry->finite_element_output;
+          if (this->update_flags & update_quadrature_points)
+            {
+              const Tensor<1, spacedim> shift = origin - entry->origin;
+              for (unsigned int q = 0; q < this->n_quadrature_points; ++q)
+                this->mapping_output.quadrature_points[q] =
+                  entry->mapping_output.quadrature_points[q] + shift;
+            }
+
+          // the internal data of the mapping and the finite element as well
+          // as the output arrays of this object still refer to the cell that
+          // was last computed, so the next cell must not be treated as a
+          // translation of the present one
+          this->cell_similarity = CellSimilarity::invalid_next_cell;
+          return;
+        }
+    }
+
+  this->present_mapping_output = &this->mapping_output;
+  this->present_fe_output      = &this->finite_element_output;
+
   // first call the mapping and let it generate the data
   // specific to the mapping. also let it inspect the
   // cell similarity flag and, if necessary, update
@@ -4690,6 +5080,13 @@ FEValues<dim, spacedim>::do_reinit()
                                 this->mapping_output,
                                 *this->fe_data,
                                 this->finite_element_output);
+
+  if (use_geometry_cache)
+    geometry_cache->insert(*geometry_cache_table,
+                           geometry_cache_key,
+                           origin,
+                           this->mapping_output,
+                           this->finite_element_output);
 }
 
 
@@ -4732,7 +5129,7 @@ FEFaceValuesBase<dim, spacedim>::get_boundary_forms() const
   Assert(this->update_flags & update_boundary_forms,
          (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
            "update_boundary_forms")));
-  return this->mapping_output.boundary_forms;
+  return this->present_mapping_output->boundary_forms;
 }
 
 
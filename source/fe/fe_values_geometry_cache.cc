@@ -0,0 +1,347 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_dgp.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values_geometry_cache.h>
+#include <deal.II/fe/mapping_cartesian.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/tria_iterator.h>
+
+#include <cmath>
+#include <functional>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+FEValuesGeometryCache<dim, spacedim>::Table::Table(
+  const unsigned int max_n_entries)
+  : entries(max_n_entries)
+  , n_entries(0)
+  , n_slots(1)
+{
+  while (n_slots < 2 * max_n_entries + 1)
+    n_slots *= 2;
+  slots.reset(new std::atomic<unsigned int>[n_slots]);
+  for (unsigned int i = 0; i < n_slots; ++i)
+    slots[i].store(0, std::memory_order_relaxed);
+}
+
+
+
+template <int dim, int spacedim>
+FEValuesGeometryCache<dim, spacedim>::FEValuesGeometryCache(
+  const unsigned int max_n_entries)
+  : max_n_entries(max_n_entries)
+  , table(std::make_shared<Table>(max_n_entries))
+  , generation(0)
+  , hit_counter(0)
+{}
+
+
+
+template <int dim, int spacedim>
+bool
+FEValuesGeometryCache<dim, spacedim>::is_supported(
+  const Mapping<dim, spacedim> &      mapping,
+  const FiniteElement<dim, spacedim> &fe)
+{
+  // only accept elements whose shape functions are defined on the reference
+  // cell and are mapped in the same way on every cell, so that they do not
+  // differ between cells that are translations of each other. this excludes,
+  // for example, FE_DGPNonparametric and FE_Enriched, whose shape functions
+  // are given in real space, and elements using Piola transformations, which
+  // depend on the orientation of the cell
+  const std::function<bool(const FiniteElement<dim, spacedim> &)>
+    is_reference_cell_element =
+      [&](const FiniteElement<dim, spacedim> &element) {
+        if (dynamic_cast<const FE_Q<dim, spacedim> *>(&element) != nullptr ||
+            dynamic_cast<const FE_DGQ<dim, spacedim> *>(&element) != nullptr ||
+            dynamic_cast<const FE_DGP<dim, spacedim> *>(&element) != nullptr)
+          return true;
+        if (dynamic_cast<const FESystem<dim, spacedim> *>(&element) != nullptr)
+          {
+            for (unsigned int b = 0; b < element.n_base_elements(); ++b)
+              if (!is_reference_cell_element(element.base_element(b)))
+                return false;
+            return true;
+          }
+        return false;
+      };
+  if (!is_reference_cell_element(fe))
+    return false;
+
+  if (dynamic_cast<const MappingCartesian<dim, spacedim> *>(&mapping) !=
+      nullptr)
+    return true;
+
+  // a MappingQGeneric of degree one is entirely described by the vertices
+  // returned by get_vertices(), no matter which manifold is attached to the
+  // cell
+  const MappingQGeneric<dim, spacedim> *mapping_q =
+    dynamic_cast<const MappingQGeneric<dim, spacedim> *>(&mapping);
+  return (mapping_q != nullptr && mapping_q->get_degree() == 1);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesGeometryCache<dim, spacedim>::clear()
+{
+  // FEValues objects still holding the old table keep it alive until they
+  // notice the new generation
+  Threads::Mutex::ScopedLock lock(mutex);
+  table = std::make_shared<Table>(max_n_entries);
+  generation.fetch_add(1, std::memory_order_release);
+  hit_counter.store(0, std::memory_order_relaxed);
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+FEValuesGeometryCache<dim, spacedim>::n_entries() const
+{
+  Threads::Mutex::ScopedLock lock(mutex);
+  return table->n_entries.load(std::memory_order_relaxed);
+}
+
+
+
+template <int dim, int spacedim>
+unsigned long long int
+FEValuesGeometryCache<dim, spacedim>::n_hits() const
+{
+  return hit_counter.load(std::memory_order_relaxed);
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+FEValuesGeometryCache<dim, spacedim>::memory_consumption() const
+{
+  Threads::Mutex::ScopedLock lock(mutex);
+  std::size_t                memory = sizeof(*this);
+  for (const auto &configuration : configurations)
+    memory += sizeof(Configuration) +
+              MemoryConsumption::memory_consumption(configuration->fe_name) +
+              configuration->quadrature.memory_consumption();
+  memory += sizeof(Table) +
+            table->entries.size() * sizeof(std::unique_ptr<const Entry>) +
+            table->n_slots * sizeof(std::atomic<unsigned int>);
+  const unsigned int n = table->n_entries.load(std::memory_order_relaxed);
+  for (unsigned int i = 0; i < n; ++i)
+    memory += sizeof(Entry) +
+              MemoryConsumption::memory_consumption(
+                table->entries[i]->key.second) +
+              table->entries[i]->mapping_output.memory_consumption() +
+              table->entries[i]->finite_element_output.memory_consumption();
+  return memory;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+FEValuesGeometryCache<dim, spacedim>::register_configuration(
+  const Mapping<dim, spacedim> &      mapping,
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim> &             quadrature,
+  const UpdateFlags                   update_flags)
+{
+  // is_supported() only admits mappings that are fully described by their
+  // type and degree
+  const std::type_index mapping_type(typeid(mapping));
+  const MappingQGeneric<dim, spacedim> *mapping_q =
+    dynamic_cast<const MappingQGeneric<dim, spacedim> *>(&mapping);
+  const unsigned int mapping_degree =
+    (mapping_q != nullptr) ? mapping_q->get_degree() : 1;
+  const std::string fe_name = fe.get_name();
+
+  Threads::Mutex::ScopedLock lock(mutex);
+  for (unsigned int i = 0; i < configurations.size(); ++i)
+    if (configurations[i]->mapping_type == mapping_type &&
+        configurations[i]->mapping_degree == mapping_degree &&
+        configurations[i]->fe_name == fe_name &&
+        configurations[i]->update_flags == update_flags &&
+        configurations[i]->quadrature == quadrature)
+      return i;
+
+  configurations.emplace_back(new Configuration{
+    mapping_type, mapping_degree, fe_name, quadrature, update_flags});
+  return configurations.size() - 1;
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesGeometryCache<dim, spacedim>::compute_key(
+  const Mapping<dim, spacedim> &                              mapping,
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const unsigned int                                          configuration,
+  Key &                                                       key,
+  Point<spacedim> &                                           origin)
+{
+  const std::array<Point<spacedim>, GeometryInfo<dim>::vertices_per_cell>
+    vertices = mapping.get_vertices(cell);
+  origin     = vertices[0];
+
+  key.first = configuration;
+  key.second.resize(1 +
+                    (GeometryInfo<dim>::vertices_per_cell - 1) * spacedim);
+
+  double max_difference = 0;
+  for (unsigned int v = 1; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      max_difference =
+        std::max(max_difference, std::abs(vertices[v][d] - origin[d]));
+
+  // round the vertex differences to integer multiples of a power of two
+  // that is about 2^-36 times the size of the cell. translated cells get the
+  // same key up to cases where the round-off in the differences crosses a
+  // rounding boundary, which only leads to a miss
+  int exponent = 0;
+  std::frexp(max_difference, &exponent);
+  key.second[0]       = exponent;
+  const double factor = std::ldexp(1., 36 - exponent);
+  for (unsigned int v = 1, c = 1; v < GeometryInfo<dim>::vertices_per_cell;
+       ++v)
+    for (unsigned int d = 0; d < spacedim; ++d, ++c)
+      key.second[c] = std::round((vertices[v][d] - origin[d]) * factor);
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+FEValuesGeometryCache<dim, spacedim>::hash(const Key &key)
+{
+  // the entries of the key are integers of at most 37 bits stored as
+  // doubles, so they can be converted exactly
+  std::size_t value = key.first;
+  for (const double entry : key.second)
+    value = value * 1000003 ^ static_cast<std::size_t>(
+                                static_cast<long long int>(entry));
+  return value ^ (value >> 29);
+}
+
+
+
+template <int dim, int spacedim>
+std::shared_ptr<
+  const typename FEValuesGeometryCache<dim, spacedim>::Table>
+FEValuesGeometryCache<dim, spacedim>::get_table() const
+{
+  Threads::Mutex::ScopedLock lock(mutex);
+  return table;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+FEValuesGeometryCache<dim, spacedim>::get_generation() const
+{
+  return generation.load(std::memory_order_acquire);
+}
+
+
+
+template <int dim, int spacedim>
+const typename FEValuesGeometryCache<dim, spacedim>::Entry *
+FEValuesGeometryCache<dim, spacedim>::find(const Table &table,
+                                           const Key &  key) const
+{
+  for (unsigned int slot = hash(key) & (table.n_slots - 1);;
+       slot = (slot + 1) & (table.n_slots - 1))
+    {
+      const unsigned int index =
+        table.slots[slot].load(std::memory_order_acquire);
+      if (index == 0)
+        return nullptr;
+      const Entry *entry = table.entries[index - 1].get();
+      if (entry->key == key)
+        {
+          hit_counter.fetch_add(1, std::memory_order_relaxed);
+          return entry;
+        }
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesGeometryCache<dim, spacedim>::insert(
+  const Table &         snapshot,
+  const Key &           key,
+  const Point<spacedim> origin,
+  const internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+    &mapping_output,
+  const internal::FEValuesImplementation::
+    FiniteElementRelatedData<dim, spacedim> &finite_element_output)
+{
+  // do not copy the data if the table of the caller is already full, as is
+  // common on unstructured meshes
+  if (snapshot.n_entries.load(std::memory_order_relaxed) >= max_n_entries)
+    return;
+
+  // copy the data outside the lock. if another thread inserts the same key
+  // in the meantime, its entry is kept and ours is discarded
+  std::unique_ptr<Entry> entry(new Entry);
+  entry->key                   = key;
+  entry->origin                = origin;
+  entry->mapping_output        = mapping_output;
+  entry->finite_element_output = finite_element_output;
+
+  Threads::Mutex::ScopedLock lock(mutex);
+  // the table may have been replaced by clear() in the meantime, in which
+  // case the entry goes into the new one. only the thread holding the lock
+  // modifies the table, and readers only look at an entry after they have
+  // seen its index in a slot
+  Table &            writable_table = *this->table;
+  const unsigned int n_entries =
+    writable_table.n_entries.load(std::memory_order_relaxed);
+  if (n_entries >= max_n_entries)
+    return;
+
+  unsigned int slot = hash(key) & (writable_table.n_slots - 1);
+  while (const unsigned int index =
+           writable_table.slots[slot].load(std::memory_order_relaxed))
+    {
+      if (writable_table.entries[index - 1]->key == key)
+        return;
+      slot = (slot + 1) & (writable_table.n_slots - 1);
+    }
+
+  writable_table.entries[n_entries] = std::move(entry);
+  writable_table.n_entries.store(n_entries + 1, std::memory_order_relaxed);
+  writable_table.slots[slot].store(n_entries + 1, std::memory_order_release);
+}
+
+
+#include "fe_values_geometry_cache.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,272 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/mapping_q_cache.h>
+
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+template <int dim, int spacedim>
+MappingQCache<dim, spacedim>::MappingQCache(
+  const unsigned int polynomial_degree)
+  : MappingQGeneric<dim, spacedim>(polynomial_degree)
+  , triangulation(nullptr)
+{}
+
+
+
+template <int dim, int spacedim>
+MappingQCache<dim, spacedim>::MappingQCache(
+  const MappingQCache<dim, spacedim> &mapping)
+  : MappingQGeneric<dim, spacedim>(mapping)
+  , support_point_cache(mapping.support_point_cache)
+  , triangulation(mapping.triangulation)
+{
+  connect_to_triangulation();
+}
+
+
+
+template <int dim, int spacedim>
+MappingQCache<dim, spacedim>::~MappingQCache()
+{
+  // disconnect so that the triangulation does not call into a destroyed
+  // object
+  clear_signal.disconnect();
+}
+
+
+
+template <int dim, int spacedim>
+std::unique_ptr<Mapping<dim, spacedim>>
+MappingQCache<dim, spacedim>::clone() const
+{
+  return std_cxx14::make_unique<MappingQCache<dim, spacedim>>(*this);
+}
+
+
+
+template <int dim, int spacedim>
+bool
+MappingQCache<dim, spacedim>::preserves_vertex_locations() const
+{
+  return false;
+}
+
+
+
+template <int dim, int spacedim>
+std::array<Point<spacedim>, GeometryInfo<dim>::vertices_per_cell>
+MappingQCache<dim, spacedim>::get_vertices(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  AssertThrow(support_point_cache.get() != nullptr, ExcNotInitialized());
+  if (!cell->active())
+    return MappingQGeneric<dim, spacedim>::get_vertices(cell);
+
+  // the vertices are the first support points of a cell
+  const ArrayView<const Point<spacedim>> support_points =
+    get_support_points(cell);
+  std::array<Point<spacedim>, GeometryInfo<dim>::vertices_per_cell> vertices;
+  std::copy_n(support_points.begin(),
+              GeometryInfo<dim>::vertices_per_cell,
+              vertices.begin());
+  return vertices;
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::initialize(
+  const Triangulation<dim, spacedim> &  triangulation,
+  const MappingQGeneric<dim, spacedim> &mapping)
+{
+  AssertDimension(this->get_degree(), mapping.get_degree());
+
+  invalidate();
+
+  // collect the active cells and assign them consecutive ranges in the
+  // cache. all cells have the same number of support points
+  const unsigned int n_points =
+    Utilities::fixed_power<dim>(this->get_degree() + 1);
+  auto cache = std::make_shared<SupportPointCache>();
+  std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+    cells;
+  cells.reserve(triangulation.n_active_cells());
+  cache->cell_offsets.resize(triangulation.n_levels());
+  for (unsigned int level = 0; level < triangulation.n_levels(); ++level)
+    cache->cell_offsets[level].resize(triangulation.n_raw_cells(level),
+                                      numbers::invalid_unsigned_int);
+  for (const auto &cell : triangulation.active_cell_iterators())
+    {
+      cache->cell_offsets[cell->level()][cell->index()] =
+        cells.size() * n_points;
+      cells.push_back(cell);
+    }
+
+  // compute the support points in parallel. the manifolds need to be
+  // thread-safe anyway because MappingQGeneric is used from several threads
+  // in assembly loops
+  cache->support_points.resize(cells.size() * n_points);
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(cells.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int c = begin; c < end; ++c)
+        {
+          const std::vector<Point<spacedim>> points =
+            mapping.compute_mapping_support_points(cells[c]);
+          AssertDimension(points.size(), n_points);
+          std::copy(points.begin(),
+                    points.end(),
+                    cache->support_points.begin() + c * n_points);
+        }
+    },
+    16);
+
+  support_point_cache = std::move(cache);
+  this->triangulation = &triangulation;
+  connect_to_triangulation();
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::invalidate()
+{
+  clear_signal.disconnect();
+  support_point_cache.reset();
+  triangulation = nullptr;
+}
+
+
+
+template <int dim, int spacedim>
+bool
+MappingQCache<dim, spacedim>::is_initialized() const
+{
+  return support_point_cache.get() != nullptr;
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+MappingQCache<dim, spacedim>::memory_consumption() const
+{
+  if (support_point_cache.get() != nullptr)
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(
+             support_point_cache->cell_offsets) +
+           MemoryConsumption::memory_consumption(
+             support_point_cache->support_points);
+  else
+    return sizeof(*this);
+}
+
+
+
+template <int dim, int spacedim>
+ArrayView<const Point<spacedim>>
+MappingQCache<dim, spacedim>::get_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  AssertThrow(support_point_cache.get() != nullptr, ExcNotInitialized());
+  Assert(&cell->get_triangulation() == triangulation,
+         ExcMessage("The cell does not belong to the triangulation the "
+                    "cache of MappingQCache has been computed for."));
+  Assert(cell->active(),
+         ExcMessage("Only the support points of active cells are cached."));
+  AssertIndexRange(cell->level(), support_point_cache->cell_offsets.size());
+  AssertIndexRange(cell->index(),
+                   support_point_cache->cell_offsets[cell->level()].size());
+
+  const unsigned int offset =
+    support_point_cache->cell_offsets[cell->level()][cell->index()];
+  Assert(offset != numbers::invalid_unsigned_int, ExcInternalError());
+
+  return ArrayView<const Point<spacedim>>(
+    support_point_cache->support_points.data() + offset,
+    Utilities::fixed_power<dim>(this->get_degree() + 1));
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<Point<spacedim>>
+MappingQCache<dim, spacedim>::compute_mapping_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  AssertThrow(support_point_cache.get() != nullptr, ExcNotInitialized());
+  if (cell->active())
+    {
+      const ArrayView<const Point<spacedim>> cached_points =
+        get_support_points(cell);
+      return std::vector<Point<spacedim>>(cached_points.begin(),
+                                          cached_points.end());
+    }
+  else
+    return MappingQGeneric<dim, spacedim>::compute_mapping_support_points(
+      cell);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::fill_mapping_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  std::vector<Point<spacedim>> &                              points) const
+{
+  AssertThrow(support_point_cache.get() != nullptr, ExcNotInitialized());
+  if (cell->active())
+    {
+      const ArrayView<const Point<spacedim>> cached_points =
+        get_support_points(cell);
+      points.assign(cached_points.begin(), cached_points.end());
+    }
+  else
+    points =
+      MappingQGeneric<dim, spacedim>::compute_mapping_support_points(cell);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::connect_to_triangulation()
+{
+  if (triangulation != nullptr)
+    clear_signal =
+      triangulation->signals.any_change.connect([&]() { invalidate(); });
+}
+
+
+
+// explicit instantiations
+#include "mapping_q_cache.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -2789,7 +2789,7 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
   // object attached to the cell and all of its bounding faces/edges,
   // etc. to reliably test that the "cell" we are on is, therefore,
   // not easily done
-  data.mapping_support_points = this->compute_mapping_support_points(cell);
+  this->fill_mapping_support_points(cell, data.mapping_support_points);
   data.cell_of_current_support_points = cell;
 
   // if the order of the mapping is greater than 1, then do not reuse any cell
@@ -3267,7 +3267,7 @@ MappingQGeneric<dim, spacedim>::fill_fe_face_values(
        &data.cell_of_current_support_points->get_triangulation()) ||
       (cell != data.cell_of_current_support_points))
     {
-      data.mapping_support_points = this->compute_mapping_support_points(cell);
+      this->fill_mapping_support_points(cell, data.mapping_support_points);
       data.cell_of_current_support_points = cell;
     }
 
@@ -3313,7 +3313,7 @@ MappingQGeneric<dim, spacedim>::fill_fe_subface_values(
        &data.cell_of_current_support_points->get_triangulation()) ||
       (cell != data.cell_of_current_support_points))
     {
-      data.mapping_support_points = this->compute_mapping_support_points(cell);
+      this->fill_mapping_support_points(cell, data.mapping_support_points);
       data.cell_of_current_support_points = cell;
     }
 
@@ -4042,6 +4042,17 @@ MappingQGeneric<dim, spacedim>::add_quad_support_points(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::fill_mapping_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  std::vector<Point<spacedim>> &                              points) const
+{
+  points = this->compute_mapping_support_points(cell);
+}
+
+
+
 template <int dim, int spacedim>
 std::vector<Point<spacedim>>
 MappingQGeneric<dim, spacedim>::compute_mapping_support_points(
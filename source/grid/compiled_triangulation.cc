@@ -0,0 +1,201 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/grid/compiled_triangulation.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria_accessor.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+const unsigned int CompiledTriangulation<dim, spacedim>::boundary_neighbor;
+
+template <int dim, int spacedim>
+const unsigned int CompiledTriangulation<dim, spacedim>::refined_neighbor;
+
+
+
+template <int dim, int spacedim>
+CompiledTriangulation<dim, spacedim>::CompiledTriangulation(
+  const Triangulation<dim, spacedim> &triangulation)
+  : triangulation(&triangulation, typeid(*this).name())
+{
+  tria_listeners.push_back(
+    triangulation.signals.create.connect([&]() { this->rebuild(); }));
+  tria_listeners.push_back(triangulation.signals.post_refinement.connect(
+    [&]() { this->rebuild(); }));
+  tria_listeners.push_back(
+    triangulation.signals.mesh_movement.connect([&]() { this->rebuild(); }));
+  tria_listeners.push_back(
+    triangulation.signals.clear.connect([&]() { this->clear(); }));
+
+  rebuild();
+}
+
+
+
+template <int dim, int spacedim>
+CompiledTriangulation<dim, spacedim>::~CompiledTriangulation()
+{
+  for (auto &connection : tria_listeners)
+    if (connection.connected())
+      connection.disconnect();
+  tria_listeners.clear();
+}
+
+
+
+template <int dim, int spacedim>
+void
+CompiledTriangulation<dim, spacedim>::clear()
+{
+  cell_level_index.clear();
+  active_to_compiled_index.clear();
+  vertex_index_data.clear();
+  face_index_data.clear();
+  neighbor_index_data.clear();
+  material_ids.clear();
+  face_boundary_ids.clear();
+  cell_centers.clear();
+}
+
+
+
+template <int dim, int spacedim>
+void
+CompiledTriangulation<dim, spacedim>::rebuild()
+{
+  clear();
+
+  const unsigned int n_cells = triangulation->n_active_cells();
+  if (n_cells == 0)
+    return;
+
+  // Collect the cells in the order of their active cell index, which is
+  // the only serial part of the algorithm. All further steps are done on
+  // subranges of cells in parallel.
+  std::vector<std::pair<unsigned int, unsigned int>> active_level_index;
+  active_level_index.reserve(n_cells);
+  for (const auto &cell : triangulation->active_cell_iterators())
+    active_level_index.emplace_back(cell->level(), cell->index());
+  Assert(active_level_index.size() == n_cells, ExcInternalError());
+
+  const unsigned int grain_size = 256;
+
+  std::vector<Point<spacedim>> centers(n_cells);
+  parallel::apply_to_subranges(
+    0U,
+    n_cells,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        centers[i] =
+          typename Triangulation<dim, spacedim>::active_cell_iterator(
+            &*triangulation,
+            active_level_index[i].first,
+            active_level_index[i].second)
+            ->center();
+    },
+    grain_size);
+
+  // Sort the cells along the Hilbert curve through their centers. The
+  // curve is laid through the bounding box of the vertices rather than the
+  // centers, such that it visits the cells of a uniformly refined cube in
+  // the same order as the recursive subdivision of the cube.
+  const std::vector<unsigned int> order =
+    GridTools::hilbert_order(centers,
+                             GridTools::compute_bounding_box(*triangulation));
+
+  cell_level_index.resize(n_cells);
+  cell_centers.resize(n_cells);
+  active_to_compiled_index.resize(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    {
+      cell_level_index[c]                = active_level_index[order[c]];
+      cell_centers[c]                    = centers[order[c]];
+      active_to_compiled_index[order[c]] = c;
+    }
+
+  // Now fill the connectivity arrays. Each cell only writes into its own
+  // slots, so the subranges are independent.
+  const unsigned int vertices_per_cell = GeometryInfo<dim>::vertices_per_cell;
+  const unsigned int faces_per_cell    = GeometryInfo<dim>::faces_per_cell;
+  vertex_index_data.resize(n_cells * vertices_per_cell);
+  face_index_data.resize(n_cells * faces_per_cell);
+  neighbor_index_data.resize(n_cells * faces_per_cell);
+  face_boundary_ids.resize(n_cells * faces_per_cell);
+  material_ids.resize(n_cells);
+
+  parallel::apply_to_subranges(
+    0U,
+    n_cells,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int c = begin; c < end; ++c)
+        {
+          const typename Triangulation<dim, spacedim>::active_cell_iterator
+            cell = get_cell_iterator(c);
+          for (unsigned int v = 0; v < vertices_per_cell; ++v)
+            vertex_index_data[c * vertices_per_cell + v] =
+              cell->vertex_index(v);
+          material_ids[c] = cell->material_id();
+          for (unsigned int f = 0; f < faces_per_cell; ++f)
+            {
+              const unsigned int slot = c * faces_per_cell + f;
+              face_index_data[slot]   = cell->face_index(f);
+              if (cell->at_boundary(f))
+                {
+                  neighbor_index_data[slot] = boundary_neighbor;
+                  face_boundary_ids[slot]   = cell->face(f)->boundary_id();
+                }
+              else
+                {
+                  const auto neighbor = cell->neighbor(f);
+                  neighbor_index_data[slot] =
+                    neighbor->has_children() ?
+                      refined_neighbor :
+                      active_to_compiled_index[neighbor->active_cell_index()];
+                  face_boundary_ids[slot] = numbers::internal_face_boundary_id;
+                }
+            }
+        }
+    },
+    grain_size);
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+CompiledTriangulation<dim, spacedim>::memory_consumption() const
+{
+  return (MemoryConsumption::memory_consumption(cell_level_index) +
+          MemoryConsumption::memory_consumption(active_to_compiled_index) +
+          MemoryConsumption::memory_consumption(vertex_index_data) +
+          MemoryConsumption::memory_consumption(face_index_data) +
+          MemoryConsumption::memory_consumption(neighbor_index_data) +
+          MemoryConsumption::memory_consumption(material_ids) +
+          MemoryConsumption::memory_consumption(face_boundary_ids) +
+          MemoryConsumption::memory_consumption(cell_centers) +
+          sizeof(*this));
+}
+
+
+// explicit instantiations
+#include "compiled_triangulation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -15,6 +15,8 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 
@@ -26,10 +28,25 @@
 #include <boost/io/ios_state.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <iterator>
+#include <locale>
 #include <map>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef __has_include
+#  if __has_include(<charconv>)
+#    include <charconv>
+#  endif
+#endif
 
 
 #ifdef DEAL_II_WITH_NETCDF
@@ -97,6 +114,9 @@ template <int dim, int spacedim>
 GridIn<dim, spacedim>::GridIn()
   : tria(nullptr, typeid(*this).name())
   , default_format(ucd)
+  , has_trusted_fingerprint(false)
+  , trusted_fingerprint(0)
+  , last_fingerprint(0)
 {}
 
 
@@ -111,315 +131,922 @@ GridIn<dim, spacedim>::attach_triangulation(Triangulation<dim, spacedim> &t)
 
 template <int dim, int spacedim>
 void
-GridIn<dim, spacedim>::read_vtk(std::istream &in)
+GridIn<dim, spacedim>::set_trusted_fingerprint(const std::uint64_t fingerprint)
 {
-  Assert((dim == 2) || (dim == 3), ExcNotImplemented());
-  std::string line;
+  has_trusted_fingerprint = true;
+  trusted_fingerprint     = fingerprint;
+}
 
-  // verify that the first, third and fourth lines match
-  // expectations. the second line of the file may essentially be
-  // anything the author of the file chose to identify what's in
-  // there, so we just ensure that we can read it
+
+
+template <int dim, int spacedim>
+std::uint64_t
+GridIn<dim, spacedim>::get_fingerprint() const
+{
+  return last_fingerprint;
+}
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::reorder_cells(std::vector<CellData<dim>> &cells)
+{
+  if (has_trusted_fingerprint)
+    GridReordering<dim, spacedim>::reorder_cells(cells,
+                                                 false,
+                                                 trusted_fingerprint);
+  else
+    GridReordering<dim, spacedim>::reorder_cells(cells);
+  last_fingerprint = GridReordering<dim, spacedim>::compute_fingerprint(cells);
+}
+
+
+
+namespace
+{
+  // Helper functions for the readers of large text and binary files
+  // below. The readers read the file piece by piece into a buffer and parse
+  // it with the following small set of functions that work directly on the
+  // characters of the buffer. Compared to reading token by token with
+  // std::istream::operator>>, this avoids the overhead of locales, sentries
+  // and virtual function calls for every single number, which dominates the
+  // time spent on reading large meshes.
+  namespace Parser
   {
-    std::string text[4];
-    text[0] = "# vtk DataFile Version 3.0";
-    text[1] = "****";
-    text[2] = "ASCII";
-    text[3] = "DATASET UNSTRUCTURED_GRID";
+    // Sections of the file that are larger than this number of characters
+    // are split into chunks that are parsed in parallel. The file is read
+    // from the stream in pieces of at least this size.
+    const std::size_t parallel_chunk_size = 1 << 20;
 
-    for (unsigned int i = 0; i < 4; ++i)
-      {
-        getline(in, line);
-        if (i != 1)
-          AssertThrow(
-            line.compare(text[i]) == 0,
-            ExcMessage(
-              std::string(
-                "While reading VTK file, failed to find a header line with text <") +
-              text[i] + ">"));
-      }
-  }
+    // The maximal number of records of a section that are held in memory
+    // and parsed at once
+    const std::size_t records_per_window = 1 << 16;
 
-  ///////////////////Declaring storage and mappings//////////////////
+    inline void
+    skip_whitespace(const char *&p, const char *end)
+    {
+      while (p != end && std::isspace(static_cast<unsigned char>(*p)))
+        ++p;
+    }
 
-  std::vector<Point<spacedim>> vertices;
-  std::vector<CellData<dim>>   cells;
-  SubCellData                  subcelldata;
 
-  std::string keyword;
 
-  in >> keyword;
+    inline std::string
+    text_at(const char *p, const char *end)
+    {
+      return std::string(p, std::min<std::size_t>(end - p, 40));
+    }
 
-  //////////////////Processing the POINTS section///////////////
 
-  if (keyword == "POINTS")
+
+    inline std::string
+    read_token(const char *&p, const char *end)
     {
-      unsigned int n_vertices;
-      in >> n_vertices;
+      skip_whitespace(p, end);
+      const char *begin = p;
+      while (p != end && !std::isspace(static_cast<unsigned char>(*p)))
+        ++p;
+      return std::string(begin, p);
+    }
 
-      in.ignore(256,
-                '\n'); // ignoring the number beside the total no. of points.
 
-      for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-        {
-          // VTK format always specifies vertex coordinates with 3 components
-          Point<3> x;
-          in >> x(0) >> x(1) >> x(2);
 
-          vertices.emplace_back();
-          for (unsigned int d = 0; d < spacedim; ++d)
-            vertices.back()(d) = x(d);
+    inline long long int
+    read_integer(const char *&p, const char *end)
+    {
+      skip_whitespace(p, end);
+      const char *begin    = p;
+      bool        negative = false;
+      if (p != end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+      AssertThrow(p != end && *p >= '0' && *p <= '9',
+                  ExcMessage("While reading a mesh file, expected an integer "
+                             "but found <" +
+                             text_at(p, end) + ">."));
+      constexpr long long int max_value =
+        std::numeric_limits<long long int>::max();
+      long long int value = 0;
+      while (p != end && *p >= '0' && *p <= '9')
+        {
+          const int digit = *p++ - '0';
+          AssertThrow(value < max_value / 10 ||
+                        (value == max_value / 10 && digit <= max_value % 10),
+                      ExcMessage("While reading a mesh file, found the "
+                                 "integer <" +
+                                 text_at(begin, end) +
+                                 ">, which is too large to be represented."));
+          value = 10 * value + digit;
         }
+      return negative ? -value : value;
     }
 
-  else
-    AssertThrow(false,
-                ExcMessage(
-                  "While reading VTK file, failed to find POINTS section"));
 
 
-  //////////////////ignoring space between points and cells
-  /// sections////////////////////
-  std::string checkline;
-  int         no;
-  in.ignore(256,
-            '\n'); // this move pointer to the next line ignoring unwanted no.
-  no = in.tellg();
-  getline(in, checkline);
-  if (checkline.compare("") != 0)
+    // Move past the next token without converting it
+    inline void
+    skip_token(const char *&p, const char *end)
     {
-      in.seekg(no);
+      skip_whitespace(p, end);
+      AssertThrow(p != end,
+                  ExcMessage("Unexpected end of file while reading a "
+                             "mesh file."));
+      while (p != end && !std::isspace(static_cast<unsigned char>(*p)))
+        ++p;
     }
 
-  in >> keyword;
 
-  ///////////////////Processing the CELLS section that contains cells(cells) and
-  /// bound_quads(subcelldata)///////////////////////
 
-  if (keyword == "CELLS")
+    inline std::size_t
+    read_unsigned(const char *&p, const char *end)
     {
-      unsigned int n_geometric_objects;
-      in >> n_geometric_objects;
-      in.ignore(256, '\n');
+      const char *         begin = p;
+      const long long int  value = read_integer(p, end);
+      AssertThrow(value >= 0,
+                  ExcMessage("While reading a mesh file, expected a "
+                             "non-negative integer but found <" +
+                             text_at(begin, end) + ">."));
+      return static_cast<std::size_t>(value);
+    }
 
-      if (dim == 3)
-        {
-          for (unsigned int count = 0; count < n_geometric_objects; count++)
-            {
-              unsigned int type;
-              in >> type;
 
-              if (type == 8)
-                {
-                  // we assume that the file contains first all cells,
-                  // and only then any faces or lines
-                  AssertThrow(subcelldata.boundary_quads.size() == 0 &&
-                                subcelldata.boundary_lines.size() == 0,
-                              ExcNotImplemented());
 
-                  cells.emplace_back();
+    // Read a floating point number. Mesh files always use a period as
+    // decimal separator, so the number is converted independently of the
+    // locale selected by the user, which std::strtod would respect.
+    inline double
+    read_double(const char *&p, const char *end)
+    {
+      skip_whitespace(p, end);
+      const char *begin = p;
+      while (p != end && !std::isspace(static_cast<unsigned char>(*p)))
+        ++p;
+
+      double value   = 0;
+      bool   success = false;
+#ifdef __cpp_lib_to_chars
+      // std::from_chars does not accept a leading plus sign
+      const char *number_begin =
+        (p - begin > 1 && *begin == '+') ? begin + 1 : begin;
+      const auto result = std::from_chars(number_begin, p, value);
+      success           = (result.ec == std::errc() && result.ptr == p);
+#else
+      std::istringstream stream(std::string(begin, p));
+      stream.imbue(std::locale::classic());
+      stream >> value;
+      success = !stream.fail() && stream.eof();
+#endif
+      AssertThrow(begin != p && success,
+                  ExcMessage("While reading a mesh file, expected a "
+                             "floating point number but found <" +
+                             text_at(begin, end) + ">."));
+      return value;
+    }
 
-                  for (unsigned int j = 0; j < type; j++) // loop to feed data
-                    in >> cells.back().vertices[j];
 
-                  cells.back().material_id = 0;
-                }
 
-              else if (type == 4)
-                {
-                  subcelldata.boundary_quads.emplace_back();
+    template <typename T>
+    inline T
+    read_binary(const char *&p, const char *end)
+    {
+      AssertThrow(static_cast<std::size_t>(end - p) >= sizeof(T),
+                  ExcMessage("Unexpected end of binary data while reading "
+                             "a mesh file."));
+      T value;
+      std::memcpy(&value, p, sizeof(T));
+      p += sizeof(T);
+      return value;
+    }
 
-                  for (unsigned int j = 0; j < type;
-                       j++) // loop to feed the data to the boundary
-                    in >> subcelldata.boundary_quads.back().vertices[j];
 
-                  subcelldata.boundary_quads.back().material_id = 0;
-                }
 
-              else
-                AssertThrow(
-                  false,
-                  ExcMessage(
-                    "While reading VTK file, unknown file type encountered"));
-            }
-        }
+    // Move to the beginning of the next line
+    inline void
+    next_line(const char *&p, const char *end)
+    {
+      p = std::find(p, end, '\n');
+      if (p != end)
+        ++p;
+    }
 
-      else if (dim == 2)
-        {
-          for (unsigned int count = 0; count < n_geometric_objects; count++)
-            {
-              unsigned int type;
-              in >> type;
 
-              if (type == 4)
-                {
-                  // we assume that the file contains first all cells,
-                  // and only then any faces
-                  AssertThrow(subcelldata.boundary_lines.size() == 0,
-                              ExcNotImplemented());
 
-                  cells.emplace_back();
+    // The part of the file that has been read from the stream but not been
+    // parsed yet. Characters are read from the stream only when they are
+    // requested, and everything before the position up to which the file
+    // has been parsed is discarded at that time, so that only a small part
+    // of the file is held in memory at once. Since the buffer may be moved
+    // when reading, all functions that read take the current position by
+    // reference and update it.
+    class InputBuffer
+    {
+    public:
+      explicit InputBuffer(std::istream &in)
+        : in(in)
+        , buffer_position(static_cast<std::streamoff>(in.tellg()))
+        , stream_exhausted(false)
+        , n_complete(0)
+      {}
+
+      const char *
+      begin() const
+      {
+        return buffer.data();
+      }
 
-                  for (unsigned int j = 0; j < type; j++) // loop to feed data
-                    in >> cells.back().vertices[j];
+      // The end of the characters read so far
+      const char *
+      end() const
+      {
+        return buffer.data() + buffer.size();
+      }
 
-                  cells.back().material_id = 0;
-                }
+      // The end of the last complete line read so far, or end() if the
+      // whole stream has been read. All tokens before this position have
+      // been read completely.
+      const char *
+      lines_end() const
+      {
+        return buffer.data() + n_complete;
+      }
 
-              else if (type == 2)
-                {
-                  // If this is encountered, the pointer comes out of the loop
-                  // and starts processing boundaries.
-                  subcelldata.boundary_lines.emplace_back();
+      // Return whether the whole stream has been read
+      bool
+      exhausted() const
+      {
+        return stream_exhausted;
+      }
 
-                  for (unsigned int j = 0; j < type;
-                       j++) // loop to feed the data to the boundary
-                    {
-                      in >> subcelldata.boundary_lines.back().vertices[j];
-                    }
+      // Discard the characters before @p p, and read from the stream until
+      // at least @p n_characters characters are available after @p p or
+      // the stream is exhausted
+      void
+      read(const char *&p, const std::size_t n_characters)
+      {
+        const std::size_t n_available = end() - p;
+        if (n_available >= n_characters || stream_exhausted)
+          return;
 
-                  subcelldata.boundary_lines.back().material_id = 0;
-                }
+        const std::size_t n_discarded = p - buffer.data();
+        buffer.erase(0, n_discarded);
+        if (buffer_position >= 0)
+          buffer_position += n_discarded;
+
+        const std::size_t n_requested =
+          std::max(n_characters - n_available, parallel_chunk_size);
+        buffer.resize(n_available + n_requested);
+        in.read(&buffer[n_available], n_requested);
+        const std::size_t n_read = in.gcount();
+        buffer.resize(n_available + n_read);
+        if (n_read < n_requested)
+          stream_exhausted = true;
+        p = buffer.data();
+
+        n_complete = buffer.size();
+        if (!stream_exhausted)
+          while (n_complete > 0 && buffer[n_complete - 1] != '\n')
+            --n_complete;
+      }
 
-              else
-                AssertThrow(
-                  false,
-                  ExcMessage(
-                    "While reading VTK file, unknown file type encountered"));
-            }
-        }
-      else
-        AssertThrow(false,
-                    ExcMessage(
-                      "While reading VTK file, failed to find CELLS section"));
+      // As above, but read until at least @p n_lines complete lines are
+      // available after @p p. Return the end of the last of these lines,
+      // or end() if the stream ends before.
+      const char *
+      read_lines(const char *&p, const std::size_t n_lines)
+      {
+        std::size_t n_found  = 0;
+        const char *line_end = p;
+        while (true)
+          {
+            for (const char *q = line_end; n_found < n_lines; ++n_found)
+              {
+                q = std::find(q, end(), '\n');
+                if (q == end())
+                  break;
+                line_end = ++q;
+              }
+            if (n_found == n_lines)
+              return line_end;
+            if (stream_exhausted)
+              return end();
+
+            const std::size_t n_scanned = line_end - p;
+            read(p, 2 * (end() - p) + 1);
+            line_end = p + n_scanned;
+          }
+      }
 
-      /////////////////////Processing the CELL_TYPES
-      /// section////////////////////////
+      // Skip whitespace, reading from the stream as long as there is
+      // nothing else
+      void
+      skip_whitespace(const char *&p)
+      {
+        Parser::skip_whitespace(p, end());
+        while (p == end() && !stream_exhausted)
+          {
+            read(p, 1);
+            Parser::skip_whitespace(p, end());
+          }
+      }
 
-      in >> keyword;
+      // Move @p p past the next @p n_characters characters without keeping
+      // them
+      void
+      skip(const char *&p, std::size_t n_characters)
+      {
+        while (static_cast<std::size_t>(end() - p) < n_characters)
+          {
+            AssertThrow(!stream_exhausted,
+                        ExcMessage("Unexpected end of binary data while "
+                                   "reading a mesh file."));
+            n_characters -= end() - p;
+            p = end();
+            read(p, std::min(n_characters, parallel_chunk_size));
+          }
+        p += n_characters;
+      }
 
-      if (keyword ==
-          "CELL_TYPES") // Entering the cell_types section and ignoring data.
-        {
-          in.ignore(256, '\n');
+      // Return the position of @p p in the stream, or -1 if the stream
+      // does not support positioning. The position is counted in
+      // characters read from the stream, which is the position used by
+      // the stream for all streams that do not translate line endings.
+      std::streamoff
+      stream_position(const char *p) const
+      {
+        return (buffer_position >= 0) ?
+                 buffer_position + (p - buffer.data()) :
+                 std::streamoff(-1);
+      }
 
-          while (!in.fail() && !in.eof())
-            {
-              in >> keyword;
-              if (keyword != "12" && keyword != "9")
-                {
-                  break;
-                }
-            }
-        }
+      // Continue reading the stream at the given position, as returned by
+      // stream_position()
+      void
+      seek(const std::streamoff position, const char *&p)
+      {
+        in.clear();
+        in.seekg(position);
+        AssertThrow(in, ExcIO());
+        buffer.clear();
+        buffer_position  = position;
+        stream_exhausted = false;
+        n_complete       = 0;
+        p                = buffer.data();
+      }
 
-      ////////////////////////Processing the CELL_DATA
-      /// section/////////////////////////////
+    private:
+      std::istream & in;
+      std::string    buffer;
+      std::streamoff buffer_position;
+      bool           stream_exhausted;
+      std::size_t    n_complete;
+    };
 
-      if (keyword == "CELL_DATA")
-        {
-          unsigned int n_ids;
-          in >> n_ids;
 
-          AssertThrow(
-            n_ids == cells.size() +
-                       (dim == 3 ?
-                          subcelldata.boundary_quads.size() :
-                          (dim == 2 ? subcelldata.boundary_lines.size() : 0)),
-            ExcMessage(
-              "The VTK reader found a CELL_DATA statement "
-              "that lists a total of " +
-              Utilities::int_to_string(n_ids) +
-              " cell data objects, but this needs to "
-              "equal the number of cells (which is " +
-              Utilities::int_to_string(cells.size()) +
-              ") plus the number of quads (" +
-              Utilities::int_to_string(subcelldata.boundary_quads.size()) +
-              " in 3d or the number of lines (" +
-              Utilities::int_to_string(subcelldata.boundary_lines.size()) +
-              ") in 2d."));
 
+    // Versions of the functions above that read the next token from an
+    // InputBuffer, making sure that it has been read from the stream
+    // completely
+    inline std::string
+    read_token(InputBuffer &input, const char *&p)
+    {
+      input.skip_whitespace(p);
+      return read_token(p, input.read_lines(p, 1));
+    }
 
-          std::string linenew;
-          std::string textnew[2];
-          textnew[0] = "SCALARS MaterialID double";
-          textnew[1] = "LOOKUP_TABLE default";
 
-          in.ignore(256, '\n');
 
-          for (unsigned int i = 0; i < 2; i++)
-            {
-              getline(in, linenew);
-              if (i == 0)
-                if (linenew.size() > textnew[0].size())
-                  linenew.resize(textnew[0].size());
+    inline std::size_t
+    read_unsigned(InputBuffer &input, const char *&p)
+    {
+      input.skip_whitespace(p);
+      return read_unsigned(p, input.read_lines(p, 1));
+    }
 
-              AssertThrow(linenew.compare(textnew[i]) == 0,
-                          ExcMessage(
-                            std::string(
-                              "While reading VTK file, failed to find <") +
-                            textnew[i] + "> section"));
-            }
 
-          // read material ids first for all cells, then for all
-          // faces. the assumption that cells come before all faces
-          // has been verified above via an assertion, so the order
-          // used in the following blocks makes sense
-          for (unsigned int i = 0; i < cells.size(); i++)
+
+    inline double
+    read_double(InputBuffer &input, const char *&p)
+    {
+      input.skip_whitespace(p);
+      return read_double(p, input.read_lines(p, 1));
+    }
+
+
+
+    // Return the rest of the current line without the line break, and move
+    // @p p to the beginning of the next line
+    inline std::string
+    read_line(InputBuffer &input, const char *&p)
+    {
+      const char *line_end = input.read_lines(p, 1);
+      std::string line(p, line_end);
+      p = line_end;
+      if (!line.empty() && line.back() == '\n')
+        line.pop_back();
+      return line;
+    }
+
+
+
+    // Move @p p to the given marker without parsing anything before it, or
+    // throw an exception if the marker does not exist
+    inline void
+    find_marker(InputBuffer &input, const char *&p, const std::string &marker)
+    {
+      while (true)
+        {
+          const char *position =
+            std::search(p, input.end(), marker.begin(), marker.end());
+          if (position != input.end())
             {
-              double id;
-              in >> id;
-              cells[i].material_id = id;
+              p = position;
+              return;
             }
+          AssertThrow(!input.exhausted(),
+                      ExcMessage("While reading a mesh file, could not find "
+                                 "the end marker <" +
+                                 marker + ">."));
+          // keep the characters that may be the beginning of the marker
+          p = std::max(p, input.end() - (marker.size() - 1));
+          input.read(p, (input.end() - p) + 1);
+        }
+    }
 
-          if (dim == 3)
+
+
+    // Parse the @p n_records records in the range [begin, end), which
+    // consists of @p n_records lines, with the function @p parse_record,
+    // which reads one record, moves the position passed to it past the
+    // record, and appends zero or one entries to the given vector. All
+    // entries are appended to @p result.
+    //
+    // If the range is larger than parallel_chunk_size characters, it is
+    // split at line breaks into chunks that are parsed in parallel. This
+    // assumes that each record is given on a line of its own, as in all
+    // files written by gmsh, but does not rely on it: the first chunk
+    // starts at a record, and each chunk that is parsed up to its end
+    // without error ends at a record, so that the next chunk starts at one,
+    // too. If all chunks succeed and the chunks contain @p n_records records
+    // in total, the result is therefore the same as the one of reading the
+    // records one after the other, and true is returned. Otherwise, e.g.,
+    // if the records extend over several lines, the entries of the chunks
+    // are discarded and false is returned.
+    template <typename T, typename Function>
+    bool
+    parse_lines(const char *      begin,
+                const char *      end,
+                const std::size_t n_records,
+                const Function &  parse_record,
+                std::vector<T> &  result)
+    {
+      const std::size_t n_characters = end - begin;
+      const std::size_t n_chunks     = std::max<std::size_t>(
+        std::min<std::size_t>(n_characters / parallel_chunk_size,
+                              8 * MultithreadInfo::n_threads()),
+        1);
+
+      std::vector<const char *> chunk_begin(n_chunks + 1, end);
+      chunk_begin[0] = begin;
+      for (std::size_t c = 1; c < n_chunks; ++c)
+        {
+          const char *p = std::max(chunk_begin[c - 1],
+                                   begin + c * (n_characters / n_chunks));
+          next_line(p, end);
+          chunk_begin[c] = p;
+        }
+
+      std::vector<std::vector<T>> chunk_results(n_chunks);
+      std::vector<std::size_t>    chunk_n_records(n_chunks, 0);
+      // not std::vector<bool>, which cannot be written concurrently
+      std::vector<char> chunk_failed(n_chunks, 0);
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(n_chunks),
+        [&](const unsigned int first, const unsigned int last) {
+          for (unsigned int c = first; c < last; ++c)
+            try
+              {
+                const char *q         = chunk_begin[c];
+                const char *chunk_end = chunk_begin[c + 1];
+                for (skip_whitespace(q, chunk_end); q != chunk_end;
+                     skip_whitespace(q, chunk_end))
+                  {
+                    parse_record(q, chunk_end, chunk_results[c]);
+                    ++chunk_n_records[c];
+                  }
+              }
+            catch (const ExceptionBase &)
+              {
+                chunk_failed[c] = 1;
+              }
+        },
+        1);
+
+      if (std::find(chunk_failed.begin(), chunk_failed.end(), 1) !=
+            chunk_failed.end() ||
+          std::accumulate(chunk_n_records.begin(),
+                          chunk_n_records.end(),
+                          std::size_t(0)) != n_records)
+        return false;
+
+      std::size_t n_entries = result.size();
+      for (const auto &chunk : chunk_results)
+        n_entries += chunk.size();
+      result.reserve(n_entries);
+      for (const auto &chunk : chunk_results)
+        result.insert(result.end(), chunk.begin(), chunk.end());
+      return true;
+    }
+
+
+
+    // Parse a single record at @p p with the function @p parse_record as
+    // described above. The record is given all complete lines read so far,
+    // and more of the stream is read if it extends beyond them.
+    template <typename T, typename Function>
+    void
+    parse_single_record(InputBuffer &    input,
+                        const char *&    p,
+                        const Function & parse_record,
+                        std::vector<T> & result)
+    {
+      const std::size_t n_entries = result.size();
+      if (input.lines_end() <= p)
+        input.read_lines(p, 1);
+      while (true)
+        {
+          const char *q = p;
+          try
             {
-              for (unsigned int i = 0; i < subcelldata.boundary_quads.size();
-                   i++)
-                {
-                  double id;
-                  in >> id;
-                  subcelldata.boundary_quads[i].material_id = id;
-                }
+              parse_record(q, input.lines_end(), result);
+              p = q;
+              return;
             }
-          else if (dim == 2)
+          catch (const ExceptionBase &)
             {
-              for (unsigned int i = 0; i < subcelldata.boundary_lines.size();
-                   i++)
-                {
-                  double id;
-                  in >> id;
-                  subcelldata.boundary_lines[i].material_id = id;
-                }
+              // if all of the file has been available, the record is
+              // malformed
+              if (input.exhausted())
+                throw;
+              result.resize(n_entries);
+              input.read(p, 2 * (input.end() - p) + 1);
             }
         }
+    }
 
-      Assert(subcelldata.check_consistency(dim), ExcInternalError());
 
-      GridTools::delete_unused_vertices(vertices, cells, subcelldata);
 
-      if (dim == spacedim)
-        GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(
-          vertices, cells);
+    // Parse @p n_records records starting at @p p with the function
+    // @p parse_record as described above, and move @p p past them. The
+    // records are read from the stream and parsed in windows of
+    // records_per_window lines. Each window is parsed in parallel by
+    // parse_lines(). If that fails, the records are read one after the
+    // other from then on, which handles records that do not come one per
+    // line and also reports the errors in malformed files.
+    template <typename T, typename Function>
+    void
+    parse_records(InputBuffer &     input,
+                  const char *&     p,
+                  const std::size_t n_records,
+                  const Function &  parse_record,
+                  std::vector<T> &  result)
+    {
+      std::size_t first = 0;
+      for (; first < n_records; first += records_per_window)
+        {
+          const std::size_t n_window =
+            std::min(records_per_window, n_records - first);
+          input.skip_whitespace(p);
+          const char *window_end = input.read_lines(p, n_window);
+          if (parse_lines(p, window_end, n_window, parse_record, result))
+            p = window_end;
+          else
+            break;
+        }
 
-      GridReordering<dim, spacedim>::reorder_cells(cells);
-      tria->create_triangulation_compatibility(vertices, cells, subcelldata);
+      for (; first < n_records; ++first)
+        parse_single_record(input, p, parse_record, result);
+    }
 
-      return;
+
+
+    // Process @p n_entries entries of binary data of @p entry_size bytes
+    // each. The entries are read from the stream in chunks of
+    // records_per_window entries, and @p process is called for each chunk
+    // with the position of its data and the range of entries it contains.
+    template <typename Function>
+    void
+    read_binary_entries(InputBuffer &     input,
+                        const char *&     p,
+                        const std::size_t entry_size,
+                        const std::size_t n_entries,
+                        const Function &  process)
+    {
+      for (std::size_t first = 0; first < n_entries;
+           first += records_per_window)
+        {
+          const std::size_t last =
+            std::min(first + records_per_window, n_entries);
+          const std::size_t n_bytes = (last - first) * entry_size;
+          input.read(p, n_bytes);
+          AssertThrow(static_cast<std::size_t>(input.end() - p) >= n_bytes,
+                      ExcMessage("Unexpected end of binary data while "
+                                 "reading a mesh file."));
+          process(p, first, last);
+          p += n_bytes;
+        }
     }
-  else
-    AssertThrow(false,
-                ExcMessage(
-                  "While reading VTK file, failed to find CELLS section"));
-}
+  } // namespace Parser
+} // namespace
 
 
 
 template <int dim, int spacedim>
 void
-GridIn<dim, spacedim>::read_unv(std::istream &in)
+GridIn<dim, spacedim>::read_vtk(std::istream &in)
 {
-  Assert(tria != nullptr, ExcNoTriangulationSelected());
+  Assert((dim == 2) || (dim == 3), ExcNotImplemented());
+  AssertThrow(in, ExcIO());
+
+  // the file is read piece by piece and parsed with the helper functions
+  // of the Parser namespace above, in parallel where the file lists one
+  // point or cell per line
+  Parser::InputBuffer input(in);
+  const char *        p = input.begin();
+
+  // verify that the first, third and fourth lines match
+  // expectations. the second line of the file may essentially be
+  // anything the author of the file chose to identify what's in
+  // there, so we just ensure that we can read it
+  {
+    std::string text[4];
+    text[0] = "# vtk DataFile Version 3.0";
+    text[1] = "****";
+    text[2] = "ASCII";
+    text[3] = "DATASET UNSTRUCTURED_GRID";
+
+    for (unsigned int i = 0; i < 4; ++i)
+      {
+        const std::string line = Parser::read_line(input, p);
+        if (i != 1)
+          AssertThrow(
+            line.compare(text[i]) == 0,
+            ExcMessage(
+              std::string(
+                "While reading VTK file, failed to find a header line with text <") +
+              text[i] + ">"));
+      }
+  }
+
+  ///////////////////Declaring storage and mappings//////////////////
+
+  std::vector<Point<spacedim>> vertices;
+  std::vector<CellData<dim>>   cells;
+  SubCellData                  subcelldata;
+
+  std::string keyword = Parser::read_token(input, p);
+
+  //////////////////Processing the POINTS section///////////////
+
+  if (keyword == "POINTS")
+    {
+      const std::size_t n_vertices = Parser::read_unsigned(input, p);
+      // ignore the data type given after the number of points
+      Parser::read_line(input, p);
+
+      vertices.reserve(n_vertices);
+      Parser::parse_records(
+        input,
+        p,
+        n_vertices,
+        [](const char *&                  q,
+           const char *                   end,
+           std::vector<Point<spacedim>> & result) {
+          // VTK format always specifies vertex coordinates with 3
+          // components
+          Point<spacedim> x;
+          for (unsigned int d = 0; d < 3; ++d)
+            {
+              const double value = Parser::read_double(q, end);
+              if (d < spacedim)
+                x[d] = value;
+            }
+          result.push_back(x);
+        },
+        vertices);
+    }
+
+  else
+    AssertThrow(false,
+                ExcMessage(
+                  "While reading VTK file, failed to find POINTS section"));
+
+  keyword = Parser::read_token(input, p);
+
+  ///////////////////Processing the CELLS section that contains cells(cells) and
+  /// bound_quads(subcelldata)///////////////////////
+
+  if (keyword == "CELLS")
+    {
+      const std::size_t n_geometric_objects = Parser::read_unsigned(input, p);
+      // ignore the total number of entries of the section
+      Parser::read_line(input, p);
+
+      // each object is given by the number of its vertices, which tells
+      // whether it is a cell or a face, followed by their indices
+      const unsigned int vertices_per_cell =
+        GeometryInfo<dim>::vertices_per_cell;
+      const unsigned int vertices_per_face =
+        GeometryInfo<dim>::vertices_per_face;
+      using Object = std::array<unsigned int, vertices_per_cell + 1>;
+
+      const auto parse_object = [](const char *&         q,
+                                   const char *          end,
+                                   std::vector<Object> & result) {
+        Object            object;
+        const std::size_t type = Parser::read_unsigned(q, end);
+        AssertThrow(type == vertices_per_cell || type == vertices_per_face,
+                    ExcMessage(
+                      "While reading VTK file, unknown file type encountered"));
+        object[0] = type;
+        for (unsigned int j = 0; j < type; ++j)
+          object[1 + j] = Parser::read_unsigned(q, end);
+        result.push_back(object);
+      };
+
+      cells.reserve(n_geometric_objects);
+      std::vector<Object> objects;
+      for (std::size_t first = 0; first < n_geometric_objects;
+           first += Parser::records_per_window)
+        {
+          objects.clear();
+          Parser::parse_records(input,
+                                p,
+                                std::min(Parser::records_per_window,
+                                         n_geometric_objects - first),
+                                parse_object,
+                                objects);
+
+          for (const Object &object : objects)
+            if (object[0] == vertices_per_cell)
+              {
+                // we assume that the file contains first all cells,
+                // and only then any faces or lines
+                AssertThrow(subcelldata.boundary_quads.size() == 0 &&
+                              subcelldata.boundary_lines.size() == 0,
+                            ExcNotImplemented());
+
+                cells.emplace_back();
+                for (unsigned int j = 0; j < vertices_per_cell; ++j)
+                  cells.back().vertices[j] = object[1 + j];
+                cells.back().material_id = 0;
+              }
+            else if (dim == 3)
+              {
+                subcelldata.boundary_quads.emplace_back();
+                for (unsigned int j = 0; j < 4; ++j)
+                  subcelldata.boundary_quads.back().vertices[j] =
+                    object[1 + j];
+                subcelldata.boundary_quads.back().material_id = 0;
+              }
+            else
+              {
+                subcelldata.boundary_lines.emplace_back();
+                for (unsigned int j = 0; j < 2; ++j)
+                  subcelldata.boundary_lines.back().vertices[j] =
+                    object[1 + j];
+                subcelldata.boundary_lines.back().material_id = 0;
+              }
+        }
+
+      /////////////////////Processing the CELL_TYPES
+      /// section////////////////////////
+
+      keyword = Parser::read_token(input, p);
+
+      if (keyword ==
+          "CELL_TYPES") // Entering the cell_types section and ignoring data.
+        {
+          const std::size_t n_types = Parser::read_unsigned(input, p);
+          std::vector<char> no_entries;
+          Parser::parse_records(
+            input,
+            p,
+            n_types,
+            [](const char *&q, const char *end, std::vector<char> &) {
+              Parser::skip_token(q, end);
+            },
+            no_entries);
+          keyword = Parser::read_token(input, p);
+        }
+
+      ////////////////////////Processing the CELL_DATA
+      /// section/////////////////////////////
+
+      if (keyword == "CELL_DATA")
+        {
+          const std::size_t n_ids = Parser::read_unsigned(input, p);
+
+          AssertThrow(
+            n_ids == cells.size() +
+                       (dim == 3 ?
+                          subcelldata.boundary_quads.size() :
+                          (dim == 2 ? subcelldata.boundary_lines.size() : 0)),
+            ExcMessage(
+              "The VTK reader found a CELL_DATA statement "
+              "that lists a total of " +
+              Utilities::to_string(n_ids) +
+              " cell data objects, but this needs to "
+              "equal the number of cells (which is " +
+              Utilities::int_to_string(cells.size()) +
+              ") plus the number of quads (" +
+              Utilities::int_to_string(subcelldata.boundary_quads.size()) +
+              " in 3d or the number of lines (" +
+              Utilities::int_to_string(subcelldata.boundary_lines.size()) +
+              ") in 2d."));
+
+
+          std::string textnew[2];
+          textnew[0] = "SCALARS MaterialID double";
+          textnew[1] = "LOOKUP_TABLE default";
+
+          Parser::read_line(input, p);
+
+          for (unsigned int i = 0; i < 2; i++)
+            {
+              std::string linenew = Parser::read_line(input, p);
+              if (i == 0)
+                if (linenew.size() > textnew[0].size())
+                  linenew.resize(textnew[0].size());
+
+              AssertThrow(linenew.compare(textnew[i]) == 0,
+                          ExcMessage(
+                            std::string(
+                              "While reading VTK file, failed to find <") +
+                            textnew[i] + "> section"));
+            }
+
+          std::vector<double> ids;
+          ids.reserve(n_ids);
+          Parser::parse_records(input,
+                                p,
+                                n_ids,
+                                [](const char *&         q,
+                                   const char *          end,
+                                   std::vector<double> & result) {
+                                  result.push_back(Parser::read_double(q, end));
+                                },
+                                ids);
+
+          // the material ids are given first for all cells, then for all
+          // faces. the assumption that cells come before all faces
+          // has been verified above via an assertion, so the order
+          // used in the following blocks makes sense
+          for (unsigned int i = 0; i < cells.size(); i++)
+            cells[i].material_id = ids[i];
+
+          if (dim == 3)
+            {
+              for (unsigned int i = 0; i < subcelldata.boundary_quads.size();
+                   i++)
+                subcelldata.boundary_quads[i].material_id =
+                  ids[cells.size() + i];
+            }
+          else if (dim == 2)
+            {
+              for (unsigned int i = 0; i < subcelldata.boundary_lines.size();
+                   i++)
+                subcelldata.boundary_lines[i].material_id =
+                  ids[cells.size() + i];
+            }
+        }
+
+      Assert(subcelldata.check_consistency(dim), ExcInternalError());
+
+      GridTools::delete_unused_vertices(vertices, cells, subcelldata);
+
+      if (dim == spacedim)
+        GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(
+          vertices, cells);
+
+      reorder_cells(cells);
+      tria->create_triangulation_compatibility(vertices, cells, subcelldata);
+
+      return;
+    }
+  else
+    AssertThrow(false,
+                ExcMessage(
+                  "While reading VTK file, failed to find CELLS section"));
+}
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_unv(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
   Assert((dim == 2) || (dim == 3), ExcNotImplemented());
 
   AssertThrow(in, ExcIO());
@@ -657,7 +1284,7 @@ GridIn<dim, spacedim>::read_unv(std::istream &in)
     GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                      cells);
 
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
 
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
@@ -910,7 +1537,7 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
   if (dim == spacedim)
     GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                      cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
 
@@ -1158,7 +1785,7 @@ GridIn<dim, spacedim>::read_dbmesh(std::istream &in)
   // ...and cells
   GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                    cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
 
@@ -1238,7 +1865,7 @@ GridIn<2>::read_xda(std::istream &in)
   GridTools::delete_unused_vertices(vertices, cells, subcelldata);
   // ... and cells
   GridReordering<2>::invert_all_cells_of_negative_grid(vertices, cells);
-  GridReordering<2>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
 
@@ -1316,385 +1943,1094 @@ GridIn<3>::read_xda(std::istream &in)
   GridTools::delete_unused_vertices(vertices, cells, subcelldata);
   // ... and cells
   GridReordering<3>::invert_all_cells_of_negative_grid(vertices, cells);
-  GridReordering<3>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
 
 
 
-template <int dim, int spacedim>
-void
-GridIn<dim, spacedim>::read_msh(std::istream &in)
+namespace
 {
-  Assert(tria != nullptr, ExcNoTriangulationSelected());
-  AssertThrow(in, ExcIO());
+  // Helper functions for the gmsh reader below
+  namespace Gmsh
+  {
+    using namespace Parser;
 
-  unsigned int n_vertices;
-  unsigned int n_cells;
-  unsigned int dummy;
-  std::string  line;
+    // A node as read from the file
+    struct Node
+    {
+      std::size_t tag;
+      Point<3>    coordinates;
+    };
 
-  in >> line;
 
-  // first determine file format
-  unsigned int gmsh_file_format = 0;
-  if (line == "$NOD")
-    gmsh_file_format = 1;
-  else if (line == "$MeshFormat")
-    gmsh_file_format = 2;
-  else
-    AssertThrow(false, ExcInvalidGMSHInput(line));
-
-  // if file format is 2 or greater
-  // then we also have to read the
-  // rest of the header
-  if (gmsh_file_format == 2)
-    {
-      double       version;
-      unsigned int file_type, data_size;
-
-      in >> version >> file_type >> data_size;
-
-      Assert((version >= 2.0) && (version <= 2.2), ExcNotImplemented());
-      Assert(file_type == 0, ExcNotImplemented());
-      Assert(data_size == sizeof(double), ExcNotImplemented());
-
-      // read the end of the header
-      // and the first line of the
-      // nodes description to synch
-      // ourselves with the format 1
-      // handling above
-      in >> line;
-      AssertThrow(line == "$EndMeshFormat", ExcInvalidGMSHInput(line));
-
-      in >> line;
-      // if the next block is of kind
-      // $PhysicalNames, ignore it
-      if (line == "$PhysicalNames")
-        {
-          do
-            {
-              in >> line;
-            }
-          while (line != "$EndPhysicalNames");
-          in >> line;
-        }
 
-      // but the next thing should,
-      // in any case, be the list of
-      // nodes:
-      AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
-    }
+    // An element as read from the file: its number, type, the tag that is
+    // interpreted as material or boundary id, and the tags of its nodes
+    struct Element
+    {
+      std::size_t                 number;
+      unsigned int                type;
+      long long int               tag;
+      unsigned int                n_nodes;
+      std::array<std::size_t, 8>  nodes;
+    };
 
-  // now read the nodes list
-  in >> n_vertices;
-  std::vector<Point<spacedim>> vertices(n_vertices);
-  // set up mapping between numbering
-  // in msh-file (nod) and in the
-  // vertices vector
-  std::map<int, int> vertex_indices;
 
-  for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
+
+    // Return the number of nodes of the element types understood by the
+    // reader, and throw an exception for all others
+    template <int dim, int spacedim>
+    unsigned int
+    n_nodes_of_element_type(const unsigned int type)
     {
-      int    vertex_number;
-      double x[3];
+      using GridInType = GridIn<dim, spacedim>;
 
-      // read vertex
-      in >> vertex_number >> x[0] >> x[1] >> x[2];
+      /*       `ELM-TYPE'
+               defines the geometrical type of the N-th element:
+               `1'
+               Line (2 nodes, 1 edge).
 
-      for (unsigned int d = 0; d < spacedim; ++d)
-        vertices[vertex](d) = x[d];
-      // store mapping
-      vertex_indices[vertex_number] = vertex;
-    }
+               `3'
+               Quadrangle (4 nodes, 4 edges).
 
-  // Assert we reached the end of the block
-  in >> line;
-  static const std::string end_nodes_marker[] = {"$ENDNOD", "$EndNodes"};
-  AssertThrow(line == end_nodes_marker[gmsh_file_format - 1],
-              ExcInvalidGMSHInput(line));
+               `5'
+               Hexahedron (8 nodes, 12 edges, 6 faces).
 
-  // Now read in next bit
-  in >> line;
-  static const std::string begin_elements_marker[] = {"$ELM", "$Elements"};
-  AssertThrow(line == begin_elements_marker[gmsh_file_format - 1],
-              ExcInvalidGMSHInput(line));
+               `15'
+               Point (1 node).
+      */
+      switch (type)
+        {
+          case 1:
+            return 2;
+          case 3:
+            return 4;
+          case 5:
+            return 8;
+          case 15:
+            return 1;
+          default:
+            // cannot read this, so throw an exception. treat triangles
+            // and tetrahedra specially since this deserves a more explicit
+            // error message
+            AssertThrow(type != 2,
+                        ExcMessage("Found triangles while reading a file "
+                                   "in gmsh format. deal.II does not "
+                                   "support triangles"));
+            AssertThrow(type != 4 && type != 11,
+                        ExcMessage("Found tetrahedra while reading a file "
+                                   "in gmsh format. deal.II does not "
+                                   "support tetrahedra"));
+            AssertThrow(false,
+                        typename GridInType::ExcGmshUnsupportedGeometry(type));
+        }
+      return 0;
+    }
 
-  in >> n_cells;
 
-  // set up array of cells and subcells (faces). In 1d, there is currently no
-  // standard way in deal.II to pass boundary indicators attached to individual
-  // vertices, so do this by hand via the boundary_ids_1d array
-  std::vector<CellData<dim>>                 cells;
-  SubCellData                                subcelldata;
-  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
 
-  for (unsigned int cell = 0; cell < n_cells; ++cell)
+    // Collects the elements that are needed for the cells with indices
+    // within a given range, counting the cells in the order they are read:
+    // these cells themselves, and all elements that may carry boundary
+    // information. All other elements are dropped as soon as they have
+    // been read.
+    template <int dim, int spacedim>
+    struct ElementFilter
     {
-      // note that since in the input
-      // file we found the number of
-      // cells at the top, there
-      // should still be input here,
-      // so check this:
-      AssertThrow(in, ExcIO());
+      explicit ElementFilter(
+        const std::pair<unsigned int, unsigned int> &cell_range)
+        : cell_range(cell_range)
+        , n_cells(0)
+      {}
+
+      static bool
+      is_cell(const Element &element)
+      {
+        return ((element.type == 1) && (dim == 1)) ||
+               ((element.type == 3) && (dim == 2)) ||
+               ((element.type == 5) && (dim == 3));
+      }
 
-      unsigned int cell_type;
-      unsigned int material_id;
-      unsigned int nod_num;
+      void
+      add(const std::vector<Element> &new_elements)
+      {
+        using GridInType = GridIn<dim, spacedim>;
 
-      /*
-        For file format version 1, the format of each cell is as follows:
-          elm-number elm-type reg-phys reg-elem number-of-nodes node-number-list
+        for (const Element &element : new_elements)
+          if (is_cell(element))
+            {
+              AssertThrow(element.n_nodes ==
+                            GeometryInfo<dim>::vertices_per_cell,
+                          ExcMessage("Number of nodes does not coincide with "
+                                     "the number required for this object"));
+              if (n_cells >= cell_range.first && n_cells < cell_range.second)
+                elements.push_back(element);
+              ++n_cells;
+            }
+          else if (((element.type == 1) && ((dim == 2) || (dim == 3))) ||
+                   ((element.type == 3) && (dim == 3)) ||
+                   ((element.type == 15) && (dim == 1)))
+            elements.push_back(element);
+          else
+            // points are only of interest in 1d
+            AssertThrow(element.type == 15,
+                        typename GridInType::ExcGmshUnsupportedGeometry(
+                          element.type));
+      }
 
-        However, for version 2, the format reads like this:
-          elm-number elm-type number-of-tags < tag > ... node-number-list
+      const std::pair<unsigned int, unsigned int> cell_range;
+      unsigned int                                n_cells;
+      std::vector<Element>                        elements;
+    };
 
-        In the following, we will ignore the element number (we simply enumerate
-        them in the order in which we read them, and we will take reg-phys
-        (version 1) or the first tag (version 2, if any tag is given at all) as
-        material id.
-      */
 
-      unsigned int elm_number;
-      in >> elm_number // ELM-NUMBER
-        >> cell_type;  // ELM-TYPE
 
-      switch (gmsh_file_format)
-        {
-          case 1:
-            {
-              in >> material_id // REG-PHYS
-                >> dummy        // reg_elm
-                >> nod_num;
-              break;
-            }
+    // Skip the line break that separates a section header from binary data
+    inline void
+    skip_to_binary_data(InputBuffer &input, const char *&p)
+    {
+      input.read(p, 2);
+      if (p != input.end() && *p == '\r')
+        ++p;
+      if (p != input.end() && *p == '\n')
+        ++p;
+    }
 
-          case 2:
-            {
-              // read the tags; ignore all but the first one which we will
-              // interpret as the material_id (for cells) or boundary_id
-              // (for faces)
-              unsigned int n_tags;
-              in >> n_tags;
-              if (n_tags > 0)
-                in >> material_id;
-              else
-                material_id = 0;
 
-              for (unsigned int i = 1; i < n_tags; ++i)
-                in >> dummy;
 
-              nod_num = GeometryInfo<dim>::vertices_per_cell;
+    // Read a number of the file format 4.1, which is given either as text or
+    // in binary form. Sizes and tags are stored as 64 bit unsigned
+    // integers, dimensions and entity tags as 32 bit signed integers.
+    inline std::size_t
+    read_size(InputBuffer &input, const char *&p, const bool binary)
+    {
+      if (binary)
+        {
+          input.read(p, sizeof(std::uint64_t));
+          return read_binary<std::uint64_t>(p, input.end());
+        }
+      return read_unsigned(input, p);
+    }
 
-              break;
-            }
 
-          default:
-            AssertThrow(false, ExcNotImplemented());
+
+    inline long long int
+    read_int(InputBuffer &input, const char *&p, const bool binary)
+    {
+      if (binary)
+        {
+          input.read(p, sizeof(std::int32_t));
+          return read_binary<std::int32_t>(p, input.end());
         }
+      input.skip_whitespace(p);
+      return read_integer(p, input.read_lines(p, 1));
+    }
 
 
-      /*       `ELM-TYPE'
-               defines the geometrical type of the N-th element:
-               `1'
-               Line (2 nodes, 1 edge).
 
-               `3'
-               Quadrangle (4 nodes, 4 edges).
+    inline double
+    read_real(InputBuffer &input, const char *&p, const bool binary)
+    {
+      if (binary)
+        {
+          input.read(p, sizeof(double));
+          return read_binary<double>(p, input.end());
+        }
+      return read_double(input, p);
+    }
 
-               `5'
-               Hexahedron (8 nodes, 12 edges, 6 faces).
 
-               `15'
-               Point (1 node).
-      */
 
-      if (((cell_type == 1) && (dim == 1)) ||
-          ((cell_type == 3) && (dim == 2)) || ((cell_type == 5) && (dim == 3)))
-        // found a cell
-        {
-          AssertThrow(nod_num == GeometryInfo<dim>::vertices_per_cell,
-                      ExcMessage("Number of nodes does not coincide with the "
-                                 "number required for this object"));
+    // The nodes whose coordinates are needed: either all of them, or those
+    // whose tags are contained in the sorted vector @p tags
+    struct NodeFilter
+    {
+      bool                     all = true;
+      std::vector<std::size_t> tags;
 
-          // allocate and read indices
-          cells.emplace_back();
-          for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell;
-               ++i)
-            in >> cells.back().vertices[i];
+      bool
+      operator()(const std::size_t tag) const
+      {
+        return all || std::binary_search(tags.begin(), tags.end(), tag);
+      }
+    };
 
-          // to make sure that the cast won't fail
-          Assert(material_id <= std::numeric_limits<types::material_id>::max(),
-                 ExcIndexRange(material_id,
-                               0,
-                               std::numeric_limits<types::material_id>::max()));
-          // we use only material_ids in the range from 0 to
-          // numbers::invalid_material_id-1
-          Assert(material_id < numbers::invalid_material_id,
-                 ExcIndexRange(material_id, 0, numbers::invalid_material_id));
 
-          cells.back().material_id =
-            static_cast<types::material_id>(material_id);
 
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell;
-               ++i)
+    // Read the nodes section of the file formats 1 and 2, keeping only the
+    // nodes selected by @p filter
+    inline void
+    read_nodes_v1_v2(InputBuffer &       input,
+                     const char *&       p,
+                     const NodeFilter &  filter,
+                     std::vector<Node> & nodes)
+    {
+      const std::size_t n_nodes = read_size(input, p, false);
+
+      if (filter.all)
+        nodes.reserve(n_nodes);
+      parse_records(
+        input,
+        p,
+        n_nodes,
+        [&filter](const char *&       q,
+                  const char *        chunk_end,
+                  std::vector<Node> & result) {
+          const std::size_t tag = read_unsigned(q, chunk_end);
+          if (filter(tag))
             {
-              AssertThrow(vertex_indices.find(cells.back().vertices[i]) !=
-                            vertex_indices.end(),
-                          ExcInvalidVertexIndexGmsh(cell,
-                                                    elm_number,
-                                                    cells.back().vertices[i]));
-
-              // vertex with this index exists
-              cells.back().vertices[i] =
-                vertex_indices[cells.back().vertices[i]];
+              Node node;
+              node.tag = tag;
+              for (unsigned int d = 0; d < 3; ++d)
+                node.coordinates[d] = read_double(q, chunk_end);
+              result.push_back(node);
             }
-        }
-      else if ((cell_type == 1) && ((dim == 2) || (dim == 3)))
-        // boundary info
-        {
-          subcelldata.boundary_lines.emplace_back();
-          in >> subcelldata.boundary_lines.back().vertices[0] >>
-            subcelldata.boundary_lines.back().vertices[1];
+          else
+            for (unsigned int d = 0; d < 3; ++d)
+              skip_token(q, chunk_end);
+        },
+        nodes);
+    }
 
-          // to make sure that the cast won't fail
-          Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
-                 ExcIndexRange(material_id,
-                               0,
-                               std::numeric_limits<types::boundary_id>::max()));
-          // we use only boundary_ids in the range from 0 to
-          // numbers::internal_face_boundary_id-1
-          Assert(material_id < numbers::internal_face_boundary_id,
-                 ExcIndexRange(material_id,
-                               0,
-                               numbers::internal_face_boundary_id));
 
-          subcelldata.boundary_lines.back().boundary_id =
-            static_cast<types::boundary_id>(material_id);
 
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i = 0; i < 2; ++i)
-            if (vertex_indices.find(
-                  subcelldata.boundary_lines.back().vertices[i]) !=
-                vertex_indices.end())
-              // vertex with this index exists
-              subcelldata.boundary_lines.back().vertices[i] =
-                vertex_indices[subcelldata.boundary_lines.back().vertices[i]];
-            else
+    // Read the elements section of the file formats 1 and 2, and hand the
+    // elements to @p filter
+    template <int dim, int spacedim>
+    void
+    read_elements_v1_v2(InputBuffer &                    input,
+                        const char *&                    p,
+                        const unsigned int               gmsh_file_format,
+                        ElementFilter<dim, spacedim> &   filter)
+    {
+      const std::size_t n_elements = read_size(input, p, false);
+
+      const auto parse_element = [gmsh_file_format](
+                                   const char *&          q,
+                                   const char *           chunk_end,
+                                   std::vector<Element> & result) {
+        /*
+          For file format version 1, the format of each element is as
+          follows:
+            elm-number elm-type reg-phys reg-elem number-of-nodes
+            node-number-list
+
+          However, for version 2, the format reads like this:
+            elm-number elm-type number-of-tags < tag > ...
+            node-number-list
+
+          We take reg-phys (version 1) or the first tag (version 2, if
+          any tag is given at all) as material or boundary id.
+        */
+        Element element;
+        element.number = read_unsigned(q, chunk_end);
+        element.type   = static_cast<unsigned int>(read_unsigned(q, chunk_end));
+        if (gmsh_file_format == 1)
+          {
+            element.tag = read_integer(q, chunk_end);
+            read_integer(q, chunk_end); // reg-elem
+            element.n_nodes =
+              static_cast<unsigned int>(read_unsigned(q, chunk_end));
+          }
+        else
+          {
+            const std::size_t n_tags = read_unsigned(q, chunk_end);
+            element.tag              = 0;
+            for (std::size_t i = 0; i < n_tags; ++i)
               {
-                // no such vertex index
-                AssertThrow(false,
-                            ExcInvalidVertexIndex(
-                              cell,
-                              subcelldata.boundary_lines.back().vertices[i]));
-                subcelldata.boundary_lines.back().vertices[i] =
-                  numbers::invalid_unsigned_int;
-              };
+                const long long int tag = read_integer(q, chunk_end);
+                if (i == 0)
+                  element.tag = tag;
+              }
+            element.n_nodes =
+              n_nodes_of_element_type<dim, spacedim>(element.type);
+          }
+        AssertThrow(element.n_nodes <= element.nodes.size(),
+                    ExcMessage("Number of nodes does not coincide "
+                               "with the number required for this "
+                               "object"));
+        for (unsigned int i = 0; i < element.n_nodes; ++i)
+          element.nodes[i] = read_unsigned(q, chunk_end);
+        result.push_back(element);
+      };
+
+      std::vector<Element> elements;
+      for (std::size_t first = 0; first < n_elements;
+           first += records_per_window)
+        {
+          elements.clear();
+          parse_records(input,
+                        p,
+                        std::min(records_per_window, n_elements - first),
+                        parse_element,
+                        elements);
+          filter.add(elements);
         }
-      else if ((cell_type == 3) && (dim == 3))
-        // boundary info
+    }
+
+
+
+    // The physical tags of the geometric entities of a file in format 4,
+    // indexed by the dimension and the tag of the entity. Entities without
+    // physical tag are assigned zero.
+    using EntityTags = std::array<std::map<int, long long int>, 4>;
+
+
+
+    // Read the entities section of the file format 4.1
+    inline void
+    read_entities_v4(InputBuffer &input,
+                     const char *&p,
+                     const bool   binary,
+                     EntityTags & entity_tags)
+    {
+      if (binary)
+        skip_to_binary_data(input, p);
+
+      std::array<std::size_t, 4> n_entities;
+      for (unsigned int d = 0; d < 4; ++d)
+        n_entities[d] = read_size(input, p, binary);
+
+      for (unsigned int d = 0; d < 4; ++d)
+        for (std::size_t e = 0; e < n_entities[d]; ++e)
+          {
+            const int tag = static_cast<int>(read_int(input, p, binary));
+            // points are given by their coordinates, all other entities by
+            // their bounding box
+            for (unsigned int i = 0; i < (d == 0 ? 3u : 6u); ++i)
+              read_real(input, p, binary);
+            const std::size_t n_physical_tags = read_size(input, p, binary);
+            long long int     physical_tag    = 0;
+            for (std::size_t i = 0; i < n_physical_tags; ++i)
+              {
+                const long long int value = read_int(input, p, binary);
+                if (i == 0)
+                  physical_tag = value;
+              }
+            entity_tags[d][tag] = physical_tag;
+            if (d > 0)
+              {
+                const std::size_t n_bounding_entities =
+                  read_size(input, p, binary);
+                for (std::size_t i = 0; i < n_bounding_entities; ++i)
+                  read_int(input, p, binary);
+              }
+          }
+    }
+
+
+
+    // Read the nodes section of the file format 4.1, keeping only the nodes
+    // selected by @p filter
+    inline void
+    read_nodes_v4(InputBuffer &       input,
+                  const char *&       p,
+                  const bool          binary,
+                  const NodeFilter &  filter,
+                  std::vector<Node> & nodes)
+    {
+      if (binary)
+        skip_to_binary_data(input, p);
+
+      const std::size_t n_blocks = read_size(input, p, binary);
+      const std::size_t n_nodes  = read_size(input, p, binary);
+      // minimal and maximal node tag
+      for (unsigned int i = 0; i < 2; ++i)
+        read_size(input, p, binary);
+
+      if (filter.all)
+        nodes.reserve(n_nodes);
+      for (std::size_t block = 0; block < n_blocks; ++block)
         {
-          subcelldata.boundary_quads.emplace_back();
-          in >> subcelldata.boundary_quads.back().vertices[0] >>
-            subcelldata.boundary_quads.back().vertices[1] >>
-            subcelldata.boundary_quads.back().vertices[2] >>
-            subcelldata.boundary_quads.back().vertices[3];
+          const int entity_dim =
+            static_cast<int>(read_int(input, p, binary));
+          read_int(input, p, binary); // entity tag
+          const bool parametric = (read_int(input, p, binary) != 0);
+          const std::size_t n_nodes_in_block = read_size(input, p, binary);
+          // parametric coordinates of the nodes, if given, follow the
+          // cartesian ones
+          const unsigned int n_coordinates = 3 + (parametric ? entity_dim : 0);
+
+          if (binary && !filter.all && filter.tags.empty())
+            {
+              input.skip(p,
+                         n_nodes_in_block *
+                           (sizeof(std::uint64_t) +
+                            n_coordinates * sizeof(double)));
+              continue;
+            }
 
-          // to make sure that the cast won't fail
-          Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
-                 ExcIndexRange(material_id,
-                               0,
-                               std::numeric_limits<types::boundary_id>::max()));
-          // we use only boundary_ids in the range from 0 to
-          // numbers::internal_face_boundary_id-1
-          Assert(material_id < numbers::internal_face_boundary_id,
-                 ExcIndexRange(material_id,
-                               0,
-                               numbers::internal_face_boundary_id));
+          // the block consists of the tags of its nodes followed by their
+          // coordinates
+          std::vector<std::size_t> tags;
+          if (binary)
+            {
+              tags.resize(n_nodes_in_block);
+              read_binary_entries(
+                input,
+                p,
+                sizeof(std::uint64_t),
+                n_nodes_in_block,
+                [&tags](const char *      data,
+                        const std::size_t first,
+                        const std::size_t last) {
+                  for (std::size_t n = first; n < last; ++n)
+                    {
+                      std::uint64_t tag;
+                      std::memcpy(&tag,
+                                  data + (n - first) * sizeof(std::uint64_t),
+                                  sizeof(std::uint64_t));
+                      tags[n] = static_cast<std::size_t>(tag);
+                    }
+                });
+            }
+          else
+            {
+              tags.reserve(n_nodes_in_block);
+              parse_records(input,
+                            p,
+                            n_nodes_in_block,
+                            [](const char *&              q,
+                               const char *               chunk_end,
+                               std::vector<std::size_t> & result) {
+                              result.push_back(read_unsigned(q, chunk_end));
+                            },
+                            tags);
+            }
 
-          subcelldata.boundary_quads.back().boundary_id =
-            static_cast<types::boundary_id>(material_id);
+          // skip the coordinates of blocks without any of the selected
+          // nodes without converting them
+          const bool block_needed =
+            filter.all ||
+            std::any_of(tags.begin(), tags.end(), std::cref(filter));
 
-          // transform from gmsh to
-          // consecutive numbering
-          for (unsigned int i = 0; i < 4; ++i)
-            if (vertex_indices.find(
-                  subcelldata.boundary_quads.back().vertices[i]) !=
-                vertex_indices.end())
-              // vertex with this index exists
-              subcelldata.boundary_quads.back().vertices[i] =
-                vertex_indices[subcelldata.boundary_quads.back().vertices[i]];
-            else
+          if (binary)
+            {
+              const std::size_t node_size = n_coordinates * sizeof(double);
+              if (!block_needed)
+                input.skip(p, n_nodes_in_block * node_size);
+              else if (filter.all)
+                {
+                  const std::size_t first_node = nodes.size();
+                  nodes.resize(first_node + n_nodes_in_block);
+                  read_binary_entries(
+                    input,
+                    p,
+                    node_size,
+                    n_nodes_in_block,
+                    [&](const char *      data,
+                        const std::size_t first,
+                        const std::size_t last) {
+                      parallel::apply_to_subranges(
+                        first,
+                        last,
+                        [&](const std::size_t begin, const std::size_t end) {
+                          for (std::size_t n = begin; n < end; ++n)
+                            {
+                              Node &node = nodes[first_node + n];
+                              node.tag   = tags[n];
+                              std::memcpy(&node.coordinates[0],
+                                          data + (n - first) * node_size,
+                                          3 * sizeof(double));
+                            }
+                        },
+                        parallel_chunk_size / 64);
+                    });
+                }
+              else
+                read_binary_entries(input,
+                                    p,
+                                    node_size,
+                                    n_nodes_in_block,
+                                    [&](const char *      data,
+                                        const std::size_t first,
+                                        const std::size_t last) {
+                                      for (std::size_t n = first; n < last;
+                                           ++n)
+                                        if (filter(tags[n]))
+                                          {
+                                            Node node;
+                                            node.tag = tags[n];
+                                            std::memcpy(
+                                              &node.coordinates[0],
+                                              data + (n - first) * node_size,
+                                              3 * sizeof(double));
+                                            nodes.push_back(node);
+                                          }
+                                    });
+            }
+          else
+            {
+              std::vector<Point<3>> coordinates;
+              if (block_needed)
+                coordinates.reserve(n_nodes_in_block);
+              parse_records(
+                input,
+                p,
+                n_nodes_in_block,
+                [n_coordinates, block_needed](const char *&           q,
+                                              const char *            chunk_end,
+                                              std::vector<Point<3>> & result) {
+                  if (block_needed)
+                    {
+                      Point<3> x;
+                      for (unsigned int d = 0; d < n_coordinates; ++d)
+                        {
+                          const double value = read_double(q, chunk_end);
+                          if (d < 3)
+                            x[d] = value;
+                        }
+                      result.push_back(x);
+                    }
+                  else
+                    for (unsigned int d = 0; d < n_coordinates; ++d)
+                      skip_token(q, chunk_end);
+                },
+                coordinates);
+
+              if (block_needed)
+                for (std::size_t n = 0; n < n_nodes_in_block; ++n)
+                  if (filter(tags[n]))
+                    {
+                      Node node;
+                      node.tag         = tags[n];
+                      node.coordinates = coordinates[n];
+                      nodes.push_back(node);
+                    }
+            }
+        }
+    }
+
+
+
+    // Read the elements section of the file format 4.1, and hand the
+    // elements to @p filter. The tag of each element is set to the physical
+    // tag of the entity it belongs to.
+    template <int dim, int spacedim>
+    void
+    read_elements_v4(InputBuffer &                  input,
+                     const char *&                  p,
+                     const bool                     binary,
+                     const EntityTags &             entity_tags,
+                     ElementFilter<dim, spacedim> & filter)
+    {
+      if (binary)
+        skip_to_binary_data(input, p);
+
+      const std::size_t n_blocks   = read_size(input, p, binary);
+      const std::size_t n_elements = read_size(input, p, binary);
+      // minimal and maximal element tag
+      for (unsigned int i = 0; i < 2; ++i)
+        read_size(input, p, binary);
+
+      std::vector<Element> elements;
+      std::size_t          n_elements_read = 0;
+      for (std::size_t block = 0; block < n_blocks; ++block)
+        {
+          const int entity_dim =
+            static_cast<int>(read_int(input, p, binary));
+          const int entity_tag =
+            static_cast<int>(read_int(input, p, binary));
+          const unsigned int type =
+            static_cast<unsigned int>(read_int(input, p, binary));
+          const std::size_t n_elements_in_block =
+            read_size(input, p, binary);
+
+          AssertThrow(entity_dim >= 0 && entity_dim <= 3,
+                      ExcMessage("Invalid entity dimension in gmsh file."));
+          const auto entity = entity_tags[entity_dim].find(entity_tag);
+          const long long int physical_tag =
+            (entity != entity_tags[entity_dim].end()) ? entity->second : 0;
+          const unsigned int n_nodes =
+            n_nodes_of_element_type<dim, spacedim>(type);
+
+          const auto make_element = [&](const std::size_t number) {
+            Element element;
+            element.number  = number;
+            element.type    = type;
+            element.tag     = physical_tag;
+            element.n_nodes = n_nodes;
+            return element;
+          };
+
+          if (binary)
+            {
+              const std::size_t entries_per_element = 1 + n_nodes;
+              read_binary_entries(
+                input,
+                p,
+                entries_per_element * sizeof(std::uint64_t),
+                n_elements_in_block,
+                [&](const char *      data,
+                    const std::size_t first,
+                    const std::size_t last) {
+                  elements.resize(last - first);
+                  parallel::apply_to_subranges(
+                    std::size_t(0),
+                    last - first,
+                    [&](const std::size_t begin, const std::size_t end) {
+                      std::array<std::uint64_t, 9> entries;
+                      for (std::size_t e = begin; e < end; ++e)
+                        {
+                          std::memcpy(entries.data(),
+                                      data + e * entries_per_element *
+                                               sizeof(std::uint64_t),
+                                      entries_per_element *
+                                        sizeof(std::uint64_t));
+                          Element &element = elements[e];
+                          element          = make_element(entries[0]);
+                          for (unsigned int i = 0; i < n_nodes; ++i)
+                            element.nodes[i] = entries[1 + i];
+                        }
+                    },
+                    parallel_chunk_size / 64);
+                  filter.add(elements);
+                });
+            }
+          else
+            for (std::size_t first = 0; first < n_elements_in_block;
+                 first += records_per_window)
               {
-                // no such vertex index
-                Assert(false,
-                       ExcInvalidVertexIndex(
-                         cell, subcelldata.boundary_quads.back().vertices[i]));
-                subcelldata.boundary_quads.back().vertices[i] =
-                  numbers::invalid_unsigned_int;
+                elements.clear();
+                parse_records(
+                  input,
+                  p,
+                  std::min(records_per_window, n_elements_in_block - first),
+                  [&](const char *&          q,
+                      const char *           chunk_end,
+                      std::vector<Element> & result) {
+                    Element element = make_element(read_unsigned(q, chunk_end));
+                    for (unsigned int i = 0; i < n_nodes; ++i)
+                      element.nodes[i] = read_unsigned(q, chunk_end);
+                    result.push_back(element);
+                  },
+                  elements);
+                filter.add(elements);
               }
+          n_elements_read += n_elements_in_block;
         }
-      else if (cell_type == 15)
+      AssertThrow(n_elements_read == n_elements,
+                  ExcMessage("The number of elements in the gmsh file (" +
+                             Utilities::to_string(n_elements_read) +
+                             ") does not match the number given in the "
+                             "header of the elements section (" +
+                             Utilities::to_string(n_elements) + ")."));
+    }
+
+
+
+    // gmsh identifies nodes by tags that are usually, but not necessarily,
+    // numbered consecutively. This class translates them into positions in
+    // the array of vertices, using a vector indexed by the tag unless the
+    // tags are too sparse for that.
+    class NodeTagMap
+    {
+    public:
+      explicit NodeTagMap(const std::vector<Node> &nodes)
+      {
+        std::size_t max_tag = 0;
+        for (const Node &node : nodes)
+          max_tag = std::max(max_tag, node.tag);
+        if (max_tag < 2 * nodes.size() + 1024)
+          {
+            dense_indices.resize(max_tag + 1, numbers::invalid_unsigned_int);
+            for (unsigned int i = 0; i < nodes.size(); ++i)
+              dense_indices[nodes[i].tag] = i;
+          }
+        else
+          for (unsigned int i = 0; i < nodes.size(); ++i)
+            sparse_indices[nodes[i].tag] = i;
+      }
+
+      // Return the index of the node with the given tag, or
+      // numbers::invalid_unsigned_int if there is no such node
+      unsigned int
+      operator()(const std::size_t tag) const
+      {
+        if (sparse_indices.empty())
+          return (tag < dense_indices.size()) ? dense_indices[tag] :
+                                                numbers::invalid_unsigned_int;
+        const auto it = sparse_indices.find(tag);
+        return (it != sparse_indices.end()) ? it->second :
+                                              numbers::invalid_unsigned_int;
+      }
+
+    private:
+      std::vector<unsigned int>                       dense_indices;
+      std::unordered_map<std::size_t, unsigned int>   sparse_indices;
+    };
+
+
+
+    // Read a file in gmsh format from the given stream and fill the arrays
+    // of vertices, cells and boundary information. Only the cells with
+    // indices within @p cell_range (counted among the cells of the file in
+    // the order they are listed) are stored.
+    //
+    // The file is read section by section, and the elements of the
+    // elements section are filtered while they are read, so that only the
+    // elements of the requested cells and the boundary elements are kept
+    // in memory. Since the nodes precede the elements in the file, the
+    // nodes section is skipped if only some of the cells are requested and
+    // read after the elements, keeping only the nodes of these cells. This
+    // requires a stream that supports positioning; for other streams, all
+    // nodes are read and the unneeded ones removed afterwards.
+    template <int dim, int spacedim>
+    void
+    read_msh(std::istream &                                in,
+             const std::pair<unsigned int, unsigned int> & cell_range,
+             std::vector<Point<spacedim>> &                vertices,
+             std::vector<CellData<dim>> &                  cells,
+             SubCellData &                                 subcelldata,
+             std::map<unsigned int, types::boundary_id> &  boundary_ids_1d)
+    {
+      using GridInType = GridIn<dim, spacedim>;
+      AssertThrow(in, ExcIO());
+
+      InputBuffer input(in);
+      const char *p = input.begin();
+
+      // first determine file format
+      std::string  line             = read_token(input, p);
+      unsigned int gmsh_file_format = 0;
+      bool         binary           = false;
+      if (line == "$NOD")
+        gmsh_file_format = 1;
+      else if (line == "$MeshFormat")
         {
-          // read the indices of nodes given
-          unsigned int node_index = 0;
-          switch (gmsh_file_format)
+          const double version   = read_real(input, p, false);
+          const auto   file_type = read_size(input, p, false);
+          const auto   data_size = read_size(input, p, false);
+          binary                 = (file_type == 1);
+
+          if (version >= 2.0 && version <= 2.2)
             {
-              case 1:
+              gmsh_file_format = 2;
+              AssertThrow(binary == false,
+                          ExcMessage("The binary variant of version 2 of "
+                                     "the gmsh file format is not "
+                                     "supported. Please use version 4.1 "
+                                     "for binary files."));
+              AssertThrow(data_size == sizeof(double), ExcNotImplemented());
+            }
+          else if (version == 4.1)
+            {
+              gmsh_file_format = 4;
+              AssertThrow(data_size == sizeof(std::uint64_t),
+                          ExcNotImplemented());
+              if (binary)
                 {
-                  for (unsigned int i = 0; i < nod_num; ++i)
-                    in >> node_index;
-                  break;
+                  // gmsh writes the integer one to detect files written on
+                  // a machine with different endianness
+                  skip_to_binary_data(input, p);
+                  AssertThrow(read_int(input, p, true) == 1,
+                              ExcMessage("The binary gmsh file was written "
+                                         "on a machine with different "
+                                         "endianness, which is not "
+                                         "supported."));
+                }
+            }
+          else
+            AssertThrow(false,
+                        ExcMessage("Version " + Utilities::to_string(version) +
+                                   " of the gmsh file format is not "
+                                   "supported. Supported are versions 1, "
+                                   "2.0 to 2.2 and 4.1."));
+
+          line = read_token(input, p);
+          AssertThrow(line == "$EndMeshFormat",
+                      typename GridInType::ExcInvalidGMSHInput(line));
+          line = read_token(input, p);
+        }
+      else
+        AssertThrow(false,
+                    typename GridInType::ExcInvalidGMSHInput(line));
+
+      const bool all_cells =
+        (cell_range.first == 0 &&
+         cell_range.second == numbers::invalid_unsigned_int);
+
+      // now go through the sections of the file. sections we do not need,
+      // like $PhysicalNames, are skipped
+      ElementFilter<dim, spacedim> element_filter(cell_range);
+      EntityTags                   entity_tags;
+      std::vector<Node>            nodes;
+      std::streamoff               nodes_position = -1;
+      std::string                  nodes_end_marker;
+      bool                         found_nodes    = false;
+      bool                         found_elements = false;
+      while (line.size() > 0)
+        {
+          AssertThrow(line[0] == '$',
+                      typename GridInType::ExcInvalidGMSHInput(line));
+          const std::string end_marker =
+            (gmsh_file_format == 1) ? "$END" + line.substr(1) :
+                                      "$End" + line.substr(1);
+
+          if (line == "$NOD" || line == "$Nodes")
+            {
+              found_nodes      = true;
+              nodes_end_marker = end_marker;
+              if (!all_cells)
+                nodes_position = input.stream_position(p);
+              if (nodes_position < 0)
+                {
+                  if (gmsh_file_format == 4)
+                    read_nodes_v4(input, p, binary, NodeFilter(), nodes);
+                  else
+                    read_nodes_v1_v2(input, p, NodeFilter(), nodes);
                 }
-              case 2:
+              // binary data may contain the end marker by chance, so walk
+              // through the blocks of binary files instead of searching it
+              else if (gmsh_file_format == 4 && binary)
                 {
-                  in >> node_index;
-                  break;
+                  NodeFilter no_nodes;
+                  no_nodes.all = false;
+                  read_nodes_v4(input, p, binary, no_nodes, nodes);
                 }
-              default:
-                Assert(false, ExcInternalError());
+              else
+                find_marker(input, p, end_marker);
+            }
+          else if (line == "$ELM" || line == "$Elements")
+            {
+              AssertThrow(found_nodes,
+                          typename GridInType::ExcInvalidGMSHInput(line));
+              if (gmsh_file_format == 4)
+                read_elements_v4(input, p, binary, entity_tags, element_filter);
+              else
+                read_elements_v1_v2(input,
+                                    p,
+                                    gmsh_file_format,
+                                    element_filter);
+              found_elements = true;
             }
+          else if (line == "$Entities" && gmsh_file_format == 4)
+            read_entities_v4(input, p, binary, entity_tags);
+          else
+            {
+              AssertThrow(line != "$PartitionedEntities",
+                          ExcMessage("Partitioned gmsh files are not "
+                                     "supported."));
+              find_marker(input, p, end_marker);
+            }
+
+          // Assert we reached the end of the block
+          line = read_token(input, p);
+          AssertThrow(line == end_marker,
+                      typename GridInType::ExcInvalidGMSHInput(line));
 
-          // we only care about boundary indicators assigned to individual
-          // vertices in 1d (because otherwise the vertices are not faces)
-          if (dim == 1)
-            boundary_ids_1d[vertex_indices[node_index]] = material_id;
+          // we do not need anything after the elements
+          if (found_elements)
+            break;
+          line = read_token(input, p);
         }
-      else
-        // cannot read this, so throw
-        // an exception. treat
-        // triangles and tetrahedra
-        // specially since this
-        // deserves a more explicit
-        // error message
+      AssertThrow(found_nodes && found_elements,
+                  ExcMessage("The gmsh file does not contain both a nodes "
+                             "and an elements section."));
+
+      const std::vector<Element> &elements = element_filter.elements;
+
+      // if only some of the cells are requested, collect the tags of their
+      // nodes. all other nodes are skipped without converting their
+      // coordinates, or removed if they have been read already
+      NodeFilter filter;
+      if (!all_cells)
         {
-          AssertThrow(cell_type != 2,
-                      ExcMessage("Found triangles while reading a file "
-                                 "in gmsh format. deal.II does not "
-                                 "support triangles"));
-          AssertThrow(cell_type != 11,
-                      ExcMessage("Found tetrahedra while reading a file "
-                                 "in gmsh format. deal.II does not "
-                                 "support tetrahedra"));
-
-          AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
+          filter.all = false;
+          for (const Element &element : elements)
+            if (element_filter.is_cell(element))
+              filter.tags.insert(filter.tags.end(),
+                                 element.nodes.begin(),
+                                 element.nodes.begin() + element.n_nodes);
+          std::sort(filter.tags.begin(), filter.tags.end());
+          filter.tags.erase(std::unique(filter.tags.begin(), filter.tags.end()),
+                            filter.tags.end());
+        }
+
+      if (nodes_position >= 0)
+        {
+          input.seek(nodes_position, p);
+          if (gmsh_file_format == 4)
+            read_nodes_v4(input, p, binary, filter, nodes);
+          else
+            read_nodes_v1_v2(input, p, filter, nodes);
+          line = read_token(input, p);
+          AssertThrow(line == nodes_end_marker,
+                      typename GridInType::ExcInvalidGMSHInput(line));
+        }
+      else if (!filter.all)
+        nodes.erase(std::remove_if(nodes.begin(),
+                                   nodes.end(),
+                                   [&filter](const Node &node) {
+                                     return !filter(node.tag);
+                                   }),
+                    nodes.end());
+
+      // now convert the nodes and elements into the data structures deal.II
+      // uses, transforming the node tags of gmsh to consecutive numbering
+      vertices.resize(nodes.size());
+      for (unsigned int v = 0; v < nodes.size(); ++v)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          vertices[v][d] = nodes[v].coordinates[d];
+      const NodeTagMap vertex_indices(nodes);
+      nodes.clear();
+      nodes.shrink_to_fit();
+
+      // if only the nodes of some cells have been read, boundary information
+      // referring to other nodes is skipped
+      const auto has_all_nodes = [&](const Element &    element,
+                                     const unsigned int n_nodes) {
+        if (filter.all)
+          return true;
+        for (unsigned int i = 0; i < n_nodes; ++i)
+          if (vertex_indices(element.nodes[i]) ==
+              numbers::invalid_unsigned_int)
+            return false;
+        return true;
+      };
+
+      const auto vertex_index = [&](const Element &    element,
+                                    const unsigned int i) {
+        const unsigned int index = vertex_indices(element.nodes[i]);
+        AssertThrow(index != numbers::invalid_unsigned_int,
+                    typename GridInType::ExcInvalidVertexIndexGmsh(
+                      &element - elements.data(),
+                      element.number,
+                      element.nodes[i]));
+        return index;
+      };
+
+      for (const Element &element : elements)
+        {
+          if (element_filter.is_cell(element))
+            // found a cell
+            {
+              // to make sure that the cast won't fail
+              Assert(element.tag >= 0 &&
+                       element.tag <=
+                         std::numeric_limits<types::material_id>::max(),
+                     ExcIndexRange(
+                       element.tag,
+                       0,
+                       std::numeric_limits<types::material_id>::max()));
+              // we use only material_ids in the range from 0 to
+              // numbers::invalid_material_id-1
+              Assert(element.tag < numbers::invalid_material_id,
+                     ExcIndexRange(element.tag,
+                                   0,
+                                   numbers::invalid_material_id));
+
+              cells.emplace_back();
+              for (unsigned int i = 0;
+                   i < GeometryInfo<dim>::vertices_per_cell;
+                   ++i)
+                cells.back().vertices[i] = vertex_index(element, i);
+              cells.back().material_id =
+                static_cast<types::material_id>(element.tag);
+            }
+          else if ((element.type == 1) && ((dim == 2) || (dim == 3)))
+            // boundary info
+            {
+              if (!has_all_nodes(element, 2))
+                continue;
+
+              // to make sure that the cast won't fail
+              Assert(element.tag >= 0 &&
+                       element.tag <=
+                         std::numeric_limits<types::boundary_id>::max(),
+                     ExcIndexRange(
+                       element.tag,
+                       0,
+                       std::numeric_limits<types::boundary_id>::max()));
+              // we use only boundary_ids in the range from 0 to
+              // numbers::internal_face_boundary_id-1
+              Assert(element.tag < numbers::internal_face_boundary_id,
+                     ExcIndexRange(element.tag,
+                                   0,
+                                   numbers::internal_face_boundary_id));
+
+              subcelldata.boundary_lines.emplace_back();
+              for (unsigned int i = 0; i < 2; ++i)
+                subcelldata.boundary_lines.back().vertices[i] =
+                  vertex_index(element, i);
+              subcelldata.boundary_lines.back().boundary_id =
+                static_cast<types::boundary_id>(element.tag);
+            }
+          else if ((element.type == 3) && (dim == 3))
+            // boundary info
+            {
+              if (!has_all_nodes(element, 4))
+                continue;
+
+              // to make sure that the cast won't fail
+              Assert(element.tag >= 0 &&
+                       element.tag <=
+                         std::numeric_limits<types::boundary_id>::max(),
+                     ExcIndexRange(
+                       element.tag,
+                       0,
+                       std::numeric_limits<types::boundary_id>::max()));
+              // we use only boundary_ids in the range from 0 to
+              // numbers::internal_face_boundary_id-1
+              Assert(element.tag < numbers::internal_face_boundary_id,
+                     ExcIndexRange(element.tag,
+                                   0,
+                                   numbers::internal_face_boundary_id));
+
+              subcelldata.boundary_quads.emplace_back();
+              for (unsigned int i = 0; i < 4; ++i)
+                subcelldata.boundary_quads.back().vertices[i] =
+                  vertex_index(element, i);
+              subcelldata.boundary_quads.back().boundary_id =
+                static_cast<types::boundary_id>(element.tag);
+            }
+          else if (element.type == 15)
+            {
+              // we only care about boundary indicators assigned to
+              // individual vertices in 1d (because otherwise the vertices
+              // are not faces). in format 1, the number of nodes is given
+              // explicitly, and we take the last one
+              if (dim == 1 && element.n_nodes > 0 &&
+                  has_all_nodes(element, element.n_nodes))
+                boundary_ids_1d[vertex_index(element, element.n_nodes - 1)] =
+                  static_cast<types::boundary_id>(element.tag);
+            }
+          else
+            AssertThrow(false,
+                        typename GridInType::ExcGmshUnsupportedGeometry(element.type));
         }
+
+      // check that no forbidden arrays are used
+      Assert(subcelldata.check_consistency(dim), ExcInternalError());
     }
+  } // namespace Gmsh
+} // namespace
 
-  // Assert we reached the end of the block
-  in >> line;
-  static const std::string end_elements_marker[] = {"$ENDELM", "$EndElements"};
-  AssertThrow(line == end_elements_marker[gmsh_file_format - 1],
-              ExcInvalidGMSHInput(line));
 
-  // check that no forbidden arrays are used
-  Assert(subcelldata.check_consistency(dim), ExcInternalError());
 
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
   AssertThrow(in, ExcIO());
 
+  // set up array of cells and subcells (faces). In 1d, there is currently no
+  // standard way in deal.II to pass boundary indicators attached to individual
+  // vertices, so do this by hand via the boundary_ids_1d array
+  std::vector<Point<spacedim>>               vertices;
+  std::vector<CellData<dim>>                 cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+
+  Gmsh::read_msh(in,
+                 std::make_pair(0U, numbers::invalid_unsigned_int),
+                 vertices,
+                 cells,
+                 subcelldata,
+                 boundary_ids_1d);
+
   // check that we actually read some
   // cells.
   AssertThrow(cells.size() > 0, ExcGmshNoCellInformation());
@@ -1706,7 +3042,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   if (dim == spacedim)
     GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                      cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 
   // in 1d, we also have to attach boundary ids to vertices, which does not
@@ -1716,6 +3052,73 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 }
 
 
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh(
+  std::istream &                               in,
+  std::vector<Point<spacedim>> &               vertices,
+  std::vector<CellData<dim>> &                 cells,
+  SubCellData &                                subcelldata,
+  std::map<unsigned int, types::boundary_id> & vertex_boundary_ids,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  AssertThrow(cell_range.first <= cell_range.second,
+              ExcMessage("The range of cells to read is empty."));
+
+  vertices.clear();
+  cells.clear();
+  subcelldata = SubCellData();
+  vertex_boundary_ids.clear();
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+
+  Gmsh::read_msh(in, cell_range, vertices, cells, subcelldata, boundary_ids_1d);
+
+  // only keep the boundary information of faces whose vertices are all
+  // part of the cells we have read
+  std::vector<bool> vertex_used(vertices.size(), false);
+  for (const CellData<dim> &cell : cells)
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      vertex_used[cell.vertices[v]] = true;
+  const auto is_unused = [&](const unsigned int *vertex_indices,
+                             const unsigned int  n_vertices) {
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      if (!vertex_used[vertex_indices[v]])
+        return true;
+    return false;
+  };
+  subcelldata.boundary_lines.erase(
+    std::remove_if(subcelldata.boundary_lines.begin(),
+                   subcelldata.boundary_lines.end(),
+                   [&](const CellData<1> &line) {
+                     return is_unused(line.vertices, 2);
+                   }),
+    subcelldata.boundary_lines.end());
+  subcelldata.boundary_quads.erase(
+    std::remove_if(subcelldata.boundary_quads.begin(),
+                   subcelldata.boundary_quads.end(),
+                   [&](const CellData<2> &quad) {
+                     return is_unused(quad.vertices, 4);
+                   }),
+    subcelldata.boundary_quads.end());
+
+  // delete_unused_vertices() keeps the order of the remaining vertices, so
+  // the new number of a vertex is the number of used vertices before it
+  std::vector<unsigned int> new_vertex_numbers(vertices.size(),
+                                               numbers::invalid_unsigned_int);
+  unsigned int              next_free_number = 0;
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    if (vertex_used[v])
+      new_vertex_numbers[v] = next_free_number++;
+  for (const auto &boundary_id : boundary_ids_1d)
+    if (vertex_used[boundary_id.first])
+      vertex_boundary_ids[new_vertex_numbers[boundary_id.first]] =
+        boundary_id.second;
+
+  GridTools::delete_unused_vertices(vertices, cells, subcelldata);
+}
+
+
 template <>
 void
 GridIn<1>::read_netcdf(const std::string &)
@@ -1990,7 +3393,7 @@ GridIn<2>::read_netcdf(const std::string &filename)
 
   SubCellData subcelldata;
   GridTools::delete_unused_vertices(vertices, cells, subcelldata);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 #endif
 }
@@ -2172,7 +3575,7 @@ GridIn<3>::read_netcdf(const std::string &filename)
   GridTools::delete_unused_vertices(vertices, cells, subcelldata);
   GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                    cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 #endif
 }
@@ -2648,7 +4051,7 @@ GridIn<2>::read_tecplot(std::istream &in)
   // do some cleanup on cells
   GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                    cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
 
@@ -2805,7 +4208,7 @@ GridIn<dim, spacedim>::read_assimp(const std::string &filename,
     GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
                                                                      cells);
 
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  reorder_cells(cells);
   if (dim == 2)
     tria->create_triangulation_compatibility(vertices, cells, subcelldata);
   else
@@ -14,13 +14,19 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/grid/grid_reordering.h>
 #include <deal.II/grid/grid_tools.h>
 
+#ifdef DEAL_II_WITH_THREADS
+#  include <tbb/parallel_sort.h>
+#endif
+
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -32,79 +38,91 @@ DEAL_II_NAMESPACE_OPEN
 namespace
 {
   /**
-   * A simple data structure denoting an edge, i.e., the ordered pair
-   * of its vertex indices. This is only used in the is_consistent()
-   * function.
+   * The number of cells each task works on in the loops over all cells
+   * below.
+   */
+  const unsigned int grain_size = 1024;
+
+
+
+  /**
+   * Sort the elements in the range [begin, end), using several threads if
+   * the library was configured with threads.
    */
-  struct CheapEdge
+  template <typename Iterator>
+  void
+  sort_in_parallel(const Iterator begin, const Iterator end)
   {
-    /**
-     * Construct an edge from the global indices of its two vertices.
-     */
-    CheapEdge(const unsigned int v0, const unsigned int v1)
-      : v0(v0)
-      , v1(v1)
-    {}
+#ifdef DEAL_II_WITH_THREADS
+    tbb::parallel_sort(begin, end);
+#else
+    std::sort(begin, end);
+#endif
+  }
 
-    /**
-     * Comparison operator for edges. It compares based on the
-     * lexicographic ordering of the two vertex indices.
-     */
-    bool
-    operator<(const CheapEdge &e) const
-    {
-      return ((v0 < e.v0) || ((v0 == e.v0) && (v1 < e.v1)));
-    }
 
-  private:
-    /**
-     * The global indices of the vertices that define the edge.
-     */
-    const unsigned int v0, v1;
-  };
+
+  /**
+   * Encode the (unordered) pair of vertex indices of an edge as a single
+   * integer, with the smaller of the two indices in the upper half. Sorting
+   * these keys therefore sorts edges lexicographically by their vertex
+   * indices.
+   */
+  inline std::uint64_t
+  edge_key(const unsigned int v0, const unsigned int v1)
+  {
+    return (static_cast<std::uint64_t>(std::min(v0, v1)) << 32) +
+           std::max(v0, v1);
+  }
+
 
 
   /**
    * A function that determines whether the edges in a mesh are
-   * already consistently oriented. It does so by adding all edges
-   * of all cells into a set (which automatically eliminates
-   * duplicates) but before that checks whether the reverse edge is
-   * already in the set -- which would imply that a neighboring cell
-   * is inconsistently oriented.
+   * already consistently oriented. It does so by collecting all
+   * edges of all cells, together with the direction in which each
+   * cell traverses them, and sorting this list. If the same edge
+   * then appears with both directions, two neighboring cells are
+   * inconsistently oriented.
+   *
+   * Both the collection and the sorting are done in parallel, which
+   * matters for coarse meshes with millions of cells.
    */
   template <int dim>
   bool
   is_consistent(const std::vector<CellData<dim>> &cells)
   {
-    std::set<CheapEdge> edges;
-
-    for (typename std::vector<CellData<dim>>::const_iterator c = cells.begin();
-         c != cells.end();
-         ++c)
-      {
-        // construct the edges in reverse order. for each of them,
-        // ensure that the reverse edge is not yet in the list of
-        // edges (return false if the reverse edge already *is* in
-        // the list) and then add the actual edge to it; std::set
-        // eliminates duplicates automatically
-        for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
-          {
-            const CheapEdge reverse_edge(
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)],
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)]);
-            if (edges.find(reverse_edge) != edges.end())
-              return false;
-
-
-            // ok, not. insert edge in correct order
-            const CheapEdge correct_edge(
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)],
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)]);
-            edges.insert(correct_edge);
-          }
-      }
+    const unsigned int lines_per_cell = GeometryInfo<dim>::lines_per_cell;
+    std::vector<std::pair<std::uint64_t, bool>> edges(cells.size() *
+                                                      lines_per_cell);
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      cells.size(),
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c)
+          for (unsigned int l = 0; l < lines_per_cell; ++l)
+            {
+              const unsigned int v0 =
+                cells[c]
+                  .vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)];
+              const unsigned int v1 =
+                cells[c]
+                  .vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)];
+              edges[c * lines_per_cell + l] =
+                std::make_pair(edge_key(v0, v1), v0 > v1);
+            }
+      },
+      grain_size);
+
+    sort_in_parallel(edges.begin(), edges.end());
+
+    // after sorting, both directions of the same edge would be adjacent
+    // in the list
+    for (std::size_t i = 1; i < edges.size(); ++i)
+      if (edges[i].first == edges[i - 1].first &&
+          edges[i].second != edges[i - 1].second)
+        return false;
 
-    // no conflicts found, so return true
     return true;
   }
 
@@ -322,6 +340,19 @@ namespace
         std::swap(vertex_indices[0], vertex_indices[1]);
     }
 
+    /**
+     * Constructor. Create the edge between the two vertices with indices
+     * @p v0 and @p v1, which have to be given in ascending order.
+     * Initialize the edge as unoriented.
+     */
+    Edge(const unsigned int v0, const unsigned int v1)
+      : orientation_status(not_oriented)
+    {
+      Assert(v0 < v1, ExcInternalError());
+      vertex_indices[0] = v0;
+      vertex_indices[1] = v1;
+    }
+
     /**
      * Comparison operator for edges. It compares based on the
      * lexicographic ordering of the two vertex indices.
@@ -379,6 +410,11 @@ namespace
   template <int dim>
   struct Cell
   {
+    /**
+     * Default constructor. Leaves the object uninitialized.
+     */
+    Cell() = default;
+
     /**
      * Construct a Cell object from a CellData object. Also take a
      * (sorted) list of edges and to point the edges of the current
@@ -538,17 +574,36 @@ namespace
     // build the edge list for all cells. because each cell has
     // GeometryInfo<dim>::lines_per_cell edges, the total number
     // of edges is this many times the number of cells. of course
-    // some of them will be duplicates, and we throw them out below
-    std::vector<Edge<dim>> edge_list;
-    edge_list.reserve(cells.size() * GeometryInfo<dim>::lines_per_cell);
-    for (unsigned int i = 0; i < cells.size(); ++i)
-      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
-        edge_list.emplace_back(cells[i], l);
+    // some of them will be duplicates, and we throw them out below.
+    //
+    // rather than sorting Edge objects (which in 3d carry a vector of
+    // adjacent cells), first collect and sort their integer keys in
+    // parallel
+    const unsigned int         lines_per_cell = GeometryInfo<dim>::lines_per_cell;
+    std::vector<std::uint64_t> edge_keys(cells.size() * lines_per_cell);
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      cells.size(),
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c)
+          for (unsigned int l = 0; l < lines_per_cell; ++l)
+            edge_keys[c * lines_per_cell + l] = edge_key(
+              cells[c].vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)],
+              cells[c]
+                .vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)]);
+      },
+      grain_size);
 
     // next sort the edge list and then remove duplicates
-    std::sort(edge_list.begin(), edge_list.end());
-    edge_list.erase(std::unique(edge_list.begin(), edge_list.end()),
-                    edge_list.end());
+    sort_in_parallel(edge_keys.begin(), edge_keys.end());
+    edge_keys.erase(std::unique(edge_keys.begin(), edge_keys.end()),
+                    edge_keys.end());
+
+    std::vector<Edge<dim>> edge_list;
+    edge_list.reserve(edge_keys.size());
+    for (const std::uint64_t key : edge_keys)
+      edge_list.emplace_back(static_cast<unsigned int>(key >> 32),
+                             static_cast<unsigned int>(key & 0xffffffffu));
 
     return edge_list;
   }
@@ -564,21 +619,25 @@ namespace
   build_cells_and_connect_edges(const std::vector<CellData<dim>> &cells,
                                 std::vector<Edge<dim>> &          edges)
   {
-    std::vector<Cell<dim>> cell_list;
-    cell_list.reserve(cells.size());
+    // create our own data structure for the cells and let it connect to
+    // the edges array. this involves a binary search for each edge of
+    // each cell, so do it in parallel
+    std::vector<Cell<dim>> cell_list(cells.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          cell_list[i] = Cell<dim>(cells[i], edges);
+      },
+      grain_size);
+
+    // then also inform the edges that they are adjacent to the cells,
+    // and where within each cell
     for (unsigned int i = 0; i < cells.size(); ++i)
-      {
-        // create our own data structure for the cells and let it
-        // connect to the edges array
-        cell_list.emplace_back(cells[i], edges);
-
-        // then also inform the edges that they are adjacent
-        // to the current cell, and where within this cell
-        for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
-          edges[cell_list.back().edge_indices[l]].adjacent_cells.push_back(
-            AdjacentCell(i, l));
-      }
-    Assert(cell_list.size() == cells.size(), ExcInternalError());
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        edges[cell_list[i].edge_indices[l]].adjacent_cells.push_back(
+          AdjacentCell(i, l));
 
     return cell_list;
   }
@@ -996,9 +1055,15 @@ namespace
 
     // now that we have oriented all edges, we need to rotate cells
     // so that the edges point in the right direction with the now
-    // rotated coordinate system
-    for (unsigned int c = 0; c < cells.size(); ++c)
-      rotate_cell(cell_list, edge_list, c, cells);
+    // rotated coordinate system. each cell is rotated independently
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int c = begin; c < end; ++c)
+          rotate_cell(cell_list, edge_list, c, cells);
+      },
+      grain_size);
   }
 
 
@@ -1114,6 +1179,59 @@ GridReordering<dim, spacedim>::reorder_cells(std::vector<CellData<dim>> &cells,
 
 
 
+template <int dim, int spacedim>
+void
+GridReordering<dim, spacedim>::reorder_cells(
+  std::vector<CellData<dim>> &cells,
+  const bool                  use_new_style_ordering,
+  const std::uint64_t         trusted_fingerprint)
+{
+  // if the cells are exactly the ones that have been found to be
+  // consistently oriented before, there is nothing to do
+  if (compute_fingerprint(cells) != trusted_fingerprint)
+    reorder_cells(cells, use_new_style_ordering);
+}
+
+
+
+template <int dim, int spacedim>
+std::uint64_t
+GridReordering<dim, spacedim>::compute_fingerprint(
+  const std::vector<CellData<dim>> &cells)
+{
+  // a 64-bit mixing function (the finalizer of the SplitMix64 generator)
+  // that spreads every input bit over all output bits
+  const auto mix = [](std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  };
+
+  // hash each cell together with its position in the list and add up the
+  // results, which makes the sum independent of how the cells are split
+  // into subranges but sensitive to the order of both cells and vertices
+  const auto hash_cells = [&](const std::size_t begin, const std::size_t end) {
+    std::uint64_t sum = 0;
+    for (std::size_t c = begin; c < end; ++c)
+      {
+        std::uint64_t hash = mix(c);
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          hash = mix(hash ^ cells[c].vertices[v]);
+        sum += hash;
+      }
+    return sum;
+  };
+
+  return mix(cells.size()) +
+         parallel::accumulate_from_subranges<std::uint64_t>(hash_cells,
+                                                            std::size_t(0),
+                                                            cells.size(),
+                                                            grain_size);
+}
+
+
+
 template <>
 void
 GridReordering<1>::invert_all_cells_of_negative_grid(
@@ -1152,35 +1270,45 @@ GridReordering<2>::invert_all_cells_of_negative_grid(
   const std::vector<Point<2>> &all_vertices,
   std::vector<CellData<2>> &   cells)
 {
-  unsigned int vertices_lex[GeometryInfo<2>::vertices_per_cell];
-  unsigned int n_negative_cells = 0;
-  for (unsigned int cell_no = 0; cell_no < cells.size(); ++cell_no)
-    {
-      // GridTools::cell_measure
-      // requires the vertices to be
-      // in lexicographic ordering
-      for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell; ++i)
-        vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] =
-          cells[cell_no].vertices[i];
-      if (GridTools::cell_measure<2>(all_vertices, vertices_lex) < 0)
-        {
-          ++n_negative_cells;
-          std::swap(cells[cell_no].vertices[1], cells[cell_no].vertices[3]);
-
-          // check whether the
-          // resulting cell is now ok.
-          // if not, then the grid is
-          // seriously broken and
-          // should be sticked into the
-          // bin
-          for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell; ++i)
-            vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] =
-              cells[cell_no].vertices[i];
-          AssertThrow(GridTools::cell_measure<2>(all_vertices, vertices_lex) >
-                        0,
-                      ExcInternalError());
-        }
-    }
+  // each cell is checked independently, so work on subranges of cells in
+  // parallel and add up the number of inverted cells
+  const auto invert_cells = [&](const unsigned int begin,
+                                const unsigned int end) {
+    unsigned int vertices_lex[GeometryInfo<2>::vertices_per_cell];
+    unsigned int n_negative_cells = 0;
+    for (unsigned int cell_no = begin; cell_no < end; ++cell_no)
+      {
+        // GridTools::cell_measure
+        // requires the vertices to be
+        // in lexicographic ordering
+        for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell; ++i)
+          vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] =
+            cells[cell_no].vertices[i];
+        if (GridTools::cell_measure<2>(all_vertices, vertices_lex) < 0)
+          {
+            ++n_negative_cells;
+            std::swap(cells[cell_no].vertices[1], cells[cell_no].vertices[3]);
+
+            // check whether the
+            // resulting cell is now ok.
+            // if not, then the grid is
+            // seriously broken and
+            // should be sticked into the
+            // bin
+            for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell;
+                 ++i)
+              vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] =
+                cells[cell_no].vertices[i];
+            AssertThrow(GridTools::cell_measure<2>(all_vertices,
+                                                   vertices_lex) > 0,
+                        ExcInternalError());
+          }
+      }
+    return n_negative_cells;
+  };
+  const unsigned int n_negative_cells =
+    parallel::accumulate_from_subranges<unsigned int>(
+      invert_cells, 0U, static_cast<unsigned int>(cells.size()), grain_size);
 
   // We assume that all cells of a grid have
   // either positive or negative volumes but
@@ -1224,38 +1352,48 @@ GridReordering<3>::invert_all_cells_of_negative_grid(
   const std::vector<Point<3>> &all_vertices,
   std::vector<CellData<3>> &   cells)
 {
-  unsigned int vertices_lex[GeometryInfo<3>::vertices_per_cell];
-  unsigned int n_negative_cells = 0;
-  for (unsigned int cell_no = 0; cell_no < cells.size(); ++cell_no)
-    {
-      // GridTools::cell_measure
-      // requires the vertices to be
-      // in lexicographic ordering
-      for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
-        vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] =
-          cells[cell_no].vertices[i];
-      if (GridTools::cell_measure<3>(all_vertices, vertices_lex) < 0)
-        {
-          ++n_negative_cells;
-          // reorder vertices: swap front and back face
-          for (unsigned int i = 0; i < 4; ++i)
-            std::swap(cells[cell_no].vertices[i],
-                      cells[cell_no].vertices[i + 4]);
-
-          // check whether the
-          // resulting cell is now ok.
-          // if not, then the grid is
-          // seriously broken and
-          // should be sticked into the
-          // bin
-          for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
-            vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] =
-              cells[cell_no].vertices[i];
-          AssertThrow(GridTools::cell_measure<3>(all_vertices, vertices_lex) >
-                        0,
-                      ExcInternalError());
-        }
-    }
+  // each cell is checked independently, so work on subranges of cells in
+  // parallel and add up the number of inverted cells
+  const auto invert_cells = [&](const unsigned int begin,
+                                const unsigned int end) {
+    unsigned int vertices_lex[GeometryInfo<3>::vertices_per_cell];
+    unsigned int n_negative_cells = 0;
+    for (unsigned int cell_no = begin; cell_no < end; ++cell_no)
+      {
+        // GridTools::cell_measure
+        // requires the vertices to be
+        // in lexicographic ordering
+        for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
+          vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] =
+            cells[cell_no].vertices[i];
+        if (GridTools::cell_measure<3>(all_vertices, vertices_lex) < 0)
+          {
+            ++n_negative_cells;
+            // reorder vertices: swap front and back face
+            for (unsigned int i = 0; i < 4; ++i)
+              std::swap(cells[cell_no].vertices[i],
+                        cells[cell_no].vertices[i + 4]);
+
+            // check whether the
+            // resulting cell is now ok.
+            // if not, then the grid is
+            // seriously broken and
+            // should be sticked into the
+            // bin
+            for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell;
+                 ++i)
+              vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] =
+                cells[cell_no].vertices[i];
+            AssertThrow(GridTools::cell_measure<3>(all_vertices,
+                                                   vertices_lex) > 0,
+                        ExcInternalError());
+          }
+      }
+    return n_negative_cells;
+  };
+  const unsigned int n_negative_cells =
+    parallel::accumulate_from_subranges<unsigned int>(
+      invert_cells, 0U, static_cast<unsigned int>(cells.size()), grain_size);
 
   // We assume that all cells of a
   // grid have either positive or
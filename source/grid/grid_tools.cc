@@ -58,6 +58,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <list>
 #include <numeric>
@@ -602,6 +603,197 @@ namespace GridTools
 
 
 
+  template <int spacedim>
+  std::vector<unsigned int>
+  hilbert_order(const std::vector<Point<spacedim>> &points,
+                const BoundingBox<spacedim> &       bounding_box)
+  {
+    // convert the points to integer coordinates relative to the bounding
+    // box, using as many bits per coordinate direction as fit into a 64 bit
+    // key. the same scaling is used in all directions so that the curve is
+    // not distorted on elongated domains
+    const Point<spacedim> &lower  = bounding_box.get_boundary_points().first;
+    const Point<spacedim> &upper  = bounding_box.get_boundary_points().second;
+    double                 extent = 0;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      extent = std::max(extent, upper[d] - lower[d]);
+
+    const int    bits_per_dim = 64 / spacedim;
+    const double scaling =
+      extent > 0 ? std::ldexp(1., bits_per_dim) / extent : 0.;
+    const double max_coordinate =
+      std::nextafter(std::ldexp(1., bits_per_dim), 0.);
+    std::vector<std::array<std::uint64_t, spacedim>> integer_coords(
+      points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        integer_coords[i][d] = static_cast<std::uint64_t>(std::max(
+          0., std::min((points[i][d] - lower[d]) * scaling, max_coordinate)));
+    integer_coords = Utilities::inverse_Hilbert_space_filling_curve<spacedim>(
+      integer_coords, bits_per_dim);
+
+    // sort by the position along the curve, and by the original index for
+    // points with the same key
+    std::vector<std::pair<std::uint64_t, unsigned int>> keys(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      keys[i] = std::make_pair(
+        Utilities::pack_integers<spacedim>(integer_coords[i], bits_per_dim), i);
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<unsigned int> order(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      order[i] = keys[i].second;
+    return order;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  hilbert_renumbering(Triangulation<dim, spacedim> &triangulation)
+  {
+    if (triangulation.n_levels() == 0)
+      return;
+    AssertThrow(triangulation.n_levels() == 1,
+                ExcMessage("Only unrefined triangulations can be renumbered."));
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                 old_cells;
+    std::vector<Point<spacedim>> centers;
+    old_cells.reserve(triangulation.n_active_cells());
+    centers.reserve(triangulation.n_active_cells());
+    for (const auto &cell : triangulation.active_cell_iterators())
+      {
+        old_cells.push_back(cell);
+        centers.push_back(cell->center());
+      }
+    const std::vector<unsigned int> order =
+      hilbert_order(centers, compute_bounding_box(triangulation));
+
+    // number the vertices in the order in which the sorted cells visit them
+    std::vector<unsigned int> new_vertex_index(triangulation.n_vertices(),
+                                               numbers::invalid_unsigned_int);
+    std::vector<Point<spacedim>> vertices;
+    std::vector<CellData<dim>>   cells(old_cells.size());
+    for (unsigned int c = 0; c < order.size(); ++c)
+      {
+        const auto &cell = old_cells[order[c]];
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            unsigned int &index = new_vertex_index[cell->vertex_index(v)];
+            if (index == numbers::invalid_unsigned_int)
+              {
+                index = vertices.size();
+                vertices.push_back(cell->vertex(v));
+              }
+            cells[c].vertices[v] = index;
+          }
+        cells[c].material_id = cell->material_id();
+        cells[c].manifold_id = cell->manifold_id();
+      }
+
+    // keep all indicators of faces and edges that differ from the defaults
+    // the triangulation would otherwise assign. in 1d, the boundary ids are
+    // attached to the vertices and are restored below
+    const auto has_indicators = [](const types::boundary_id boundary_id,
+                                   const types::manifold_id manifold_id) {
+      return (boundary_id != 0 &&
+              boundary_id != numbers::internal_face_boundary_id) ||
+             manifold_id != numbers::flat_manifold_id;
+    };
+    SubCellData subcelldata;
+    if (dim > 1)
+      for (auto face = triangulation.begin_active_face();
+           face != triangulation.end_face();
+           ++face)
+        if (has_indicators(face->boundary_id(), face->manifold_id()))
+          {
+            if (dim == 2)
+              {
+                CellData<1> line;
+                for (unsigned int v = 0; v < GeometryInfo<1>::vertices_per_cell;
+                     ++v)
+                  line.vertices[v] = new_vertex_index[face->vertex_index(v)];
+                line.boundary_id = face->boundary_id();
+                line.manifold_id = face->manifold_id();
+                subcelldata.boundary_lines.push_back(line);
+              }
+            else
+              {
+                CellData<2> quad;
+                for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell;
+                     ++v)
+                  quad.vertices[v] = new_vertex_index[face->vertex_index(v)];
+                quad.boundary_id = face->boundary_id();
+                quad.manifold_id = face->manifold_id();
+                subcelldata.boundary_quads.push_back(quad);
+              }
+          }
+    if (dim == 3)
+      {
+        // the triangulation is going to be cleared anyway, so we are free
+        // to use its user flags to visit each line only once
+        triangulation.clear_user_flags_line();
+        for (const auto &cell : old_cells)
+          for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+            {
+              const auto line = cell->line(l);
+              if (line->user_flag_set())
+                continue;
+              line->set_user_flag();
+              if (has_indicators(line->boundary_id(), line->manifold_id()))
+                {
+                  CellData<1> line_data;
+                  for (unsigned int v = 0;
+                       v < GeometryInfo<1>::vertices_per_cell;
+                       ++v)
+                    line_data.vertices[v] =
+                      new_vertex_index[line->vertex_index(v)];
+                  line_data.boundary_id = line->boundary_id();
+                  line_data.manifold_id = line->manifold_id();
+                  subcelldata.boundary_lines.push_back(line_data);
+                }
+            }
+      }
+
+    std::map<unsigned int, types::boundary_id> vertex_boundary_ids;
+    if (dim == 1)
+      for (const auto &cell : old_cells)
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->at_boundary(f))
+            {
+              const unsigned int vertex =
+                new_vertex_index[cell->face(f)->vertex_index(0)];
+              vertex_boundary_ids[vertex] = cell->face(f)->boundary_id();
+            }
+
+    // clearing the triangulation also removes the manifold objects, so
+    // keep copies of the ones in use
+    std::map<types::manifold_id,
+             std::unique_ptr<const Manifold<dim, spacedim>>>
+      manifolds;
+    for (const types::manifold_id manifold_id : triangulation.get_manifold_ids())
+      if (manifold_id != numbers::flat_manifold_id)
+        manifolds[manifold_id] =
+          triangulation.get_manifold(manifold_id).clone();
+
+    old_cells.clear();
+    triangulation.clear();
+    triangulation.create_triangulation(vertices, cells, subcelldata);
+
+    for (const auto &manifold : manifolds)
+      triangulation.set_manifold(manifold.first, *manifold.second);
+
+    if (dim == 1)
+      for (const auto &cell : triangulation.active_cell_iterators())
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->at_boundary(f))
+            cell->face(f)->set_boundary_id(
+              vertex_boundary_ids[cell->face(f)->vertex_index(0)]);
+  }
+
+
+
   // define some transformations in an anonymous namespace
   namespace
   {
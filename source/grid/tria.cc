@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/table.h>
 
@@ -1099,6 +1100,37 @@ namespace
   }
 
 
+
+  // Evaluate the function @p new_point on all the objects (lines or cells)
+  // given in the first argument and store the resulting points in the last
+  // argument. During refinement, the locations of new vertices only depend
+  // on the geometry of the coarse objects and the manifolds attached to
+  // them, but not on the creation of the new objects. This allows us to split the
+  // computation of the new vertices (which involves possibly expensive
+  // queries to manifolds) from the serial setup of the new objects and run
+  // it in parallel. The manifolds must therefore be safe to be called from
+  // several threads at once, just as when they are used by a mapping inside
+  // WorkStream::run().
+  template <typename IteratorType, int spacedim, typename Function>
+  void
+  compute_new_vertex_locations(const std::vector<IteratorType> &objects,
+                               const Function &                 new_point,
+                               std::vector<Point<spacedim>> &   new_vertices)
+  {
+    new_vertices.resize(objects.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(objects.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          new_vertices[i] = new_point(objects[i]);
+      },
+      // manifold queries are typically expensive enough to justify small
+      // chunks
+      64);
+  }
+
+
 } // end of anonymous namespace
 
 
@@ -4196,6 +4228,12 @@ namespace internal
        * lines, quads and cells have to
        * be passed, which point at (or
        * "before") the reserved space.
+       *
+       * For isotropic refinement, the
+       * last argument points to the
+       * location of the new vertex at
+       * the center of the cell. It is
+       * not used otherwise.
        */
       template <int spacedim>
       static void create_children(
@@ -4205,7 +4243,8 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &                                                 next_unused_cell,
-        typename Triangulation<2, spacedim>::cell_iterator &cell)
+        typename Triangulation<2, spacedim>::cell_iterator &cell,
+        const Point<spacedim> *                             center_vertex)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -4332,47 +4371,10 @@ namespace internal
 
             new_vertices[8] = next_unused_vertex;
 
-            // if this quad lives
-            // in 2d, then we can
-            // compute the new
-            // central vertex
-            // location just from
-            // the surrounding
-            // ones. If this is
-            // not the case, then
-            // we need to ask a
-            // boundary object
-            if (dim == spacedim)
-              {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
-                // if the user_flag is set, i.e. if the cell is at the
-                // boundary, use a different calculation of the middle vertex
-                // here. this is of advantage if the boundary is strongly
-                // curved (whereas the cell is not) and the cell has a high
-                // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
-              }
-            else
-              {
-                // if this quad lives in a higher dimensional space
-                // then we don't need to worry if it is at the
-                // boundary of the manifold -- we always have to use
-                // the boundary object anyway; so ignore whether the
-                // user flag is set or not
-                cell->clear_user_flag();
-
-                // new vertex is placed on the surface according to
-                // the information stored in the boundary class
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-              }
+            // the location of the new vertex has been computed by the
+            // caller, see execute_refinement()
+            Assert(center_vertex != nullptr, ExcInternalError());
+            triangulation.vertices[next_unused_vertex] = *center_vertex;
           }
 
 
@@ -5090,7 +5092,48 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_line_iterator
               next_unused_line = triangulation.begin_raw_line();
 
+            // compute the midpoints of all lines to be refined in
+            // parallel before setting up the new lines
+            std::vector<
+              typename Triangulation<dim, spacedim>::active_line_iterator>
+              lines_to_refine;
+            lines_to_refine.reserve(n_lines_in_pairs / 2);
             for (; line != endl; ++line)
+              if (line->user_flag_set())
+                lines_to_refine.push_back(line);
+
+            std::vector<Point<spacedim>> line_midpoints;
+            compute_new_vertex_locations(
+              lines_to_refine,
+              [&](const typename Triangulation<dim, spacedim>::
+                    active_line_iterator &flagged_line) -> Point<spacedim> {
+                if (spacedim == dim)
+                  {
+                    // for the case of a domain in an
+                    // equal-dimensional space we only have to treat
+                    // boundary lines differently; for interior
+                    // lines we can compute the midpoint as the mean
+                    // of the two vertices: if (line->at_boundary())
+                    return flagged_line->center(true);
+                  }
+                else
+                  // however, if spacedim>dim, we always have to ask
+                  // the boundary object for its answer. We use the
+                  // same object of the cell (which was stored in
+                  // line->user_index() before) unless a manifold_id
+                  // has been set on this very line.
+                  if (flagged_line->manifold_id() == numbers::flat_manifold_id)
+                  return triangulation.get_manifold(flagged_line->user_index())
+                    .get_new_point_on_line(flagged_line);
+                else
+                  return flagged_line->center(true);
+              },
+              line_midpoints);
+
+            // the lines are visited in the same order as above, so we can
+            // take their midpoints one after the other
+            unsigned int next_line_midpoint = 0;
+            for (line = triangulation.begin_active_line(); line != endl; ++line)
               if (line->user_flag_set())
                 {
                   // this line needs to be refined
@@ -5106,29 +5149,10 @@ namespace internal
                       "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                   triangulation.vertices_used[next_unused_vertex] = true;
 
-                  if (spacedim == dim)
-                    {
-                      // for the case of a domain in an
-                      // equal-dimensional space we only have to treat
-                      // boundary lines differently; for interior
-                      // lines we can compute the midpoint as the mean
-                      // of the two vertices: if (line->at_boundary())
-                      triangulation.vertices[next_unused_vertex] =
-                        line->center(true);
-                    }
-                  else
-                    // however, if spacedim>dim, we always have to ask
-                    // the boundary object for its answer. We use the
-                    // same object of the cell (which was stored in
-                    // line->user_index() before) unless a manifold_id
-                    // has been set on this very line.
-                    if (line->manifold_id() == numbers::flat_manifold_id)
-                    triangulation.vertices[next_unused_vertex] =
-                      triangulation.get_manifold(line->user_index())
-                        .get_new_point_on_line(line);
-                  else
-                    triangulation.vertices[next_unused_vertex] =
-                      line->center(true);
+                  Assert(lines_to_refine[next_line_midpoint] == line,
+                         ExcInternalError());
+                  triangulation.vertices[next_unused_vertex] =
+                    line_midpoints[next_line_midpoint++];
 
                   // now that we created the right point, make up the
                   // two child lines.  To this end, find a pair of
@@ -5210,6 +5234,40 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
+        // compute the new vertices at the centers of all cells that are
+        // refined isotropically in parallel. the lines of these cells have
+        // all been refined above, so the new vertices on the lines that
+        // enter the computation of the centers are already available
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells_with_center_vertex;
+        for (int level = 0;
+             level < static_cast<int>(triangulation.levels.size()) - 1;
+             ++level)
+          for (typename Triangulation<dim, spacedim>::active_cell_iterator
+                 cell = triangulation.begin_active(level);
+               cell != triangulation.begin_active(level + 1);
+               ++cell)
+            if (cell->refine_flag_set() == RefinementCase<dim>::cut_xy)
+              cells_with_center_vertex.push_back(cell);
+
+        std::vector<Point<spacedim>> cell_centers;
+        compute_new_vertex_locations(
+          cells_with_center_vertex,
+          [](const typename Triangulation<dim, spacedim>::active_cell_iterator
+               &cell) -> Point<spacedim> {
+            // if the cell is at the boundary, use a different calculation
+            // of the middle vertex here. this is of advantage if the
+            // boundary is strongly curved (whereas the cell is not) and the
+            // cell has a high aspect ratio. if the quad lives in a higher
+            // dimensional space, we always ask the manifold for the center
+            if (dim == spacedim && cell->at_boundary())
+              return cell->center(true, true);
+            else
+              return cell->center(true);
+          },
+          cell_centers);
+        unsigned int next_cell_center = 0;
+
         for (int level = 0;
              level < static_cast<int>(triangulation.levels.size()) - 1;
              ++level)
@@ -5226,14 +5284,14 @@ namespace internal
             for (; cell != endc; ++cell)
               if (cell->refine_flag_set())
                 {
-                  // set the user flag to indicate, that at least one
-                  // line is at the boundary
-
-                  // TODO[Tobias Leicht] find a better place to set
-                  // this flag, so that we do not need so much time to
-                  // check each cell here
-                  if (cell->at_boundary())
-                    cell->set_user_flag();
+                  const Point<spacedim> *center_vertex = nullptr;
+                  if (cell->refine_flag_set() == RefinementCase<dim>::cut_xy)
+                    {
+                      Assert(cells_with_center_vertex[next_cell_center] ==
+                               cell,
+                             ExcInternalError());
+                      center_vertex = &cell_centers[next_cell_center++];
+                    }
 
                   // actually set up the children and update neighbor
                   // information
@@ -5241,7 +5299,8 @@ namespace internal
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
+                                  cell,
+                                  center_vertex);
 
                   if ((check_for_distorted_cells == true) &&
                       has_distorted_children(
@@ -5599,7 +5658,28 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_line_iterator
               next_unused_line = triangulation.begin_raw_line();
 
+            // compute the midpoints of all lines to be refined in
+            // parallel before setting up the new lines
+            std::vector<
+              typename Triangulation<dim, spacedim>::active_line_iterator>
+              lines_to_refine;
             for (; line != endl; ++line)
+              if (line->user_flag_set())
+                lines_to_refine.push_back(line);
+
+            std::vector<Point<spacedim>> line_midpoints;
+            compute_new_vertex_locations(
+              lines_to_refine,
+              [](const typename Triangulation<dim, spacedim>::
+                   active_line_iterator &flagged_line) {
+                return flagged_line->center(true);
+              },
+              line_midpoints);
+
+            // the lines are visited in the same order as above, so we can
+            // take their midpoints one after the other
+            unsigned int next_line_midpoint = 0;
+            for (line = triangulation.begin_active_line(); line != endl; ++line)
               if (line->user_flag_set())
                 {
                   // this line needs to be refined
@@ -5615,8 +5695,10 @@ namespace internal
                       "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                   triangulation.vertices_used[next_unused_vertex] = true;
 
+                  Assert(lines_to_refine[next_line_midpoint] == line,
+                         ExcInternalError());
                   triangulation.vertices[next_unused_vertex] =
-                    line->center(true);
+                    line_midpoints[next_line_midpoint++];
 
                   // now that we created the right point, make up the
                   // two child lines (++ takes care of the end of the
@@ -5700,6 +5782,36 @@ namespace internal
         // anisotropically (this is transformed to case c), however we
         // might have to renumber/rename children...)
 
+        // compute the new vertices at the centers of all quads that are
+        // refined isotropically (case a) in parallel. quads with a user
+        // index are split anisotropically first and do not get a center
+        // vertex of their own. the list is sorted by the index of the
+        // quads, just like the loop below. all lines have been refined
+        // above, so the new vertices on the lines that enter the
+        // computation of the centers are already available
+        std::vector<typename Triangulation<dim, spacedim>::quad_iterator>
+          quads_with_center_vertex;
+        for (typename Triangulation<dim, spacedim>::quad_iterator quad =
+               triangulation.begin_quad();
+             quad != triangulation.end_quad();
+             ++quad)
+          if (quad->user_flag_set() && (quad->user_index() == 0) &&
+              (quad->refinement_case() ==
+               RefinementCase<dim - 1>::no_refinement))
+            quads_with_center_vertex.push_back(quad);
+
+        std::vector<Point<spacedim>> quad_centers;
+        compute_new_vertex_locations(
+          quads_with_center_vertex,
+          [](const typename Triangulation<dim, spacedim>::quad_iterator &quad) {
+            // the exact weights are chosen such as to minimize the
+            // distortion of the four new quads from the optimal shape, see
+            // below
+            return quad->center(true, true);
+          },
+          quad_centers);
+        unsigned int next_quad_center = 0;
+
         // we need a loop in cases c) and d), as the anisotropic
         // children migt have a lower index than the mother quad
         for (unsigned int loop = 0; loop < 2; ++loop)
@@ -6383,8 +6495,21 @@ namespace internal
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
                     // implementation
+                    //
+                    // the location of the new vertex has been computed
+                    // before the loop over all quads. the children of quads
+                    // in case d) may have been flagged as well, but only get
+                    // their user index in this loop and are then refined
+                    // anisotropically, so skip their entries
+                    while (next_quad_center < quads_with_center_vertex.size() &&
+                           quads_with_center_vertex[next_quad_center]
+                               ->index() < quad->index())
+                      ++next_quad_center;
+                    Assert(next_quad_center < quads_with_center_vertex.size() &&
+                             quads_with_center_vertex[next_quad_center] == quad,
+                           ExcInternalError());
                     triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                      quad_centers[next_quad_center++];
                     triangulation.vertices_used[next_unused_vertex] = true;
 
                     // now that we created the right point, make up
@@ -6641,6 +6766,29 @@ namespace internal
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        // compute the new vertices at the centers of all hexes that are
+        // refined isotropically in parallel. they only depend on the
+        // vertices on the lines and quads of the hexes, which have all
+        // been created above
+        std::vector<typename Triangulation<dim, spacedim>::active_hex_iterator>
+          hexes_with_center_vertex;
+        for (unsigned int level = 0; level != triangulation.levels.size() - 1;
+             ++level)
+          for (typename Triangulation<dim, spacedim>::active_hex_iterator hex =
+                 triangulation.begin_active_hex(level);
+               hex != triangulation.begin_active_hex(level + 1);
+               ++hex)
+            if (hex->refine_flag_set() == RefinementCase<dim>::cut_xyz)
+              hexes_with_center_vertex.push_back(hex);
+
+        std::vector<Point<spacedim>> hex_centers;
+        compute_new_vertex_locations(
+          hexes_with_center_vertex,
+          [](const typename Triangulation<dim, spacedim>::active_hex_iterator
+               &hex) { return hex->center(true, true); },
+          hex_centers);
+        unsigned int next_hex_center = 0;
+
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
              ++level)
           {
@@ -8951,11 +9099,14 @@ namespace internal
                           // the new vertex is definitely in the interior,
                           // so we need not worry about the
                           // boundary. However we need to worry about
-                          // Manifolds. Let the cell compute its own
-                          // center, by querying the underlying manifold
-                          // object.
+                          // Manifolds. The cell's center has been computed
+                          // by querying the underlying manifold object
+                          // before the loop over all levels.
+                          Assert(hexes_with_center_vertex[next_hex_center] ==
+                                   hex,
+                                 ExcInternalError());
                           triangulation.vertices[next_unused_vertex] =
-                            hex->center(true, true);
+                            hex_centers[next_hex_center++];
 
                           // set the data of the six lines.  first collect
                           // the indices of the seven vertices (consider
@@ -13197,6 +13348,28 @@ Triangulation<dim, spacedim>::locally_owned_subdomain() const
 
 
 
+template <int dim, int spacedim>
+unsigned int
+Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+  const unsigned int coarse_cell_index) const
+{
+  AssertIndexRange(coarse_cell_index, n_cells(0));
+  return coarse_cell_index;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+  const unsigned int coarse_cell_id) const
+{
+  AssertIndexRange(coarse_cell_id, n_cells(0));
+  return coarse_cell_id;
+}
+
+
+
 template <int dim, int spacedim>
 Triangulation<dim, spacedim> &
 Triangulation<dim, spacedim>::get_triangulation()
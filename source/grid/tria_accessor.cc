@@ -2216,7 +2216,8 @@ CellAccessor<dim, spacedim>::id() const
     }
 
   Assert(ptr.level() == 0, ExcInternalError());
-  const unsigned int coarse_index = ptr.index();
+  const unsigned int coarse_index =
+    this->tria->coarse_cell_index_to_coarse_cell_id(ptr.index());
 
   return CellId(coarse_index, n_child_indices, &(id[0]));
 }
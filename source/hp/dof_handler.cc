@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/thread_management.h>
@@ -1353,6 +1354,8 @@ namespace hp
            ExcMessage("The Triangulation you are using is empty!"));
     Assert(ff.size() > 0, ExcMessage("The hp::FECollection given is empty!"));
 
+    DEAL_II_INSTRUMENT_REGION("hp::DoFHandler::distribute_dofs");
+
     // don't create a new object if the one we have is already appropriate
     if (fe_collection != ff)
       fe_collection = hp::FECollection<dim, spacedim>(ff);
@@ -1466,8 +1469,7 @@ namespace hp
         std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                  ParallelShared<DoFHandler<dim, spacedim>>>(
           *this);
-    else if (dynamic_cast<
-               const parallel::distributed::Triangulation<dim, spacedim> *>(
+    else if (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
                &*this->tria) != nullptr)
       policy = std_cxx14::make_unique<
         internal::DoFHandlerImplementation::Policy::ParallelDistributed<
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
@@ -195,9 +196,19 @@ template <class Matrix>
 void
 SparseDirectUMFPACK::factorize(const Matrix &matrix)
 {
-  Assert(matrix.m() == matrix.n(), ExcNotQuadratic())
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  // keep the structure of the previous matrix and its symbolic
+  // factorization around so that we can reuse the latter if the new matrix
+  // has the same sparsity structure
+  std::vector<long int> previous_Ap;
+  std::vector<long int> previous_Ai;
+  previous_Ap.swap(Ap);
+  previous_Ai.swap(Ai);
+  void *previous_symbolic_decomposition = symbolic_decomposition;
+  symbolic_decomposition                = nullptr;
 
-    clear();
+  clear();
 
   _m = matrix.m();
   _n = matrix.n();
@@ -269,16 +280,27 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   sort_arrays(matrix);
 
   int status;
-  status = umfpack_dl_symbolic(N,
-                               N,
-                               Ap.data(),
-                               Ai.data(),
-                               Ax.data(),
-                               &symbolic_decomposition,
-                               control.data(),
-                               nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_symbolic", status));
+  if (previous_symbolic_decomposition != nullptr && previous_Ap == Ap &&
+      previous_Ai == Ai)
+    // the symbolic analysis only depends on the sparsity structure, so we
+    // can skip it and go straight to the numeric factorization
+    symbolic_decomposition = previous_symbolic_decomposition;
+  else
+    {
+      if (previous_symbolic_decomposition != nullptr)
+        umfpack_dl_free_symbolic(&previous_symbolic_decomposition);
+
+      status = umfpack_dl_symbolic(N,
+                                   N,
+                                   Ap.data(),
+                                   Ai.data(),
+                                   Ax.data(),
+                                   &symbolic_decomposition,
+                                   control.data(),
+                                   nullptr);
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_symbolic", status));
+    }
 
   status = umfpack_dl_numeric(Ap.data(),
                               Ai.data(),
@@ -289,8 +311,6 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                               nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
-
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
 }
 
 
@@ -342,6 +362,25 @@ SparseDirectUMFPACK::solve(BlockVector<double> &rhs_and_solution,
 
 
 
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &rhs_and_solutions,
+                           bool transpose /*=false*/) const
+{
+  // the numeric factorization is only read by umfpack_dl_solve, which
+  // allocates its own workspace, so the different right hand sides can be
+  // worked on concurrently
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    rhs_and_solutions.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        solve(rhs_and_solutions[i], transpose);
+    },
+    1);
+}
+
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &  matrix,
@@ -413,6 +452,17 @@ SparseDirectUMFPACK::solve(BlockVector<double> &, bool) const
 }
 
 
+
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &, bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &, Vector<double> &, bool)
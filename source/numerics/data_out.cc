@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
@@ -453,6 +454,8 @@ DataOut<dim, DoFHandlerType>::build_patches(
 
   this->validate_dataset_names();
 
+  DEAL_II_INSTRUMENT_REGION("DataOut::build_patches");
+
   // First count the cells we want to create patches of. Also fill the object
   // that maps the cell indices to the patch numbers, as this will be needed
   // for generation of neighborship information.
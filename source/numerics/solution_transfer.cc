@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/instrumentation.h>
 #include <deal.II/base/memory_consumption.h>
 
 #include <deal.II/distributed/tria.h>
@@ -39,6 +40,9 @@
 
 #include <deal.II/numerics/solution_transfer.h>
 
+#include <algorithm>
+#include <tuple>
+
 DEAL_II_NAMESPACE_OPEN
 
 template <int dim, typename VectorType, typename DoFHandlerType>
@@ -76,6 +80,7 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::clear()
   indices_on_cell.clear();
   dof_values_on_cell.clear();
   cell_map.clear();
+  packed_values.clear();
 
   prepared_for = none;
 }
@@ -86,6 +91,8 @@ template <int dim, typename VectorType, typename DoFHandlerType>
 void
 SolutionTransfer<dim, VectorType, DoFHandlerType>::prepare_for_pure_refinement()
 {
+  DEAL_II_INSTRUMENT_REGION("SolutionTransfer::prepare_for_pure_refinement");
+
   Assert(prepared_for != pure_refinement, ExcAlreadyPrepForRef());
   Assert(prepared_for != coarsening_and_refinement,
          ExcAlreadyPrepForCoarseAndRef());
@@ -128,6 +135,8 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::refine_interpolate(
   const VectorType &in,
   VectorType &      out) const
 {
+  DEAL_II_INSTRUMENT_REGION("SolutionTransfer::refine_interpolate");
+
   Assert(prepared_for == pure_refinement, ExcNotPrepared());
   Assert(in.size() == n_dofs_old, ExcDimensionMismatch(in.size(), n_dofs_old));
   Assert(out.size() == dof_handler->n_dofs(),
@@ -264,6 +273,9 @@ void
 SolutionTransfer<dim, VectorType, DoFHandlerType>::
   prepare_for_coarsening_and_refinement(const std::vector<VectorType> &all_in)
 {
+  DEAL_II_INSTRUMENT_REGION(
+    "SolutionTransfer::prepare_for_coarsening_and_refinement");
+
   Assert(prepared_for != pure_refinement, ExcAlreadyPrepForRef());
   Assert(prepared_for != coarsening_and_refinement,
          ExcAlreadyPrepForCoarseAndRef());
@@ -439,6 +451,8 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate(
   const std::vector<VectorType> &all_in,
   std::vector<VectorType> &      all_out) const
 {
+  DEAL_II_INSTRUMENT_REGION("SolutionTransfer::interpolate");
+
   Assert(prepared_for == coarsening_and_refinement, ExcNotPrepared());
   const unsigned int size = all_in.size();
   Assert(all_out.size() == size, ExcDimensionMismatch(all_out.size(), size));
@@ -591,6 +605,201 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate(
 
 
 
+template <int dim, typename VectorType, typename DoFHandlerType>
+void
+SolutionTransfer<dim, VectorType, DoFHandlerType>::
+  pack_for_coarsening_and_refinement(const std::vector<VectorType *> &all_in,
+                                     const bool release_input_vectors)
+{
+  DEAL_II_INSTRUMENT_REGION(
+    "SolutionTransfer::pack_for_coarsening_and_refinement");
+
+  Assert(prepared_for != pure_refinement, ExcAlreadyPrepForRef());
+  Assert(prepared_for != coarsening_and_refinement &&
+           prepared_for != packed_coarsening_and_refinement,
+         ExcAlreadyPrepForCoarseAndRef());
+  Assert(all_in.size() != 0,
+         ExcMessage("The array of input vectors you pass to this "
+                    "function has no elements. This is not useful."));
+
+  clear();
+
+  n_dofs_old = dof_handler->n_dofs();
+  for (unsigned int j = 0; j < all_in.size(); ++j)
+    Assert(all_in[j]->size() == n_dofs_old,
+           ExcDimensionMismatch(all_in[j]->size(), n_dofs_old));
+
+  // first store the dof indices of the cells that stay or are refined and
+  // determine the position of the values of the cells whose children are
+  // coarsened away, in the same way as
+  // prepare_for_coarsening_and_refinement() does
+  unsigned int n_cells_to_stay_or_refine = 0;
+  for (const auto &cell : dof_handler->active_cell_iterators())
+    if (!cell->coarsen_flag_set())
+      ++n_cells_to_stay_or_refine;
+  std::vector<std::vector<types::global_dof_index>>(n_cells_to_stay_or_refine)
+    .swap(indices_on_cell);
+
+  std::vector<std::tuple<typename DoFHandlerType::cell_iterator,
+                         unsigned int,
+                         std::size_t>>
+               coarsen_fathers;
+  std::size_t  n_coarsen_values = 0;
+  unsigned int n_sr             = 0;
+  for (typename DoFHandlerType::cell_iterator cell = dof_handler->begin();
+       cell != dof_handler->end();
+       ++cell)
+    {
+      if (cell->active() && !cell->coarsen_flag_set())
+        {
+          indices_on_cell[n_sr].resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(indices_on_cell[n_sr]);
+          cell_map[std::make_pair(cell->level(), cell->index())] =
+            Pointerstruct(&indices_on_cell[n_sr], cell->active_fe_index());
+          ++n_sr;
+        }
+      else if (cell->has_children() && cell->child(0)->coarsen_flag_set())
+        {
+          // take the FE index from the child with most degrees of freedom
+          // locally, see prepare_for_coarsening_and_refinement()
+          unsigned int most_general_child = 0;
+          for (unsigned int child = 1; child < cell->n_children(); ++child)
+            {
+              Assert(cell->child(child)->coarsen_flag_set(),
+                     ExcMessage(
+                       "It looks like you didn't call "
+                       "Triangulation::prepare_coarsening_and_refinement "
+                       "before calling the current function. This can't "
+                       "work."));
+              if (cell->child(child)->get_fe().dofs_per_cell >
+                  cell->child(most_general_child)->get_fe().dofs_per_cell)
+                most_general_child = child;
+            }
+          const unsigned int target_fe_index =
+            cell->child(most_general_child)->active_fe_index();
+
+          cell_map[std::make_pair(cell->level(), cell->index())] =
+            Pointerstruct(n_coarsen_values, target_fe_index);
+          coarsen_fathers.emplace_back(cell,
+                                       target_fe_index,
+                                       n_dofs_old + n_coarsen_values);
+          n_coarsen_values +=
+            cell->get_dof_handler().get_fe(target_fe_index).dofs_per_cell;
+        }
+    }
+  Assert(n_sr == n_cells_to_stay_or_refine, ExcInternalError());
+
+  // then copy the values of one vector after the other into its buffer and
+  // release the vector right away, so that the additional memory needed is
+  // at most the size of one vector
+  packed_values.resize(all_in.size());
+  Vector<typename VectorType::value_type> local_values;
+  for (unsigned int j = 0; j < all_in.size(); ++j)
+    {
+      std::vector<typename VectorType::value_type> &values = packed_values[j];
+      values.resize(n_dofs_old + n_coarsen_values);
+
+      for (const std::vector<types::global_dof_index> &indices :
+           indices_on_cell)
+        for (const types::global_dof_index index : indices)
+          values[index] =
+            internal::ElementAccess<VectorType>::get(*all_in[j], index);
+
+      for (const auto &father : coarsen_fathers)
+        {
+          const auto &       cell     = std::get<0>(father);
+          const unsigned int fe_index = std::get<1>(father);
+          local_values.reinit(
+            cell->get_dof_handler().get_fe(fe_index).dofs_per_cell, true);
+          cell->get_interpolated_dof_values(*all_in[j], local_values, fe_index);
+          std::copy(local_values.begin(),
+                    local_values.end(),
+                    values.begin() + std::get<2>(father));
+        }
+
+      if (release_input_vectors)
+        {
+          VectorType empty_vector;
+          all_in[j]->swap(empty_vector);
+        }
+    }
+
+  prepared_for = packed_coarsening_and_refinement;
+}
+
+
+
+template <int dim, typename VectorType, typename DoFHandlerType>
+void
+SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate(
+  const std::vector<VectorType *> &all_out)
+{
+  DEAL_II_INSTRUMENT_REGION("SolutionTransfer::interpolate");
+
+  Assert(prepared_for == packed_coarsening_and_refinement, ExcNotPrepared());
+  Assert(all_out.size() == packed_values.size(),
+         ExcDimensionMismatch(all_out.size(), packed_values.size()));
+  for (unsigned int j = 0; j < all_out.size(); ++j)
+    Assert(all_out[j]->size() == dof_handler->n_dofs(),
+           ExcDimensionMismatch(all_out[j]->size(), dof_handler->n_dofs()));
+
+  // the cells in cell_map are exactly the ones that carry data, so loop over
+  // the map rather than over all cells of the new mesh. Write one vector
+  // after the other and free its buffer as soon as it is not needed anymore
+  Vector<typename VectorType::value_type> local_values;
+  for (unsigned int j = 0; j < all_out.size(); ++j)
+    {
+      const std::vector<typename VectorType::value_type> &values =
+        packed_values[j];
+
+      for (const auto &entry : cell_map)
+        {
+          const typename DoFHandlerType::cell_iterator cell(
+            &dof_handler->get_triangulation(),
+            entry.first.first,
+            entry.first.second,
+            &*dof_handler);
+          const Pointerstruct &data = entry.second;
+
+          if (data.indices_ptr != nullptr)
+            {
+              // cell stayed as it was or was refined
+              const std::vector<types::global_dof_index> &indices =
+                *data.indices_ptr;
+              local_values.reinit(indices.size(), true);
+              for (unsigned int i = 0; i < indices.size(); ++i)
+                local_values(i) = values[indices[i]];
+            }
+          else
+            {
+              // the children of this cell were deleted
+              Assert(!cell->has_children(), ExcInternalError());
+              local_values.reinit(cell->get_dof_handler()
+                                    .get_fe(data.active_fe_index)
+                                    .dofs_per_cell,
+                                  true);
+              std::copy(values.begin() + n_dofs_old +
+                          data.packed_values_offset,
+                        values.begin() + n_dofs_old +
+                          data.packed_values_offset + local_values.size(),
+                        local_values.begin());
+            }
+
+          // this also interpolates between different elements in the hp
+          // case
+          cell->set_dof_values_by_interpolation(local_values,
+                                                *all_out[j],
+                                                data.active_fe_index);
+        }
+
+      std::vector<typename VectorType::value_type>().swap(packed_values[j]);
+    }
+
+  clear();
+}
+
+
+
 template <int dim, typename VectorType, typename DoFHandlerType>
 std::size_t
 SolutionTransfer<dim, VectorType, DoFHandlerType>::memory_consumption() const
@@ -603,7 +812,8 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::memory_consumption() const
           MemoryConsumption::memory_consumption(n_dofs_old) +
           sizeof(prepared_for) +
           MemoryConsumption::memory_consumption(indices_on_cell) +
-          MemoryConsumption::memory_consumption(dof_values_on_cell));
+          MemoryConsumption::memory_consumption(dof_values_on_cell) +
+          MemoryConsumption::memory_consumption(packed_values));
 }
 
 
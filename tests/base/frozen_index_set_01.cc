@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2008 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that FrozenIndexSet gives the same answers as IndexSet for sets with
+// few ranges, for fragmented sets whose chunks are stored as arrays, bitmaps
+// and runs, and for the bulk query functions
+
+#include <deal.II/base/frozen_index_set.h>
+#include <deal.II/base/index_set.h>
+
+#include "../tests.h"
+
+
+void
+check(const IndexSet &index_set)
+{
+  const FrozenIndexSet frozen(index_set);
+  deallog << "representation: "
+          << (frozen.get_representation() ==
+                  FrozenIndexSet::Representation::ranges ?
+                "ranges" :
+                "chunks")
+          << ", n_elements: " << frozen.n_elements() << std::endl;
+  AssertThrow(frozen.size() == index_set.size(), ExcInternalError());
+  AssertThrow(frozen.n_elements() == index_set.n_elements(),
+              ExcInternalError());
+
+  // check all indices one by one
+  for (types::global_dof_index i = 0; i < index_set.size(); ++i)
+    {
+      AssertThrow(frozen.is_element(i) == index_set.is_element(i),
+                  ExcInternalError());
+      AssertThrow(frozen.index_within_set(i) == index_set.index_within_set(i),
+                  ExcInternalError());
+    }
+  for (types::global_dof_index n = 0; n < index_set.n_elements(); ++n)
+    AssertThrow(frozen.nth_index_in_set(n) == index_set.nth_index_in_set(n),
+                ExcInternalError());
+
+  // check the bulk query with sorted indices and with indices in random
+  // order
+  std::vector<types::global_dof_index> indices;
+  for (types::global_dof_index i = 0; i < index_set.size(); i += 3)
+    indices.push_back(i);
+  for (unsigned int i = 0; i < 10000; ++i)
+    indices.push_back(Testing::rand() % index_set.size());
+  std::vector<types::global_dof_index> positions(indices.size());
+  frozen.index_within_set(make_array_view(indices),
+                          make_array_view(positions));
+  unsigned int n_elements = 0;
+  for (unsigned int i = 0; i < indices.size(); ++i)
+    {
+      AssertThrow(positions[i] == index_set.index_within_set(indices[i]),
+                  ExcInternalError());
+      if (index_set.is_element(indices[i]))
+        ++n_elements;
+    }
+  AssertThrow(frozen.n_elements_in_set(make_array_view(indices)) ==
+                n_elements,
+              ExcInternalError());
+  deallog << "OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // an empty set and a set with few ranges
+  check(IndexSet(100));
+  {
+    IndexSet index_set(1000000);
+    index_set.add_range(1000, 400000);
+    index_set.add_range(500000, 500010);
+    index_set.add_index(999999);
+    check(index_set);
+  }
+
+  // a fragmented set: sparse in the first chunks, dense in the middle ones,
+  // and consisting of runs of 100 indices in the last ones
+  {
+    IndexSet index_set(1000000);
+    for (unsigned int i = 0; i < 200000; i += 37)
+      index_set.add_index(i);
+    for (unsigned int i = 200000; i < 600000; ++i)
+      if (Testing::rand() % 3 != 0)
+        index_set.add_index(i);
+    for (unsigned int i = 600000; i < 1000000; i += 1000)
+      index_set.add_range(i, i + 100);
+    check(index_set);
+  }
+}
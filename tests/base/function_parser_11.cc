@@ -0,0 +1,190 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the bytecode evaluation mode of FunctionParser: compare it with
+// muparser for expressions that use all supported operators and functions,
+// for single points and lists of points, and from several threads. also
+// check that calling initialize() again and switching the mode back and forth
+// uses the current expressions
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+void
+compare(const std::string &expression)
+{
+  std::map<std::string, double> constants;
+  constants["pi"] = numbers::PI;
+  constants["c"]  = 0.25;
+
+  FunctionParser<2> reference(1, 0.5);
+  reference.initialize("x,y,t", expression, constants, true);
+
+  FunctionParser<2> function(1, 0.5);
+  function.set_evaluation_mode(FunctionParser<2>::EvaluationMode::bytecode);
+  function.initialize("x,y,t", expression, constants, true);
+
+  std::vector<Point<2>> points(37);
+  for (unsigned int i = 0; i < points.size(); ++i)
+    points[i] = Point<2>(-1.2 + 0.07 * i, 0.9 - 0.05 * i);
+
+  std::vector<double> values(points.size());
+  function.value_list(points, values);
+
+  double difference = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      const double value = reference.value(points[i]);
+      const double scale = std::max(1., std::abs(value));
+      difference =
+        std::max({difference,
+                  std::abs(values[i] - value) / scale,
+                  std::abs(function.value(points[i]) - value) / scale});
+    }
+
+  deallog << expression << ": bytecode " << function.uses_bytecode()
+          << ", equal " << (difference < 1e-14) << std::endl;
+}
+
+
+void
+test_vector_valued()
+{
+  FunctionParser<3> reference(2);
+  reference.initialize("x,y,z",
+                       "x*y+z; sin(x)*exp(-y^2)",
+                       std::map<std::string, double>());
+
+  FunctionParser<3> function(2);
+  function.set_evaluation_mode(FunctionParser<3>::EvaluationMode::bytecode);
+  function.initialize("x,y,z",
+                      "x*y+z; sin(x)*exp(-y^2)",
+                      std::map<std::string, double>());
+
+  std::vector<Point<3>> points;
+  for (unsigned int i = 0; i < 10; ++i)
+    points.emplace_back(0.1 * i, 1. - 0.2 * i, 0.3);
+  std::vector<Vector<double>> values(points.size(), Vector<double>(2));
+  function.vector_value_list(points, values);
+
+  double difference = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      Vector<double> value(2);
+      reference.vector_value(points[i], value);
+      value -= values[i];
+      difference = std::max(difference, value.linfty_norm());
+    }
+  deallog << "vector-valued: equal " << (difference < 1e-14) << std::endl;
+}
+
+
+void
+evaluate(const FunctionParser<2> &function, double *sum)
+{
+  std::vector<Point<2>> points(1000);
+  for (unsigned int i = 0; i < points.size(); ++i)
+    points[i] = Point<2>(0.001 * i, 1.);
+  std::vector<double> values(points.size());
+  function.value_list(points, values);
+  *sum = 0;
+  for (const double value : values)
+    *sum += value;
+}
+
+
+void
+test_threads()
+{
+  FunctionParser<2> function("x*y");
+  function.set_evaluation_mode(FunctionParser<2>::EvaluationMode::bytecode);
+
+  std::vector<double>      sums(8);
+  Threads::TaskGroup<void> tasks;
+  for (double &sum : sums)
+    tasks += Threads::new_task(&evaluate, function, &sum);
+  tasks.join_all();
+
+  for (const double sum : sums)
+    AssertThrow(std::abs(sum - 499.5) < 1e-10, ExcInternalError());
+  deallog << "threads: OK" << std::endl;
+}
+
+
+void
+test_reinitialize()
+{
+  FunctionParser<2> function(1);
+  function.set_evaluation_mode(FunctionParser<2>::EvaluationMode::bytecode);
+  function.initialize("x,y", "x+y", std::map<std::string, double>());
+  {
+    // the expression given to initialize() only lives during that call
+    const std::string expression = "x*y-1";
+    function.initialize("x,y", expression, std::map<std::string, double>());
+  }
+  const Point<2> point(2., 3.);
+  deallog << "reinitialized: " << function.value(point) << ' '
+          << function.uses_bytecode() << std::endl;
+
+  function.set_evaluation_mode(FunctionParser<2>::EvaluationMode::muparser);
+  function.initialize("x,y", "x-y", std::map<std::string, double>());
+  deallog << "muparser: " << function.value(point) << ' '
+          << function.uses_bytecode() << std::endl;
+
+  function.set_evaluation_mode(FunctionParser<2>::EvaluationMode::bytecode);
+  deallog << "bytecode: " << function.value(point) << ' '
+          << function.uses_bytecode() << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  compare("x+y*t-c");
+  compare("-x^2 + 2^-y - x^3");
+  compare("(x-y)/(1+x*x) * pi");
+  compare("x < y ? sin(x) : cos(y)");
+  compare("if(x > 0 & y > 0, 1, 0) + (x <= 0.1 | y >= 0.5)");
+  compare("(x != y) + (x == x) + (x > y && y > 0) + (x < 0 || y < 0)");
+  compare("tan(x) + asin(x/2) + acos(y/2) + atan(x) + atan2(y, x)");
+  compare("sinh(x) + cosh(y) + tanh(x) + asinh(x) + atanh(y/2)");
+  compare("acosh(3+x) + log2(2+x) + log10(2+y) + log(2+x) + ln(2+y)");
+  compare("exp(x) + sqrt(2+y) + sign(x) + rint(x) + abs(y)");
+  compare("int(x) + ceil(y) + floor(x) + cot(1+x) + csc(2+y) + sec(x)");
+  compare("pow(2+x, y) + erfc(x)");
+  compare("sum(x, y, 1) + avg(x, y) + min(x, y, 0.5) + max(x, -y)");
+  compare("_pi * _e * x");
+  compare("1.5e-1 * x + .5 * y");
+
+  // rand() and rand_seed() are left to muparser
+  FunctionParser<2> random("x + rand_seed(10)");
+  random.set_evaluation_mode(FunctionParser<2>::EvaluationMode::bytecode);
+  deallog << "rand_seed: bytecode " << random.uses_bytecode() << std::endl;
+
+  test_vector_valued();
+  test_threads();
+  test_reinitialize();
+}
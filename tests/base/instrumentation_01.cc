@@ -0,0 +1,99 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that the instrumented regions of the library are reported to the
+// attached sink, and not reported anymore after the sink has been detached
+
+#include <deal.II/base/instrumentation.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <map>
+#include <sstream>
+
+#include "../tests.h"
+
+
+int
+main()
+{
+  initlog();
+
+  Triangulation<2> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  FE_Q<2>       fe(1);
+  DoFHandler<2> dof_handler(tria);
+
+  std::map<std::string, unsigned int> n_calls;
+  Threads::Mutex                      mutex;
+  Instrumentation::CallbackSink       callback_sink(
+    [&](const char *name, const double wall_time) {
+      Threads::Mutex::ScopedLock lock(mutex);
+      ++n_calls[name];
+      AssertThrow(wall_time >= 0, ExcInternalError());
+    });
+  Instrumentation::attach_sink(callback_sink);
+
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+  // a second call returns immediately and is not reported
+  constraints.close();
+
+  Vector<double> solution(dof_handler.n_dofs());
+  DataOut<2>     data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.build_patches();
+
+  Instrumentation::detach_sink();
+  dof_handler.distribute_dofs(fe);
+
+  for (const auto &entry : n_calls)
+    deallog << entry.first << ": " << entry.second << std::endl;
+
+  // report to a TimerOutput object
+  std::stringstream ss;
+  TimerOutput       timer(ss, TimerOutput::never, TimerOutput::wall_times);
+  Instrumentation::TimerOutputSink timer_sink(timer);
+  Instrumentation::attach_sink(timer_sink);
+  {
+    TimerOutput::Scope scope(timer, "Setup");
+    dof_handler.distribute_dofs(fe);
+  }
+  Instrumentation::detach_sink();
+
+  for (const auto &node : timer.get_call_tree_data())
+    {
+      std::string path;
+      for (const auto &name : node.first)
+        path += (path.empty() ? "" : "/") + name;
+      deallog << path << ": " << node.second.n_calls << std::endl;
+    }
+}
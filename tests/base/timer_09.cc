@@ -0,0 +1,97 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the call tree of TimerOutput with nested sections and with sections
+// entered on several threads, and the export of the recorded events
+
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/timer.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+int
+main()
+{
+  initlog();
+
+  std::stringstream ss;
+  TimerOutput t(ss, TimerOutput::never, TimerOutput::wall_times);
+  t.enable_trace_recording();
+
+  t.enter_subsection("outer");
+  t.enter_subsection("inner");
+  t.leave_subsection("inner");
+  t.enter_subsection("inner");
+  t.leave_subsection();
+  t.leave_subsection("outer");
+
+  t.enter_subsection("inner");
+  t.leave_subsection("inner");
+
+  {
+    TimerOutput::Scope scope(t, "threads");
+    Threads::TaskGroup<> tasks;
+    for (unsigned int i = 0; i < 8; ++i)
+      tasks += Threads::new_task([&t]() {
+        TimerOutput::ThreadScope task_scope(t, "task");
+        for (unsigned int j = 0; j < 3; ++j)
+          {
+            TimerOutput::ThreadScope work_scope(t, "work");
+          }
+      });
+    tasks.join_all();
+  }
+
+  // thread sections outside of any section go to the top level
+  {
+    TimerOutput::ThreadScope scope(t, "task");
+  }
+
+  for (const auto &node : t.get_call_tree_data())
+    {
+      std::string path;
+      for (const auto &name : node.first)
+        path += (path.empty() ? "" : "/") + name;
+      deallog << path << ": " << node.second.n_calls << " calls, time "
+              << (node.second.wall_time.avg >= 0) << std::endl;
+    }
+
+  // print the name column of the table, the times vary from run to run
+  t.print_call_tree();
+  std::string line;
+  while (std::getline(ss, line))
+    if (line.size() > 0 && line[0] == '|')
+      deallog << line.substr(0, line.find('|', 1)) << std::endl;
+
+  std::ostringstream trace;
+  t.write_chrome_trace(trace);
+  const std::string trace_string = trace.str();
+  const std::string event_type   = "\"ph\":\"X\"";
+  unsigned int      n_events     = 0;
+  for (std::size_t pos = trace_string.find(event_type);
+       pos != std::string::npos;
+       pos = trace_string.find(event_type, pos + 1))
+    ++n_events;
+  deallog << "trace starts with: " << trace_string.substr(0, 15) << std::endl;
+  deallog << "number of events: " << n_events << std::endl;
+
+  t.reset();
+  deallog << "nodes after reset: " << t.get_call_tree_data().size()
+          << std::endl;
+}
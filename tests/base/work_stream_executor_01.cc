@@ -0,0 +1,182 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2008 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test WorkStream::Executor: repeated runs with the sequential and the
+// concurrent copier and with colored iterators give the right results, and
+// the scratch objects are kept between runs
+
+#include <deal.II/base/work_stream.h>
+
+#include <atomic>
+
+#include "../tests.h"
+
+
+std::atomic<unsigned int> n_scratch_copies(0);
+
+struct ScratchData
+{
+  ScratchData() = default;
+
+  ScratchData(const ScratchData &)
+  {
+    ++n_scratch_copies;
+  }
+};
+
+
+struct CopyData
+{
+  unsigned int computed;
+};
+
+
+void
+worker(const std::vector<unsigned int>::const_iterator &i,
+       ScratchData &,
+       CopyData &copy_data)
+{
+  copy_data.computed = *i * 2;
+}
+
+
+std::vector<unsigned int> copied;
+
+void
+copier(const CopyData &copy_data)
+{
+  copied.push_back(copy_data.computed);
+}
+
+
+std::atomic<unsigned int> sum(0);
+
+void
+concurrent_copier(const CopyData &copy_data)
+{
+  sum += copy_data.computed;
+}
+
+
+class MainClass
+{
+public:
+  void
+  worker(const std::vector<unsigned int>::const_iterator &i,
+         ScratchData &,
+         CopyData &copy_data)
+  {
+    copy_data.computed = *i + 1;
+  }
+
+  void
+  copier(const CopyData &copy_data)
+  {
+    result += copy_data.computed;
+  }
+
+  unsigned int result = 0;
+};
+
+
+
+void
+test()
+{
+  std::vector<unsigned int> v;
+  for (unsigned int i = 0; i < 200; ++i)
+    v.push_back(i);
+
+  using Iterator = std::vector<unsigned int>::const_iterator;
+  const ScratchData                                     sample_scratch_data;
+  const CopyData                                        sample_copy_data{0};
+  WorkStream::Executor<Iterator, ScratchData, CopyData> executor(
+    sample_scratch_data, sample_copy_data);
+  // do not count the copy of the sample object the executor stores
+  n_scratch_copies = 0;
+
+  // the sequential copier needs to see the items in order in every run
+  bool in_order = true;
+  for (unsigned int run = 0; run < 5; ++run)
+    {
+      copied.clear();
+      executor.run(v.cbegin(), v.cend(), &worker, &copier);
+      AssertThrow(copied.size() == v.size(), ExcInternalError());
+      for (unsigned int i = 0; i < v.size(); ++i)
+        if (copied[i] != 2 * v[i])
+          in_order = false;
+    }
+  deallog << "sequential copier in order: " << in_order << std::endl;
+
+  // the scratch objects are created once per thread, not once per run
+  const unsigned int n_copies = n_scratch_copies;
+  deallog << "scratch objects kept: "
+          << (executor.n_scratch_data_objects() == n_copies) << std::endl;
+  deallog << "at most one scratch object per thread: "
+          << (n_copies <= MultithreadInfo::n_threads()) << std::endl;
+
+  for (unsigned int run = 0; run < 5; ++run)
+    {
+      sum = 0;
+      executor.run(v.cbegin(),
+                   v.cend(),
+                   &worker,
+                   &concurrent_copier,
+                   WorkStream::CopierMode::concurrent);
+      AssertThrow(sum == 199 * 200, ExcInternalError());
+    }
+  deallog << "concurrent copier sum: " << sum << std::endl;
+
+  // with colored iterators, the copiers of the items of one color do not
+  // conflict
+  std::vector<std::vector<Iterator>> colored_iterators(2);
+  for (Iterator p = v.cbegin(); p != v.cend(); ++p)
+    colored_iterators[*p % 2].push_back(p);
+  std::vector<unsigned int> result(v.size());
+  for (unsigned int run = 0; run < 5; ++run)
+    executor.run(colored_iterators,
+                 &worker,
+                 [&](const CopyData &copy_data) {
+                   result[copy_data.computed / 2] += copy_data.computed;
+                 });
+  bool colored_correct = true;
+  for (unsigned int i = 0; i < v.size(); ++i)
+    if (result[i] != 5 * 2 * v[i])
+      colored_correct = false;
+  deallog << "colored run correct: " << colored_correct << std::endl;
+
+  MainClass main_object;
+  executor.run(v.cbegin(),
+               v.cend(),
+               main_object,
+               &MainClass::worker,
+               &MainClass::copier);
+  deallog << "member functions: " << main_object.result << std::endl;
+
+  executor.clear();
+  deallog << "scratch objects after clear: "
+          << executor.n_scratch_data_objects() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that SolutionTransfer::pack_for_coarsening_and_refinement() and the
+// interpolate() function taking pointers give the same result as
+// prepare_for_coarsening_and_refinement() and interpolate() with a vector of
+// vectors, and that the input vectors are released
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/solution_transfer.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename DoFHandlerType, typename FEType>
+void
+test(const FEType &fe, const unsigned int n_fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  DoFHandlerType dof_handler(tria);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cell->set_active_fe_index(cell->index() % n_fe);
+  dof_handler.distribute_dofs(fe);
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.4)
+      cell->set_refine_flag();
+    else if (cell->center()[0] > 0.6)
+      cell->set_coarsen_flag();
+  tria.prepare_coarsening_and_refinement();
+
+  std::vector<Vector<double>> reference_in(
+    3, Vector<double>(dof_handler.n_dofs()));
+  for (Vector<double> &vector : reference_in)
+    for (double &value : vector)
+      value = random_value<double>();
+  Vector<double> u0 = reference_in[0], u1 = reference_in[1],
+                 u2 = reference_in[2];
+
+  SolutionTransfer<dim, Vector<double>, DoFHandlerType> reference_transfer(
+    dof_handler);
+  reference_transfer.prepare_for_coarsening_and_refinement(reference_in);
+
+  SolutionTransfer<dim, Vector<double>, DoFHandlerType> packed_transfer(
+    dof_handler);
+  packed_transfer.pack_for_coarsening_and_refinement({&u0, &u1});
+  deallog << "Sizes after packing: " << u0.size() << " " << u1.size()
+          << std::endl;
+
+  SolutionTransfer<dim, Vector<double>, DoFHandlerType> kept_transfer(
+    dof_handler);
+  kept_transfer.pack_for_coarsening_and_refinement({&u2}, false);
+  deallog << "Size without release: "
+          << (u2.size() == reference_in[2].size()) << std::endl;
+
+  tria.execute_coarsening_and_refinement();
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->center()[1] < 0.3)
+      cell->set_active_fe_index(n_fe - 1);
+  dof_handler.distribute_dofs(fe);
+
+  std::vector<Vector<double>> reference_out(
+    3, Vector<double>(dof_handler.n_dofs()));
+  reference_transfer.interpolate(reference_in, reference_out);
+
+  u0.reinit(dof_handler.n_dofs());
+  u1.reinit(dof_handler.n_dofs());
+  packed_transfer.interpolate({&u0, &u1});
+
+  Vector<double> u2_new(dof_handler.n_dofs());
+  std::vector<Vector<double> *> kept_out = {&u2_new};
+  kept_transfer.interpolate(kept_out);
+
+  u0 -= reference_out[0];
+  u1 -= reference_out[1];
+  u2_new -= reference_out[2];
+  deallog << "Differences: " << u0.linfty_norm() << " " << u1.linfty_norm()
+          << " " << u2_new.linfty_norm() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("DoFHandler");
+  test<2, DoFHandler<2>>(FE_Q<2>(2), 1);
+  deallog.pop();
+
+  hp::FECollection<3> fe;
+  fe.push_back(FE_Q<3>(1));
+  fe.push_back(FE_Q<3>(2));
+  deallog.push("hp::DoFHandler");
+  test<3, hp::DoFHandler<3>>(fe, fe.size());
+  deallog.pop();
+}
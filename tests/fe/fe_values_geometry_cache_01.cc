@@ -0,0 +1,142 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that an FEValues object attached to an FEValuesGeometryCache
+// computes the same data as one without cache on a mesh with cells of two
+// different sizes, that the cache stores one entry per translation class,
+// and that it is only used for supported mappings and elements
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_geometry_cache.h>
+#include <deal.II/fe/mapping_cartesian.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const Mapping<dim> &mapping)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 3, -1., 2.);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>         fe(2);
+  const QGauss<dim> quadrature(3);
+  const UpdateFlags flags = update_values | update_gradients |
+                            update_hessians | update_quadrature_points |
+                            update_JxW_values;
+
+  FEValuesGeometryCache<dim> cache;
+  FEValues<dim>              fe_values(mapping, fe, quadrature, flags);
+  FEValues<dim>              fe_values_cached(mapping, fe, quadrature, flags);
+  fe_values_cached.attach_geometry_cache(cache);
+
+  double difference = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values_cached.reinit(cell);
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          difference =
+            std::max(difference,
+                     std::abs(fe_values.JxW(q) - fe_values_cached.JxW(q)));
+          difference = std::max(difference,
+                                fe_values.quadrature_point(q).distance(
+                                  fe_values_cached.quadrature_point(q)));
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            {
+              difference =
+                std::max(difference,
+                         std::abs(fe_values.shape_value(i, q) -
+                                  fe_values_cached.shape_value(i, q)));
+              difference = std::max(difference,
+                                    (fe_values.shape_grad(i, q) -
+                                     fe_values_cached.shape_grad(i, q))
+                                      .norm());
+              difference = std::max(difference,
+                                    (fe_values.shape_hessian(i, q) -
+                                     fe_values_cached.shape_hessian(i, q))
+                                      .norm());
+            }
+        }
+    }
+  deallog << "same values: " << (difference < 1e-10) << std::endl;
+  deallog << "entries: " << cache.n_entries() << std::endl;
+
+  // a new object starts out without a previous cell and needs to get its
+  // data from the cache
+  const unsigned long long int n_hits = cache.n_hits();
+  FEValues<dim> fe_values_new(mapping, fe, quadrature, flags);
+  fe_values_new.attach_geometry_cache(cache);
+  fe_values_new.reinit(tria.begin_active());
+  deallog << "new object served from cache: " << (cache.n_hits() > n_hits)
+          << std::endl;
+  deallog << "entries: " << cache.n_entries() << std::endl;
+
+  cache.clear();
+  deallog << "entries after clear: " << cache.n_entries() << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_supported()
+{
+  deallog << "supported FE_Q/MappingQ1: "
+          << FEValuesGeometryCache<dim>::is_supported(MappingQGeneric<dim>(1),
+                                                      FE_Q<dim>(2))
+          << std::endl;
+  deallog << "supported FE_Q/MappingQ2: "
+          << FEValuesGeometryCache<dim>::is_supported(MappingQGeneric<dim>(2),
+                                                      FE_Q<dim>(2))
+          << std::endl;
+  deallog << "supported FE_RaviartThomas/MappingQ1: "
+          << FEValuesGeometryCache<dim>::is_supported(MappingQGeneric<dim>(1),
+                                                      FE_RaviartThomas<dim>(0))
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(MappingQGeneric<2>(1));
+  test<2>(MappingCartesian<2>());
+  test_supported<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(MappingQGeneric<3>(1));
+  test<3>(MappingCartesian<3>());
+  test_supported<3>();
+  deallog.pop();
+}
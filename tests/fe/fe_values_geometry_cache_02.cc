@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check FEValuesGeometryCache with an FESystem, with FEValues objects that
+// use different but equal mapping objects and alternate between cells, and
+// with the per-thread copies of WorkStream::run(). all results are compared
+// against FEValues objects without a cache
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_geometry_cache.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+// a number that depends on all values computed by an FEValues object on the
+// present cell
+template <int dim>
+double
+cell_value(const FEValues<dim> &fe_values)
+{
+  double value = 0;
+  for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+    for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+      value += (fe_values.shape_value(i, q) +
+                fe_values.shape_grad(i, q) * fe_values.quadrature_point(q)) *
+               fe_values.JxW(q);
+  return value;
+}
+
+
+
+template <int dim>
+struct ScratchData
+{
+  ScratchData(const Mapping<dim> &        mapping,
+              const FiniteElement<dim> &  fe,
+              const Quadrature<dim> &     quadrature,
+              const UpdateFlags           flags,
+              FEValuesGeometryCache<dim> &cache)
+    : fe_values(mapping, fe, quadrature, flags)
+    , cache(&cache)
+  {
+    fe_values.attach_geometry_cache(cache);
+  }
+
+  ScratchData(const ScratchData &scratch)
+    : fe_values(scratch.fe_values.get_mapping(),
+                scratch.fe_values.get_fe(),
+                scratch.fe_values.get_quadrature(),
+                scratch.fe_values.get_update_flags())
+    , cache(scratch.cache)
+  {
+    fe_values.attach_geometry_cache(*scratch.cache);
+  }
+
+  FEValues<dim>                            fe_values;
+  SmartPointer<FEValuesGeometryCache<dim>> cache;
+};
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 4, -1., 3.);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FESystem<dim>     fe(FE_Q<dim>(2), dim, FE_Q<dim>(1), 1);
+  const QGauss<dim> quadrature(3);
+  const UpdateFlags flags =
+    update_values | update_gradients | update_quadrature_points |
+    update_JxW_values;
+
+  const MappingQGeneric<dim> mapping(1);
+  const MappingQGeneric<dim> other_mapping(1);
+
+  std::vector<double> reference;
+  {
+    FEValues<dim> fe_values(mapping, fe, quadrature, flags);
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        fe_values.reinit(cell);
+        reference.push_back(cell_value(fe_values));
+      }
+  }
+
+  // two objects with separate mapping objects that take turns
+  FEValuesGeometryCache<dim> cache;
+  FEValues<dim>              fe_values_0(mapping, fe, quadrature, flags);
+  FEValues<dim>              fe_values_1(other_mapping, fe, quadrature, flags);
+  fe_values_0.attach_geometry_cache(cache);
+  fe_values_1.attach_geometry_cache(cache);
+  double       difference = 0;
+  unsigned int index      = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      FEValues<dim> &fe_values = (index % 2 == 0) ? fe_values_0 : fe_values_1;
+      fe_values.reinit(cell);
+      difference = std::max(difference,
+                            std::abs(cell_value(fe_values) - reference[index]));
+      ++index;
+    }
+  deallog << "alternating: same values " << (difference < 1e-10)
+          << ", entries " << cache.n_entries() << ", hits " << cache.n_hits()
+          << std::endl;
+
+  // the same from several threads
+  cache.clear();
+  std::vector<double> values(reference.size());
+  ScratchData<dim>    scratch(mapping, fe, quadrature, flags, cache);
+  WorkStream::run(
+    tria.begin_active(),
+    tria.end(),
+    [&values](const typename Triangulation<dim>::active_cell_iterator &cell,
+              ScratchData<dim> &scratch,
+              unsigned int &) {
+      scratch.fe_values.reinit(cell);
+      values[cell->active_cell_index()] = cell_value(scratch.fe_values);
+    },
+    [](const unsigned int &) {},
+    scratch,
+    0U);
+  difference = 0;
+  for (unsigned int i = 0; i < values.size(); ++i)
+    difference = std::max(difference, std::abs(values[i] - reference[i]));
+  deallog << "WorkStream: same values " << (difference < 1e-10)
+          << ", entries " << cache.n_entries() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
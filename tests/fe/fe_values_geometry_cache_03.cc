@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// the shape functions of FE_DGPNonparametric are polynomials in real space
+// and differ between cells that are translations of each other. check that
+// an FEValues object using it bypasses an attached FEValuesGeometryCache on
+// a mesh of translated cells and computes the same values as one without
+// cache, also when the element is part of an FESystem
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_dgp_nonparametric.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_geometry_cache.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 3, -1., 2.);
+
+  const MappingQGeneric<dim> mapping(1);
+  const QGauss<dim>          quadrature(3);
+  const UpdateFlags          flags =
+    update_values | update_gradients | update_JxW_values;
+
+  deallog << fe.get_name() << " supported: "
+          << FEValuesGeometryCache<dim>::is_supported(mapping, fe)
+          << std::endl;
+
+  FEValuesGeometryCache<dim> cache;
+  FEValues<dim>              fe_values(mapping, fe, quadrature, flags);
+  FEValues<dim>              fe_values_cached(mapping, fe, quadrature, flags);
+  fe_values_cached.attach_geometry_cache(cache);
+
+  double difference = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values_cached.reinit(cell);
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          {
+            const unsigned int c = fe.system_to_component_index(i).first;
+            difference =
+              std::max(difference,
+                       std::abs(fe_values.shape_value_component(i, q, c) -
+                                fe_values_cached.shape_value_component(i,
+                                                                       q,
+                                                                       c)));
+            difference =
+              std::max(difference,
+                       (fe_values.shape_grad_component(i, q, c) -
+                        fe_values_cached.shape_grad_component(i, q, c))
+                         .norm());
+          }
+    }
+  deallog << "same values: " << (difference < 1e-12)
+          << ", entries: " << cache.n_entries()
+          << ", hits: " << cache.n_hits() << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  test(FE_DGPNonparametric<dim>(2));
+  test(FESystem<dim>(FE_Q<dim>(1), 1, FE_DGPNonparametric<dim>(1), 1));
+  test(FE_Q<dim>(2));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
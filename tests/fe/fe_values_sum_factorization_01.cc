@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// FEValues evaluates get_function_values() and get_function_gradients() by
+// sum factorization for high order tensor product elements. check that the
+// result matches the sum over the shape function tables on a deformed mesh,
+// for elements with and without the sum factorization path, and with and
+// without the inverse Jacobians among the update flags
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+Point<dim>
+deform(const Point<dim> &p)
+{
+  Point<dim> q = p;
+  q[0] += 0.1 * p[1] * p[1];
+  q[1] += 0.05 * p[0];
+  return q;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe,
+     const Quadrature<dim> &   quadrature,
+     const UpdateFlags         update_flags)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 2);
+  GridTools::transform(&deform<dim>, tria);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = std::sin(0.7 * i);
+
+  FEValues<dim> fe_values(fe, quadrature, update_flags);
+
+  std::vector<double>         values(quadrature.size());
+  std::vector<Tensor<1, dim>> gradients(quadrature.size());
+  std::vector<double>         local_values(fe.dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+
+  double value_error = 0, gradient_error = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      cell->get_dof_indices(dof_indices);
+
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          double         value = 0;
+          Tensor<1, dim> gradient;
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            {
+              value += solution(dof_indices[i]) * fe_values.shape_value(i, q);
+              gradient +=
+                solution(dof_indices[i]) * fe_values.shape_grad(i, q);
+            }
+          value_error = std::max(value_error, std::abs(value - values[q]));
+          gradient_error =
+            std::max(gradient_error, (gradient - gradients[q]).norm());
+        }
+    }
+
+  // FEValues adds the inverse Jacobians by itself if it computes gradients
+  // by sum factorization
+  deallog << fe.get_name() << " with " << quadrature.size()
+          << " points: values " << (value_error < 1e-12) << ", gradients "
+          << (gradient_error < 1e-10) << ", inverse Jacobians "
+          << ((fe_values.get_update_flags() & update_inverse_jacobians) != 0)
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const Quadrature<dim> &quadrature)
+{
+  test(fe, quadrature, update_values | update_gradients);
+  test(fe,
+       quadrature,
+       update_values | update_gradients | update_inverse_jacobians |
+         update_JxW_values);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(FE_Q<2>(1), QGauss<2>(2));
+  test<2>(FE_Q<2>(4), QGauss<2>(5));
+  test<2>(FE_Q<2>(5), QGauss<2>(3));
+  test<2>(FE_DGQ<2>(3), QGauss<2>(6));
+  test<3>(FE_Q<3>(3), QGauss<3>(4));
+  test<3>(FE_DGQ<3>(4), QGauss<3>(5));
+}
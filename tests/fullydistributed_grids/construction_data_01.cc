@@ -0,0 +1,95 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check parallel::fullydistributed::create_construction_data() on a mesh
+// partitioned into a left and a right half: each part needs to contain the
+// locally owned cells plus the cells that share a vertex with them, and
+// needs to describe a valid triangulation with the boundary ids of the
+// original mesh
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int n_subdivisions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, n_subdivisions);
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cell->set_subdomain_id(cell->center()[0] < 0.5 ? 0 : 1);
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->at_boundary(f) && cell->face(f)->center()[0] < 1e-12)
+          cell->face(f)->set_boundary_id(1);
+    }
+
+  for (types::subdomain_id subdomain = 0; subdomain < 2; ++subdomain)
+    {
+      const auto construction_data =
+        parallel::fullydistributed::create_construction_data(tria, subdomain);
+
+      deallog << "subdomain " << subdomain << ": "
+              << construction_data.vertices.size() << " vertices, "
+              << construction_data.cells.size() << " cells, "
+              << construction_data.subcelldata.boundary_lines.size()
+              << " boundary lines, "
+              << construction_data.subcelldata.boundary_quads.size()
+              << " boundary quads" << std::endl;
+
+      deallog << "ids:";
+      for (unsigned int c = 0; c < construction_data.cells.size(); ++c)
+        deallog << ' ' << construction_data.coarse_cell_ids[c] << '/'
+                << construction_data.subdomain_ids[c];
+      deallog << std::endl;
+
+      Triangulation<dim> local_tria;
+      local_tria.create_triangulation(construction_data.vertices,
+                                      construction_data.cells,
+                                      construction_data.subcelldata);
+      unsigned int n_faces_with_id = 0;
+      for (const auto &cell : local_tria.active_cell_iterators())
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->at_boundary(f) && cell->face(f)->boundary_id() == 1)
+            ++n_faces_with_id;
+      deallog << "triangulation: " << local_tria.n_active_cells()
+              << " cells, " << n_faces_with_id << " faces with boundary id 1"
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(4);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(2);
+  deallog.pop();
+}
@@ -0,0 +1,252 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// create a parallel::fullydistributed::Triangulation from a mesh partitioned
+// into strips and check that a DoFHandler on it distributes the degrees of
+// freedom like one on a parallel::shared::Triangulation with the same
+// partition. also check that CellId identifies the same cells on both, and
+// that MatrixFree and DataOut work on the locally owned cells
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include "../tests.h"
+
+
+// return whether a condition holds on all processors
+bool
+on_all_processors(const bool condition)
+{
+  return Utilities::MPI::min(static_cast<unsigned int>(condition),
+                             MPI_COMM_WORLD) == 1;
+}
+
+
+
+// return the sorted support points of the given degrees of freedom, which
+// do not depend on how the degrees of freedom are numbered
+template <int dim>
+std::vector<Point<dim>>
+sorted_support_points(const DoFHandler<dim> &dof, const IndexSet &dofs)
+{
+  std::map<types::global_dof_index, Point<dim>> support_points;
+  DoFTools::map_dofs_to_support_points(MappingQGeneric<dim>(1),
+                                       dof,
+                                       support_points);
+
+  std::vector<Point<dim>> points;
+  for (const auto &entry : support_points)
+    if (dofs.is_element(entry.first))
+      points.push_back(entry.second);
+  std::sort(points.begin(),
+            points.end(),
+            [](const Point<dim> &a, const Point<dim> &b) {
+              for (unsigned int d = 0; d < dim; ++d)
+                if (std::abs(a[d] - b[d]) > 1e-12)
+                  return a[d] < b[d];
+              return false;
+            });
+  return points;
+}
+
+
+
+template <int dim>
+bool
+same_points(const std::vector<Point<dim>> &a, const std::vector<Point<dim>> &b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (unsigned int i = 0; i < a.size(); ++i)
+    if (a[i].distance(b[i]) > 1e-12)
+      return false;
+  return true;
+}
+
+
+
+template <int dim>
+IndexSet
+ghost_dofs(const DoFHandler<dim> &dof)
+{
+  IndexSet relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof, relevant_dofs);
+  relevant_dofs.subtract_set(dof.locally_owned_dofs());
+  return relevant_dofs;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const unsigned int n_subdivisions)
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  Triangulation<dim> serial_tria;
+  GridGenerator::subdivided_hyper_cube(serial_tria, n_subdivisions);
+  for (const auto &cell : serial_tria.active_cell_iterators())
+    cell->set_subdomain_id(
+      static_cast<unsigned int>(cell->center()[0] * n_procs));
+
+  parallel::fullydistributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  tria.create_triangulation(
+    parallel::fullydistributed::create_construction_data(serial_tria, myid));
+
+  parallel::shared::Triangulation<dim> shared_tria(
+    MPI_COMM_WORLD,
+    Triangulation<dim>::none,
+    true,
+    parallel::shared::Triangulation<dim>::partition_custom_signal);
+  shared_tria.copy_triangulation(serial_tria);
+
+  deallog << "n_active_cells: " << tria.n_global_active_cells() << " / "
+          << shared_tria.n_global_active_cells() << std::endl;
+
+  // cells are identified by their CellId on both triangulations
+  bool same_cells = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const CellId id = cell->id();
+        same_cells &= (id.to_cell(tria) == cell);
+        const auto shared_cell = id.to_cell(shared_tria);
+        same_cells &= shared_cell->is_locally_owned();
+        same_cells &= (shared_cell->center().distance(cell->center()) < 1e-12);
+      }
+  deallog << "Same cells: " << on_all_processors(same_cells) << std::endl;
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  DoFHandler<dim> shared_dof(shared_tria);
+  dof.distribute_dofs(fe);
+  shared_dof.distribute_dofs(fe);
+
+  deallog << "n_dofs: " << dof.n_dofs() << " / " << shared_dof.n_dofs()
+          << std::endl;
+
+  // both assign the degrees of freedom on interfaces to the processor with
+  // the smaller subdomain id and number the degrees of freedom of each
+  // processor contiguously, so the locally owned ranges agree. the ghost
+  // degrees of freedom are compared by their support points, which do not
+  // depend on the numbering within each processor
+  deallog << "Same locally owned dofs: "
+          << on_all_processors(dof.locally_owned_dofs() ==
+                               shared_dof.locally_owned_dofs())
+          << std::endl;
+  deallog << "Same ghost dofs: "
+          << on_all_processors(
+               same_points(sorted_support_points(dof, ghost_dofs(dof)),
+                           sorted_support_points(shared_dof,
+                                                 ghost_dofs(shared_dof))))
+          << std::endl;
+
+  // integrate the constant function one with MatrixFree, which sums up to
+  // the volume of the unit cube
+  AffineConstraints<double> constraints;
+  constraints.close();
+  MatrixFree<dim> matrix_free;
+  matrix_free.reinit(dof,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     typename MatrixFree<dim>::AdditionalData());
+
+  LinearAlgebra::distributed::Vector<double> vec, dummy;
+  matrix_free.initialize_dof_vector(vec);
+  deallog << "MatrixFree vector with locally owned dofs: "
+          << on_all_processors(vec.locally_owned_elements() ==
+                               dof.locally_owned_dofs())
+          << std::endl;
+
+  std::function<void(const MatrixFree<dim> &,
+                     LinearAlgebra::distributed::Vector<double> &,
+                     const LinearAlgebra::distributed::Vector<double> &,
+                     const std::pair<unsigned int, unsigned int> &)>
+    integrate_one = [](const MatrixFree<dim> &                           data,
+                       LinearAlgebra::distributed::Vector<double> &      dst,
+                       const LinearAlgebra::distributed::Vector<double> &,
+                       const std::pair<unsigned int, unsigned int> &range) {
+      FEEvaluation<dim, fe_degree> phi(data);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          phi.reinit(cell);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            phi.submit_value(make_vectorized_array(1.), q);
+          phi.integrate(true, false);
+          phi.distribute_local_to_global(dst);
+        }
+    };
+  matrix_free.cell_loop(integrate_one, vec, dummy, true);
+  deallog << "Volume of unit cube: "
+          << (std::abs(vec.mean_value() * vec.size() - 1.) < 1e-12)
+          << std::endl;
+
+  // DataOut creates one patch per locally owned cell
+  vec.update_ghost_values();
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof);
+  data_out.add_data_vector(vec, "integral");
+  data_out.build_patches();
+  std::ostringstream vtu;
+  data_out.write_vtu(vtu);
+  const std::string  output    = vtu.str();
+  const std::string  cells_tag = "NumberOfCells=\"";
+  const unsigned int n_patches =
+    std::stoul(output.substr(output.find(cells_tag) + cells_tag.size()));
+  deallog << "DataOut patches on locally owned cells: "
+          << on_all_processors(n_patches == tria.n_locally_owned_active_cells())
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  mpi_initlog();
+
+  deallog.push("2d");
+  test<2, 2>(6);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3, 1>(3);
+  deallog.pop();
+}
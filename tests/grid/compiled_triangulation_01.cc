@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test that the arrays of CompiledTriangulation agree with the information
+// obtained from cell iterators, that the cells are sorted along a
+// space-filling curve, and that the data is rebuilt upon refinement and
+// cleared together with the triangulation
+
+#include <deal.II/grid/compiled_triangulation.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+check_consistency(const CompiledTriangulation<dim> &compiled)
+{
+  const Triangulation<dim> &tria = compiled.get_triangulation();
+  AssertThrow(compiled.n_active_cells() == tria.n_active_cells(),
+              ExcInternalError());
+
+  unsigned int n_errors           = 0;
+  unsigned int n_refined_neighbor = 0;
+  for (unsigned int c = 0; c < compiled.n_active_cells(); ++c)
+    {
+      const auto cell = compiled.get_cell_iterator(c);
+      if (compiled.compiled_index(cell) != c)
+        ++n_errors;
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        if (compiled.vertex_indices(c)[v] != cell->vertex_index(v))
+          ++n_errors;
+      if (compiled.get_material_ids()[c] != cell->material_id())
+        ++n_errors;
+      if (compiled.get_cell_centers()[c].distance(cell->center()) != 0.)
+        ++n_errors;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          const unsigned int slot = c * GeometryInfo<dim>::faces_per_cell + f;
+          if (compiled.get_face_indices()[slot] != cell->face_index(f))
+            ++n_errors;
+          if (compiled.get_face_boundary_ids()[slot] !=
+              cell->face(f)->boundary_id())
+            ++n_errors;
+
+          unsigned int expected_neighbor;
+          if (cell->at_boundary(f))
+            expected_neighbor = CompiledTriangulation<dim>::boundary_neighbor;
+          else if (cell->neighbor(f)->has_children())
+            expected_neighbor = CompiledTriangulation<dim>::refined_neighbor;
+          else
+            expected_neighbor = compiled.compiled_index(cell->neighbor(f));
+          if (compiled.neighbor_indices(c)[f] != expected_neighbor)
+            ++n_errors;
+          if (expected_neighbor == CompiledTriangulation<dim>::refined_neighbor)
+            ++n_refined_neighbor;
+        }
+    }
+
+  deallog << "Number of active cells: " << compiled.n_active_cells()
+          << std::endl;
+  deallog << "Consistent with iterators: " << (n_errors == 0 ? "yes" : "no")
+          << std::endl;
+  deallog << "Faces with refined neighbor: " << n_refined_neighbor
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, 0, 1, true);
+  tria.refine_global(dim == 2 ? 3 : 2);
+
+  CompiledTriangulation<dim> compiled(tria);
+  check_consistency(compiled);
+
+  // on a uniformly refined cube, consecutive cells along the Hilbert curve
+  // share a face
+  unsigned int n_adjacent = 0;
+  for (unsigned int c = 1; c < compiled.n_active_cells(); ++c)
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (compiled.neighbor_indices(c)[f] == c - 1)
+        ++n_adjacent;
+  deallog << "Face-adjacent consecutive cells: " << n_adjacent << " of "
+          << compiled.n_active_cells() - 1 << std::endl;
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  check_consistency(compiled);
+
+  tria.clear();
+  deallog << "Number of active cells after clear: "
+          << compiled.n_active_cells() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
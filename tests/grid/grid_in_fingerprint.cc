@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check GridIn::set_trusted_fingerprint(): write a mesh, read it back and
+// store the fingerprint of its cells, then read it again with that
+// fingerprint set, and read a different mesh that does not match it
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::string
+write_mesh(const unsigned int n_subdivisions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, n_subdivisions);
+  std::ostringstream out;
+  GridOut().write_msh(tria, out);
+  return out.str();
+}
+
+
+
+template <int dim>
+void
+print_mesh(const Triangulation<dim> &tria)
+{
+  Point<dim> center_sum;
+  for (const auto &cell : tria.active_cell_iterators())
+    center_sum += cell->center();
+  deallog << tria.n_vertices() << ' ' << tria.n_active_cells() << ' '
+          << center_sum << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const std::string file = write_mesh<dim>(4);
+
+  std::uint64_t fingerprint;
+  {
+    Triangulation<dim> tria;
+    GridIn<dim>        grid_in;
+    grid_in.attach_triangulation(tria);
+    std::istringstream in(file);
+    grid_in.read_msh(in);
+    fingerprint = grid_in.get_fingerprint();
+    print_mesh(tria);
+  }
+
+  {
+    Triangulation<dim> tria;
+    GridIn<dim>        grid_in;
+    grid_in.attach_triangulation(tria);
+    grid_in.set_trusted_fingerprint(fingerprint);
+    std::istringstream in(file);
+    grid_in.read_msh(in);
+    print_mesh(tria);
+    deallog << "same fingerprint: "
+            << (grid_in.get_fingerprint() == fingerprint) << std::endl;
+  }
+
+  // a different mesh does not match the fingerprint and is read as usual
+  {
+    Triangulation<dim> tria;
+    GridIn<dim>        grid_in;
+    grid_in.attach_triangulation(tria);
+    grid_in.set_trusted_fingerprint(fingerprint);
+    std::istringstream in(write_mesh<dim>(3));
+    grid_in.read_msh(in);
+    print_mesh(tria);
+    deallog << "same fingerprint: "
+            << (grid_in.get_fingerprint() == fingerprint) << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
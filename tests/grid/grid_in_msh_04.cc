@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// read a file in the MSH format that is large enough to be parsed in
+// parallel, once with one record per line as written by GridOut and once
+// with each record split over two lines, which the reader has to detect and
+// parse sequentially. check that both give the same mesh, both for the whole
+// file and for a range of its cells
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+void
+read_range(const std::string &                          file,
+           const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  std::vector<Point<2>>                      vertices;
+  std::vector<CellData<2>>                   cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> vertex_boundary_ids;
+  std::istringstream                         in(file);
+  GridIn<2>::read_msh(
+    in, vertices, cells, subcelldata, vertex_boundary_ids, cell_range);
+
+  Point<2> vertex_sum;
+  for (const Point<2> &vertex : vertices)
+    vertex_sum += vertex;
+  std::size_t index_sum = 0;
+  for (const CellData<2> &cell : cells)
+    for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+      index_sum += cell.vertices[v];
+  deallog << vertices.size() << ' ' << cells.size() << ' '
+          << subcelldata.boundary_lines.size() << ' ' << vertex_sum << ' '
+          << index_sum << std::endl;
+}
+
+
+
+void
+check(const std::string &file)
+{
+  Triangulation<2>   tria;
+  GridIn<2>          gi;
+  std::istringstream in(file);
+  gi.attach_triangulation(tria);
+  gi.read_msh(in);
+  deallog << tria.n_vertices() << ' ' << tria.n_active_cells() << std::endl;
+
+  read_range(file, std::make_pair(0U, numbers::invalid_unsigned_int));
+  read_range(file, std::make_pair(1000U, 3000U));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_rectangle(
+    tria, {300U, 300U}, Point<2>(), Point<2>(3, 3), true);
+  std::ostringstream out;
+  GridOut().write_msh(tria, out);
+  std::string file = out.str();
+
+  deallog.push("lines");
+  check(file);
+  deallog.pop();
+
+  // break each line after its first token
+  std::string split_file;
+  bool        at_line_start = true;
+  for (const char c : file)
+    {
+      split_file += (c == ' ' && at_line_start) ? '\n' : c;
+      if (c == ' ')
+        at_line_start = false;
+      else if (c == '\n')
+        at_line_start = true;
+    }
+  deallog.push("split");
+  check(split_file);
+  deallog.pop();
+}
@@ -0,0 +1,86 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// read ranges of the cells of a 1d mesh in the MSH format and check that the
+// boundary indicators assigned to vertices are returned with the numbers of
+// the vertices that are kept
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+const std::string file = "$MeshFormat\n"
+                         "2.2 0 8\n"
+                         "$EndMeshFormat\n"
+                         "$Nodes\n"
+                         "5\n"
+                         "1 0 0 0\n"
+                         "2 1 0 0\n"
+                         "3 2 0 0\n"
+                         "4 3 0 0\n"
+                         "5 4 0 0\n"
+                         "$EndNodes\n"
+                         "$Elements\n"
+                         "6\n"
+                         "1 15 2 3 1 1\n"
+                         "2 15 2 4 2 5\n"
+                         "3 1 2 7 1 1 2\n"
+                         "4 1 2 7 1 2 3\n"
+                         "5 1 2 7 1 3 4\n"
+                         "6 1 2 7 1 4 5\n"
+                         "$EndElements\n";
+
+
+
+void
+check(const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  std::vector<Point<1>>                      vertices;
+  std::vector<CellData<1>>                   cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> vertex_boundary_ids;
+  std::istringstream                         in(file);
+  GridIn<1>::read_msh(
+    in, vertices, cells, subcelldata, vertex_boundary_ids, cell_range);
+
+  deallog << "cells " << cell_range.first << " to " << cell_range.second
+          << ':' << std::endl;
+  for (const CellData<1> &cell : cells)
+    deallog << "cell (" << vertices[cell.vertices[0]] << ") ("
+            << vertices[cell.vertices[1]] << ")" << std::endl;
+  for (const auto &boundary_id : vertex_boundary_ids)
+    deallog << "vertex (" << vertices[boundary_id.first] << ") boundary "
+            << static_cast<unsigned int>(boundary_id.second) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check(std::make_pair(0U, 4U));
+  check(std::make_pair(0U, 1U));
+  check(std::make_pair(2U, 4U));
+  check(std::make_pair(1U, 3U));
+}
@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// read a file in the MSH format used by the GMSH program. test the
+// reader for version 4.1 of the MSH file format, in its ASCII and binary
+// variants, against the same mesh stored in version 2.2. also read only a
+// range of the cells of the file
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "../tests.h"
+
+
+void
+check_file(const std::string &name)
+{
+  Triangulation<2> tria;
+  GridIn<2>        gi;
+  gi.attach_triangulation(tria);
+  std::ifstream in(name);
+  gi.read_msh(in);
+  deallog << tria.n_vertices() << ' ' << tria.n_active_cells() << std::endl;
+
+  // sort cells and boundary faces by their centers, to make the output
+  // independent of the orientation chosen by the reordering of the cells
+  std::map<std::pair<double, double>, unsigned int> cells, faces;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cells[std::make_pair(cell->center()[0], cell->center()[1])] =
+        cell->material_id();
+      for (unsigned int f = 0; f < GeometryInfo<2>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          faces[std::make_pair(cell->face(f)->center()[0],
+                               cell->face(f)->center()[1])] =
+            cell->face(f)->boundary_id();
+    }
+  for (const auto &cell : cells)
+    deallog << "cell " << Point<2>(cell.first.first, cell.first.second)
+            << " material " << cell.second << std::endl;
+  for (const auto &face : faces)
+    deallog << "face " << Point<2>(face.first.first, face.first.second)
+            << " boundary " << face.second << std::endl;
+}
+
+
+
+void
+check_cell_range(const std::string &name)
+{
+  std::vector<Point<2>>                      vertices;
+  std::vector<CellData<2>>                   cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> vertex_boundary_ids;
+  std::ifstream                              in(name);
+  GridIn<2>::read_msh(in,
+                      vertices,
+                      cells,
+                      subcelldata,
+                      vertex_boundary_ids,
+                      std::make_pair(2U, 5U));
+
+  deallog << vertices.size() << ' ' << cells.size() << ' '
+          << subcelldata.boundary_lines.size() << std::endl;
+  for (const auto &cell : cells)
+    {
+      deallog << "cell";
+      for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        deallog << " (" << vertices[cell.vertices[v]] << ')';
+      deallog << " material " << static_cast<unsigned int>(cell.material_id)
+              << std::endl;
+    }
+  for (const auto &line : subcelldata.boundary_lines)
+    deallog << "line (" << vertices[line.vertices[0]] << ") ("
+            << vertices[line.vertices[1]] << ") boundary "
+            << static_cast<unsigned int>(line.boundary_id) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const std::string directory = SOURCE_DIR "/grid_in_msh_version_4/";
+  for (const std::string name : {"mesh_v2", "mesh_v4_ascii", "mesh_v4_binary"})
+    {
+      deallog.push(name);
+      check_file(directory + name + ".msh");
+      check_cell_range(directory + name + ".msh");
+      deallog.pop();
+    }
+}
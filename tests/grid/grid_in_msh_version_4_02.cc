@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// like grid_in_msh_version_4, but read the range of cells from a stream
+// that does not support positioning, for which the reader cannot come back
+// to the nodes after reading the elements. also read a file in which the
+// records of the elements section are spread over several lines
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+#include "../tests.h"
+
+
+// A stream buffer that provides the characters of a string, but does not
+// implement seeking
+class UnseekableBuffer : public std::streambuf
+{
+public:
+  explicit UnseekableBuffer(const std::string &text)
+    : text(text)
+  {
+    setg(&this->text[0], &this->text[0], &this->text[0] + this->text.size());
+  }
+
+private:
+  std::string text;
+};
+
+
+
+void
+check_cell_range(std::istream &in)
+{
+  std::vector<Point<2>>                      vertices;
+  std::vector<CellData<2>>                   cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> vertex_boundary_ids;
+  GridIn<2>::read_msh(in,
+                      vertices,
+                      cells,
+                      subcelldata,
+                      vertex_boundary_ids,
+                      std::make_pair(2U, 5U));
+
+  deallog << vertices.size() << ' ' << cells.size() << ' '
+          << subcelldata.boundary_lines.size() << std::endl;
+  for (const auto &cell : cells)
+    {
+      deallog << "cell";
+      for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        deallog << " (" << vertices[cell.vertices[v]] << ')';
+      deallog << " material " << static_cast<unsigned int>(cell.material_id)
+              << std::endl;
+    }
+  for (const auto &line : subcelldata.boundary_lines)
+    deallog << "line (" << vertices[line.vertices[0]] << ") ("
+            << vertices[line.vertices[1]] << ") boundary "
+            << static_cast<unsigned int>(line.boundary_id) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const std::string directory = SOURCE_DIR "/grid_in_msh_version_4/";
+  for (const std::string name : {"mesh_v2", "mesh_v4_ascii", "mesh_v4_binary"})
+    {
+      deallog.push(name);
+      std::ifstream     file(directory + name + ".msh", std::ios::binary);
+      std::stringstream text;
+      text << file.rdbuf();
+
+      UnseekableBuffer buffer(text.str());
+      std::istream     in(&buffer);
+      check_cell_range(in);
+      deallog.pop();
+    }
+
+  // put every node of the elements of the file in format 2 on a line of its
+  // own
+  {
+    deallog.push("mesh_v2_split");
+    std::ifstream     file(directory + "mesh_v2.msh");
+    std::stringstream text;
+    text << file.rdbuf();
+    std::string       content  = text.str();
+    const std::size_t elements = content.find("$Elements");
+    for (std::size_t i = content.find('\n', content.find('\n', elements) + 1);
+         i < content.size();
+         ++i)
+      if (content[i] == ' ')
+        content[i] = '\n';
+
+    std::istringstream in(content);
+    check_cell_range(in);
+    deallog.pop();
+  }
+}
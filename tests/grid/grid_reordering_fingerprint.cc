@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that GridReordering::reorder_cells() gives the same result with one
+// and with many threads, and that reorder_cells() skips the work if given
+// the fingerprint of the cells it is passed
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_reordering.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::vector<CellData<dim>>
+make_cells(const unsigned int n)
+{
+  // a subdivided cube in which the vertices of each cell are mirrored
+  // along some of the coordinate directions
+  std::vector<CellData<dim>> cells;
+  unsigned int               flip = 0;
+  for (unsigned int k = 0; k < (dim == 3 ? n : 1); ++k)
+    for (unsigned int j = 0; j < n; ++j)
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          CellData<dim> cell;
+          flip = (flip * 5 + 3) % GeometryInfo<dim>::vertices_per_cell;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              const unsigned int w = v ^ flip;
+              cell.vertices[v] =
+                (i + (w & 1)) +
+                (n + 1) * ((j + ((w >> 1) & 1)) +
+                           (n + 1) * (dim == 3 ? k + ((w >> 2) & 1) : 0));
+            }
+          cells.push_back(cell);
+        }
+  return cells;
+}
+
+
+
+template <int dim>
+bool
+equal(const std::vector<CellData<dim>> &a, const std::vector<CellData<dim>> &b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (unsigned int c = 0; c < a.size(); ++c)
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (a[c].vertices[v] != b[c].vertices[v])
+        return false;
+  return true;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const std::vector<CellData<dim>> original = make_cells<dim>(dim == 2 ? 40 : 12);
+
+  MultithreadInfo::set_thread_limit(1);
+  std::vector<CellData<dim>> serial = original;
+  GridReordering<dim>::reorder_cells(serial, true);
+
+  MultithreadInfo::set_thread_limit();
+  std::vector<CellData<dim>> threaded = original;
+  GridReordering<dim>::reorder_cells(threaded, true);
+
+  deallog << "Reordering changed cells: " << !equal(original, serial)
+          << std::endl;
+  deallog << "Same result with threads: " << equal(serial, threaded)
+          << std::endl;
+
+  const std::uint64_t fingerprint =
+    GridReordering<dim>::compute_fingerprint(threaded);
+  deallog << "Fingerprint differs from original: "
+          << (GridReordering<dim>::compute_fingerprint(original) != fingerprint)
+          << std::endl;
+
+  // swapping two cells must change the fingerprint
+  std::vector<CellData<dim>> swapped = threaded;
+  std::swap(swapped[0], swapped[1]);
+  deallog << "Fingerprint differs after swapping cells: "
+          << (GridReordering<dim>::compute_fingerprint(swapped) != fingerprint)
+          << std::endl;
+
+  // passing cells with a matching fingerprint leaves them untouched, even
+  // in old-style ordering which would otherwise be converted back and forth
+  std::vector<CellData<dim>> trusted = threaded;
+  GridReordering<dim>::reorder_cells(trusted, false, fingerprint);
+  deallog << "Trusted cells unchanged: " << equal(trusted, threaded)
+          << std::endl;
+
+  // with a fingerprint that does not match, the cells are reordered
+  std::vector<CellData<dim>> untrusted = original;
+  GridReordering<dim>::reorder_cells(untrusted, true, fingerprint);
+  deallog << "Untrusted cells reordered: " << equal(untrusted, threaded)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check GridTools::hilbert_renumbering() on a subdivided cube whose cells
+// are given in a scrambled order: afterwards, consecutive cells must be
+// neighbors, the vertices must be numbered in the order the cells visit
+// them, and all ids and manifolds must be preserved
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <map>
+#include <vector>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::vector<double>
+key(const Point<dim> &p)
+{
+  std::vector<double> coordinates(dim);
+  for (unsigned int d = 0; d < dim; ++d)
+    coordinates[d] = p[d];
+  return coordinates;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n)
+{
+  // a subdivided unit cube, with the cells listed in a scrambled order and
+  // the original position stored as material id
+  std::vector<Point<dim>> vertices;
+  for (unsigned int k = 0; k < (dim == 3 ? n + 1 : 1); ++k)
+    for (unsigned int j = 0; j < n + 1; ++j)
+      for (unsigned int i = 0; i < n + 1; ++i)
+        {
+          Point<dim> p;
+          p[0] = 1. * i / n;
+          p[1] = 1. * j / n;
+          if (dim == 3)
+            p[2] = 1. * k / n;
+          vertices.push_back(p);
+        }
+
+  const unsigned int n_cells = Utilities::fixed_power<dim>(n);
+  std::vector<CellData<dim>> cells(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    {
+      const unsigned int position = (7 * c) % n_cells;
+      const unsigned int i = position % n, j = (position / n) % n,
+                         k = position / n / n;
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        cells[c].vertices[v] =
+          (i + (v & 1)) +
+          (n + 1) * ((j + ((v >> 1) & 1)) + (n + 1) * (k + ((v >> 2) & 1)));
+      cells[c].material_id = c;
+    }
+
+  Triangulation<dim> tria;
+  tria.create_triangulation(vertices, cells, SubCellData());
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->at_boundary(f))
+        {
+          if (cell->face(f)->center()[0] < 1e-12)
+            cell->face(f)->set_boundary_id(1);
+          else if (cell->face(f)->center()[0] > 1 - 1e-12)
+            cell->face(f)->set_manifold_id(3);
+        }
+  tria.set_manifold(3, SphericalManifold<dim>(Point<dim>()));
+
+  std::map<std::vector<double>, unsigned int> materials;
+  for (const auto &cell : tria.active_cell_iterators())
+    materials[key(cell->center())] = cell->material_id();
+
+  GridTools::hilbert_renumbering(tria);
+
+  deallog << "cells: " << tria.n_active_cells()
+          << " vertices: " << tria.n_vertices() << std::endl;
+
+  bool same_materials = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const auto entry = materials.find(key(cell->center()));
+      if (entry == materials.end() || entry->second != cell->material_id())
+        same_materials = false;
+    }
+  deallog << "material ids preserved: " << same_materials << std::endl;
+
+  unsigned int n_boundary_faces = 0, n_manifold_faces = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->at_boundary(f))
+        {
+          if (cell->face(f)->boundary_id() == 1)
+            ++n_boundary_faces;
+          if (cell->face(f)->manifold_id() == 3)
+            ++n_manifold_faces;
+        }
+  deallog << "faces with boundary id 1: " << n_boundary_faces << std::endl;
+  deallog << "faces with manifold id 3: " << n_manifold_faces << std::endl;
+  deallog << "manifold attached: "
+          << (dynamic_cast<const SphericalManifold<dim> *>(
+                &tria.get_manifold(3)) != nullptr)
+          << std::endl;
+
+  bool neighbors = true;
+  for (auto cell = tria.begin_active(); std::next(cell) != tria.end(); ++cell)
+    {
+      bool found = false;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (!cell->at_boundary(f) && cell->neighbor(f) == std::next(cell))
+          found = true;
+      neighbors = neighbors && found;
+    }
+  deallog << "consecutive cells are neighbors: " << neighbors << std::endl;
+
+  unsigned int next_vertex = 0;
+  bool         vertices_in_order = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (cell->vertex_index(v) == next_vertex)
+        ++next_vertex;
+      else if (cell->vertex_index(v) > next_vertex)
+        vertices_in_order = false;
+  deallog << "vertices numbered in cell order: " << vertices_in_order
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(4);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(4);
+  deallog.pop();
+}
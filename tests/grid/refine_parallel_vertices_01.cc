@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// The locations of the new vertices created during refinement are computed
+// in parallel. Check that the resulting mesh on a curved geometry does not
+// depend on the number of threads, both for global and adaptive refinement
+// and, in 3d, for anisotropic refinement followed by isotropic refinement of
+// the same cells. The checksum of the vertices in the output was generated
+// with the serial implementation that computed each new vertex while setting
+// up the new objects.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+create_mesh(Triangulation<dim> &tria)
+{
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 0, true);
+  tria.refine_global(dim == 2 ? 3 : 1);
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  if (dim == 3)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[1] > 0)
+          cell->set_refine_flag(RefinementCase<dim>::cut_x);
+      tria.execute_coarsening_and_refinement();
+
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[2] > 0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+}
+
+
+
+// a number that depends on the location and the numbering of all vertices
+template <int dim>
+double
+vertex_checksum(const Triangulation<dim> &tria)
+{
+  double checksum = 0;
+  for (unsigned int v = 0; v < tria.n_vertices(); ++v)
+    if (tria.get_used_vertices()[v])
+      for (unsigned int d = 0; d < dim; ++d)
+        checksum += (v % 7 + d + 1) * tria.get_vertices()[v][d];
+  return checksum;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria_serial, tria_parallel;
+
+  MultithreadInfo::set_thread_limit(1);
+  create_mesh(tria_serial);
+  MultithreadInfo::set_thread_limit();
+  create_mesh(tria_parallel);
+
+  AssertThrow(tria_serial.n_vertices() == tria_parallel.n_vertices(),
+              ExcInternalError());
+  double max_difference = 0;
+  for (unsigned int v = 0; v < tria_serial.n_vertices(); ++v)
+    max_difference =
+      std::max(max_difference,
+               tria_serial.get_vertices()[v].distance(
+                 tria_parallel.get_vertices()[v]));
+
+  deallog << "Maximal vertex difference: " << max_difference << std::endl;
+  deallog << "Active cells: " << tria_parallel.n_active_cells()
+          << ", used vertices: " << tria_parallel.n_used_vertices()
+          << std::endl;
+  deallog << "Vertex checksum: " << std::setprecision(12)
+          << vertex_checksum(tria_parallel) << std::endl;
+
+  // all new vertices must lie within the shell
+  bool inside = true;
+  for (unsigned int v = 0; v < tria_parallel.n_vertices(); ++v)
+    if (tria_parallel.get_used_vertices()[v])
+      {
+        const double radius = tria_parallel.get_vertices()[v].norm();
+        if (radius < 0.5 - 1e-12 || radius > 1. + 1e-12)
+          inside = false;
+      }
+  deallog << "Vertices inside shell: " << (inside ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
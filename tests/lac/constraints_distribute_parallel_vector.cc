@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that AffineConstraints::distribute() for
+// LinearAlgebra::distributed::Vector, which caches the local indices of the
+// constraints, gives the same result as for Vector, also when the vector is
+// reinitialized or the inhomogeneities are changed after close()
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <typename Number>
+void
+check(const AffineConstraints<double> &constraints,
+      const unsigned int               n_dofs)
+{
+  Vector<Number>                             reference(n_dofs);
+  LinearAlgebra::distributed::Vector<Number> vec(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    reference(i) = vec(i) = Number(1. + 0.1 * (i % 7));
+
+  constraints.distribute(reference);
+  constraints.distribute(vec);
+
+  double difference = 0;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    difference += std::abs(reference(i) - vec(i));
+  deallog << "Difference: " << difference << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(dof_handler,
+                                           0,
+                                           Functions::SquareFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  // the first call sets up the index translation, the second one reuses it
+  check<double>(constraints, dof_handler.n_dofs());
+  check<double>(constraints, dof_handler.n_dofs());
+  check<float>(constraints, dof_handler.n_dofs());
+
+  // changing the inhomogeneities after close() is allowed and must be
+  // picked up by the next call
+  for (const auto &line : constraints.get_lines())
+    if (constraints.is_inhomogeneously_constrained(line.index))
+      constraints.set_inhomogeneity(line.index, 2.5);
+  check<double>(constraints, dof_handler.n_dofs());
+
+  // a vector of different size must not use the previous index translation,
+  // without the constraints being changed in between
+  check<double>(constraints, dof_handler.n_dofs() + 10);
+  check<double>(constraints, dof_handler.n_dofs());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,100 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2013 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+// tests that GMRES with classical Gram-Schmidt orthogonalization gives the
+// same solution as with modified Gram-Schmidt for a matrix that needs many
+// iterations and thus re-orthogonalization
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+template <typename VectorType>
+void
+test(const unsigned int n, const unsigned int max_n_tmp_vectors)
+{
+  using number = typename VectorType::value_type;
+  VectorType rhs, sol_mgs, sol_cgs;
+  rhs.reinit(n);
+  sol_mgs.reinit(n);
+  sol_cgs.reinit(n);
+  for (unsigned int i = 0; i < n; ++i)
+    rhs(i) = 1. + (i % 7);
+
+  SparsityPattern sp(n, n, 3);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      if (i > 0)
+        sp.add(i, i - 1);
+      if (i < n - 1)
+        sp.add(i, i + 1);
+    }
+  sp.compress();
+  SparseMatrix<number> matrix(sp);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      matrix.diag_element(i) = (i % 200) + 1;
+      if (i > 0)
+        matrix.set(i, i - 1, -0.3);
+      if (i < n - 1)
+        matrix.set(i, i + 1, -0.7);
+    }
+
+  using Strategy = typename SolverGMRES<VectorType>::OrthogonalizationStrategy;
+  typename SolverGMRES<VectorType>::AdditionalData data;
+  data.max_n_tmp_vectors = max_n_tmp_vectors;
+
+  SolverControl control_mgs(1000, 1e-10 * rhs.l2_norm());
+  data.orthogonalization_strategy = Strategy::modified_gram_schmidt;
+  SolverGMRES<VectorType>(control_mgs, data)
+    .solve(matrix, sol_mgs, rhs, PreconditionIdentity());
+
+  SolverControl control_cgs(1000, 1e-10 * rhs.l2_norm());
+  data.orthogonalization_strategy = Strategy::classical_gram_schmidt;
+  SolverGMRES<VectorType>(control_cgs, data)
+    .solve(matrix, sol_cgs, rhs, PreconditionIdentity());
+
+  const unsigned int step_difference =
+    std::abs(static_cast<int>(control_mgs.last_step()) -
+             static_cast<int>(control_cgs.last_step()));
+  deallog << "Iteration counts differ by at most one: "
+          << (step_difference <= 1 ? "yes" : "no") << std::endl;
+
+  sol_cgs -= sol_mgs;
+  deallog << "Solutions agree: "
+          << (sol_cgs.l2_norm() < 1e-8 * sol_mgs.l2_norm() ? "yes" : "no")
+          << std::endl;
+}
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  test<Vector<double>>(200, 30);
+  test<Vector<double>>(200, 202);
+  test<LinearAlgebra::distributed::Vector<double>>(200, 30);
+  test<LinearAlgebra::distributed::Vector<double>>(200, 202);
+
+  // vectors that span several of the blocks processed by different threads
+  test<Vector<double>>(100000, 30);
+  test<LinearAlgebra::distributed::Vector<double>>(100000, 30);
+}
@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2005 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Tests the eigenvalue estimation by power iteration in
+// PreconditionChebyshev, including the warm start from the previous
+// eigenvector and the reuse of eigenvalue estimates in initialize()
+
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+void
+check()
+{
+  // diagonal matrix with a well separated largest eigenvalue
+  const unsigned int size = 100;
+  SparsityPattern    sparsity(size, size);
+  sparsity.compress();
+  SparseMatrix<double> matrix(sparsity);
+  for (unsigned int i = 0; i < size - 1; ++i)
+    matrix.diag_element(i) = i + 1;
+  matrix.diag_element(size - 1) = 200;
+
+  Vector<double> in(size), out(size);
+  for (unsigned int i = 0; i < size; ++i)
+    in(i) = random_value<double>();
+
+  using Chebyshev = PreconditionChebyshev<SparseMatrix<double>, Vector<double>>;
+  Chebyshev                 prec;
+  Chebyshev::AdditionalData data;
+  data.smoothing_range      = 10.;
+  data.degree               = 3;
+  data.eig_cg_n_iterations  = 40;
+  data.eig_cg_residual      = 1e-4;
+  data.eigenvalue_algorithm = Chebyshev::AdditionalData::EigenvalueAlgorithm::
+    power_iteration;
+  data.preconditioner = std::make_shared<DiagonalMatrix<Vector<double>>>();
+  data.preconditioner->get_vector().reinit(size);
+  data.preconditioner->get_vector() = 1.;
+  prec.initialize(matrix, data);
+
+  // the estimate is computed during the first vmult
+  prec.vmult(out, in);
+  const Chebyshev::EigenvalueInformation cold_start =
+    prec.get_eigenvalue_information();
+  deallog << "Estimate bounds largest eigenvalue: "
+          << (cold_start.max_eigenvalue_estimate >= 200. &&
+                  cold_start.max_eigenvalue_estimate <= 1.2 * 201. ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  // change the matrix slightly: the estimate from the warm start needs
+  // fewer iterations
+  matrix.diag_element(size - 1) = 201;
+  prec.initialize(matrix, data);
+  const Chebyshev::EigenvalueInformation warm_start =
+    prec.estimate_eigenvalues(in);
+  deallog << "Warm start needs fewer iterations: "
+          << (warm_start.cg_iterations < cold_start.cg_iterations ? "yes" :
+                                                                    "no")
+          << std::endl;
+  deallog << "Estimate bounds largest eigenvalue: "
+          << (warm_start.max_eigenvalue_estimate >= 201. &&
+                  warm_start.max_eigenvalue_estimate <= 1.2 * 202. ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  // reuse the estimate for another modification of the matrix
+  matrix.diag_element(size - 1) = 202;
+  data.reuse_eigenvalue_estimate = true;
+  prec.initialize(matrix, data);
+  prec.vmult(out, in);
+  deallog << "Estimate reused: "
+          << (prec.get_eigenvalue_information().max_eigenvalue_estimate ==
+                  warm_start.max_eigenvalue_estimate ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  // the CG-based estimate reports its iterations as well
+  data.eigenvalue_algorithm =
+    Chebyshev::AdditionalData::EigenvalueAlgorithm::lanczos;
+  data.reuse_eigenvalue_estimate = false;
+  prec.initialize(matrix, data);
+  prec.vmult(out, in);
+  deallog << "Lanczos iterations performed: "
+          << (prec.get_eigenvalue_information().cg_iterations > 0 ? "yes" :
+                                                                    "no")
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  check();
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check SolverCG::solve() for several right hand sides and the
+// SparseMatrix::vmult() function for several vectors it uses. also check
+// that a system with a much smaller right hand side than the others is
+// solved to the same relative accuracy when using one control per system
+
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+template <typename PreconditionerType>
+void
+check(const SparseMatrix<double> &A,
+      const PreconditionerType &  preconditioner,
+      const std::string &         name)
+{
+  const unsigned int          n_vectors = 11;
+  std::vector<Vector<double>> x(n_vectors, Vector<double>(A.m()));
+  std::vector<Vector<double>> b(n_vectors, Vector<double>(A.m()));
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    for (unsigned int i = 0; i < A.m(); ++i)
+      b[v](i) = 1. + (v + 1) * ((i * (v + 3)) % 17);
+  // use a nonzero starting guess for one of the systems and a zero right
+  // hand side for another one
+  x[2] = 1.;
+  b[4] = 0.;
+
+  // check the matrix-vector product for several vectors first
+  std::vector<Vector<double>>         result(n_vectors, Vector<double>(A.m()));
+  std::vector<Vector<double> *>       dst;
+  std::vector<const Vector<double> *> src;
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      dst.push_back(&result[v]);
+      src.push_back(&b[v]);
+    }
+  A.vmult(dst, src);
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      Vector<double> tmp(A.m());
+      A.vmult(tmp, b[v]);
+      tmp -= result[v];
+      AssertThrow(tmp.linfty_norm() == 0., ExcInternalError());
+    }
+
+  SolverControl            control(1000, 1e-10, false, false);
+  SolverCG<Vector<double>> solver(control);
+  solver.solve(A, x, b, preconditioner);
+  AssertThrow(control.last_value() <= 1e-10, ExcInternalError());
+
+  // compare with the solution obtained for each system on its own
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      Vector<double> single(A.m());
+      if (v == 2)
+        single = 1.;
+      solver.solve(A, single, b[v], preconditioner);
+
+      Vector<double> residual(A.m());
+      A.vmult(residual, x[v]);
+      residual -= b[v];
+      AssertThrow(residual.l2_norm() <= 1e-9, ExcInternalError());
+
+      single -= x[v];
+      AssertThrow(single.l2_norm() <= 1e-8 * std::max(1., x[v].l2_norm()),
+                  ExcInternalError());
+    }
+
+  deallog << name << ": solved for " << n_vectors << " right hand sides"
+          << std::endl;
+}
+
+
+
+// the first and last right hand sides are eigenvectors of the matrix, for
+// which CG converges in one step, while the middle one is small but needs
+// many iterations. each system gets its own ReductionControl, so that the
+// small one is not considered converged early
+void
+check_reduction(const SparseMatrix<double> &A, const unsigned int size)
+{
+  const unsigned int          n_vectors = 3;
+  std::vector<Vector<double>> x(n_vectors, Vector<double>(A.m()));
+  std::vector<Vector<double>> b(n_vectors, Vector<double>(A.m()));
+  for (unsigned int i = 0; i < size - 1; ++i)
+    for (unsigned int j = 0; j < size - 1; ++j)
+      {
+        const unsigned int row = j + (size - 1) * i;
+        b[0](row) = std::sin(numbers::PI * (i + 1) / size) *
+                    std::sin(numbers::PI * (j + 1) / size);
+        b[1](row) = 1e-6 * (1. + ((row * 5) % 17));
+        b[2](row) = 2. * std::sin(2 * numbers::PI * (i + 1) / size) *
+                    std::sin(3 * numbers::PI * (j + 1) / size);
+      }
+
+  std::vector<ReductionControl> controls(
+    n_vectors, ReductionControl(1000, 1e-30, 1e-8, false, false));
+  std::vector<SolverControl *> system_controls;
+  for (ReductionControl &control : controls)
+    system_controls.push_back(&control);
+
+  SolverControl            control;
+  SolverCG<Vector<double>> solver(control);
+  solver.solve(A, x, b, PreconditionIdentity(), system_controls);
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    deallog << "Reduction: system " << v << " converged in "
+            << controls[v].last_step() << " steps" << std::endl;
+
+  bool reduced = true;
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      Vector<double> residual(A.m());
+      A.vmult(residual, x[v]);
+      residual -= b[v];
+      if (residual.l2_norm() > 1e-8 * b[v].l2_norm())
+        reduced = false;
+    }
+  deallog << "Reduction: all residuals reduced: " << reduced << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 25;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  check(A, PreconditionIdentity(), "Identity");
+
+  PreconditionJacobi<SparseMatrix<double>> jacobi;
+  jacobi.initialize(A, 0.8);
+  check(A, jacobi, "Jacobi");
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+  check(A, ssor, "SSOR");
+
+  check_reduction(A, size);
+}
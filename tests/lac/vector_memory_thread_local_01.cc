@@ -0,0 +1,176 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check the thread-local lists of GrowingVectorMemory, the reuse of vectors
+// freed on another thread, the reuse of the vector layout by alloc_like(),
+// and the statistics
+
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_memory.h>
+
+#include "../tests.h"
+
+
+using VectorType = Vector<double>;
+
+
+void
+print_statistics()
+{
+  const GrowingVectorMemory<VectorType>::Statistics statistics =
+    GrowingVectorMemory<VectorType>::get_statistics();
+  deallog << "allocations: " << statistics.n_allocations
+          << ", thread-local: " << statistics.n_thread_local_hits
+          << ", pool: " << statistics.n_pool_hits
+          << ", other threads: " << statistics.n_other_thread_hits
+          << ", new: " << statistics.n_new_vectors
+          << ", reinit skipped: " << statistics.n_reinit_skipped
+          << std::endl;
+}
+
+
+void
+test_layout()
+{
+  GrowingVectorMemory<VectorType> mem;
+  VectorType                      small(10), large(20);
+
+  {
+    VectorMemory<VectorType>::Pointer v(mem, small);
+    deallog << "size: " << v->size() << std::endl;
+  }
+  {
+    VectorMemory<VectorType>::Pointer v(mem, small);
+    deallog << "size: " << v->size() << std::endl;
+  }
+  {
+    VectorMemory<VectorType>::Pointer v(mem, large);
+    deallog << "size: " << v->size() << std::endl;
+  }
+  print_statistics();
+
+  // free a small and a large vector, and check that the next allocation
+  // picks the one with the requested size
+  VectorType *v1 = mem.alloc_like(small);
+  VectorType *v2 = mem.alloc_like(large);
+  mem.free(v1);
+  mem.free(v2);
+  VectorType *v3 = mem.alloc_like(small);
+  deallog << "reused the vector with the same size: " << (v3 == v1)
+          << std::endl;
+  mem.free(v3);
+  print_statistics();
+}
+
+
+void
+test_overflow()
+{
+  GrowingVectorMemory<VectorType>::reset_statistics();
+  GrowingVectorMemory<VectorType> mem;
+
+  // more vectors than fit into the list of a thread: the rest goes back to
+  // the shared pool
+  std::vector<VectorType *> vectors(20);
+  for (unsigned int round = 0; round < 2; ++round)
+    {
+      for (auto &v : vectors)
+        v = mem.alloc();
+      for (auto &v : vectors)
+        mem.free(v);
+    }
+  print_statistics();
+}
+
+
+void
+allocate_and_free(const unsigned int n_vectors)
+{
+  GrowingVectorMemory<VectorType> mem;
+  std::vector<VectorType *>       vectors(n_vectors);
+  for (auto &v : vectors)
+    v = mem.alloc();
+  for (auto &v : vectors)
+    mem.free(v);
+}
+
+
+void
+test_other_thread()
+{
+  // start from an empty pool
+  GrowingVectorMemory<VectorType>::release_unused_memory();
+  GrowingVectorMemory<VectorType>::reset_statistics();
+
+  // another thread frees its vectors into its own list. this thread must
+  // reuse them instead of creating new ones
+  Threads::new_thread(&allocate_and_free, 4U).join();
+  allocate_and_free(4);
+  print_statistics();
+}
+
+
+void
+allocate_many()
+{
+  GrowingVectorMemory<VectorType> mem;
+  VectorType                      model(100);
+  for (unsigned int i = 0; i < 1000; ++i)
+    {
+      VectorMemory<VectorType>::Pointer v1(mem, model);
+      VectorMemory<VectorType>::Pointer v2(mem);
+      *v1 = 1.;
+    }
+}
+
+
+void
+test_threads()
+{
+  GrowingVectorMemory<VectorType>::reset_statistics();
+
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int i = 0; i < 8; ++i)
+    tasks += Threads::new_task(&allocate_many);
+  tasks.join_all();
+
+  const GrowingVectorMemory<VectorType>::Statistics statistics =
+    GrowingVectorMemory<VectorType>::get_statistics();
+  deallog << "allocations: " << statistics.n_allocations << std::endl;
+  deallog << "all allocations counted: "
+          << (statistics.n_thread_local_hits + statistics.n_pool_hits +
+                statistics.n_other_thread_hits + statistics.n_new_vectors ==
+              statistics.n_allocations)
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test_layout();
+  test_overflow();
+  test_other_thread();
+  test_threads();
+
+  GrowingVectorMemory<VectorType>::release_unused_memory();
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,100 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that TransfiniteInterpolationManifold::get_new_points() gives the
+// same points as computing the points one by one with get_new_point() on a
+// ball with a curved boundary
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+do_test()
+{
+  SphericalManifold<dim>                spherical_manifold;
+  TransfiniteInterpolationManifold<dim> transfinite;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.set_all_manifold_ids(1);
+  tria.set_all_manifold_ids_on_boundary(0);
+  tria.set_manifold(0, spherical_manifold);
+  transfinite.initialize(tria);
+  tria.set_manifold(1, transfinite);
+  tria.refine_global(1);
+
+  // the triangulation stores a copy of the manifold, which is the one that
+  // knows about the coarse cells
+  const Manifold<dim> &manifold = tria.get_manifold(1);
+
+  // weights of a tensor product of linear functions at the points of a
+  // Gauss formula, interpolating between the vertices of a cell
+  const QGauss<dim> quadrature(3);
+  Table<2, double>  weights(quadrature.size(),
+                           GeometryInfo<dim>::vertices_per_cell);
+  for (unsigned int q = 0; q < quadrature.size(); ++q)
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      weights(q, v) =
+        GeometryInfo<dim>::d_linear_shape_function(quadrature.point(q), v);
+
+  double       max_difference = 0;
+  unsigned int n_points       = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      std::vector<Point<dim>> vertices(GeometryInfo<dim>::vertices_per_cell);
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        vertices[v] = cell->vertex(v);
+
+      std::vector<Point<dim>> new_points(quadrature.size());
+      manifold.get_new_points(make_array_view(vertices),
+                              weights,
+                              make_array_view(new_points));
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          std::vector<double> row_weights(&weights(q, 0),
+                                          &weights(q, 0) +
+                                            weights.size(1));
+          const Point<dim> single_point =
+            manifold.get_new_point(make_array_view(vertices),
+                                   make_array_view(row_weights));
+          max_difference =
+            std::max(max_difference, single_point.distance(new_points[q]));
+          ++n_points;
+        }
+    }
+
+  deallog << "Checked " << n_points << " points in " << dim << "D" << std::endl;
+  deallog << "Batched and single-point evaluation agree: "
+          << (max_difference < 1e-10 ? "yes" : "no") << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  do_test<2>();
+  do_test<3>();
+
+  return 0;
+}
@@ -0,0 +1,75 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Compute the volume of a ball with a TransfiniteInterpolationManifold in
+// the interior and a high-order mapping. Many support points of the mapping
+// share their coordinates on some faces of the coarse cell
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+do_test()
+{
+  SphericalManifold<dim>                spherical_manifold;
+  TransfiniteInterpolationManifold<dim> transfinite;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.set_all_manifold_ids(1);
+  tria.set_all_manifold_ids_on_boundary(0);
+  tria.set_manifold(0, spherical_manifold);
+  transfinite.initialize(tria);
+  tria.set_manifold(1, transfinite);
+  tria.refine_global(2);
+
+  MappingQGeneric<dim> mapping(4);
+  FE_Nothing<dim>      fe;
+  FEValues<dim>        fe_values(mapping, fe, QGauss<dim>(5), update_JxW_values);
+  double               volume = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+        volume += fe_values.JxW(q);
+    }
+
+  deallog << "Volume of the ball in " << dim << "D: " << std::setprecision(8)
+          << volume << ", exact: "
+          << (dim == 2 ? numbers::PI : 4. / 3. * numbers::PI) << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  do_test<2>();
+  do_test<3>();
+
+  return 0;
+}
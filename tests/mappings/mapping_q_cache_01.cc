@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test that MappingQCache gives the same quadrature points and Jacobians as
+// the MappingQGeneric it was initialized with on a curved geometry, also on
+// cells that are not active and are therefore not cached, and that using the
+// cache after it has been invalidated by refinement throws an exception
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_cache.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const unsigned int   degree = 3;
+  MappingQGeneric<dim> mapping(degree);
+  MappingQCache<dim>   mapping_cache(degree);
+  mapping_cache.initialize(tria, mapping);
+  deallog << "Initialized: " << mapping_cache.is_initialized() << std::endl;
+
+  FE_Nothing<dim> fe;
+  QGauss<dim>     quadrature(degree + 1);
+  FEValues<dim>   fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_quadrature_points | update_JxW_values);
+  FEValues<dim>   fe_values_cache(mapping_cache,
+                                fe,
+                                quadrature,
+                                update_quadrature_points |
+                                  update_JxW_values);
+
+  double max_difference     = 0;
+  double max_jxw_difference = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values_cache.reinit(cell);
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          max_difference =
+            std::max(max_difference,
+                     fe_values.quadrature_point(q).distance(
+                       fe_values_cache.quadrature_point(q)));
+          max_jxw_difference =
+            std::max(max_jxw_difference,
+                     std::abs(fe_values.JxW(q) - fe_values_cache.JxW(q)));
+        }
+    }
+  deallog << "Maximal difference of quadrature points: " << max_difference
+          << std::endl;
+  deallog << "Maximal difference of JxW values: " << max_jxw_difference
+          << std::endl;
+
+  max_difference = 0;
+  for (const auto &cell : tria.cell_iterators_on_level(0))
+    {
+      fe_values.reinit(cell);
+      fe_values_cache.reinit(cell);
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        max_difference = std::max(max_difference,
+                                  fe_values.quadrature_point(q).distance(
+                                    fe_values_cache.quadrature_point(q)));
+    }
+  deallog << "Maximal difference of quadrature points on level 0: "
+          << max_difference << std::endl;
+
+  tria.refine_global(1);
+  deallog << "Initialized after refinement: "
+          << mapping_cache.is_initialized() << std::endl;
+  try
+    {
+      fe_values_cache.reinit(tria.begin_active());
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "Using the invalidated cache: " << e.get_exc_name()
+              << std::endl;
+    }
+  mapping_cache.initialize(tria, mapping);
+  deallog << "Initialized: " << mapping_cache.is_initialized() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(6);
+
+  test<2>();
+  test<3>();
+}
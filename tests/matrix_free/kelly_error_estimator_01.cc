@@ -0,0 +1,187 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// compare MatrixFreeKellyErrorEstimator against KellyErrorEstimator for all
+// strategies, with and without a coefficient and Neumann boundary values,
+// for continuous and discontinuous elements on uniform and adaptively
+// refined meshes
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/error_estimator.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/error_estimator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class Solution : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double value = std::sin(3. * p[0]);
+    for (unsigned int d = 1; d < dim; ++d)
+      value *= std::exp(p[d]);
+    return value;
+  }
+};
+
+
+
+template <int dim>
+class Coefficient : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    return 1. + p.square();
+  }
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test(const FiniteElement<dim> &fe, const bool refine_locally)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, 0., 1., true);
+  tria.refine_global(2);
+  if (refine_locally)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[0] < 0.3 && cell->center()[1] < 0.6)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags_inner_faces =
+    update_gradients | update_JxW_values | update_normal_vectors |
+    update_quadrature_points;
+  additional_data.mapping_update_flags_boundary_faces =
+    additional_data.mapping_update_flags_inner_faces;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, Solution<dim>(), solution);
+  constraints.distribute(solution);
+
+  LinearAlgebra::distributed::Vector<double> mf_solution;
+  matrix_free.initialize_dof_vector(mf_solution);
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    mf_solution(i) = solution(i);
+
+  Functions::ConstantFunction<dim> neumann_function(0.5);
+  Coefficient<dim>                 coefficient;
+
+  const typename KellyErrorEstimator<dim>::Strategy strategies[] = {
+    KellyErrorEstimator<dim>::cell_diameter_over_24,
+    KellyErrorEstimator<dim>::cell_diameter,
+    KellyErrorEstimator<dim>::face_diameter_over_twice_max_degree};
+
+  for (const auto strategy : strategies)
+    for (unsigned int variant = 0; variant < 2; ++variant)
+      {
+        std::map<types::boundary_id, const Function<dim> *> neumann_bc;
+        if (variant == 1)
+          neumann_bc[1] = &neumann_function;
+        const Function<dim> *coefficient_ptr =
+          (variant == 1 ? &coefficient : nullptr);
+
+        Vector<float> reference(tria.n_active_cells());
+        KellyErrorEstimator<dim>::estimate(dof_handler,
+                                           QGauss<dim - 1>(fe_degree + 1),
+                                           neumann_bc,
+                                           solution,
+                                           reference,
+                                           ComponentMask(),
+                                           coefficient_ptr,
+                                           numbers::invalid_unsigned_int,
+                                           numbers::invalid_subdomain_id,
+                                           numbers::invalid_material_id,
+                                           strategy);
+
+        Vector<float> estimate;
+        MatrixFreeKellyErrorEstimator<dim, fe_degree>::estimate(
+          matrix_free,
+          mf_solution,
+          estimate,
+          neumann_bc,
+          coefficient_ptr,
+          strategy);
+
+        Vector<float> difference = estimate;
+        difference -= reference;
+        deallog << fe.get_name() << ", strategy " << strategy << ", variant "
+                << variant << ": relative difference below 1e-5: "
+                << (difference.linfty_norm() < 1e-5 * reference.linfty_norm())
+                << std::endl;
+      }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2, 2>(FE_Q<2>(2), false);
+  test<2, 2>(FE_Q<2>(2), true);
+  test<2, 2>(FE_DGQ<2>(2), true);
+  deallog.pop();
+  deallog.push("3d");
+  test<3, 1>(FE_Q<3>(1), false);
+  test<3, 2>(FE_Q<3>(2), true);
+  test<3, 1>(FE_DGQ<3>(1), true);
+  deallog.pop();
+}
@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2013 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that AffineConstraints::distribute() for
+// LinearAlgebra::distributed::Vector gives the same result as the serial
+// version when the vector layout changes between calls, including the case
+// where only some of the processors see a different locally owned range and
+// the index translation must nonetheless be set up again on all of them
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+template <typename Number>
+void
+check(const AffineConstraints<double> &constraints,
+      const unsigned int               size,
+      const unsigned int               n_owned_on_first)
+{
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  // the first processor owns the first n_owned_on_first elements, the
+  // others share the rest
+  const unsigned int n_rest = (size - n_owned_on_first) / (numproc - 1);
+  const unsigned int begin =
+    myid == 0 ? 0 : n_owned_on_first + (myid - 1) * n_rest;
+  const unsigned int end =
+    myid == 0 ? n_owned_on_first :
+                (myid == numproc - 1 ? size : begin + n_rest);
+  IndexSet locally_owned(size);
+  locally_owned.add_range(begin, end);
+
+  LinearAlgebra::distributed::Vector<Number> vec(locally_owned,
+                                                 MPI_COMM_WORLD);
+  Vector<Number>                             reference(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      reference(i) = Number(1. + 0.1 * (i % 7));
+      if (locally_owned.is_element(i))
+        vec(i) = reference(i);
+    }
+
+  constraints.distribute(reference);
+  constraints.distribute(vec);
+
+  double difference = 0;
+  for (unsigned int i = begin; i < end; ++i)
+    difference += std::abs(reference(i) - vec(i));
+  deallog << "Size " << size << ", first range [0," << n_owned_on_first
+          << "), difference: "
+          << Utilities::MPI::sum(difference, MPI_COMM_WORLD) << std::endl;
+}
+
+
+
+void
+test()
+{
+  // all processors store all constraints, which refer to elements owned by
+  // other processors in all of the layouts below
+  AffineConstraints<double> constraints;
+  for (unsigned int i = 3; i < 20; i += 5)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, (i + 7) % 20, 0.5);
+      constraints.add_entry(i, (i + 11) % 20, 0.5);
+      constraints.set_inhomogeneity(i, 0.25 * i);
+    }
+  constraints.close();
+
+  // set up the index translation and reuse it
+  check<double>(constraints, 20, 10);
+  check<double>(constraints, 20, 10);
+
+  // same size, but a different locally owned range on all processors
+  check<double>(constraints, 20, 6);
+
+  // the first processor keeps its locally owned range, whereas the range of
+  // the others changes
+  check<double>(constraints, 25, 6);
+  check<float>(constraints, 25, 6);
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  test();
+}
@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// VectorTools::interpolate() averages the values computed on the cells
+// sharing a degree of freedom. check this for a function that is
+// discontinuous along a line through a distorted mesh: a serial Vector, for
+// which the values are averaged in the output vector itself, must give the
+// same result as a LinearAlgebra::distributed::Vector, for which temporary
+// vectors are used. the checksums in the output were generated before the
+// in-place averaging was introduced
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class JumpFunction : public Function<dim>
+{
+public:
+  JumpFunction(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    if (p[0] + 0.3 * p[1] > 0.1)
+      return 1. + p[0] + component;
+    else
+      return -p[1] * p[1] + 0.5 * component;
+  }
+};
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 4, -1., 1.);
+  GridTools::distort_random(0.2, tria, false);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const JumpFunction<dim> function(fe.n_components());
+
+  Vector<double> serial(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, function, serial);
+
+  LinearAlgebra::distributed::Vector<double> parallel(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, function, parallel);
+
+  double difference = 0;
+  double checksum   = 0;
+  for (unsigned int i = 0; i < serial.size(); ++i)
+    {
+      difference = std::max(difference, std::abs(serial(i) - parallel(i)));
+      checksum += (i % 7 + 1) * serial(i);
+    }
+  deallog << fe.get_name() << ": difference " << difference << ", checksum "
+          << std::setprecision(12) << checksum << std::setprecision(6)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(FE_Q<2>(2));
+  test(FE_RaviartThomas<2>(1));
+  test(FESystem<2>(FE_Q<2>(1), 1, FE_Q<2>(3), 1));
+  test(FE_Q<3>(2));
+}
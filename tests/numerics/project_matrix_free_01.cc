@@ -0,0 +1,162 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the matrix-free VectorTools::project reproduces finite element
+// functions, both with the cell-wise inverse mass matrix used for FE_DGQ on
+// affine meshes and with the Chebyshev-preconditioned CG solver used
+// otherwise, and that VectorTools::interpolate into a
+// LinearAlgebra::distributed::Vector gives the same result as into a
+// Vector, with and without a component mask
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/fe_field_function.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test_project(const FiniteElement<dim> &fe,
+             const bool                distort,
+             const bool                refine_locally)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(2);
+  if (refine_locally)
+    {
+      tria.begin_active()->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+  if (distort)
+    GridTools::distort_random(0.1, tria);
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  Vector<double> reference(dof.n_dofs());
+  for (unsigned int i = 0; i < reference.size(); ++i)
+    reference(i) = random_value<double>();
+  constraints.distribute(reference);
+
+  Functions::FEFieldFunction<dim> function(dof, reference);
+  Vector<double>                  result(dof.n_dofs());
+  VectorTools::project(
+    dof, constraints, QGauss<dim>(fe.degree + 2), function, result);
+
+  result -= reference;
+  deallog << fe.get_name() << (distort ? ", distorted" : ", affine")
+          << " mesh, reproduces finite element function: "
+          << (result.linfty_norm() < 1e-8 * reference.linfty_norm())
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_interpolate(const FiniteElement<dim> &fe, const ComponentMask &mask)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  const Functions::CosineFunction<dim> function(fe.n_components());
+
+  Vector<double> reference(dof.n_dofs());
+  for (unsigned int i = 0; i < reference.size(); ++i)
+    reference(i) = i;
+  LinearAlgebra::distributed::Vector<double> result(dof.n_dofs());
+  for (unsigned int i = 0; i < reference.size(); ++i)
+    result(i) = i;
+
+  VectorTools::interpolate(dof, function, reference, mask);
+  VectorTools::interpolate(dof, function, result, mask);
+
+  double difference = 0;
+  for (unsigned int i = 0; i < reference.size(); ++i)
+    difference = std::max(difference, std::abs(result(i) - reference(i)));
+  deallog << fe.get_name() << ", " << mask.n_selected_components(
+                                        fe.n_components())
+          << " selected components, same interpolation: "
+          << (difference < 1e-12) << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    {
+      test_project(FE_DGQ<dim>(degree), false, false);
+      test_project(FE_DGQ<dim>(degree), true, false);
+    }
+  test_project(FESystem<dim>(FE_DGQ<dim>(2), 2), false, false);
+  test_project(FE_Q<dim>(2), false, true);
+
+  test_interpolate(FE_Q<dim>(2), ComponentMask());
+  test_interpolate(FESystem<dim>(FE_Q<dim>(2), 1, FE_DGQ<dim>(1), 1),
+                   ComponentMask());
+  std::vector<bool> mask(2, true);
+  mask[1] = false;
+  test_interpolate(FESystem<dim>(FE_Q<dim>(2), 1, FE_DGQ<dim>(1), 1),
+                   ComponentMask(mask));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
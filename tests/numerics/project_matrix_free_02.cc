@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the matrix-free VectorTools::project works in parallel when the
+// cells of only one of the processors are curved. the cell-wise inverse mass
+// matrix for FE_DGQ can then only be used on the other processors, but all
+// of them must take the same code path, as the two differ in their
+// collective operations
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int) const
+  {
+    double val = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      val += (d + 1) * p[d];
+    return val;
+  }
+};
+
+
+
+template <int dim>
+Point<dim>
+deform_lower_half(const Point<dim> &p)
+{
+  // move the interior vertices of the half with negative last coordinate,
+  // which for two processors is owned by the first one, so that its cells
+  // become non-affine
+  Point<dim>   q = p;
+  const double t = p[dim - 1];
+  if (t < 0)
+    q[0] += 0.4 * t * (t + 1.) * (1. - p[0] * p[0]);
+  return q;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(3 - dim / 3);
+  GridTools::transform(&deform_lower_half<dim>, tria);
+
+  FE_DGQ<dim>     fe(degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof, locally_relevant_dofs);
+  AffineConstraints<double> constraints;
+  constraints.reinit(locally_relevant_dofs);
+  constraints.close();
+
+  LinearAlgebra::distributed::Vector<double> projection(
+    dof.locally_owned_dofs(), locally_relevant_dofs, MPI_COMM_WORLD);
+  VectorTools::project(dof,
+                       constraints,
+                       QGauss<dim>(degree + 2),
+                       LinearFunction<dim>(),
+                       projection);
+  projection.update_ghost_values();
+
+  Vector<float> error(tria.n_active_cells());
+  VectorTools::integrate_difference(dof,
+                                    projection,
+                                    LinearFunction<dim>(),
+                                    error,
+                                    QGauss<dim>(degree + 1),
+                                    VectorTools::L2_norm);
+  const double local_error = error.l2_norm();
+  const double global_error =
+    std::sqrt(Utilities::MPI::sum(local_error * local_error, MPI_COMM_WORLD));
+  deallog << fe.get_name()
+          << ", reproduces linear function: " << (global_error < 1e-8)
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv, 1);
+  mpi_initlog();
+
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    test<2>(degree);
+  for (unsigned int degree = 1; degree < 3; ++degree)
+    test<3>(degree);
+}
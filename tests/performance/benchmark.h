@@ -0,0 +1,282 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_tests_performance_benchmark_h
+#define dealii_tests_performance_benchmark_h
+
+// Common infrastructure of the performance benchmarks in this directory:
+// parsing of the command line, timing of a kernel, and output of the results
+// as a table and as a JSON file that can be compared against a baseline with
+// contrib/utilities/compare_benchmarks.py.
+//
+// Every benchmark program accepts the arguments
+//   --size=small|medium|large   the problem sizes to run (default: medium)
+//   --repetitions=N             the number of timed runs of each kernel
+//                               (default: 10)
+//   --output=FILE               the JSON file to write (default: none)
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/revision.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace dealii;
+
+
+namespace Benchmark
+{
+  /**
+   * The settings given on the command line.
+   */
+  struct Parameters
+  {
+    Parameters(int argc, char **argv);
+
+    /**
+     * The index of the problem size: 0 for small, 1 for medium, 2 for
+     * large. Benchmarks typically add this number (or a multiple of it) to
+     * the number of global refinements of their mesh.
+     */
+    unsigned int size;
+
+    std::string size_name;
+
+    unsigned int repetitions;
+
+    std::string output_file;
+  };
+
+
+
+  /**
+   * The result of one kernel for one set of parameters. The throughput is
+   * measured in the units given by @p throughput_unit, e.g. "DoFs/s", and
+   * the memory bandwidth in GB/s. A negative bandwidth means that no
+   * meaningful estimate of the transferred data exists for this kernel.
+   */
+  struct Result
+  {
+    std::string                                      name;
+    std::vector<std::pair<std::string, std::string>> parameters;
+    double                                           time_min;
+    double                                           time_median;
+    unsigned int                                     repetitions;
+    double                                           throughput;
+    std::string                                      throughput_unit;
+    double                                           bandwidth;
+  };
+
+
+
+  /**
+   * Call @p kernel once to warm up caches and to trigger any lazy
+   * initialization, then @p repetitions times with timing. Return the
+   * minimal and the median time of one call in seconds.
+   */
+  template <typename Kernel>
+  std::pair<double, double>
+  measure(const Kernel &kernel, const unsigned int repetitions)
+  {
+    kernel();
+
+    std::vector<double> times(std::max(repetitions, 1U));
+    for (double &time : times)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        kernel();
+        time = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                 .count();
+      }
+    std::sort(times.begin(), times.end());
+    return std::make_pair(times.front(), times[times.size() / 2]);
+  }
+
+
+
+  /**
+   * Collects the results of one benchmark program, prints them, and writes
+   * them to the JSON file requested on the command line.
+   */
+  class Report
+  {
+  public:
+    Report(const std::string &benchmark_name, const Parameters &parameters);
+
+    /**
+     * Time @p kernel as described in measure() and add the result. @p
+     * n_items is the number of items (e.g., degrees of freedom or cells)
+     * processed by one call of the kernel, and @p n_bytes the number of bytes
+     * it needs to transfer from or to main memory at least, or zero if
+     * unknown.
+     */
+    template <typename Kernel>
+    void
+    add(const std::string &                                      name,
+        const std::vector<std::pair<std::string, std::string>> &parameters,
+        const Kernel &                                           kernel,
+        const double                                             n_items,
+        const std::string &                                      item_unit,
+        const double                                             n_bytes = 0);
+
+    /**
+     * Write the JSON file, if requested.
+     */
+    void
+    write() const;
+
+  private:
+    const std::string benchmark_name;
+
+    const Parameters parameters;
+
+    std::vector<Result> results;
+  };
+
+
+
+  /* -------------------------- implementation -------------------------- */
+
+
+  inline Parameters::Parameters(int argc, char **argv)
+    : size(1)
+    , size_name("medium")
+    , repetitions(10)
+  {
+    for (int i = 1; i < argc; ++i)
+      {
+        const std::string argument = argv[i];
+        if (argument == "--size=small")
+          size = 0;
+        else if (argument == "--size=medium")
+          size = 1;
+        else if (argument == "--size=large")
+          size = 2;
+        else if (argument.find("--repetitions=") == 0)
+          repetitions = std::atoi(argument.c_str() + 14);
+        else if (argument.find("--output=") == 0)
+          output_file = argument.substr(9);
+        else
+          AssertThrow(false,
+                      ExcMessage("Unknown command line argument <" + argument +
+                                 ">"));
+      }
+    const char *size_names[] = {"small", "medium", "large"};
+    size_name                = size_names[size];
+  }
+
+
+
+  inline Report::Report(const std::string &benchmark_name,
+                        const Parameters & parameters)
+    : benchmark_name(benchmark_name)
+    , parameters(parameters)
+  {
+    std::cout << "Benchmark " << benchmark_name << " (size "
+              << parameters.size_name << ", " << MultithreadInfo::n_threads()
+              << " threads)" << std::endl;
+  }
+
+
+
+  template <typename Kernel>
+  void
+  Report::add(const std::string &                                      name,
+              const std::vector<std::pair<std::string, std::string>> &params,
+              const Kernel &                                           kernel,
+              const double                                             n_items,
+              const std::string &item_unit,
+              const double       n_bytes)
+  {
+    const std::pair<double, double> times =
+      measure(kernel, parameters.repetitions);
+
+    Result result;
+    result.name            = name;
+    result.parameters      = params;
+    result.time_min        = times.first;
+    result.time_median     = times.second;
+    result.repetitions     = parameters.repetitions;
+    result.throughput      = n_items / times.first;
+    result.throughput_unit = item_unit + "/s";
+    result.bandwidth       = (n_bytes > 0 ? 1e-9 * n_bytes / times.first : -1);
+    results.push_back(result);
+
+    std::cout << "  " << std::left << std::setw(24) << name;
+    for (const auto &p : params)
+      std::cout << p.first << "=" << std::setw(9) << p.second << " ";
+    std::cout << std::right << std::setprecision(3) << std::setw(10)
+              << result.time_min << "s " << std::setw(10) << result.throughput
+              << " " << result.throughput_unit;
+    if (result.bandwidth > 0)
+      std::cout << std::setw(8) << result.bandwidth << " GB/s";
+    std::cout << std::endl;
+  }
+
+
+
+  inline void
+  Report::write() const
+  {
+    if (parameters.output_file.empty())
+      return;
+
+    std::ofstream out(parameters.output_file);
+    AssertThrow(out, ExcIO());
+    out << std::setprecision(8);
+    out << "{\n"
+        << "  \"benchmark\": \"" << benchmark_name << "\",\n"
+        << "  \"deal.II version\": \"" << DEAL_II_PACKAGE_VERSION << "\",\n"
+        << "  \"git revision\": \"" << DEAL_II_GIT_SHORTREV << "\",\n"
+#ifdef DEBUG
+        << "  \"build type\": \"Debug\",\n"
+#else
+        << "  \"build type\": \"Release\",\n"
+#endif
+        << "  \"n_threads\": " << MultithreadInfo::n_threads() << ",\n"
+        << "  \"size\": \"" << parameters.size_name << "\",\n"
+        << "  \"results\": [";
+    for (unsigned int i = 0; i < results.size(); ++i)
+      {
+        const Result &result = results[i];
+        out << (i > 0 ? "," : "") << "\n    {\"name\": \"" << result.name
+            << "\", \"parameters\": {";
+        for (unsigned int p = 0; p < result.parameters.size(); ++p)
+          out << (p > 0 ? ", " : "") << "\"" << result.parameters[p].first
+              << "\": \"" << result.parameters[p].second << "\"";
+        out << "}, \"time_min\": " << result.time_min
+            << ", \"time_median\": " << result.time_median
+            << ", \"repetitions\": " << result.repetitions
+            << ", \"throughput\": " << result.throughput
+            << ", \"throughput_unit\": \"" << result.throughput_unit << "\"";
+        if (result.bandwidth > 0)
+          out << ", \"bandwidth_GBs\": " << result.bandwidth;
+        out << "}";
+      }
+    out << "\n  ]\n}\n";
+  }
+} // namespace Benchmark
+
+#endif
@@ -0,0 +1,102 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark DataOut::build_patches() and the output of the patches in VTU
+// format to memory, for linear and quadratic elements in 2d and 3d. The
+// bandwidth of the output is computed from the size of the written data.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <sstream>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+run(Benchmark::Report &report,
+    const unsigned int degree,
+    const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = std::sin(0.01 * i);
+
+  const std::vector<std::pair<std::string, std::string>> parameters = {
+    {"dim", std::to_string(dim)},
+    {"degree", std::to_string(degree)},
+    {"n_cells", std::to_string(tria.n_active_cells())}};
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+
+  report.add("build_patches",
+             parameters,
+             [&]() { data_out.build_patches(degree); },
+             tria.n_active_cells(),
+             "cells");
+
+  std::size_t n_bytes = 0;
+  {
+    std::ostringstream out;
+    data_out.write_vtu(out);
+    n_bytes = out.str().size();
+  }
+
+  report.add("write_vtu",
+             parameters,
+             [&]() {
+               std::ostringstream out;
+               data_out.write_vtu(out);
+             },
+             tria.n_active_cells(),
+             "cells",
+             n_bytes);
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("data_out", parameters);
+
+  run<2>(report, 1, 6 + 2 * parameters.size);
+  run<2>(report, 2, 5 + 2 * parameters.size);
+  run<3>(report, 1, 3 + parameters.size);
+  run<3>(report, 2, 2 + parameters.size);
+
+  report.write();
+}
@@ -0,0 +1,82 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark DoFHandler::distribute_dofs() and the renumbering with
+// DoFRenumbering::Cuthill_McKee() for continuous elements on an adaptively
+// refined mesh in 2d and 3d.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+run(Benchmark::Report &report,
+    const unsigned int degree,
+    const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_refinements);
+  // refine the cells close to the center once more to get hanging nodes
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.4)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  const std::vector<std::pair<std::string, std::string>> parameters = {
+    {"dim", std::to_string(dim)},
+    {"degree", std::to_string(degree)},
+    {"n_dofs", std::to_string(dof_handler.n_dofs())}};
+
+  report.add("distribute_dofs",
+             parameters,
+             [&]() { dof_handler.distribute_dofs(fe); },
+             dof_handler.n_dofs(),
+             "DoFs");
+
+  report.add("Cuthill_McKee",
+             parameters,
+             [&]() { DoFRenumbering::Cuthill_McKee(dof_handler); },
+             dof_handler.n_dofs(),
+             "DoFs");
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("distribute_dofs", parameters);
+
+  run<2>(report, 1, 5 + 2 * parameters.size);
+  run<2>(report, 3, 5 + 2 * parameters.size);
+  run<3>(report, 1, 2 + parameters.size);
+  run<3>(report, 2, 2 + parameters.size);
+
+  report.write();
+}
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark FEValues::reinit() with and without an FEValuesGeometryCache on
+// a mesh of translated cells, both alone and as part of the assembly of a
+// Laplace matrix with WorkStream::run(). The cells alternate between two
+// widths in each direction, so that there are only 2^dim different cells up
+// to translation but CellSimilarity hardly ever applies to two consecutive
+// cells.
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_geometry_cache.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+struct ScratchData
+{
+  ScratchData(const FEValues<dim> &fe_values, FEValuesGeometryCache<dim> *cache)
+    : fe_values(fe_values.get_mapping(),
+                fe_values.get_fe(),
+                fe_values.get_quadrature(),
+                fe_values.get_update_flags())
+    , cache(cache)
+  {
+    if (cache != nullptr)
+      this->fe_values.attach_geometry_cache(*cache);
+  }
+
+  ScratchData(const ScratchData &scratch)
+    : ScratchData(scratch.fe_values, scratch.cache)
+  {}
+
+  FEValues<dim>               fe_values;
+  FEValuesGeometryCache<dim> *cache;
+};
+
+
+
+template <int dim>
+void
+run(Benchmark::Report &report,
+    const unsigned int degree,
+    const unsigned int n_refinements)
+{
+  const unsigned int               n_subdivisions = 1U << n_refinements;
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       corner;
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int i = 0; i < n_subdivisions; ++i)
+      {
+        step_sizes[d].push_back(i % 2 == 0 ? 1. : 1.5);
+        corner[d] += step_sizes[d].back();
+      }
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            step_sizes,
+                                            Point<dim>(),
+                                            corner);
+
+  FE_Q<dim>                  fe(degree);
+  const MappingQGeneric<dim> mapping(1);
+  DoFHandler<dim>            dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const UpdateFlags flags = update_values | update_gradients |
+                            update_quadrature_points | update_JxW_values;
+  FEValues<dim> fe_values(mapping, fe, QGauss<dim>(degree + 1), flags);
+
+  for (const bool use_cache : {false, true})
+    {
+      FEValuesGeometryCache<dim> cache;
+      const std::vector<std::pair<std::string, std::string>> parameters = {
+        {"dim", std::to_string(dim)},
+        {"degree", std::to_string(degree)},
+        {"n_cells", std::to_string(tria.n_active_cells())},
+        {"cache", use_cache ? "true" : "false"}};
+
+      ScratchData<dim> scratch(fe_values, use_cache ? &cache : nullptr);
+      report.add("reinit",
+                 parameters,
+                 [&]() {
+                   for (const auto &cell : dof_handler.active_cell_iterators())
+                     scratch.fe_values.reinit(cell);
+                 },
+                 tria.n_active_cells(),
+                 "cells");
+
+      report.add(
+        "assemble",
+        parameters,
+        [&]() {
+          WorkStream::run(
+            dof_handler.begin_active(),
+            dof_handler.end(),
+            [](const typename DoFHandler<dim>::active_cell_iterator &cell,
+               ScratchData<dim> &                                    scratch,
+               FullMatrix<double> &cell_matrix) {
+              const FEValues<dim> &fe_values = scratch.fe_values;
+              scratch.fe_values.reinit(cell);
+              cell_matrix = 0;
+              for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+                for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+                  for (unsigned int j = 0; j < fe_values.dofs_per_cell; ++j)
+                    cell_matrix(i, j) += fe_values.shape_grad(i, q) *
+                                         fe_values.shape_grad(j, q) *
+                                         fe_values.JxW(q);
+            },
+            [](const FullMatrix<double> &) {},
+            scratch,
+            FullMatrix<double>(fe.dofs_per_cell, fe.dofs_per_cell));
+        },
+        tria.n_active_cells(),
+        "cells");
+    }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("fe_values_geometry_cache", parameters);
+
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    run<2>(report, degree, 6 + 2 * parameters.size);
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    run<3>(report, degree, 3 + parameters.size);
+
+  report.write();
+}
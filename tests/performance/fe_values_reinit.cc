@@ -0,0 +1,82 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark FEValues::reinit() on a deformed mesh in 2d and 3d, i.e., the
+// computation of the mapping data and the transformation of the shape
+// function gradients on each cell, for elements of degree 1 to 3.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+run(Benchmark::Report &report,
+    const unsigned int degree,
+    const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+  // make sure the cells are not translations of each other
+  GridTools::distort_random(0.1, tria, false);
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  FEValues<dim> fe_values(fe,
+                          QGauss<dim>(degree + 1),
+                          update_values | update_gradients |
+                            update_quadrature_points | update_JxW_values);
+
+  report.add("reinit",
+             {{"dim", std::to_string(dim)},
+              {"degree", std::to_string(degree)},
+              {"n_cells", std::to_string(tria.n_active_cells())}},
+             [&]() {
+               for (const auto &cell : dof_handler.active_cell_iterators())
+                 fe_values.reinit(cell);
+             },
+             tria.n_active_cells(),
+             "cells");
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("fe_values_reinit", parameters);
+
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    run<2>(report, degree, 6 + 2 * parameters.size);
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    run<3>(report, degree, 3 + parameters.size);
+
+  report.write();
+}
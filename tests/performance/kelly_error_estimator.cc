@@ -0,0 +1,94 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark KellyErrorEstimator::estimate() for an interpolated smooth
+// function on an adaptively refined mesh in 2d and 3d, for elements of
+// degree 1 and 2.
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/error_estimator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+run(Benchmark::Report &report,
+    const unsigned int degree,
+    const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.25)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler,
+                           Functions::CosineFunction<dim>(),
+                           solution);
+
+  Vector<float> estimated_error(tria.n_active_cells());
+
+  report.add("estimate",
+             {{"dim", std::to_string(dim)},
+              {"degree", std::to_string(degree)},
+              {"n_cells", std::to_string(tria.n_active_cells())}},
+             [&]() {
+               KellyErrorEstimator<dim>::estimate(
+                 dof_handler,
+                 QGauss<dim - 1>(degree + 1),
+                 std::map<types::boundary_id, const Function<dim> *>(),
+                 solution,
+                 estimated_error);
+             },
+             tria.n_active_cells(),
+             "cells");
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("kelly_error_estimator", parameters);
+
+  run<2>(report, 1, 6 + 2 * parameters.size);
+  run<2>(report, 2, 5 + 2 * parameters.size);
+  run<3>(report, 1, 3 + parameters.size);
+  run<3>(report, 2, 2 + parameters.size);
+
+  report.write();
+}
@@ -0,0 +1,153 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark the matrix-free evaluation of the Laplace operator with FE_Q
+// elements of degree 1 to 8 in 3d. The mesh is chosen such that the number of
+// degrees of freedom is roughly the same for all degrees. The bandwidth is
+// computed from the vector access only, i.e., one read of the source vector
+// and one read and write of the destination vector.
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "benchmark.h"
+
+
+template <int dim, int fe_degree>
+class LaplaceOperator
+{
+public:
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  LaplaceOperator(const MatrixFree<dim, double> &data)
+    : data(data)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    data.cell_loop(&LaplaceOperator::local_apply, this, dst, src, true);
+  }
+
+private:
+  void
+  local_apply(const MatrixFree<dim, double> &              data,
+              VectorType &                                 dst,
+              const VectorType &                           src,
+              const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, double> phi(data);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, false, true);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          phi.submit_gradient(phi.get_gradient(q), q);
+        phi.integrate_scatter(false, true, dst);
+      }
+  }
+
+  const MatrixFree<dim, double> &data;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+run(Benchmark::Report &report, const unsigned int size)
+{
+  // choose the mesh such that the number of degrees of freedom is close to
+  // 2^(17 + 3 size), i.e., 131k, 1M, or 8M
+  unsigned int n_refinements = 0;
+  while (std::pow(2. * (1U << n_refinements) * fe_degree, dim) <=
+         std::pow(2., 17 + 3 * size))
+    ++n_refinements;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+  MatrixFree<dim, double> data;
+  data.reinit(MappingQGeneric<dim>(1),
+              dof_handler,
+              constraints,
+              QGauss<1>(fe_degree + 1),
+              additional_data);
+
+  LinearAlgebra::distributed::Vector<double> src, dst;
+  data.initialize_dof_vector(src);
+  data.initialize_dof_vector(dst);
+  for (unsigned int i = 0; i < src.local_size(); ++i)
+    src.local_element(i) = 1. + 0.001 * (i % 97);
+
+  const LaplaceOperator<dim, fe_degree> laplace_operator(data);
+
+  const double n_dofs = dof_handler.n_dofs();
+  report.add("laplace_vmult",
+             {{"dim", std::to_string(dim)},
+              {"degree", std::to_string(fe_degree)},
+              {"n_dofs", std::to_string(dof_handler.n_dofs())}},
+             [&]() { laplace_operator.vmult(dst, src); },
+             n_dofs,
+             "DoFs",
+             3 * n_dofs * sizeof(double));
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv);
+
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("matrix_free_laplace", parameters);
+
+  run<3, 1>(report, parameters.size);
+  run<3, 2>(report, parameters.size);
+  run<3, 3>(report, parameters.size);
+  run<3, 4>(report, parameters.size);
+  run<3, 5>(report, parameters.size);
+  run<3, 6>(report, parameters.size);
+  run<3, 7>(report, parameters.size);
+  run<3, 8>(report, parameters.size);
+
+  report.write();
+}
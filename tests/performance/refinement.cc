@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark Triangulation::execute_coarsening_and_refinement(), once for
+// global refinement of a cube and once for repeated local refinement of a
+// ball, in 2d and 3d. Each run starts from the coarse mesh, and the
+// throughput is given in terms of the number of active cells of the final
+// mesh.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+refine_locally(Triangulation<dim> &tria,
+               const unsigned int  n_global_refinements)
+{
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_global_refinements);
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (std::abs(cell->center().norm() - 0.5) < 0.1)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+}
+
+
+
+template <int dim>
+void
+run(Benchmark::Report &report, const unsigned int n_refinements)
+{
+  {
+    Triangulation<dim> tria;
+    GridGenerator::hyper_cube(tria);
+    tria.refine_global(n_refinements);
+
+    report.add("refine_global",
+               {{"dim", std::to_string(dim)},
+                {"n_cells", std::to_string(tria.n_active_cells())}},
+               [&]() {
+                 tria.clear();
+                 GridGenerator::hyper_cube(tria);
+                 tria.refine_global(n_refinements);
+               },
+               tria.n_active_cells(),
+               "cells");
+  }
+
+  {
+    Triangulation<dim> tria;
+    refine_locally(tria, n_refinements - 2);
+
+    report.add("refine_local",
+               {{"dim", std::to_string(dim)},
+                {"n_cells", std::to_string(tria.n_active_cells())}},
+               [&]() {
+                 tria.clear();
+                 refine_locally(tria, n_refinements - 2);
+               },
+               tria.n_active_cells(),
+               "cells");
+  }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("refinement", parameters);
+
+  run<2>(report, 7 + 2 * parameters.size);
+  run<3>(report, 3 + parameters.size);
+
+  report.write();
+}
@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Benchmark the matrix-vector product of SparseMatrix for the Laplace matrix
+// of linear and quadratic elements in 3d. The bandwidth is computed from the
+// minimal data transfer: the matrix values and column indices, the row
+// pointers, one read of the source and one write of the destination vector.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+run(Benchmark::Report &report,
+    const unsigned int degree,
+    const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> matrix(sparsity);
+  MatrixTools::create_laplace_matrix(dof_handler,
+                                     QGauss<dim>(degree + 1),
+                                     matrix);
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = 1. + 0.001 * (i % 97);
+
+  const double n_rows = matrix.m();
+  const double n_bytes =
+    matrix.n_nonzero_elements() *
+      (sizeof(double) + sizeof(SparsityPattern::size_type)) +
+    (n_rows + 1) * sizeof(std::size_t) + 2 * n_rows * sizeof(double);
+
+  report.add("vmult",
+             {{"dim", std::to_string(dim)},
+              {"degree", std::to_string(degree)},
+              {"n_dofs", std::to_string(dof_handler.n_dofs())}},
+             [&]() { matrix.vmult(dst, src); },
+             n_rows,
+             "DoFs",
+             n_bytes);
+
+  report.add("Tvmult",
+             {{"dim", std::to_string(dim)},
+              {"degree", std::to_string(degree)},
+              {"n_dofs", std::to_string(dof_handler.n_dofs())}},
+             [&]() { matrix.Tvmult(dst, src); },
+             n_rows,
+             "DoFs",
+             n_bytes);
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("sparse_matrix_vmult", parameters);
+
+  run<3>(report, 1, 4 + parameters.size);
+  run<3>(report, 2, 3 + parameters.size);
+
+  report.write();
+}
@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Benchmark TransfiniteInterpolationManifold on a ball whose interior cells
+// interpolate from the spherical boundary: the creation of new points during
+// global refinement, and the computation of the support points of a
+// high-order MappingQGeneric in FEValues::reinit(), which both pull back the
+// surrounding points to the chart of the coarse cell.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include "benchmark.h"
+
+
+template <int dim>
+void
+create_mesh(Triangulation<dim> &                   tria,
+            TransfiniteInterpolationManifold<dim> &manifold,
+            const unsigned int                     n_refinements)
+{
+  GridGenerator::hyper_ball(tria);
+  tria.set_all_manifold_ids(1);
+  tria.set_all_manifold_ids_on_boundary(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  manifold.initialize(tria);
+  tria.set_manifold(1, manifold);
+  tria.refine_global(n_refinements);
+}
+
+
+
+template <int dim>
+void
+run(Benchmark::Report &report, const unsigned int n_refinements)
+{
+  Triangulation<dim>                    tria;
+  TransfiniteInterpolationManifold<dim> manifold;
+  create_mesh(tria, manifold, n_refinements);
+
+  report.add("refine_global",
+             {{"dim", std::to_string(dim)},
+              {"n_cells", std::to_string(tria.n_active_cells())}},
+             [&]() {
+               Triangulation<dim>                    tria;
+               TransfiniteInterpolationManifold<dim> manifold;
+               create_mesh(tria, manifold, n_refinements);
+             },
+             tria.n_active_cells(),
+             "cells");
+
+  const unsigned int   mapping_degree = 4;
+  MappingQGeneric<dim> mapping(mapping_degree);
+  FE_Nothing<dim>      fe;
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          QGauss<dim>(mapping_degree + 1),
+                          update_quadrature_points | update_JxW_values);
+  report.add("mapping_support_points",
+             {{"dim", std::to_string(dim)},
+              {"mapping_degree", std::to_string(mapping_degree)},
+              {"n_cells", std::to_string(tria.n_active_cells())}},
+             [&]() {
+               for (const auto &cell : tria.active_cell_iterators())
+                 fe_values.reinit(cell);
+             },
+             tria.n_active_cells(),
+             "cells");
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  const Benchmark::Parameters parameters(argc, argv);
+  Benchmark::Report           report("transfinite_manifold", parameters);
+
+  run<2>(report, 4 + 2 * parameters.size);
+  run<3>(report, 2 + parameters.size);
+
+  report.write();
+}
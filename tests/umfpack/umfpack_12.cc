@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// factorize several matrices with the same sparsity pattern with the same
+// SparseDirectUMFPACK object (which reuses the symbolic factorization), then
+// a matrix with a different sparsity pattern, and solve for several right
+// hand sides at once
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+fill_matrix(SparseMatrix<double> &matrix, const double shift)
+{
+  for (unsigned int row = 0; row < matrix.m(); ++row)
+    for (SparseMatrix<double>::iterator p = matrix.begin(row);
+         p != matrix.end(row);
+         ++p)
+      if (p->column() == row)
+        p->value() = 4. + shift;
+      else if (p->column() < row)
+        p->value() = -1. - 0.1 * shift;
+      else
+        p->value() = -1. + 0.2 * shift;
+}
+
+
+
+void
+check(const SparseMatrix<double> &matrix, SparseDirectUMFPACK &solver)
+{
+  solver.factorize(matrix);
+
+  std::vector<Vector<double>> solutions(5, Vector<double>(matrix.m()));
+  std::vector<Vector<double>> rhs(5, Vector<double>(matrix.m()));
+  for (unsigned int i = 0; i < solutions.size(); ++i)
+    {
+      for (unsigned int j = 0; j < matrix.m(); ++j)
+        solutions[i](j) = 1. + (i + 1) * j;
+      matrix.vmult(rhs[i], solutions[i]);
+    }
+
+  std::vector<Vector<double>> x = rhs;
+  solver.solve(x);
+
+  for (unsigned int i = 0; i < solutions.size(); ++i)
+    {
+      // compare with the solution for a single vector
+      Vector<double> y = rhs[i];
+      solver.solve(y);
+      y -= x[i];
+      AssertThrow(y.l2_norm() == 0., ExcInternalError());
+
+      x[i] -= solutions[i];
+      AssertThrow(x[i].l2_norm() < 1e-10 * solutions[i].l2_norm(),
+                  ExcInternalError());
+    }
+  deallog << "Solved for " << solutions.size() << " right hand sides"
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int     n = 40;
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = (i > 2 ? i - 2 : 0); j < std::min(n, i + 3); ++j)
+      dsp.add(i, j);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseDirectUMFPACK  solver;
+  SparseMatrix<double> matrix(sparsity);
+  for (unsigned int k = 0; k < 3; ++k)
+    {
+      fill_matrix(matrix, k);
+      check(matrix, solver);
+    }
+
+  // now a matrix with a different sparsity pattern
+  dsp.add(0, n - 1);
+  dsp.add(n - 1, 0);
+  SparsityPattern sparsity_2;
+  sparsity_2.copy_from(dsp);
+  SparseMatrix<double> matrix_2(sparsity_2);
+  fill_matrix(matrix_2, 1.);
+  check(matrix_2, solver);
+
+  // and back to the first one
+  check(matrix, solver);
+}